@@ -67,7 +67,7 @@ Feature: Basic trip planning
 
         When I plan a trip I should get
             | waypoints               | trips         |
-            | a,b,c,d,e,f,g,h,i,j,k,l | alkjihgfedcba |
+            | a,b,c,d,e,f,g,h,i,j,k,l | abcdefghijkla |
 
     Scenario: Testbot - Trip: Roundtrip FS waypoints (more than 10)
         Given the node map
@@ -94,7 +94,7 @@ Feature: Basic trip planning
 
         When I plan a trip I should get
             | waypoints               | source | trips         |
-            | a,b,c,d,e,f,g,h,i,j,k,l | first  | alkjihgfedcba |
+            | a,b,c,d,e,f,g,h,i,j,k,l | first  | abcdefghijkla |
 
     Scenario: Testbot - Trip: Roundtrip FE waypoints (more than 10)
         Given the query options
@@ -123,7 +123,7 @@ Feature: Basic trip planning
 
         When I plan a trip I should get
             | waypoints               | trips         |
-            | a,b,c,d,e,f,g,h,i,j,k,l | lkjihgfedcbal |
+            | a,b,c,d,e,f,g,h,i,j,k,l | labcdefghijkl |
 
     Scenario: Testbot - Trip: Unroutable roundtrip with waypoints (less than 10)
         Given the node map
@@ -245,7 +245,7 @@ Feature: Basic trip planning
 
         When I plan a trip I should get
             |  waypoints              | source | destination | roundtrip |  trips       | durations  | distance  |
-            |  a,b,c,d,e,h,i,j,k,g,f  | first  | last        | false     | abcdeghijkf  | 15         | 149.8     |
+            |  a,b,c,d,e,h,i,j,k,g,f  | first  | last        | false     | abcdehijkgf  | 15         | 149.8     |
 
     Scenario: Testbot - Trip: FSE roundtrip with waypoints (less than 10)
         Given the node map
@@ -2,6 +2,7 @@
 #define OSRM_CONTRACTOR_CONTRACT_EXCLUDABLE_GRAPH_HPP
 
 #include "contractor/contracted_edge_container.hpp"
+#include "contractor/contracted_metric.hpp"
 #include "contractor/contractor_graph.hpp"
 #include "contractor/graph_contractor.hpp"
 #include "contractor/graph_contractor_adaptors.hpp"
@@ -12,8 +13,6 @@ namespace osrm
 namespace contractor
 {
 
-using GraphAndFilter = std::tuple<QueryGraph, std::vector<std::vector<bool>>>;
-
 inline auto contractFullGraph(ContractorGraph contractor_graph,
                               std::vector<EdgeWeight> node_weights)
 {
@@ -23,7 +22,7 @@ inline auto contractFullGraph(ContractorGraph contractor_graph,
     auto edges = toEdges<QueryEdge>(std::move(contractor_graph));
     std::vector<bool> edge_filter(edges.size(), true);
 
-    return GraphAndFilter{QueryGraph{num_nodes, std::move(edges)}, {std::move(edge_filter)}};
+    return makeContractedMetric(num_nodes, edges, {std::move(edge_filter)});
 }
 
 inline auto contractExcludableGraph(ContractorGraph contractor_graph_,
@@ -91,8 +90,7 @@ inline auto contractExcludableGraph(ContractorGraph contractor_graph_,
         edge_container.Merge(toEdges<QueryEdge>(std::move(filtered_core_graph)));
     }
 
-    return GraphAndFilter{QueryGraph{num_nodes, std::move(edge_container.edges)},
-                          edge_container.MakeEdgeFilters()};
+    return makeContractedMetric(num_nodes, edge_container.edges, edge_container.MakeEdgeFilters());
 }
 }
 }
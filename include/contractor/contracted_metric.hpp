@@ -3,6 +3,15 @@
 
 #include "contractor/query_graph.hpp"
 
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
+#include "util/typedefs.hpp"
+#include "util/vector_view.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
 namespace osrm
 {
 namespace contractor
@@ -13,12 +22,45 @@ namespace detail
 template <storage::Ownership Ownership> struct ContractedMetric
 {
     detail::QueryGraph<Ownership> graph;
+    // indexed by the edge ids of graph
+    util::ViewOrVector<EdgeDuration, Ownership> durations;
+    util::ViewOrVector<EdgeDistance, Ownership> distances;
     std::vector<util::ViewOrVector<bool, Ownership>> edge_filter;
 };
 }
 
 using ContractedMetric = detail::ContractedMetric<storage::Ownership::Container>;
 using ContractedMetricView = detail::ContractedMetric<storage::Ownership::View>;
+
+// Builds the query graph from edges sorted by (source, target) and moves the durations and
+// distances of the edges to the arrays next to it
+inline ContractedMetric makeContractedMetric(const std::uint32_t number_of_nodes,
+                                             const std::vector<QueryEdge> &edges,
+                                             std::vector<std::vector<bool>> edge_filter)
+{
+    const auto heaviest = std::max_element(
+        edges.begin(), edges.end(), [](const auto &lhs, const auto &rhs) {
+            return lhs.data.weight < rhs.data.weight;
+        });
+    if (heaviest != edges.end() && heaviest->data.weight > SearchEdgeData::MAX_WEIGHT)
+    {
+        throw util::exception("Contracted edge weight " + std::to_string(heaviest->data.weight) +
+                              " exceeds the maximum of " +
+                              std::to_string(SearchEdgeData::MAX_WEIGHT) + SOURCE_REF);
+    }
+
+    ContractedMetric metric{QueryGraph{number_of_nodes, edges}, {}, {}, std::move(edge_filter)};
+
+    metric.durations.reserve(edges.size());
+    metric.distances.reserve(edges.size());
+    for (const auto &edge : edges)
+    {
+        metric.durations.push_back(edge.data.duration);
+        metric.distances.push_back(edge.data.distance);
+    }
+
+    return metric;
+}
 }
 }
 
@@ -21,6 +21,8 @@ void write(storage::tar::FileWriter &writer,
            const detail::ContractedMetric<Ownership> &metric)
 {
     util::serialization::write(writer, name + "/contracted_graph", metric.graph);
+    storage::serialization::write(writer, name + "/durations", metric.durations);
+    storage::serialization::write(writer, name + "/distances", metric.distances);
 
     writer.WriteElementCount64(name + "/exclude", metric.edge_filter.size());
     for (const auto index : util::irange<std::size_t>(0, metric.edge_filter.size()))
@@ -37,6 +39,8 @@ void read(storage::tar::FileReader &reader,
           detail::ContractedMetric<Ownership> &metric)
 {
     util::serialization::read(reader, name + "/contracted_graph", metric.graph);
+    storage::serialization::read(reader, name + "/durations", metric.durations);
+    storage::serialization::read(reader, name + "/distances", metric.distances);
 
     metric.edge_filter.resize(reader.ReadElementCount64(name + "/exclude"));
     for (const auto index : util::irange<std::size_t>(0, metric.edge_filter.size()))
@@ -1541,6 +1541,10 @@ struct TableT : public flatbuffers::NativeTable {
   std::vector<float> distances;
   std::vector<std::unique_ptr<osrm::engine::api::fbresult::WaypointT>> destinations;
   std::vector<uint32_t> fallback_speed_cells;
+  std::vector<int32_t> durations_ds;
+  std::vector<int32_t> distances_m;
+  std::vector<uint16_t> durations_s;
+  std::vector<uint16_t> distances_dam;
   TableT()
       : rows(0),
         cols(0) {
@@ -1555,7 +1559,11 @@ struct Table FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
     VT_COLS = 8,
     VT_DISTANCES = 10,
     VT_DESTINATIONS = 12,
-    VT_FALLBACK_SPEED_CELLS = 14
+    VT_FALLBACK_SPEED_CELLS = 14,
+    VT_DURATIONS_DS = 16,
+    VT_DISTANCES_M = 18,
+    VT_DURATIONS_S = 20,
+    VT_DISTANCES_DAM = 22
   };
   const flatbuffers::Vector<float> *durations() const {
     return GetPointer<const flatbuffers::Vector<float> *>(VT_DURATIONS);
@@ -1575,6 +1583,18 @@ struct Table FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   const flatbuffers::Vector<uint32_t> *fallback_speed_cells() const {
     return GetPointer<const flatbuffers::Vector<uint32_t> *>(VT_FALLBACK_SPEED_CELLS);
   }
+  const flatbuffers::Vector<int32_t> *durations_ds() const {
+    return GetPointer<const flatbuffers::Vector<int32_t> *>(VT_DURATIONS_DS);
+  }
+  const flatbuffers::Vector<int32_t> *distances_m() const {
+    return GetPointer<const flatbuffers::Vector<int32_t> *>(VT_DISTANCES_M);
+  }
+  const flatbuffers::Vector<uint16_t> *durations_s() const {
+    return GetPointer<const flatbuffers::Vector<uint16_t> *>(VT_DURATIONS_S);
+  }
+  const flatbuffers::Vector<uint16_t> *distances_dam() const {
+    return GetPointer<const flatbuffers::Vector<uint16_t> *>(VT_DISTANCES_DAM);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyOffset(verifier, VT_DURATIONS) &&
@@ -1588,6 +1608,14 @@ struct Table FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            verifier.VerifyVectorOfTables(destinations()) &&
            VerifyOffset(verifier, VT_FALLBACK_SPEED_CELLS) &&
            verifier.VerifyVector(fallback_speed_cells()) &&
+           VerifyOffset(verifier, VT_DURATIONS_DS) &&
+           verifier.VerifyVector(durations_ds()) &&
+           VerifyOffset(verifier, VT_DISTANCES_M) &&
+           verifier.VerifyVector(distances_m()) &&
+           VerifyOffset(verifier, VT_DURATIONS_S) &&
+           verifier.VerifyVector(durations_s()) &&
+           VerifyOffset(verifier, VT_DISTANCES_DAM) &&
+           verifier.VerifyVector(distances_dam()) &&
            verifier.EndTable();
   }
   TableT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
@@ -1616,6 +1644,18 @@ struct TableBuilder {
   void add_fallback_speed_cells(flatbuffers::Offset<flatbuffers::Vector<uint32_t>> fallback_speed_cells) {
     fbb_.AddOffset(Table::VT_FALLBACK_SPEED_CELLS, fallback_speed_cells);
   }
+  void add_durations_ds(flatbuffers::Offset<flatbuffers::Vector<int32_t>> durations_ds) {
+    fbb_.AddOffset(Table::VT_DURATIONS_DS, durations_ds);
+  }
+  void add_distances_m(flatbuffers::Offset<flatbuffers::Vector<int32_t>> distances_m) {
+    fbb_.AddOffset(Table::VT_DISTANCES_M, distances_m);
+  }
+  void add_durations_s(flatbuffers::Offset<flatbuffers::Vector<uint16_t>> durations_s) {
+    fbb_.AddOffset(Table::VT_DURATIONS_S, durations_s);
+  }
+  void add_distances_dam(flatbuffers::Offset<flatbuffers::Vector<uint16_t>> distances_dam) {
+    fbb_.AddOffset(Table::VT_DISTANCES_DAM, distances_dam);
+  }
   explicit TableBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -1635,8 +1675,16 @@ inline flatbuffers::Offset<Table> CreateTable(
     uint16_t cols = 0,
     flatbuffers::Offset<flatbuffers::Vector<float>> distances = 0,
     flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<osrm::engine::api::fbresult::Waypoint>>> destinations = 0,
-    flatbuffers::Offset<flatbuffers::Vector<uint32_t>> fallback_speed_cells = 0) {
+    flatbuffers::Offset<flatbuffers::Vector<uint32_t>> fallback_speed_cells = 0,
+    flatbuffers::Offset<flatbuffers::Vector<int32_t>> durations_ds = 0,
+    flatbuffers::Offset<flatbuffers::Vector<int32_t>> distances_m = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint16_t>> durations_s = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint16_t>> distances_dam = 0) {
   TableBuilder builder_(_fbb);
+  builder_.add_distances_dam(distances_dam);
+  builder_.add_durations_s(durations_s);
+  builder_.add_distances_m(distances_m);
+  builder_.add_durations_ds(durations_ds);
   builder_.add_fallback_speed_cells(fallback_speed_cells);
   builder_.add_destinations(destinations);
   builder_.add_distances(distances);
@@ -1653,11 +1701,19 @@ inline flatbuffers::Offset<Table> CreateTableDirect(
     uint16_t cols = 0,
     const std::vector<float> *distances = nullptr,
     const std::vector<flatbuffers::Offset<osrm::engine::api::fbresult::Waypoint>> *destinations = nullptr,
-    const std::vector<uint32_t> *fallback_speed_cells = nullptr) {
+    const std::vector<uint32_t> *fallback_speed_cells = nullptr,
+    const std::vector<int32_t> *durations_ds = nullptr,
+    const std::vector<int32_t> *distances_m = nullptr,
+    const std::vector<uint16_t> *durations_s = nullptr,
+    const std::vector<uint16_t> *distances_dam = nullptr) {
   auto durations__ = durations ? _fbb.CreateVector<float>(*durations) : 0;
   auto distances__ = distances ? _fbb.CreateVector<float>(*distances) : 0;
   auto destinations__ = destinations ? _fbb.CreateVector<flatbuffers::Offset<osrm::engine::api::fbresult::Waypoint>>(*destinations) : 0;
   auto fallback_speed_cells__ = fallback_speed_cells ? _fbb.CreateVector<uint32_t>(*fallback_speed_cells) : 0;
+  auto durations_ds__ = durations_ds ? _fbb.CreateVector<int32_t>(*durations_ds) : 0;
+  auto distances_m__ = distances_m ? _fbb.CreateVector<int32_t>(*distances_m) : 0;
+  auto durations_s__ = durations_s ? _fbb.CreateVector<uint16_t>(*durations_s) : 0;
+  auto distances_dam__ = distances_dam ? _fbb.CreateVector<uint16_t>(*distances_dam) : 0;
   return osrm::engine::api::fbresult::CreateTable(
       _fbb,
       durations__,
@@ -1665,7 +1721,11 @@ inline flatbuffers::Offset<Table> CreateTableDirect(
       cols,
       distances__,
       destinations__,
-      fallback_speed_cells__);
+      fallback_speed_cells__,
+      durations_ds__,
+      distances_m__,
+      durations_s__,
+      distances_dam__);
 }
 
 flatbuffers::Offset<Table> CreateTable(flatbuffers::FlatBufferBuilder &_fbb, const TableT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
@@ -2293,6 +2353,10 @@ inline void Table::UnPackTo(TableT *_o, const flatbuffers::resolver_function_t *
   { auto _e = distances(); if (_e) { _o->distances.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->distances[_i] = _e->Get(_i); } } };
   { auto _e = destinations(); if (_e) { _o->destinations.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->destinations[_i] = std::unique_ptr<osrm::engine::api::fbresult::WaypointT>(_e->Get(_i)->UnPack(_resolver)); } } };
   { auto _e = fallback_speed_cells(); if (_e) { _o->fallback_speed_cells.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->fallback_speed_cells[_i] = _e->Get(_i); } } };
+  { auto _e = durations_ds(); if (_e) { _o->durations_ds.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->durations_ds[_i] = _e->Get(_i); } } };
+  { auto _e = distances_m(); if (_e) { _o->distances_m.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->distances_m[_i] = _e->Get(_i); } } };
+  { auto _e = durations_s(); if (_e) { _o->durations_s.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->durations_s[_i] = _e->Get(_i); } } };
+  { auto _e = distances_dam(); if (_e) { _o->distances_dam.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->distances_dam[_i] = _e->Get(_i); } } };
 }
 
 inline flatbuffers::Offset<Table> Table::Pack(flatbuffers::FlatBufferBuilder &_fbb, const TableT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
@@ -2309,6 +2373,10 @@ inline flatbuffers::Offset<Table> CreateTable(flatbuffers::FlatBufferBuilder &_f
   auto _distances = _o->distances.size() ? _fbb.CreateVector(_o->distances) : 0;
   auto _destinations = _o->destinations.size() ? _fbb.CreateVector<flatbuffers::Offset<osrm::engine::api::fbresult::Waypoint>> (_o->destinations.size(), [](size_t i, _VectorArgs *__va) { return CreateWaypoint(*__va->__fbb, __va->__o->destinations[i].get(), __va->__rehasher); }, &_va ) : 0;
   auto _fallback_speed_cells = _o->fallback_speed_cells.size() ? _fbb.CreateVector(_o->fallback_speed_cells) : 0;
+  auto _durations_ds = _o->durations_ds.size() ? _fbb.CreateVector(_o->durations_ds) : 0;
+  auto _distances_m = _o->distances_m.size() ? _fbb.CreateVector(_o->distances_m) : 0;
+  auto _durations_s = _o->durations_s.size() ? _fbb.CreateVector(_o->durations_s) : 0;
+  auto _distances_dam = _o->distances_dam.size() ? _fbb.CreateVector(_o->distances_dam) : 0;
   return osrm::engine::api::fbresult::CreateTable(
       _fbb,
       _durations,
@@ -2316,7 +2384,11 @@ inline flatbuffers::Offset<Table> CreateTable(flatbuffers::FlatBufferBuilder &_f
       _cols,
       _distances,
       _destinations,
-      _fallback_speed_cells);
+      _fallback_speed_cells,
+      _durations_ds,
+      _distances_m,
+      _durations_s,
+      _distances_dam);
 }
 
 inline ErrorT *Error::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
@@ -30,6 +30,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "engine/api/route_parameters.hpp"
 
+#include <string>
 #include <vector>
 
 namespace osrm
@@ -44,6 +45,9 @@ namespace api
  *
  * Holds member attributes:
  *  - timestamps: timestamp(s) for the corresponding input coordinate(s)
+ *  - session: appends the coordinates to an online matching session with this id instead of
+ *    matching them on their own, only the parts of the trace that became final are returned
+ *  - end_session: returns the remaining matching of the session and removes it
  *
  * \see OSRM, Coordinate, Hint, Bearing, RouteParame, RouteParameters, TableParameters,
  *      NearestParameters, TripParameters, MatchParameters and TileParameters
@@ -63,7 +67,7 @@ struct MatchParameters : public RouteParameters
                           RouteParameters::GeometriesType::Polyline,
                           RouteParameters::OverviewType::Simplified,
                           {}),
-          gaps(GapsType::Split), tidy(false)
+          gaps(GapsType::Split), tidy(false), end_session(false)
     {
     }
 
@@ -80,18 +84,25 @@ struct MatchParameters : public RouteParameters
                     std::vector<std::size_t> waypoints_,
                     Args... args_)
         : RouteParameters{std::forward<Args>(args_)..., waypoints_},
-          timestamps{std::move(timestamps_)}, gaps(gaps_), tidy(tidy_)
+          timestamps{std::move(timestamps_)}, gaps(gaps_), tidy(tidy_), end_session(false)
     {
     }
 
     std::vector<unsigned> timestamps;
     GapsType gaps;
     bool tidy;
+    std::string session;
+    bool end_session;
 
     bool IsValid() const
     {
-        return RouteParameters::IsValid() &&
-               (timestamps.empty() || timestamps.size() == coordinates.size());
+        // sessions can be continued with a single coordinate
+        const auto route_parameters_ok =
+            RouteParameters::IsValid() ||
+            (!session.empty() && coordinates.size() == 1 && BaseParameters::IsValid());
+        return route_parameters_ok &&
+               (timestamps.empty() || timestamps.size() == coordinates.size()) &&
+               (!end_session || !session.empty());
     }
 };
 }
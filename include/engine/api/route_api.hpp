@@ -27,7 +27,12 @@
 #include "util/integer_range.hpp"
 #include "util/json_util.hpp"
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include <iterator>
+#include <numeric>
+#include <tuple>
 #include <vector>
 
 namespace osrm
@@ -37,6 +42,11 @@ namespace engine
 namespace api
 {
 
+// Smallest number of path segments of a route for which its legs are assembled in parallel.
+// Assembling a leg costs about 0.6us per segment, below this the dispatch to the TBB workers
+// costs more than running the legs one after another.
+const constexpr std::size_t PARALLEL_LEGS_MIN_PATH_SIZE = 1000;
+
 class RouteAPI : public BaseAPI
 {
   public:
@@ -123,6 +133,107 @@ class RouteAPI : public BaseAPI
         }
     }
 
+    void MakeResponse(const InternalRouteSummary &summary,
+                      const std::vector<PhantomNodes> &all_start_end_points,
+                      osrm::engine::api::ResultT &response) const
+    {
+        BOOST_ASSERT(summary.is_valid());
+
+        if (response.is<flatbuffers::FlatBufferBuilder>())
+        {
+            auto &fb_result = response.get<flatbuffers::FlatBufferBuilder>();
+            MakeResponse(summary, all_start_end_points, fb_result);
+        }
+        else
+        {
+            auto &json_result = response.get<util::json::Object>();
+            MakeResponse(summary, all_start_end_points, json_result);
+        }
+    }
+
+    // Responses for eta_only requests: routes and legs only have duration, distance and weight
+    void MakeResponse(const InternalRouteSummary &summary,
+                      const std::vector<PhantomNodes> &all_start_end_points,
+                      flatbuffers::FlatBufferBuilder &fb_result) const
+    {
+        auto data_timestamp = facade.GetTimestamp();
+        flatbuffers::Offset<flatbuffers::String> data_version_string;
+        if (!data_timestamp.empty())
+        {
+            data_version_string = fb_result.CreateString(data_timestamp);
+        }
+
+        auto legs = MakeLegs(summary);
+        auto route = guidance::assembleRoute(legs);
+
+        const std::vector<flatbuffers::Offset<fbresult::Step>> no_steps;
+        std::vector<flatbuffers::Offset<fbresult::Leg>> routeLegs;
+        routeLegs.reserve(legs.size());
+        for (const auto &leg : legs)
+        {
+            auto steps_vector = fb_result.CreateVector(no_steps);
+            fbresult::LegBuilder legBuilder(fb_result);
+            legBuilder.add_distance(leg.distance);
+            legBuilder.add_duration(leg.duration);
+            legBuilder.add_weight(leg.weight);
+            legBuilder.add_steps(steps_vector);
+            routeLegs.emplace_back(legBuilder.Finish());
+        }
+        auto legs_vector = fb_result.CreateVector(routeLegs);
+        auto weight_name_string = fb_result.CreateString(facade.GetWeightName());
+
+        fbresult::RouteObjectBuilder routeObject(fb_result);
+        routeObject.add_distance(route.distance);
+        routeObject.add_duration(route.duration);
+        routeObject.add_weight(route.weight);
+        routeObject.add_weight_name(weight_name_string);
+        routeObject.add_legs(legs_vector);
+        auto routes_vector = fb_result.CreateVector(
+            std::vector<flatbuffers::Offset<fbresult::RouteObject>>{routeObject.Finish()});
+
+        flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<fbresult::Waypoint>>>
+            waypoints_vector;
+        if (!parameters.skip_waypoints)
+        {
+            waypoints_vector = BaseAPI::MakeWaypoints(&fb_result, all_start_end_points);
+        }
+
+        fbresult::FBResultBuilder response(fb_result);
+        response.add_routes(routes_vector);
+        response.add_waypoints(waypoints_vector);
+        if (!data_timestamp.empty())
+        {
+            response.add_data_version(data_version_string);
+        }
+        fb_result.Finish(response.Finish());
+    }
+
+    void MakeResponse(const InternalRouteSummary &summary,
+                      const std::vector<PhantomNodes> &all_start_end_points,
+                      util::json::Object &response) const
+    {
+        auto legs = MakeLegs(summary);
+        auto route = guidance::assembleRoute(legs);
+
+        util::json::Array jsRoutes;
+        jsRoutes.values.push_back(json::makeRoute(route,
+                                                  json::makeRouteLegs(std::move(legs), {}, {}),
+                                                  boost::none,
+                                                  facade.GetWeightName()));
+
+        if (!parameters.skip_waypoints)
+        {
+            response.values["waypoints"] = BaseAPI::MakeWaypoints(all_start_end_points);
+        }
+        response.values["routes"] = std::move(jsRoutes);
+        response.values["code"] = "Ok";
+        auto data_timestamp = facade.GetTimestamp();
+        if (!data_timestamp.empty())
+        {
+            response.values["data_version"] = data_timestamp;
+        }
+    }
+
   protected:
     template <typename GetWptsFn>
     std::unique_ptr<fbresult::FBResultBuilder>
@@ -866,6 +977,22 @@ class RouteAPI : public BaseAPI
 
     const RouteParameters &parameters;
 
+    std::vector<guidance::RouteLeg> MakeLegs(const InternalRouteSummary &summary) const
+    {
+        std::vector<guidance::RouteLeg> legs;
+        legs.reserve(summary.legs.size());
+        for (const auto &leg : summary.legs)
+        {
+            // same units as guidance::assembleLeg
+            legs.push_back(guidance::RouteLeg{std::round(leg.distance * 10.) / 10.,
+                                              leg.duration / 10.,
+                                              leg.weight / facade.GetWeightMultiplier(),
+                                              {},
+                                              {}});
+        }
+        return legs;
+    }
+
     std::pair<std::vector<guidance::RouteLeg>, std::vector<guidance::LegGeometry>>
     MakeLegs(const std::vector<PhantomNodes> &segment_end_coordinates,
              const std::vector<std::vector<PathData>> &unpacked_path_segments,
@@ -877,100 +1004,127 @@ class RouteAPI : public BaseAPI
         auto &legs = result.first;
         auto &leg_geometries = result.second;
         auto number_of_legs = segment_end_coordinates.size();
-        legs.reserve(number_of_legs);
-        leg_geometries.reserve(number_of_legs);
-
-        for (auto idx : util::irange<std::size_t>(0UL, number_of_legs))
-        {
-            const auto &phantoms = segment_end_coordinates[idx];
-            const auto &path_data = unpacked_path_segments[idx];
-
-            const bool reversed_source = source_traversed_in_reverse[idx];
-            const bool reversed_target = target_traversed_in_reverse[idx];
-
-            auto leg_geometry = guidance::assembleGeometry(BaseAPI::facade,
-                                                           path_data,
-                                                           phantoms.source_phantom,
-                                                           phantoms.target_phantom,
-                                                           reversed_source,
-                                                           reversed_target);
-            auto leg = guidance::assembleLeg(facade,
-                                             path_data,
-                                             leg_geometry,
-                                             phantoms.source_phantom,
-                                             phantoms.target_phantom,
-                                             reversed_target,
-                                             parameters.steps);
-
-            util::Log(logDEBUG) << "Assembling steps " << std::endl;
-            if (parameters.steps)
-            {
-                auto steps = guidance::assembleSteps(BaseAPI::facade,
-                                                     path_data,
-                                                     leg_geometry,
-                                                     phantoms.source_phantom,
-                                                     phantoms.target_phantom,
-                                                     reversed_source,
-                                                     reversed_target);
-
-                // Apply maneuver overrides before any other post
-                // processing is performed
-                guidance::applyOverrides(BaseAPI::facade, steps, leg_geometry);
-
-                // Collapse segregated steps before others
-                steps = guidance::collapseSegregatedTurnInstructions(std::move(steps));
-
-                /* Perform step-based post-processing.
-                 *
-                 * Using post-processing on basis of route-steps for a single leg at a time
-                 * comes at the cost that we cannot count the correct exit for roundabouts.
-                 * We can only emit the exit nr/intersections up to/starting at a part of the leg.
-                 * If a roundabout is not terminated in a leg, we will end up with a
-                 *enter-roundabout
-                 * and exit-roundabout-nr where the exit nr is out of sync with the previous enter.
-                 *
-                 *         | S |
-                 *         *   *
-                 *  ----*        * ----
-                 *                  T
-                 *  ----*        * ----
-                 *       V *   *
-                 *         |   |
-                 *         |   |
-                 *
-                 * Coming from S via V to T, we end up with the legs S->V and V->T. V-T will say to
-                 *take
-                 * the second exit, even though counting from S it would be the third.
-                 * For S, we only emit `roundabout` without an exit number, showing that we enter a
-                 *roundabout
-                 * to find a via point.
-                 * The same exit will be emitted, though, if we should start routing at S, making
-                 * the overall response consistent.
-                 *
-                 * ⚠ CAUTION: order of post-processing steps is important
-                 *    - handleRoundabouts must be called before collapseTurnInstructions that
-                 *      expects post-processed roundabouts
-                 */
-
-                guidance::trimShortSegments(steps, leg_geometry);
-                leg.steps = guidance::handleRoundabouts(std::move(steps));
-                leg.steps = guidance::collapseTurnInstructions(std::move(leg.steps));
-                leg.steps = guidance::anticipateLaneChange(std::move(leg.steps));
-                leg.steps = guidance::buildIntersections(std::move(leg.steps));
-                leg.steps = guidance::suppressShortNameSegments(std::move(leg.steps));
-                leg.steps = guidance::assignRelativeLocations(std::move(leg.steps),
-                                                              leg_geometry,
-                                                              phantoms.source_phantom,
-                                                              phantoms.target_phantom);
-                leg_geometry = guidance::resyncGeometry(std::move(leg_geometry), leg.steps);
-            }
+        legs.resize(number_of_legs);
+        leg_geometries.resize(number_of_legs);
+
+        // the legs are assembled and post-processed independently of each other
+        const auto make_leg = [&](const std::size_t idx) {
+            std::tie(legs[idx], leg_geometries[idx]) =
+                MakeLeg(segment_end_coordinates[idx],
+                        unpacked_path_segments[idx],
+                        source_traversed_in_reverse[idx],
+                        target_traversed_in_reverse[idx]);
+        };
 
-            leg_geometries.push_back(std::move(leg_geometry));
-            legs.push_back(std::move(leg));
+        const auto path_size = std::accumulate(unpacked_path_segments.begin(),
+                                               unpacked_path_segments.end(),
+                                               std::size_t{0},
+                                               [](const std::size_t sum, const auto &segments) {
+                                                   return sum + segments.size();
+                                               });
+
+        if (number_of_legs > 1 && path_size >= PARALLEL_LEGS_MIN_PATH_SIZE)
+        {
+            tbb::parallel_for(tbb::blocked_range<std::size_t>(0, number_of_legs, 1),
+                              [&](const tbb::blocked_range<std::size_t> &range) {
+                                  for (auto idx = range.begin(); idx < range.end(); ++idx)
+                                      make_leg(idx);
+                              });
+        }
+        else
+        {
+            for (const auto idx : util::irange<std::size_t>(0UL, number_of_legs))
+                make_leg(idx);
         }
         return result;
     }
 
+    std::pair<guidance::RouteLeg, guidance::LegGeometry>
+    MakeLeg(const PhantomNodes &phantoms,
+            const std::vector<PathData> &path_data,
+            const bool reversed_source,
+            const bool reversed_target) const
+    {
+        auto leg_geometry = guidance::assembleGeometry(BaseAPI::facade,
+                                                       path_data,
+                                                       phantoms.source_phantom,
+                                                       phantoms.target_phantom,
+                                                       reversed_source,
+                                                       reversed_target);
+        auto leg = guidance::assembleLeg(facade,
+                                         path_data,
+                                         leg_geometry,
+                                         phantoms.source_phantom,
+                                         phantoms.target_phantom,
+                                         reversed_target,
+                                         parameters.steps);
+
+        util::Log(logDEBUG) << "Assembling steps " << std::endl;
+        if (parameters.steps)
+        {
+            auto steps = guidance::assembleSteps(BaseAPI::facade,
+                                                 path_data,
+                                                 leg_geometry,
+                                                 phantoms.source_phantom,
+                                                 phantoms.target_phantom,
+                                                 reversed_source,
+                                                 reversed_target);
+
+            // Apply maneuver overrides before any other post
+            // processing is performed
+            guidance::applyOverrides(BaseAPI::facade, steps, leg_geometry);
+
+            // Collapse segregated steps before others
+            steps = guidance::collapseSegregatedTurnInstructions(std::move(steps));
+
+            /* Perform step-based post-processing.
+             *
+             * Using post-processing on basis of route-steps for a single leg at a time
+             * comes at the cost that we cannot count the correct exit for roundabouts.
+             * We can only emit the exit nr/intersections up to/starting at a part of the leg.
+             * If a roundabout is not terminated in a leg, we will end up with a
+             *enter-roundabout
+             * and exit-roundabout-nr where the exit nr is out of sync with the previous enter.
+             *
+             *         | S |
+             *         *   *
+             *  ----*        * ----
+             *                  T
+             *  ----*        * ----
+             *       V *   *
+             *         |   |
+             *         |   |
+             *
+             * Coming from S via V to T, we end up with the legs S->V and V->T. V-T will say to
+             *take
+             * the second exit, even though counting from S it would be the third.
+             * For S, we only emit `roundabout` without an exit number, showing that we enter a
+             *roundabout
+             * to find a via point.
+             * The same exit will be emitted, though, if we should start routing at S, making
+             * the overall response consistent.
+             *
+             * ⚠ CAUTION: order of post-processing steps is important
+             *    - handleRoundabouts must be called before collapseTurnInstructions that
+             *      expects post-processed roundabouts
+             */
+
+            guidance::trimShortSegments(steps, leg_geometry);
+            leg.steps = guidance::handleRoundabouts(std::move(steps));
+            leg.steps = guidance::collapseTurnInstructions(std::move(leg.steps));
+            leg.steps = guidance::anticipateLaneChange(std::move(leg.steps));
+            leg.steps = guidance::buildIntersections(std::move(leg.steps));
+            leg.steps = guidance::suppressShortNameSegments(std::move(leg.steps));
+            leg.steps = guidance::assignRelativeLocations(std::move(leg.steps),
+                                                          leg_geometry,
+                                                          phantoms.source_phantom,
+                                                          phantoms.target_phantom);
+            leg_geometry = guidance::resyncGeometry(std::move(leg_geometry), leg.steps);
+        }
+
+        return std::make_pair(std::move(leg), std::move(leg_geometry));
+    }
+
     boost::optional<std::vector<Coordinate>>
     MakeOverview(const std::vector<guidance::LegGeometry> &leg_geometries) const
     {
@@ -49,6 +49,8 @@ namespace api
  *  - overview: adds overview geometry either Full, Simplified (according to highest zoom level) or
  *              False (not at all)
  *  - continue_straight: enable or disable continue_straight (disabled by default)
+ *  - eta_only: only compute duration, distance and weight of the route and its legs, without
+ *              geometry, steps or annotations
  *
  * \see OSRM, Coordinate, Hint, Bearing, RouteParame, RouteParameters, TableParameters,
  *      NearestParameters, TripParameters, MatchParameters and TileParameters
@@ -184,6 +186,7 @@ struct RouteParameters : public BaseParameters
     OverviewType overview = OverviewType::Simplified;
     boost::optional<bool> continue_straight;
     std::vector<std::size_t> waypoints;
+    bool eta_only = false;
 
     bool IsValid() const
     {
@@ -193,7 +196,11 @@ struct RouteParameters : public BaseParameters
             std::all_of(waypoints.begin(), waypoints.end(), [this](const auto &w) {
                 return w < coordinates.size();
             });
-        return coordinates_ok && base_params_ok && valid_waypoints;
+        // routes without a path have nothing to compute steps, annotations or alternatives on
+        const auto valid_eta_only =
+            !eta_only || (!steps && !annotations && annotations_type == AnnotationsType::None &&
+                          !alternatives && number_of_alternatives == 0);
+        return coordinates_ok && base_params_ok && valid_waypoints && valid_eta_only;
     }
 };
 
@@ -20,7 +20,11 @@
 
 #include <boost/range/algorithm/transform.hpp>
 
+#include <cmath>
+#include <cstdint>
 #include <iterator>
+#include <limits>
+#include <type_traits>
 
 namespace osrm
 {
@@ -41,6 +45,13 @@ class TableAPI final : public BaseAPI
         std::size_t column;
     };
 
+    // Cells without a route have the largest value of the type in integer encoded tables.
+    // Larger durations and distances are clamped to the value below.
+    template <typename T> static constexpr T UnreachableCell()
+    {
+        return std::numeric_limits<T>::max();
+    }
+
     TableAPI(const datafacade::BaseDataFacade &facade_, const TableParameters &parameters_)
         : BaseAPI(facade_, parameters_), parameters(parameters_)
     {
@@ -116,18 +127,46 @@ class TableAPI final : public BaseAPI
             }
         }
 
+        const auto encoding = parameters.encoding;
+
         bool use_durations = parameters.annotations & TableParameters::AnnotationsType::Duration;
         flatbuffers::Offset<flatbuffers::Vector<float>> durations;
+        flatbuffers::Offset<flatbuffers::Vector<std::int32_t>> durations_ds;
+        flatbuffers::Offset<flatbuffers::Vector<std::uint16_t>> durations_s;
         if (use_durations)
         {
-            durations = MakeDurationTable(fb_result, tables.first);
+            switch (encoding)
+            {
+            case TableParameters::EncodingType::Float:
+                durations = MakeDurationTable(fb_result, tables.first);
+                break;
+            case TableParameters::EncodingType::Int32:
+                durations_ds = MakeIntegerDurationTable(fb_result, tables.first);
+                break;
+            case TableParameters::EncodingType::UInt16:
+                durations_s = MakeShortDurationTable(fb_result, tables.first);
+                break;
+            }
         }
 
         bool use_distances = parameters.annotations & TableParameters::AnnotationsType::Distance;
         flatbuffers::Offset<flatbuffers::Vector<float>> distances;
+        flatbuffers::Offset<flatbuffers::Vector<std::int32_t>> distances_m;
+        flatbuffers::Offset<flatbuffers::Vector<std::uint16_t>> distances_dam;
         if (use_distances)
         {
-            distances = MakeDistanceTable(fb_result, tables.second);
+            switch (encoding)
+            {
+            case TableParameters::EncodingType::Float:
+                distances = MakeDistanceTable(fb_result, tables.second);
+                break;
+            case TableParameters::EncodingType::Int32:
+                distances_m = MakeIntegerDistanceTable(fb_result, tables.second);
+                break;
+            case TableParameters::EncodingType::UInt16:
+                distances_dam = MakeShortDistanceTable(fb_result, tables.second);
+                break;
+            }
         }
 
         bool have_speed_cells =
@@ -142,14 +181,13 @@ class TableAPI final : public BaseAPI
         table.add_destinations(destinations);
         table.add_rows(number_of_sources);
         table.add_cols(number_of_destinations);
-        if (use_durations)
-        {
-            table.add_durations(durations);
-        }
-        if (use_distances)
-        {
-            table.add_distances(distances);
-        }
+        // only the vectors of the requested encoding are set
+        table.add_durations(durations);
+        table.add_durations_ds(durations_ds);
+        table.add_durations_s(durations_s);
+        table.add_distances(distances);
+        table.add_distances_m(distances_m);
+        table.add_distances_dam(distances_dam);
         if (have_speed_cells)
         {
             table.add_fallback_speed_cells(speed_cells);
@@ -264,34 +302,100 @@ class TableAPI final : public BaseAPI
     MakeDurationTable(flatbuffers::FlatBufferBuilder &builder,
                       const std::vector<EdgeWeight> &values) const
     {
-        std::vector<float> distance_table;
-        distance_table.resize(values.size());
+        float *duration_table;
+        const auto offset = builder.CreateUninitializedVector(values.size(), &duration_table);
         std::transform(
-            values.begin(), values.end(), distance_table.begin(), [](const EdgeWeight duration) {
+            values.begin(), values.end(), duration_table, [](const EdgeWeight duration) {
                 if (duration == MAXIMAL_EDGE_DURATION)
                 {
                     return 0.;
                 }
                 return duration / 10.;
             });
-        return builder.CreateVector(distance_table);
+        return offset;
     }
 
     virtual flatbuffers::Offset<flatbuffers::Vector<float>>
     MakeDistanceTable(flatbuffers::FlatBufferBuilder &builder,
                       const std::vector<EdgeDistance> &values) const
     {
-        std::vector<float> duration_table;
-        duration_table.resize(values.size());
+        float *distance_table;
+        const auto offset = builder.CreateUninitializedVector(values.size(), &distance_table);
         std::transform(
-            values.begin(), values.end(), duration_table.begin(), [](const EdgeDistance distance) {
+            values.begin(), values.end(), distance_table, [](const EdgeDistance distance) {
                 if (distance == INVALID_EDGE_DISTANCE)
                 {
                     return 0.;
                 }
                 return std::round(distance * 10) / 10.;
             });
-        return builder.CreateVector(duration_table);
+        return offset;
+    }
+
+    // Durations are stored in deciseconds already, so they are copied into the buffer as they are.
+    // MAXIMAL_EDGE_DURATION of unreachable cells is the same as UnreachableCell<std::int32_t>().
+    virtual flatbuffers::Offset<flatbuffers::Vector<std::int32_t>>
+    MakeIntegerDurationTable(flatbuffers::FlatBufferBuilder &builder,
+                             const std::vector<EdgeDuration> &values) const
+    {
+        static_assert(std::is_same<EdgeDuration, std::int32_t>::value,
+                      "durations have to be copied without conversion");
+        BOOST_ASSERT(MAXIMAL_EDGE_DURATION == UnreachableCell<std::int32_t>());
+        return builder.CreateVector(values);
+    }
+
+    // Distances rounded to meters
+    virtual flatbuffers::Offset<flatbuffers::Vector<std::int32_t>>
+    MakeIntegerDistanceTable(flatbuffers::FlatBufferBuilder &builder,
+                             const std::vector<EdgeDistance> &values) const
+    {
+        std::int32_t *distance_table;
+        const auto offset = builder.CreateUninitializedVector(values.size(), &distance_table);
+        std::transform(
+            values.begin(), values.end(), distance_table, [](const EdgeDistance distance) {
+                if (distance == INVALID_EDGE_DISTANCE)
+                {
+                    return UnreachableCell<std::int32_t>();
+                }
+                return ClampCell<std::int32_t>(std::round(distance));
+            });
+        return offset;
+    }
+
+    // Durations rounded to seconds
+    virtual flatbuffers::Offset<flatbuffers::Vector<std::uint16_t>>
+    MakeShortDurationTable(flatbuffers::FlatBufferBuilder &builder,
+                           const std::vector<EdgeDuration> &values) const
+    {
+        std::uint16_t *duration_table;
+        const auto offset = builder.CreateUninitializedVector(values.size(), &duration_table);
+        std::transform(
+            values.begin(), values.end(), duration_table, [](const EdgeDuration duration) {
+                if (duration == MAXIMAL_EDGE_DURATION)
+                {
+                    return UnreachableCell<std::uint16_t>();
+                }
+                return ClampCell<std::uint16_t>(std::round(duration / 10.));
+            });
+        return offset;
+    }
+
+    // Distances rounded to decameters
+    virtual flatbuffers::Offset<flatbuffers::Vector<std::uint16_t>>
+    MakeShortDistanceTable(flatbuffers::FlatBufferBuilder &builder,
+                           const std::vector<EdgeDistance> &values) const
+    {
+        std::uint16_t *distance_table;
+        const auto offset = builder.CreateUninitializedVector(values.size(), &distance_table);
+        std::transform(
+            values.begin(), values.end(), distance_table, [](const EdgeDistance distance) {
+                if (distance == INVALID_EDGE_DISTANCE)
+                {
+                    return UnreachableCell<std::uint16_t>();
+                }
+                return ClampCell<std::uint16_t>(std::round(distance / 10.));
+            });
+        return offset;
     }
 
     virtual flatbuffers::Offset<flatbuffers::Vector<uint32_t>>
@@ -405,6 +509,12 @@ class TableAPI final : public BaseAPI
     }
 
     const TableParameters &parameters;
+
+  private:
+    template <typename T> static T ClampCell(const double value)
+    {
+        return static_cast<T>(std::min<double>(std::max(value, 0.), UnreachableCell<T>() - 1));
+    }
 };
 
 } // ns api
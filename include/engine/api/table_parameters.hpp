@@ -51,6 +51,9 @@ namespace api
  *             use all coordinates as sources
  *  - destinations: indices into coordinates indicating destinations for the Table service, no
  *                  destinations means use all coordinates as destinations
+ *  - encoding: number type of the flatbuffers tables, int32 tables hold durations in deciseconds
+ *              and distances in meters, uint16 tables durations in seconds and distances in
+ *              decameters
  *
  * \see OSRM, Coordinate, Hint, Bearing, RouteParame, RouteParameters, TableParameters,
  *      NearestParameters, TripParameters, MatchParameters and TileParameters
@@ -81,6 +84,15 @@ struct TableParameters : public BaseParameters
 
     double scale_factor = 1;
 
+    enum class EncodingType
+    {
+        Float = 0,
+        Int32 = 1,
+        UInt16 = 2
+    };
+
+    EncodingType encoding = EncodingType::Float;
+
     TableParameters() = default;
     template <typename... Args>
     TableParameters(std::vector<std::size_t> sources_,
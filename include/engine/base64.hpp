@@ -1,19 +1,17 @@
 #ifndef OSRM_BASE64_HPP
 #define OSRM_BASE64_HPP
 
+#include <algorithm>
 #include <iterator>
+#include <limits>
 #include <string>
 #include <type_traits>
-#include <vector>
 
 #include <climits>
 #include <cstddef>
+#include <cstdint>
 
-#include <boost/algorithm/string/trim.hpp>
-#include <boost/archive/iterators/base64_from_binary.hpp>
-#include <boost/archive/iterators/binary_from_base64.hpp>
-#include <boost/archive/iterators/transform_width.hpp>
-#include <boost/range/algorithm/copy.hpp>
+#include <boost/assert.hpp>
 
 namespace osrm
 {
@@ -27,44 +25,99 @@ namespace detail
 static_assert(CHAR_BIT == 8u, "we assume a byte holds 8 bits");
 static_assert(sizeof(char) == 1u, "we assume a char is one byte large");
 
-using Base64FromBinary = boost::archive::iterators::base64_from_binary<
-    boost::archive::iterators::transform_width<const char *, // sequence of chars
-                                               6,            // get view of 6 bit
-                                               8             // from sequence of 8 bit
-                                               >>;
-
-using BinaryFromBase64 = boost::archive::iterators::transform_width<
-    boost::archive::iterators::binary_from_base64<std::string::const_iterator>,
-    8, // get a view of 8 bit
-    6  // from a sequence of 6 bit
-    >;
-} // ns detail
-namespace engine
+constexpr const char BASE64_ALPHABET[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+// Section 5: "Base 64 Encoding with URL and Filename Safe Alphabet"
+constexpr const char BASE64_URL_ALPHABET[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+// Maps the characters of both alphabets to their 6 bit values, all other characters to 0
+struct Base64DecodeTable
 {
+    constexpr Base64DecodeTable() : values{}
+    {
+        for (unsigned char i = 0; i < 64; ++i)
+        {
+            values[static_cast<unsigned char>(BASE64_ALPHABET[i])] = i;
+            values[static_cast<unsigned char>(BASE64_URL_ALPHABET[i])] = i;
+        }
+    }
 
-// Encoding Implementation
+    unsigned char values[256];
+};
 
-// Encodes a chunk of memory to Base64.
-inline std::string encodeBase64(const unsigned char *first, std::size_t size)
+inline const Base64DecodeTable &base64DecodeTable()
 {
-    std::vector<unsigned char> bytes{first, first + size};
-    BOOST_ASSERT(!bytes.empty());
+    static constexpr Base64DecodeTable table{};
+    return table;
+}
 
-    std::size_t bytes_to_pad{0};
+// Encodes size bytes into (size + 2) / 3 * 4 characters starting at out, including padding
+inline char *
+encodeBase64(const unsigned char *first, std::size_t size, const char *alphabet, char *out)
+{
+    for (; size >= 3; size -= 3, first += 3)
+    {
+        const std::uint32_t bits = (first[0] << 16) | (first[1] << 8) | first[2];
+        *out++ = alphabet[(bits >> 18) & 0x3f];
+        *out++ = alphabet[(bits >> 12) & 0x3f];
+        *out++ = alphabet[(bits >> 6) & 0x3f];
+        *out++ = alphabet[bits & 0x3f];
+    }
 
-    while (bytes.size() % 3 != 0)
+    if (size > 0)
     {
-        bytes_to_pad += 1;
-        bytes.push_back(0);
+        const std::uint32_t bits = (first[0] << 16) | (size == 2 ? first[1] << 8 : 0);
+        *out++ = alphabet[(bits >> 18) & 0x3f];
+        *out++ = alphabet[(bits >> 12) & 0x3f];
+        *out++ = size == 2 ? alphabet[(bits >> 6) & 0x3f] : '=';
+        *out++ = '=';
     }
 
-    BOOST_ASSERT(bytes_to_pad == 0 || bytes_to_pad == 1 || bytes_to_pad == 2);
-    BOOST_ASSERT_MSG(0 == bytes.size() % 3, "base64 input data size is not a multiple of 3");
+    return out;
+}
 
-    std::string encoded{detail::Base64FromBinary{bytes.data()},
-                        detail::Base64FromBinary{bytes.data() + (bytes.size() - bytes_to_pad)}};
+// Decodes characters up to the first padding character, but writes at most max_size bytes.
+// Characters of both alphabets are accepted.
+template <typename Iter, typename OutputIter>
+OutputIter decodeBase64(Iter first, const Iter last, OutputIter out, std::size_t max_size)
+{
+    const auto &table = base64DecodeTable();
 
-    return encoded.append(bytes_to_pad, '=');
+    std::uint32_t bits = 0;
+    int num_bits = 0;
+    for (; first != last && max_size > 0; ++first)
+    {
+        const auto character = static_cast<unsigned char>(*first);
+        if (character == '=')
+            break;
+
+        bits = (bits << 6) | table.values[character];
+        num_bits += 6;
+        if (num_bits >= 8)
+        {
+            num_bits -= 8;
+            *out++ = static_cast<unsigned char>(bits >> num_bits);
+            --max_size;
+        }
+    }
+    return out;
+}
+} // ns detail
+namespace engine
+{
+
+// Encoding Implementation
+
+// Encodes a chunk of memory to Base64.
+inline std::string encodeBase64(const unsigned char *first, std::size_t size)
+{
+    BOOST_ASSERT(size > 0);
+
+    std::string encoded((size + 2) / 3 * 4, '=');
+    detail::encodeBase64(first, size, detail::BASE64_ALPHABET, &encoded[0]);
+
+    return encoded;
 }
 
 // C++11 standard 3.9.1/1: Plain char, signed char, and unsigned char are three distinct types
@@ -99,16 +152,8 @@ template <typename T> std::string encodeBase64Bytewise(const T &x)
 // Decodes into a chunk of memory that is at least as large as the input.
 template <typename OutputIter> void decodeBase64(const std::string &encoded, OutputIter out)
 {
-    auto unpadded = encoded;
-
-    const auto num_padded = std::count(begin(encoded), end(encoded), '=');
-    std::replace(begin(unpadded), end(unpadded), '=', 'A'); // A_64 == \0
-
-    std::string decoded{detail::BinaryFromBase64{begin(unpadded)},
-                        detail::BinaryFromBase64{begin(unpadded) + unpadded.length()}};
-
-    decoded.erase(end(decoded) - num_padded, end(decoded));
-    std::copy(begin(decoded), end(decoded), out);
+    detail::decodeBase64(
+        encoded.begin(), encoded.end(), out, std::numeric_limits<std::size_t>::max());
 }
 
 // Convenience specialization, filling string instead of byte-dumping into it.
@@ -121,7 +166,8 @@ inline std::string decodeBase64(const std::string &encoded)
     return rv;
 }
 
-// Decodes from Base 64 to any sufficiently trivial object.
+// Decodes from Base 64 to any sufficiently trivial object. Bytes that are missing in the input
+// are zero, superfluous input is ignored.
 template <typename T> T decodeBase64Bytewise(const std::string &encoded)
 {
 #if !defined(__GNUC__) || (__GNUC__ > 4)
@@ -130,7 +176,9 @@ template <typename T> T decodeBase64Bytewise(const std::string &encoded)
 
     T x;
 
-    decodeBase64(encoded, reinterpret_cast<unsigned char *>(&x));
+    auto bytes = reinterpret_cast<unsigned char *>(&x);
+    const auto end = detail::decodeBase64(encoded.begin(), encoded.end(), bytes, sizeof(T));
+    std::fill(end, bytes + sizeof(T), 0);
 
     return x;
 }
@@ -1,10 +1,11 @@
 #ifndef OSRM_ENGINE_DATAFACADE_ALGORITHM_DATAFACADE_HPP
 #define OSRM_ENGINE_DATAFACADE_ALGORITHM_DATAFACADE_HPP
 
-#include "contractor/query_edge.hpp"
+#include "contractor/query_graph.hpp"
 #include "customizer/edge_based_graph.hpp"
 #include "extractor/edge_based_edge.hpp"
 #include "engine/algorithm.hpp"
+#include "engine/unpacking_cache.hpp"
 
 #include "partitioner/cell_storage.hpp"
 #include "partitioner/multi_level_partition.hpp"
@@ -28,7 +29,7 @@ template <typename AlgorithmT> class AlgorithmDataFacade;
 template <> class AlgorithmDataFacade<CH>
 {
   public:
-    using EdgeData = contractor::QueryEdge::EdgeData;
+    using EdgeData = contractor::SearchEdgeData;
     using EdgeRange = util::filtered_range<EdgeID, util::vector_view<bool>>;
 
     // search graph access
@@ -42,6 +43,11 @@ template <> class AlgorithmDataFacade<CH>
 
     virtual const EdgeData &GetEdgeData(const EdgeID e) const = 0;
 
+    // durations and distances are not part of the edge data that is read while searching
+    virtual EdgeDuration GetEdgeDuration(const EdgeID e) const = 0;
+
+    virtual EdgeDistance GetEdgeDistance(const EdgeID e) const = 0;
+
     virtual EdgeRange GetAdjacentEdgeRange(const NodeID node) const = 0;
 
     // searches for a specific edge
@@ -55,6 +61,9 @@ template <> class AlgorithmDataFacade<CH>
     virtual EdgeID FindSmallestEdge(const NodeID from,
                                     const NodeID to,
                                     const std::function<bool(EdgeData)> filter) const = 0;
+
+    // cache of unpacked shortcuts, may be nullptr
+    virtual UnpackingCache *GetUnpackingCache() const = 0;
 };
 
 template <> class AlgorithmDataFacade<MLD>
@@ -45,7 +45,16 @@ class ContiguousInternalMemoryAlgorithmDataFacade<CH> : public datafacade::Algor
     using GraphNode = QueryGraph::NodeArrayEntry;
     using GraphEdge = QueryGraph::EdgeArrayEntry;
 
+    // bytes the cache of unpacked shortcuts may use, including the bookkeeping of its entries.
+    // Every exclude class has its own facade and cache.
+    static constexpr std::size_t UNPACKING_CACHE_CAPACITY = 16 << 20;
+
     QueryGraph m_query_graph;
+    util::vector_view<EdgeDuration> m_edge_durations;
+    util::vector_view<EdgeDistance> m_edge_distances;
+
+    // shortcuts of this facade's graph, the edges that are excluded differ between facades
+    std::unique_ptr<UnpackingCache> unpacking_cache;
 
     // allocator that keeps the allocation data
     std::shared_ptr<ContiguousBlockAllocator> allocator;
@@ -55,17 +64,31 @@ class ContiguousInternalMemoryAlgorithmDataFacade<CH> : public datafacade::Algor
         std::shared_ptr<ContiguousBlockAllocator> allocator_,
         const std::string &metric_name,
         std::size_t exclude_index)
-        : allocator(std::move(allocator_))
+        : unpacking_cache(std::make_unique<UnpackingCache>(UNPACKING_CACHE_CAPACITY)),
+          allocator(std::move(allocator_))
     {
         InitializeInternalPointers(allocator->GetIndex(), metric_name, exclude_index);
     }
 
+    ~ContiguousInternalMemoryAlgorithmDataFacade()
+    {
+        const auto hits = unpacking_cache->GetHits();
+        const auto misses = unpacking_cache->GetMisses();
+        if (hits + misses > 0)
+        {
+            util::Log(logDEBUG) << "Shortcut unpacking cache: " << hits << " hits, " << misses
+                                << " misses (" << 100 * unpacking_cache->GetHitRate() << "%)";
+        }
+    }
+
     void InitializeInternalPointers(const storage::SharedDataIndex &index,
                                     const std::string &metric_name,
                                     const std::size_t exclude_index)
     {
-        m_query_graph =
-            make_filtered_graph_view(index, "/ch/metrics/" + metric_name, exclude_index);
+        const auto metric_prefix = "/ch/metrics/" + metric_name;
+        m_query_graph = make_filtered_graph_view(index, metric_prefix, exclude_index);
+        m_edge_durations = make_contracted_durations_view(index, metric_prefix);
+        m_edge_distances = make_contracted_distances_view(index, metric_prefix);
     }
 
     // search graph access
@@ -85,6 +108,16 @@ class ContiguousInternalMemoryAlgorithmDataFacade<CH> : public datafacade::Algor
         return m_query_graph.GetEdgeData(e);
     }
 
+    EdgeDuration GetEdgeDuration(const EdgeID e) const override final
+    {
+        return m_edge_durations[e];
+    }
+
+    EdgeDistance GetEdgeDistance(const EdgeID e) const override final
+    {
+        return m_edge_distances[e];
+    }
+
     EdgeRange GetAdjacentEdgeRange(const NodeID node) const override final
     {
         return m_query_graph.GetAdjacentEdgeRange(node);
@@ -113,6 +146,8 @@ class ContiguousInternalMemoryAlgorithmDataFacade<CH> : public datafacade::Algor
     {
         return m_query_graph.FindSmallestEdge(from, to, filter);
     }
+
+    UnpackingCache *GetUnpackingCache() const override final { return unpacking_cache.get(); }
 };
 
 /**
@@ -271,6 +306,42 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
         return segment_data.GetReverseWeights(id);
     }
 
+    void CopyUncompressedForwardWeights(const EdgeID id,
+                                        std::vector<SegmentWeight> &weights) const override final
+    {
+        segment_data.CopyForwardWeights(id, weights);
+    }
+
+    void CopyUncompressedReverseWeights(const EdgeID id,
+                                        std::vector<SegmentWeight> &weights) const override final
+    {
+        segment_data.CopyReverseWeights(id, weights);
+    }
+
+    void CopyUncompressedForwardDurations(const EdgeID id, std::vector<SegmentDuration> &durations)
+        const override final
+    {
+        segment_data.CopyForwardDurations(id, durations);
+    }
+
+    void CopyUncompressedReverseDurations(const EdgeID id, std::vector<SegmentDuration> &durations)
+        const override final
+    {
+        segment_data.CopyReverseDurations(id, durations);
+    }
+
+    void CopyUncompressedForwardZoomLevels(const EdgeID id,
+                                           std::vector<std::uint8_t> &levels) const override final
+    {
+        segment_data.CopyForwardZoomLevels(id, levels);
+    }
+
+    void CopyUncompressedReverseZoomLevels(const EdgeID id,
+                                           std::vector<std::uint8_t> &levels) const override final
+    {
+        segment_data.CopyReverseZoomLevels(id, levels);
+    }
+
     // Returns the data source ids that were used to supply the edge
     // weights.
     DatasourceForwardRange GetUncompressedForwardDatasources(const EdgeID id) const override final
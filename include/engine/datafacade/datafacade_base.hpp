@@ -35,6 +35,7 @@
 #include <boost/range/any_range.hpp>
 #include <cstddef>
 
+#include <algorithm>
 #include <string>
 #include <utility>
 #include <vector>
@@ -102,6 +103,42 @@ class BaseDataFacade
     virtual DurationForwardRange GetUncompressedForwardDurations(const EdgeID id) const = 0;
     virtual DurationReverseRange GetUncompressedReverseDurations(const EdgeID id) const = 0;
 
+    // Copy the same values as the ranges above into a vector in one pass. The default
+    // implementations iterate the ranges, facades with packed storage decode them in bulk.
+    virtual void CopyUncompressedForwardWeights(const EdgeID id,
+                                                std::vector<SegmentWeight> &weights) const
+    {
+        copyRange(GetUncompressedForwardWeights(id), weights);
+    }
+    virtual void CopyUncompressedReverseWeights(const EdgeID id,
+                                                std::vector<SegmentWeight> &weights) const
+    {
+        copyRange(GetUncompressedReverseWeights(id), weights);
+    }
+    virtual void CopyUncompressedForwardDurations(const EdgeID id,
+                                                  std::vector<SegmentDuration> &durations) const
+    {
+        copyRange(GetUncompressedForwardDurations(id), durations);
+    }
+    virtual void CopyUncompressedReverseDurations(const EdgeID id,
+                                                  std::vector<SegmentDuration> &durations) const
+    {
+        copyRange(GetUncompressedReverseDurations(id), durations);
+    }
+
+    // Copy the smallest overview zoom level that keeps each node of an uncompressed geometry.
+    // The default implementations keep all nodes on every zoom level.
+    virtual void CopyUncompressedForwardZoomLevels(const EdgeID id,
+                                                   std::vector<std::uint8_t> &levels) const
+    {
+        levels.assign(GetUncompressedForwardGeometry(id).size(), 0);
+    }
+    virtual void CopyUncompressedReverseZoomLevels(const EdgeID id,
+                                                   std::vector<std::uint8_t> &levels) const
+    {
+        levels.assign(GetUncompressedReverseGeometry(id).size(), 0);
+    }
+
     // Returns the data source ids that were used to supply the edge
     // weights.  Will return an empty array when only the base profile is used.
     virtual DatasourceForwardRange GetUncompressedForwardDatasources(const EdgeID id) const = 0;
@@ -222,6 +259,14 @@ class BaseDataFacade
 
     virtual std::vector<extractor::ManeuverOverride>
     GetOverridesThatStartAt(const NodeID edge_based_node_id) const = 0;
+
+  private:
+    template <typename RangeT, typename VectorT>
+    static void copyRange(const RangeT &range, VectorT &vector)
+    {
+        vector.resize(range.size());
+        std::copy(range.begin(), range.end(), vector.begin());
+    }
 };
 }
 }
@@ -29,6 +29,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define ENGINE_CONFIG_HPP
 
 #include "storage/storage_config.hpp"
+#include "util/rectangle.hpp"
 
 #include <boost/filesystem/path.hpp>
 
@@ -53,6 +54,12 @@ namespace engine
  *  - Match
  *  - Nearest
  *
+ * The MLD alternatives search stops unpacking candidates once its time budget (in milliseconds,
+ * 0 for unlimited) runs out and returns the alternatives found so far.
+ *
+ * Requests can be restricted to a region: requests with coordinates outside of it are rejected.
+ * This only restricts requests, the whole dataset is still loaded or mapped.
+ *
  * In addition, shared memory can be used for datasets loaded with osrm-datastore.
  *
  * You can chose between three algorithms:
@@ -87,6 +94,8 @@ struct EngineConfig final
     double max_radius_map_matching = -1.0;
     int max_results_nearest = -1;
     int max_alternatives = 3; // set an arbitrary upper bound; can be adjusted by user
+    int alternatives_time_budget = 0; // milliseconds spent unpacking alternatives, 0 unlimited
+    util::RectangleInt2D region; // not restricted unless valid
     bool use_shared_memory = true;
     boost::filesystem::path memory_file;
     bool use_mmap = true;
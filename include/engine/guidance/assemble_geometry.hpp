@@ -44,6 +44,7 @@ inline LegGeometry assembleGeometry(const datafacade::BaseDataFacade &facade,
     // segment 0 first and last
     geometry.segment_offsets.push_back(0);
     geometry.locations.push_back(source_node.location);
+    geometry.zoom_levels.push_back(0);
 
     //                          u       *      v
     //                          0 -- 1 -- 2 -- 3
@@ -100,6 +101,7 @@ inline LegGeometry assembleGeometry(const datafacade::BaseDataFacade &facade,
                 path_point.datasource_id});
             geometry.locations.push_back(std::move(coordinate));
             geometry.osm_node_ids.push_back(osm_node_id);
+            geometry.zoom_levels.push_back(path_point.zoom_level);
         }
     }
     current_distance =
@@ -149,6 +151,7 @@ inline LegGeometry assembleGeometry(const datafacade::BaseDataFacade &facade,
 
     geometry.segment_offsets.push_back(geometry.locations.size());
     geometry.locations.push_back(target_node.location);
+    geometry.zoom_levels.push_back(0);
 
     //                           u       *      v
     //                           0 -- 1 -- 2 -- 3
@@ -65,6 +65,9 @@ struct PathData
 
     // Driving side of the turn
     bool is_left_hand_driving;
+
+    // smallest overview zoom level that keeps the via node, see util::douglasPeuckerZoomLevels
+    std::uint8_t zoom_level;
 };
 
 struct InternalRouteResult
@@ -95,6 +98,24 @@ struct InternalRouteResult
     }
 };
 
+// Weight, duration and distance of the legs of a route, without the path itself.
+// Used for responses that do not need geometry or guidance.
+struct InternalRouteSummary
+{
+    struct Leg
+    {
+        EdgeWeight weight;
+        EdgeDuration duration;
+        EdgeDistance distance;
+    };
+
+    std::vector<Leg> legs;
+    std::vector<PhantomNodes> segment_end_coordinates;
+    EdgeWeight shortest_path_weight = INVALID_EDGE_WEIGHT;
+
+    bool is_valid() const { return INVALID_EDGE_WEIGHT != shortest_path_weight; }
+};
+
 struct InternalManyRoutesResult
 {
     InternalManyRoutesResult() = default;
@@ -173,6 +194,38 @@ inline InternalRouteResult CollapseInternalRouteResult(const InternalRouteResult
                  collapsed.unpacked_path_segments.size());
     return collapsed;
 }
+
+inline InternalRouteSummary CollapseInternalRouteSummary(const InternalRouteSummary &leggy_summary,
+                                                         const std::vector<bool> &is_waypoint)
+{
+    BOOST_ASSERT(leggy_summary.is_valid());
+    BOOST_ASSERT(is_waypoint[0]);     // first and last coords
+    BOOST_ASSERT(is_waypoint.back()); // should always be waypoints
+
+    InternalRouteSummary collapsed;
+    collapsed.shortest_path_weight = leggy_summary.shortest_path_weight;
+    for (auto i : util::irange<std::size_t>(0, leggy_summary.legs.size()))
+    {
+        const auto &leg = leggy_summary.legs[i];
+        if (is_waypoint[i])
+        {
+            collapsed.legs.push_back(leg);
+            collapsed.segment_end_coordinates.push_back(leggy_summary.segment_end_coordinates[i]);
+        }
+        else
+        {
+            // no new leg, the legs meet at the silent waypoint so their values add up
+            BOOST_ASSERT(!collapsed.legs.empty());
+            collapsed.legs.back().weight += leg.weight;
+            collapsed.legs.back().duration += leg.duration;
+            collapsed.legs.back().distance += leg.distance;
+            collapsed.segment_end_coordinates.back().target_phantom =
+                leggy_summary.segment_end_coordinates[i].target_phantom;
+        }
+    }
+
+    return collapsed;
+}
 }
 }
 
@@ -5,10 +5,14 @@
 
 #include <boost/assert.hpp>
 #include <boost/math/constants/constants.hpp>
+#include <boost/range/iterator_range.hpp>
 
 #include <cmath>
 
+#include <algorithm>
+#include <cstdint>
 #include <limits>
+#include <utility>
 #include <vector>
 
 namespace osrm
@@ -48,59 +52,181 @@ struct TransitionLogProbability
     double operator()(const double d_t) const { return -log_beta - d_t / beta; }
 };
 
+/**
+ * Flat storage of the states of all candidates of a trace.
+ *
+ * The states of timestamp t are stored at [offsets[t], offsets[t + 1]) of every array, so a trace
+ * needs a handful of allocations instead of several per timestamp. Storages are meant to be
+ * reused between traces: they only ever grow and keep their capacity when they are reset.
+ */
+struct HiddenMarkovModelStorage
+{
+    std::vector<std::size_t> offsets;
+    std::vector<double> viterbi;
+    std::vector<std::uint8_t> viterbi_reachable;
+    std::vector<std::pair<unsigned, unsigned>> parents;
+    std::vector<float> path_distances;
+    std::vector<std::uint8_t> pruned;
+    std::vector<std::uint8_t> breakage;
+
+    template <class CandidateLists> void Reset(const CandidateLists &candidates_list)
+    {
+        offsets.clear();
+        offsets.reserve(candidates_list.size() + 1);
+        offsets.push_back(0);
+        for (const auto &candidates : candidates_list)
+        {
+            offsets.push_back(offsets.back() + candidates.size());
+        }
+
+        viterbi.clear();
+        viterbi_reachable.clear();
+        parents.clear();
+        path_distances.clear();
+        pruned.clear();
+        breakage.clear();
+        Resize();
+    }
+
+    // Adds default states for all candidates up to the last offset
+    void Resize()
+    {
+        const auto number_of_states = offsets.back();
+        viterbi.resize(number_of_states, IMPOSSIBLE_LOG_PROB);
+        viterbi_reachable.resize(number_of_states, false);
+        parents.resize(number_of_states, std::make_pair(0u, 0u));
+        path_distances.resize(number_of_states, 0);
+        pruned.resize(number_of_states, true);
+        breakage.resize(offsets.size() - 1, true);
+    }
+};
+
+// Rows of one of the state arrays, row t holds the states of all candidates of timestamp t
+template <typename T> class StateRows
+{
+  public:
+    using Row = boost::iterator_range<typename std::vector<T>::iterator>;
+    using ConstRow = boost::iterator_range<typename std::vector<T>::const_iterator>;
+
+    StateRows(std::vector<T> &values, const std::vector<std::size_t> &offsets)
+        : values(values), offsets(offsets)
+    {
+    }
+
+    Row operator[](const std::size_t timestamp)
+    {
+        BOOST_ASSERT(timestamp + 1 < offsets.size());
+        return boost::make_iterator_range(values.begin() + offsets[timestamp],
+                                          values.begin() + offsets[timestamp + 1]);
+    }
+
+    ConstRow operator[](const std::size_t timestamp) const
+    {
+        BOOST_ASSERT(timestamp + 1 < offsets.size());
+        return boost::make_iterator_range(values.cbegin() + offsets[timestamp],
+                                          values.cbegin() + offsets[timestamp + 1]);
+    }
+
+    std::size_t size() const { return offsets.size() - 1; }
+
+  private:
+    std::vector<T> &values;
+    const std::vector<std::size_t> &offsets;
+};
+
 template <class CandidateLists> struct HiddenMarkovModel
 {
-    std::vector<std::vector<double>> viterbi;
-    std::vector<std::vector<bool>> viterbi_reachable;
-    std::vector<std::vector<std::pair<unsigned, unsigned>>> parents;
-    std::vector<std::vector<float>> path_distances;
-    std::vector<std::vector<bool>> pruned;
-    std::vector<bool> breakage;
+    HiddenMarkovModelStorage &storage;
+
+    StateRows<double> viterbi;
+    StateRows<std::uint8_t> viterbi_reachable;
+    StateRows<std::pair<unsigned, unsigned>> parents;
+    StateRows<float> path_distances;
+    StateRows<std::uint8_t> pruned;
+    std::vector<std::uint8_t> &breakage;
 
     const CandidateLists &candidates_list;
     const std::vector<std::vector<double>> &emission_log_probabilities;
 
     HiddenMarkovModel(const CandidateLists &candidates_list,
-                      const std::vector<std::vector<double>> &emission_log_probabilities)
-        : breakage(candidates_list.size()), candidates_list(candidates_list),
-          emission_log_probabilities(emission_log_probabilities)
+                      const std::vector<std::vector<double>> &emission_log_probabilities,
+                      HiddenMarkovModelStorage &storage)
+        : storage(storage), viterbi(storage.viterbi, storage.offsets),
+          viterbi_reachable(storage.viterbi_reachable, storage.offsets),
+          parents(storage.parents, storage.offsets),
+          path_distances(storage.path_distances, storage.offsets),
+          pruned(storage.pruned, storage.offsets), breakage(storage.breakage),
+          candidates_list(candidates_list), emission_log_probabilities(emission_log_probabilities)
+    {
+        storage.Reset(candidates_list);
+    }
+
+    HiddenMarkovModel(const HiddenMarkovModel &) = delete;
+    HiddenMarkovModel &operator=(const HiddenMarkovModel &) = delete;
+
+    // Adds the states of timestamps that were appended to the candidates list since the model
+    // was created, used for online matching
+    void Append()
+    {
+        auto &offsets = storage.offsets;
+        for (auto t = offsets.size() - 1; t < candidates_list.size(); ++t)
+        {
+            offsets.push_back(offsets.back() + candidates_list[t].size());
+        }
+        storage.Resize();
+    }
+
+    // Drops the states of the first timestamps, the candidates list has to be shortened by the
+    // same number. States with a parent before that become initial states.
+    void Trim(std::size_t number_of_timestamps)
     {
-        viterbi.resize(candidates_list.size());
-        viterbi_reachable.resize(candidates_list.size());
-        parents.resize(candidates_list.size());
-        path_distances.resize(candidates_list.size());
-        pruned.resize(candidates_list.size());
-        breakage.resize(candidates_list.size());
-        for (const auto i : util::irange<std::size_t>(0UL, candidates_list.size()))
+        auto &offsets = storage.offsets;
+        BOOST_ASSERT(number_of_timestamps < offsets.size());
+
+        const auto number_of_states = offsets[number_of_timestamps];
+        const auto trim = [number_of_states](auto &values) {
+            values.erase(values.begin(), values.begin() + number_of_states);
+        };
+        trim(storage.viterbi);
+        trim(storage.viterbi_reachable);
+        trim(storage.parents);
+        trim(storage.path_distances);
+        trim(storage.pruned);
+        breakage.erase(breakage.begin(), breakage.begin() + number_of_timestamps);
+
+        offsets.erase(offsets.begin(), offsets.begin() + number_of_timestamps);
+        for (auto &offset : offsets)
         {
-            const auto &num_candidates = candidates_list[i].size();
-            // add empty vectors
-            if (num_candidates > 0)
+            offset -= number_of_states;
+        }
+
+        for (const auto t : util::irange<std::size_t>(0UL, parents.size()))
+        {
+            auto row = parents[t];
+            for (const auto s : util::irange<std::size_t>(0UL, row.size()))
             {
-                viterbi[i].resize(num_candidates);
-                viterbi_reachable[i].resize(num_candidates);
-                parents[i].resize(num_candidates);
-                path_distances[i].resize(num_candidates);
-                pruned[i].resize(num_candidates);
+                auto &parent = row[s];
+                if (parent.first >= number_of_timestamps)
+                    parent.first -= number_of_timestamps;
+                else
+                    parent = std::make_pair(t, s);
             }
         }
-
-        Clear(0);
     }
 
     void Clear(std::size_t initial_timestamp)
     {
-        BOOST_ASSERT(viterbi.size() == parents.size() && parents.size() == path_distances.size() &&
-                     path_distances.size() == pruned.size() && pruned.size() == breakage.size());
+        BOOST_ASSERT(initial_timestamp < storage.offsets.size());
 
-        for (const auto t : util::irange(initial_timestamp, viterbi.size()))
-        {
-            std::fill(viterbi[t].begin(), viterbi[t].end(), IMPOSSIBLE_LOG_PROB);
-            std::fill(viterbi_reachable[t].begin(), viterbi_reachable[t].end(), false);
-            std::fill(parents[t].begin(), parents[t].end(), std::make_pair(0u, 0u));
-            std::fill(path_distances[t].begin(), path_distances[t].end(), 0);
-            std::fill(pruned[t].begin(), pruned[t].end(), true);
-        }
+        const auto first_state = storage.offsets[initial_timestamp];
+        const auto clear = [first_state](auto &values, const auto value) {
+            std::fill(values.begin() + first_state, values.end(), value);
+        };
+        clear(storage.viterbi, IMPOSSIBLE_LOG_PROB);
+        clear(storage.viterbi_reachable, false);
+        clear(storage.parents, std::make_pair(0u, 0u));
+        clear(storage.path_distances, 0.f);
+        clear(storage.pruned, true);
         std::fill(breakage.begin() + initial_timestamp, breakage.end(), true);
     }
 
@@ -111,14 +237,16 @@ template <class CandidateLists> struct HiddenMarkovModel
         {
             BOOST_ASSERT(initial_timestamp < num_points);
 
-            for (const auto s : util::irange<std::size_t>(0UL, viterbi[initial_timestamp].size()))
+            auto initial_viterbi = viterbi[initial_timestamp];
+            auto initial_parents = parents[initial_timestamp];
+            auto initial_pruned = pruned[initial_timestamp];
+            for (const auto s : util::irange<std::size_t>(0UL, initial_viterbi.size()))
             {
-                viterbi[initial_timestamp][s] = emission_log_probabilities[initial_timestamp][s];
-                parents[initial_timestamp][s] = std::make_pair(initial_timestamp, s);
-                pruned[initial_timestamp][s] = viterbi[initial_timestamp][s] < MINIMAL_LOG_PROB;
+                initial_viterbi[s] = emission_log_probabilities[initial_timestamp][s];
+                initial_parents[s] = std::make_pair(initial_timestamp, s);
+                initial_pruned[s] = initial_viterbi[s] < MINIMAL_LOG_PROB;
 
-                breakage[initial_timestamp] =
-                    breakage[initial_timestamp] && pruned[initial_timestamp][s];
+                breakage[initial_timestamp] = breakage[initial_timestamp] && initial_pruned[s];
             }
 
             ++initial_timestamp;
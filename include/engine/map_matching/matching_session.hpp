@@ -0,0 +1,75 @@
+#ifndef MAP_MATCHING_MATCHING_SESSION_HPP
+#define MAP_MATCHING_MATCHING_SESSION_HPP
+
+#include "engine/map_matching/hidden_markov_model.hpp"
+#include "engine/routing_algorithms/map_matching.hpp"
+
+#include "util/coordinate.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace map_matching
+{
+
+/**
+ * State of an online map matching session that is kept between requests.
+ *
+ * Samples are appended as they arrive and the Viterbi state of all samples that are not final
+ * yet is kept. As soon as all candidates that can still be extended share a common ancestor the
+ * path up to this ancestor can not change anymore and is handed out as a finalized sub-matching.
+ * Samples before it are not needed anymore. They are dropped as soon as they make up at least
+ * half of the kept samples, so every sample is moved a constant number of times on average.
+ *
+ * Sample indices are local to the kept samples, first_sample is the index of the first kept
+ * sample since the session started.
+ */
+struct MatchingSession
+{
+    MatchingSession() : model(candidates_list, emission_log_probabilities, model_storage) {}
+
+    MatchingSession(const MatchingSession &) = delete;
+    MatchingSession &operator=(const MatchingSession &) = delete;
+
+    std::size_t NumberOfSamples() const { return candidates_list.size(); }
+    std::size_t NumberOfPendingSamples() const
+    {
+        return candidates_list.size() - (finalized == INVALID_STATE ? 0 : finalized + 1);
+    }
+
+    std::size_t first_sample = 0;
+    // checksum and timestamp of the dataset the candidates were snapped to
+    std::uint32_t data_checksum = 0;
+    std::string data_timestamp;
+    bool use_timestamps = false;
+
+    routing_algorithms::CandidateLists candidates_list;
+    std::vector<std::vector<double>> emission_log_probabilities;
+    std::vector<util::Coordinate> trace_coordinates;
+    std::vector<unsigned> trace_timestamps;
+    // differences between the latest timestamps, to estimate the sample time
+    std::deque<unsigned> sample_times;
+
+    HiddenMarkovModelStorage model_storage;
+    HiddenMarkovModel<routing_algorithms::CandidateLists> model;
+
+    // the next sample that has no transitions yet
+    std::size_t next_timestamp = 0;
+    std::size_t sub_matching_begin = 0;
+    std::size_t breakage_begin = INVALID_STATE;
+    // last finalized sample, its state is the only one that is kept
+    std::size_t finalized = INVALID_STATE;
+    std::vector<std::size_t> prev_unbroken_timestamps;
+};
+}
+}
+}
+
+#endif
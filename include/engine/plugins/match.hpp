@@ -2,11 +2,19 @@
 #define MATCH_HPP
 
 #include "engine/api/match_parameters.hpp"
+#include "engine/map_matching/matching_session.hpp"
 #include "engine/plugins/plugin_base.hpp"
 #include "engine/routing_algorithms.hpp"
 
 #include "util/json_util.hpp"
 
+#include <chrono>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace osrm
@@ -23,9 +31,15 @@ class MatchPlugin : public BasePlugin
     using SubMatchingList = routing_algorithms::SubMatchingList;
     using CandidateLists = routing_algorithms::CandidateLists;
     static const constexpr double RADIUS_MULTIPLIER = 3;
+    // sessions that were not continued for this long are removed
+    static const constexpr int SESSION_TIMEOUT_SECONDS = 300;
+    // the least recently continued sessions are removed if there are more than this
+    static const constexpr std::size_t MAX_SESSIONS = 10000;
 
-    MatchPlugin(const int max_locations_map_matching, const double max_radius_map_matching)
-        : max_locations_map_matching(max_locations_map_matching),
+    MatchPlugin(const int max_locations_map_matching,
+                const double max_radius_map_matching,
+                const util::RectangleInt2D &region)
+        : BasePlugin(region), max_locations_map_matching(max_locations_map_matching),
           max_radius_map_matching(max_radius_map_matching)
     {
     }
@@ -35,8 +49,35 @@ class MatchPlugin : public BasePlugin
                          osrm::engine::api::ResultT &json_result) const;
 
   private:
+    struct Session
+    {
+        std::mutex mutex;
+        std::unique_ptr<map_matching::MatchingSession> state;
+    };
+
+    Status HandleSessionRequest(const RoutingAlgorithmsInterface &algorithms,
+                                const api::MatchParameters &parameters,
+                                osrm::engine::api::ResultT &result) const;
+
+    // Returns the session with this id, expired sessions and the least recently used ones beyond
+    // MAX_SESSIONS are removed on the way
+    std::shared_ptr<Session> GetSession(const std::string &id) const;
+    void RemoveSession(const std::string &id) const;
+
     const int max_locations_map_matching;
     const double max_radius_map_matching;
+
+    struct SessionEntry
+    {
+        std::string id;
+        std::shared_ptr<Session> session;
+        std::chrono::steady_clock::time_point last_access;
+    };
+    using SessionList = std::list<SessionEntry>;
+    mutable std::mutex sessions_mutex;
+    // most recently used first
+    mutable SessionList sessions;
+    mutable std::unordered_map<std::string, SessionList::iterator> session_index;
 };
 }
 }
@@ -13,6 +13,7 @@
 #include "util/coordinate_calculation.hpp"
 #include "util/integer_range.hpp"
 #include "util/json_container.hpp"
+#include "util/rectangle.hpp"
 
 #include <algorithm>
 #include <iterator>
@@ -31,6 +32,10 @@ namespace plugins
 class BasePlugin
 {
   protected:
+    BasePlugin() = default;
+    // an invalid region does not restrict the coordinates of requests
+    explicit BasePlugin(const util::RectangleInt2D &region) : region(region) {}
+
     bool CheckAllCoordinates(const std::vector<util::Coordinate> &coordinates) const
     {
         return !std::any_of(
@@ -39,6 +44,17 @@ class BasePlugin
             });
     }
 
+    // Checks that all coordinates are in the region this engine serves
+    bool CheckRegion(const std::vector<util::Coordinate> &coordinates) const
+    {
+        return !region.IsValid() ||
+               std::all_of(std::begin(coordinates),
+                           std::end(coordinates),
+                           [this](const util::Coordinate coordinate) {
+                               return region.Contains(coordinate);
+                           });
+    }
+
     bool CheckAlgorithms(const api::BaseParameters &params,
                          const RoutingAlgorithmsInterface &algorithms,
                          osrm::engine::api::ResultT &result) const
@@ -371,6 +387,9 @@ class BasePlugin
         }
         return phantom_node_pairs;
     }
+
+  private:
+    util::RectangleInt2D region;
 };
 }
 }
@@ -36,7 +36,10 @@ class TripPlugin final : public BasePlugin
                                      const bool roundtrip) const;
 
   public:
-    explicit TripPlugin(const int max_locations_trip_) : max_locations_trip(max_locations_trip_) {}
+    TripPlugin(const int max_locations_trip_, const util::RectangleInt2D &region)
+        : BasePlugin(region), max_locations_trip(max_locations_trip_)
+    {
+    }
 
     Status HandleRequest(const RoutingAlgorithmsInterface &algorithms,
                          const api::TripParameters &parameters,
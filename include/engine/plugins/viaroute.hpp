@@ -11,6 +11,7 @@
 #include <cstdlib>
 
 #include <algorithm>
+#include <chrono>
 #include <memory>
 #include <string>
 #include <vector>
@@ -27,9 +28,13 @@ class ViaRoutePlugin final : public BasePlugin
   private:
     const int max_locations_viaroute;
     const int max_alternatives;
+    const std::chrono::milliseconds alternatives_time_budget;
 
   public:
-    explicit ViaRoutePlugin(int max_locations_viaroute, int max_alternatives);
+    ViaRoutePlugin(int max_locations_viaroute,
+                   int max_alternatives,
+                   std::chrono::milliseconds alternatives_time_budget,
+                   const util::RectangleInt2D &region);
 
     Status HandleRequest(const RoutingAlgorithmsInterface &algorithms,
                          const api::RouteParameters &route_parameters,
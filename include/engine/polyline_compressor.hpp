@@ -3,8 +3,12 @@
 
 #include "util/coordinate.hpp"
 
-#include <algorithm>
 #include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -12,46 +16,99 @@ namespace osrm
 {
 namespace engine
 {
+using CoordVectorForwardIter = std::vector<util::Coordinate>::const_iterator;
+
 namespace detail
 {
-std::string encode(std::vector<int> &numbers);
 std::int32_t decode_polyline_integer(std::string::const_iterator &first,
                                      std::string::const_iterator last);
+
+// changes two's complement to "zig-zag" sign coding
+inline std::uint32_t zigzagEncode(const std::int32_t number)
+{
+    return (static_cast<std::uint32_t>(number) << 1u) ^ static_cast<std::uint32_t>(number >> 31);
 }
-using CoordVectorForwardIter = std::vector<util::Coordinate>::const_iterator;
+
+// number of characters of a varint coded value
+inline std::size_t encodedLength(std::uint32_t value)
+{
+    std::size_t length = 1;
+    for (; value >= 0x20; value >>= 5)
+    {
+        ++length;
+    }
+    return length;
+}
+
+inline char *encodeValue(std::uint32_t value, char *output)
+{
+    for (; value >= 0x20; value >>= 5)
+    {
+        *output++ = static_cast<char>((0x20 | (value & 0x1f)) + 63);
+    }
+    *output++ = static_cast<char>(value + 63);
+    return output;
+}
+
+// Calls callback with the zig-zag coded latitude and longitude differences of all coordinates
+template <unsigned POLYLINE_PRECISION, typename Callback>
+void forEachPolylineValue(CoordVectorForwardIter begin,
+                          CoordVectorForwardIter end,
+                          Callback &&callback)
+{
+    const double coordinate_to_polyline = POLYLINE_PRECISION / COORDINATE_PRECISION;
+    std::int32_t current_lat = 0;
+    std::int32_t current_lon = 0;
+    for (; begin != end; ++begin)
+    {
+        const auto lat = static_cast<std::int32_t>(
+            std::round(static_cast<std::int32_t>(begin->lat) * coordinate_to_polyline));
+        const auto lon = static_cast<std::int32_t>(
+            std::round(static_cast<std::int32_t>(begin->lon) * coordinate_to_polyline));
+        callback(zigzagEncode(lat - current_lat));
+        callback(zigzagEncode(lon - current_lon));
+        current_lat = lat;
+        current_lon = lon;
+    }
+}
+}
+
 // Encodes geometry into polyline format.
 // See: https://developers.google.com/maps/documentation/utilities/polylinealgorithm
 
+// Returns the number of characters of the encoded geometry
+template <unsigned POLYLINE_PRECISION = 100000>
+std::size_t encodedPolylineSize(CoordVectorForwardIter begin, CoordVectorForwardIter end)
+{
+    std::size_t size = 0;
+    detail::forEachPolylineValue<POLYLINE_PRECISION>(
+        begin, end, [&size](const std::uint32_t value) { size += detail::encodedLength(value); });
+    return size;
+}
+
+// Writes the encoded geometry to output, which needs room for encodedPolylineSize characters.
+// Returns the end of the written characters.
+template <unsigned POLYLINE_PRECISION = 100000>
+char *encodePolyline(CoordVectorForwardIter begin, CoordVectorForwardIter end, char *output)
+{
+    detail::forEachPolylineValue<POLYLINE_PRECISION>(
+        begin, end, [&output](const std::uint32_t value) {
+            output = detail::encodeValue(value, output);
+        });
+    return output;
+}
+
 template <unsigned POLYLINE_PRECISION = 100000>
 std::string encodePolyline(CoordVectorForwardIter begin, CoordVectorForwardIter end)
 {
-    double coordinate_to_polyline = POLYLINE_PRECISION / COORDINATE_PRECISION;
-    auto size = std::distance(begin, end);
-    if (size == 0)
+    std::string output(encodedPolylineSize<POLYLINE_PRECISION>(begin, end), '\0');
+    if (!output.empty())
     {
-        return {};
+        const auto output_end = encodePolyline<POLYLINE_PRECISION>(begin, end, &output[0]);
+        BOOST_ASSERT(output_end == &output[0] + output.size());
+        (void)output_end;
     }
-
-    std::vector<int> delta_numbers;
-    BOOST_ASSERT(size > 0);
-    delta_numbers.reserve((size - 1) * 2);
-    int current_lat = 0;
-    int current_lon = 0;
-    std::for_each(
-        begin,
-        end,
-        [&delta_numbers, &current_lat, &current_lon, coordinate_to_polyline](
-            const util::Coordinate loc) {
-            const int lat_diff =
-                std::round(static_cast<int>(loc.lat) * coordinate_to_polyline) - current_lat;
-            const int lon_diff =
-                std::round(static_cast<int>(loc.lon) * coordinate_to_polyline) - current_lon;
-            delta_numbers.emplace_back(lat_diff);
-            delta_numbers.emplace_back(lon_diff);
-            current_lat += lat_diff;
-            current_lon += lon_diff;
-        });
-    return detail::encode(delta_numbers);
+    return output;
 }
 
 // Decodes geometry from polyline format
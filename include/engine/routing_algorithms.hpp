@@ -21,12 +21,17 @@ class RoutingAlgorithmsInterface
   public:
     virtual InternalManyRoutesResult
     AlternativePathSearch(const PhantomNodes &phantom_node_pair,
-                          unsigned number_of_alternatives) const = 0;
+                          unsigned number_of_alternatives,
+                          std::chrono::milliseconds time_budget) const = 0;
 
     virtual InternalRouteResult
     ShortestPathSearch(const std::vector<PhantomNodes> &phantom_node_pair,
                        const boost::optional<bool> continue_straight_at_waypoint) const = 0;
 
+    virtual InternalRouteSummary
+    ShortestPathSummary(const std::vector<PhantomNodes> &phantom_node_pair,
+                        const boost::optional<bool> continue_straight_at_waypoint) const = 0;
+
     virtual InternalRouteResult
     DirectShortestPathSearch(const PhantomNodes &phantom_node_pair) const = 0;
 
@@ -43,6 +48,15 @@ class RoutingAlgorithmsInterface
                 const std::vector<boost::optional<double>> &trace_gps_precision,
                 const bool allow_splitting) const = 0;
 
+    virtual routing_algorithms::SubMatchingList
+    OnlineMapMatching(map_matching::MatchingSession &session,
+                      const routing_algorithms::CandidateLists &candidates_list,
+                      const std::vector<util::Coordinate> &trace_coordinates,
+                      const std::vector<unsigned> &trace_timestamps,
+                      const std::vector<boost::optional<double>> &trace_gps_precision,
+                      const bool allow_splitting,
+                      const bool finish) const = 0;
+
     virtual std::vector<routing_algorithms::TurnData>
     GetTileTurns(const std::vector<datafacade::BaseDataFacade::RTreeLeaf> &edges,
                  const std::vector<std::size_t> &sorted_edge_indexes) const = 0;
@@ -74,12 +88,17 @@ template <typename Algorithm> class RoutingAlgorithms final : public RoutingAlgo
 
     InternalManyRoutesResult
     AlternativePathSearch(const PhantomNodes &phantom_node_pair,
-                          unsigned number_of_alternatives) const final override;
+                          unsigned number_of_alternatives,
+                          std::chrono::milliseconds time_budget) const final override;
 
     InternalRouteResult ShortestPathSearch(
         const std::vector<PhantomNodes> &phantom_node_pair,
         const boost::optional<bool> continue_straight_at_waypoint) const final override;
 
+    InternalRouteSummary ShortestPathSummary(
+        const std::vector<PhantomNodes> &phantom_node_pair,
+        const boost::optional<bool> continue_straight_at_waypoint) const final override;
+
     InternalRouteResult
     DirectShortestPathSearch(const PhantomNodes &phantom_nodes) const final override;
 
@@ -96,6 +115,15 @@ template <typename Algorithm> class RoutingAlgorithms final : public RoutingAlgo
                 const std::vector<boost::optional<double>> &trace_gps_precision,
                 const bool allow_splitting) const final override;
 
+    routing_algorithms::SubMatchingList
+    OnlineMapMatching(map_matching::MatchingSession &session,
+                      const routing_algorithms::CandidateLists &candidates_list,
+                      const std::vector<util::Coordinate> &trace_coordinates,
+                      const std::vector<unsigned> &trace_timestamps,
+                      const std::vector<boost::optional<double>> &trace_gps_precision,
+                      const bool allow_splitting,
+                      const bool finish) const final override;
+
     std::vector<routing_algorithms::TurnData>
     GetTileTurns(const std::vector<datafacade::BaseDataFacade::RTreeLeaf> &edges,
                  const std::vector<std::size_t> &sorted_edge_indexes) const final override;
@@ -152,10 +180,11 @@ template <typename Algorithm> class RoutingAlgorithms final : public RoutingAlgo
 template <typename Algorithm>
 InternalManyRoutesResult
 RoutingAlgorithms<Algorithm>::AlternativePathSearch(const PhantomNodes &phantom_node_pair,
-                                                    unsigned number_of_alternatives) const
+                                                    unsigned number_of_alternatives,
+                                                    std::chrono::milliseconds time_budget) const
 {
     return routing_algorithms::alternativePathSearch(
-        heaps, *facade, phantom_node_pair, number_of_alternatives);
+        heaps, *facade, phantom_node_pair, number_of_alternatives, time_budget);
 }
 
 template <typename Algorithm>
@@ -167,6 +196,15 @@ InternalRouteResult RoutingAlgorithms<Algorithm>::ShortestPathSearch(
         heaps, *facade, phantom_node_pair, continue_straight_at_waypoint);
 }
 
+template <typename Algorithm>
+InternalRouteSummary RoutingAlgorithms<Algorithm>::ShortestPathSummary(
+    const std::vector<PhantomNodes> &phantom_node_pair,
+    const boost::optional<bool> continue_straight_at_waypoint) const
+{
+    return routing_algorithms::shortestPathSummary(
+        heaps, *facade, phantom_node_pair, continue_straight_at_waypoint);
+}
+
 template <typename Algorithm>
 InternalRouteResult
 RoutingAlgorithms<Algorithm>::DirectShortestPathSearch(const PhantomNodes &phantom_nodes) const
@@ -191,6 +229,27 @@ inline routing_algorithms::SubMatchingList RoutingAlgorithms<Algorithm>::MapMatc
                                            allow_splitting);
 }
 
+template <typename Algorithm>
+inline routing_algorithms::SubMatchingList RoutingAlgorithms<Algorithm>::OnlineMapMatching(
+    map_matching::MatchingSession &session,
+    const routing_algorithms::CandidateLists &candidates_list,
+    const std::vector<util::Coordinate> &trace_coordinates,
+    const std::vector<unsigned> &trace_timestamps,
+    const std::vector<boost::optional<double>> &trace_gps_precision,
+    const bool allow_splitting,
+    const bool finish) const
+{
+    return routing_algorithms::onlineMapMatching(heaps,
+                                                 *facade,
+                                                 session,
+                                                 candidates_list,
+                                                 trace_coordinates,
+                                                 trace_timestamps,
+                                                 trace_gps_precision,
+                                                 allow_splitting,
+                                                 finish);
+}
+
 template <typename Algorithm>
 std::pair<std::vector<EdgeDuration>, std::vector<EdgeDistance>>
 RoutingAlgorithms<Algorithm>::ManyToManySearch(const std::vector<PhantomNode> &phantom_nodes,
@@ -9,6 +9,10 @@
 
 #include "util/exception.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
 namespace osrm
 {
 namespace engine
@@ -16,15 +20,37 @@ namespace engine
 namespace routing_algorithms
 {
 
+// Number of via candidates the filter stages of the MLD alternatives search rejected since the
+// process started, to tune the search parameters on production traffic
+struct AlternativeFilterCounters
+{
+    std::atomic<std::uint64_t> searches{0};
+    std::atomic<std::uint64_t> candidates{0};
+    std::atomic<std::uint64_t> by_unique_node{0};
+    std::atomic<std::uint64_t> by_stretch{0};
+    std::atomic<std::uint64_t> by_via_on_path{0};
+    std::atomic<std::uint64_t> by_local_optimality{0};
+    std::atomic<std::uint64_t> by_cell_sharing{0};
+    std::atomic<std::uint64_t> by_unpacking_limit{0};
+    std::atomic<std::uint64_t> by_time_budget{0};
+    std::atomic<std::uint64_t> by_sharing{0};
+    std::atomic<std::uint64_t> by_number_of_alternatives{0};
+    std::atomic<std::uint64_t> by_annotated_stretch{0};
+};
+
+const AlternativeFilterCounters &getAlternativeFilterCounters();
+
 InternalManyRoutesResult alternativePathSearch(SearchEngineData<ch::Algorithm> &search_engine_data,
                                                const DataFacade<ch::Algorithm> &facade,
                                                const PhantomNodes &phantom_node_pair,
-                                               unsigned number_of_alternatives);
+                                               unsigned number_of_alternatives,
+                                               std::chrono::milliseconds unpacking_time_budget);
 
 InternalManyRoutesResult alternativePathSearch(SearchEngineData<mld::Algorithm> &search_engine_data,
                                                const DataFacade<mld::Algorithm> &facade,
                                                const PhantomNodes &phantom_node_pair,
-                                               unsigned number_of_alternatives);
+                                               unsigned number_of_alternatives,
+                                               std::chrono::milliseconds unpacking_time_budget);
 
 } // namespace routing_algorithms
 } // namespace engine
@@ -7,6 +7,7 @@
 
 #include "util/typedefs.hpp"
 
+#include <algorithm>
 #include <vector>
 
 namespace osrm
@@ -88,8 +89,46 @@ struct NodeBucket
         }
     };
 };
+
+// Smallest weight a search from the source phantom nodes starts with. It is negative for
+// sources with an offset, so searches from the targets can only stop at the upper bound
+// minus this value without missing paths.
+inline EdgeWeight getMinimalSourceWeight(const std::vector<PhantomNode> &phantom_nodes,
+                                         const std::vector<std::size_t> &source_indices)
+{
+    EdgeWeight min_weight = 0;
+    for (const auto index : source_indices)
+    {
+        const auto &phantom_node = phantom_nodes[index];
+        if (phantom_node.IsValidForwardSource())
+            min_weight = std::min(min_weight, -phantom_node.GetForwardWeightPlusOffset());
+        if (phantom_node.IsValidReverseSource())
+            min_weight = std::min(min_weight, -phantom_node.GetReverseWeightPlusOffset());
+    }
+    return min_weight;
+}
+
+// Paths that were found before the searches stopped can still exceed the upper bound
+inline void invalidateAboveUpperBound(const std::vector<EdgeWeight> &weights_table,
+                                      std::vector<EdgeDuration> &durations_table,
+                                      std::vector<EdgeDistance> &distances_table,
+                                      const EdgeWeight weight_upper_bound)
+{
+    for (std::size_t index = 0; index < weights_table.size(); ++index)
+    {
+        if (weights_table[index] > weight_upper_bound)
+        {
+            durations_table[index] = MAXIMAL_EDGE_DURATION;
+            if (!distances_table.empty())
+                distances_table[index] = MAXIMAL_EDGE_DISTANCE;
+        }
+    }
+}
 } // namespace
 
+// Computes the durations (and optionally distances) matrix between sources and targets.
+// If weight_upper_bound is given searches stop at this weight and paths with a higher weight
+// are reported as not found, e.g. for the transitions between candidates in map matching.
 template <typename Algorithm>
 std::pair<std::vector<EdgeDuration>, std::vector<EdgeDistance>>
 manyToManySearch(SearchEngineData<Algorithm> &engine_working_data,
@@ -97,7 +136,8 @@ manyToManySearch(SearchEngineData<Algorithm> &engine_working_data,
                  const std::vector<PhantomNode> &phantom_nodes,
                  const std::vector<std::size_t> &source_indices,
                  const std::vector<std::size_t> &target_indices,
-                 const bool calculate_distance);
+                 const bool calculate_distance,
+                 const EdgeWeight weight_upper_bound = INVALID_EDGE_WEIGHT);
 
 } // namespace routing_algorithms
 } // namespace engine
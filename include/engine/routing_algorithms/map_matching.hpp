@@ -12,6 +12,11 @@ namespace osrm
 {
 namespace engine
 {
+namespace map_matching
+{
+struct MatchingSession;
+}
+
 namespace routing_algorithms
 {
 
@@ -31,6 +36,20 @@ SubMatchingList mapMatching(SearchEngineData<Algorithm> &engine_working_data,
                             const std::vector<boost::optional<double>> &trace_gps_precision,
                             const bool allow_splitting);
 
+// Online variant of mapMatching: appends the samples to the session and returns the parts of
+// the trace that became final. If finish is set the remaining samples are matched as if the
+// trace ended and the next samples start a new sub-matching.
+template <typename Algorithm>
+SubMatchingList onlineMapMatching(SearchEngineData<Algorithm> &engine_working_data,
+                                  const DataFacade<Algorithm> &facade,
+                                  map_matching::MatchingSession &session,
+                                  const CandidateLists &candidates_list,
+                                  const std::vector<util::Coordinate> &trace_coordinates,
+                                  const std::vector<unsigned> &trace_timestamps,
+                                  const std::vector<boost::optional<double>> &trace_gps_precision,
+                                  const bool allow_splitting,
+                                  const bool finish);
+
 } // namespace routing_algorithms
 } // namespace engine
 } // namespace osrm
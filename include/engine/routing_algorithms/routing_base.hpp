@@ -147,6 +147,7 @@ void annotatePath(const FacadeT &facade,
     std::vector<SegmentWeight> weight_vector;
     std::vector<SegmentDuration> duration_vector;
     std::vector<DatasourceID> datasource_vector;
+    std::vector<std::uint8_t> zoom_level_vector;
 
     const auto get_segment_geometry = [&](const auto geometry_index) {
         const auto copy = [](auto &vector, const auto range) {
@@ -157,16 +158,18 @@ void annotatePath(const FacadeT &facade,
         if (geometry_index.forward)
         {
             copy(id_vector, facade.GetUncompressedForwardGeometry(geometry_index.id));
-            copy(weight_vector, facade.GetUncompressedForwardWeights(geometry_index.id));
-            copy(duration_vector, facade.GetUncompressedForwardDurations(geometry_index.id));
+            facade.CopyUncompressedForwardWeights(geometry_index.id, weight_vector);
+            facade.CopyUncompressedForwardDurations(geometry_index.id, duration_vector);
             copy(datasource_vector, facade.GetUncompressedForwardDatasources(geometry_index.id));
+            facade.CopyUncompressedForwardZoomLevels(geometry_index.id, zoom_level_vector);
         }
         else
         {
             copy(id_vector, facade.GetUncompressedReverseGeometry(geometry_index.id));
-            copy(weight_vector, facade.GetUncompressedReverseWeights(geometry_index.id));
-            copy(duration_vector, facade.GetUncompressedReverseDurations(geometry_index.id));
+            facade.CopyUncompressedReverseWeights(geometry_index.id, weight_vector);
+            facade.CopyUncompressedReverseDurations(geometry_index.id, duration_vector);
             copy(datasource_vector, facade.GetUncompressedReverseDatasources(geometry_index.id));
+            facade.CopyUncompressedReverseZoomLevels(geometry_index.id, zoom_level_vector);
         }
     };
 
@@ -189,6 +192,7 @@ void annotatePath(const FacadeT &facade,
         BOOST_ASSERT(datasource_vector.size() > 0);
         BOOST_ASSERT(weight_vector.size() + 1 == id_vector.size());
         BOOST_ASSERT(duration_vector.size() + 1 == id_vector.size());
+        BOOST_ASSERT(zoom_level_vector.size() == id_vector.size());
 
         const bool is_first_segment = unpacked_path.empty();
 
@@ -223,7 +227,8 @@ void annotatePath(const FacadeT &facade,
                          datasource_vector[segment_idx],
                          osrm::guidance::TurnBearing(0),
                          osrm::guidance::TurnBearing(0),
-                         is_left_hand_driving});
+                         is_left_hand_driving,
+                         zoom_level_vector[segment_idx + 1]});
         }
         BOOST_ASSERT(unpacked_path.size() > 0);
         if (facade.HasLaneData(turn_id))
@@ -281,9 +286,10 @@ void annotatePath(const FacadeT &facade,
     {
         BOOST_ASSERT(segment_idx < static_cast<std::size_t>(id_vector.size() - 1));
         BOOST_ASSERT(facade.GetTravelMode(target_node_id) > 0);
+        const auto via_index = start_index < end_index ? segment_idx + 1 : segment_idx - 1;
         unpacked_path.push_back(
             PathData{target_node_id,
-                     id_vector[start_index < end_index ? segment_idx + 1 : segment_idx - 1],
+                     id_vector[via_index],
                      facade.GetNameIndex(target_node_id),
                      facade.IsSegregated(target_node_id),
                      static_cast<EdgeWeight>(weight_vector[segment_idx]),
@@ -298,7 +304,8 @@ void annotatePath(const FacadeT &facade,
                      datasource_vector[segment_idx],
                      guidance::TurnBearing(0),
                      guidance::TurnBearing(0),
-                     is_target_left_hand_driving});
+                     is_target_left_hand_driving,
+                     zoom_level_vector[via_index]});
     }
 
     if (unpacked_path.size() > 0)
@@ -5,7 +5,9 @@
 #include "engine/datafacade.hpp"
 #include "engine/routing_algorithms/routing_base.hpp"
 #include "engine/search_engine_data.hpp"
+#include "engine/unpacking_cache.hpp"
 
+#include "util/for_each_pair.hpp"
 #include "util/typedefs.hpp"
 
 #include <boost/assert.hpp>
@@ -198,11 +200,11 @@ std::tuple<EdgeWeight, EdgeDistance> getLoopWeight(const DataFacade<Algorithm> &
             const NodeID to = facade.GetTarget(edge);
             if (to == node)
             {
-                const auto value = UseDuration ? data.duration : data.weight;
+                const auto value = UseDuration ? facade.GetEdgeDuration(edge) : data.weight;
                 if (value < loop_weight)
                 {
                     loop_weight = value;
-                    loop_distance = data.distance;
+                    loop_distance = facade.GetEdgeDistance(edge);
                 }
             }
         }
@@ -210,6 +212,167 @@ std::tuple<EdgeWeight, EdgeDistance> getLoopWeight(const DataFacade<Algorithm> &
     return std::make_tuple(loop_weight, loop_distance);
 }
 
+namespace detail
+{
+// Finds the edge for the path segment from -> to. Segments found by the backward search are
+// stored at `to`, in this case `reversed` is set.
+inline EdgeID findPathEdge(const DataFacade<Algorithm> &facade,
+                           const NodeID from,
+                           const NodeID to,
+                           bool &reversed)
+{
+    // Look for an edge on the forward CH graph (.forward)
+    EdgeID smaller_edge_id =
+        facade.FindSmallestEdge(from, to, [](const auto &data) { return data.forward; });
+    reversed = false;
+
+    // If we didn't find one there, the we might be looking at a part of the path that
+    // was found using the backward search.  Here, we flip the node order (.second, .first)
+    // and only consider edges with the `.backward` flag.
+    if (SPECIAL_EDGEID == smaller_edge_id)
+    {
+        smaller_edge_id =
+            facade.FindSmallestEdge(to, from, [](const auto &data) { return data.backward; });
+        reversed = true;
+    }
+
+    // If we didn't find anything *still*, then something is broken and someone has
+    // called this function with bad values.
+    BOOST_ASSERT_MSG(smaller_edge_id != SPECIAL_EDGEID, "Invalid smaller edge ID");
+    BOOST_ASSERT_MSG(facade.GetEdgeData(smaller_edge_id).weight !=
+                         std::numeric_limits<EdgeWeight>::max(),
+                     "edge weight invalid");
+
+    return smaller_edge_id;
+}
+
+// Depth-first unpacking of a single CH edge, calls `callback` for all original edges it consists
+// of in order
+template <typename Callback>
+void unpackCHEdge(const DataFacade<Algorithm> &facade,
+                  const std::pair<NodeID, NodeID> packed_edge,
+                  const EdgeID packed_edge_id,
+                  Callback &&callback)
+{
+    std::stack<std::pair<NodeID, NodeID>> recursion_stack;
+
+    std::pair<NodeID, NodeID> edge = packed_edge;
+    EdgeID edge_id = packed_edge_id;
+    while (true)
+    {
+        const auto &data = facade.GetEdgeData(edge_id);
+
+        // If the edge is a shortcut, we need to add the two halfs to the stack.
+        if (data.shortcut)
+        { // unpack
+            const NodeID middle_node_id = data.turn_id;
+            // Note the order here - we're adding these to a stack, so we
+            // want the first->middle to get visited before middle->second
+            recursion_stack.emplace(middle_node_id, edge.second);
+            recursion_stack.emplace(edge.first, middle_node_id);
+        }
+        else
+        {
+            // We found an original edge, call our callback.
+            callback(edge, edge_id);
+        }
+
+        if (recursion_stack.empty())
+            break;
+
+        edge = recursion_stack.top();
+        recursion_stack.pop();
+
+        bool reversed;
+        edge_id = findPathEdge(facade, edge.first, edge.second, reversed);
+    }
+}
+
+// Same as unpackCHEdge, but shortcuts of all levels are looked up in the cache first. Shortcuts
+// that were not cached are added once they are unpacked, unless they are too large to be used by
+// more than a few routes. Large one-off shortcuts thereby still profit from the cached shortcuts
+// they consist of, without evicting them.
+template <typename Callback>
+void unpackCHEdgeCached(const DataFacade<Algorithm> &facade,
+                        UnpackingCache &cache,
+                        const std::pair<NodeID, NodeID> packed_edge,
+                        const EdgeID packed_edge_id,
+                        const bool packed_edge_reversed,
+                        Callback &&callback)
+{
+    struct Task
+    {
+        std::pair<NodeID, NodeID> edge;
+        EdgeID edge_id;
+        bool reversed;
+        // set once the halves of the shortcut are on the stack, the original edges of the
+        // shortcut start at `first_edge` of the result when the task is reached again
+        bool unpacked;
+        std::size_t first_edge;
+    };
+
+    UnpackedShortcut result;
+    result.nodes.push_back(packed_edge.first);
+
+    std::vector<Task> stack;
+    stack.push_back({packed_edge, packed_edge_id, packed_edge_reversed, false, 0});
+    while (!stack.empty())
+    {
+        auto task = stack.back();
+        stack.pop_back();
+
+        const auto key = UnpackingCache::MakeKey(task.edge_id, task.reversed);
+        if (task.unpacked)
+        {
+            if (result.edges.size() - task.first_edge <= UnpackingCache::MAX_CACHED_EDGES)
+            {
+                UnpackedShortcut shortcut;
+                shortcut.nodes.assign(result.nodes.begin() + task.first_edge, result.nodes.end());
+                shortcut.edges.assign(result.edges.begin() + task.first_edge, result.edges.end());
+                cache.Insert(key, std::move(shortcut));
+            }
+            continue;
+        }
+
+        const auto &data = facade.GetEdgeData(task.edge_id);
+        if (!data.shortcut)
+        {
+            result.nodes.push_back(task.edge.second);
+            result.edges.push_back(task.edge_id);
+            continue;
+        }
+
+        if (const auto cached = cache.Find(key))
+        {
+            result.nodes.insert(result.nodes.end(), cached->nodes.begin() + 1, cached->nodes.end());
+            result.edges.insert(result.edges.end(), cached->edges.begin(), cached->edges.end());
+            continue;
+        }
+
+        task.unpacked = true;
+        task.first_edge = result.edges.size();
+        stack.push_back(task);
+
+        // Note the order here - we're adding these to a stack, so we
+        // want the first->middle to get visited before middle->second
+        const NodeID middle_node_id = data.turn_id;
+        for (const auto &half : {std::make_pair(middle_node_id, task.edge.second),
+                                 std::make_pair(task.edge.first, middle_node_id)})
+        {
+            bool reversed;
+            const auto half_id = findPathEdge(facade, half.first, half.second, reversed);
+            stack.push_back({half, half_id, reversed, false, 0});
+        }
+    }
+
+    for (std::size_t index = 0; index < result.edges.size(); ++index)
+    {
+        std::pair<NodeID, NodeID> original{result.nodes[index], result.nodes[index + 1]};
+        callback(original, result.edges[index]);
+    }
+}
+}
+
 /**
  * Given a sequence of connected `NodeID`s in the CH graph, performs a depth-first unpacking of
  * the shortcut
@@ -225,6 +388,10 @@ std::tuple<EdgeWeight, EdgeDistance> getLoopWeight(const DataFacade<Algorithm> &
  * the original route
  * from beginning to end.
  *
+ * Shortcuts are looked up in the unpacking cache of the facade first, so shortcuts that are
+ * used by many routes are only unpacked once. This includes the shortcuts nested in the
+ * shortcuts of the packed path.
+ *
  * @param packed_path_begin iterator pointing to the start of the NodeID list
  * @param packed_path_end iterator pointing to the end of the NodeID list
  * @param callback void(const std::pair<NodeID, NodeID>, const EdgeID &) called for each
@@ -240,59 +407,45 @@ void unpackPath(const DataFacade<Algorithm> &facade,
     if (packed_path_begin == packed_path_end)
         return;
 
-    std::stack<std::pair<NodeID, NodeID>> recursion_stack;
-
-    // We have to push the path in reverse order onto the stack because it's LIFO.
-    for (auto current = std::prev(packed_path_end); current != packed_path_begin;
-         current = std::prev(current))
-    {
-        recursion_stack.emplace(*std::prev(current), *current);
-    }
+    auto *cache = facade.GetUnpackingCache();
 
-    std::pair<NodeID, NodeID> edge;
-    while (!recursion_stack.empty())
+    for (auto current = std::next(packed_path_begin); current != packed_path_end; ++current)
     {
-        edge = recursion_stack.top();
-        recursion_stack.pop();
+        std::pair<NodeID, NodeID> edge{*std::prev(current), *current};
 
-        // Look for an edge on the forward CH graph (.forward)
-        EdgeID smaller_edge_id = facade.FindSmallestEdge(
-            edge.first, edge.second, [](const auto &data) { return data.forward; });
+        bool reversed;
+        const auto edge_id = detail::findPathEdge(facade, edge.first, edge.second, reversed);
 
-        // If we didn't find one there, the we might be looking at a part of the path that
-        // was found using the backward search.  Here, we flip the node order (.second, .first)
-        // and only consider edges with the `.backward` flag.
-        if (SPECIAL_EDGEID == smaller_edge_id)
+        if (!cache || !facade.GetEdgeData(edge_id).shortcut)
         {
-            smaller_edge_id = facade.FindSmallestEdge(
-                edge.second, edge.first, [](const auto &data) { return data.backward; });
-        }
-
-        // If we didn't find anything *still*, then something is broken and someone has
-        // called this function with bad values.
-        BOOST_ASSERT_MSG(smaller_edge_id != SPECIAL_EDGEID, "Invalid smaller edge ID");
-
-        const auto &data = facade.GetEdgeData(smaller_edge_id);
-        BOOST_ASSERT_MSG(data.weight != std::numeric_limits<EdgeWeight>::max(),
-                         "edge weight invalid");
-
-        // If the edge is a shortcut, we need to add the two halfs to the stack.
-        if (data.shortcut)
-        { // unpack
-            const NodeID middle_node_id = data.turn_id;
-            // Note the order here - we're adding these to a stack, so we
-            // want the first->middle to get visited before middle->second
-            recursion_stack.emplace(middle_node_id, edge.second);
-            recursion_stack.emplace(edge.first, middle_node_id);
+            detail::unpackCHEdge(facade, edge, edge_id, callback);
         }
         else
         {
-            // We found an original edge, call our callback.
-            std::forward<Callback>(callback)(edge, smaller_edge_id);
+            detail::unpackCHEdgeCached(facade, *cache, edge, edge_id, reversed, callback);
         }
     }
 }
 
+// Sums up weight, duration and distance of the CH edges between the nodes of a packed path.
+// Shortcuts store the sums of the edges they consist of, so no edge is unpacked.
+template <typename RandomIter>
+InternalRouteSummary::Leg summarizePackedPath(const DataFacade<Algorithm> &facade,
+                                              RandomIter packed_path_begin,
+                                              RandomIter packed_path_end)
+{
+    InternalRouteSummary::Leg summary{0, 0, 0};
+    util::for_each_pair(
+        packed_path_begin, packed_path_end, [&](const NodeID from, const NodeID to) {
+            bool reversed;
+            const auto edge = detail::findPathEdge(facade, from, to, reversed);
+            summary.weight += facade.GetEdgeData(edge).weight;
+            summary.duration += facade.GetEdgeDuration(edge);
+            summary.distance += facade.GetEdgeDistance(edge);
+        });
+    return summary;
+}
+
 template <typename BidirectionalIterator>
 EdgeDistance calculateEBGNodeAnnotations(const DataFacade<Algorithm> &facade,
                                          BidirectionalIterator packed_path_begin,
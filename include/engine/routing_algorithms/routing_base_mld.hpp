@@ -564,6 +564,26 @@ void unpackPath(const FacadeT &facade,
     annotatePath(facade, phantom_nodes, unpacked_nodes, unpacked_edges, unpacked_path);
 }
 
+// Sums up weight, duration and distance of the edges between the nodes of a path. The MLD
+// search returns unpacked paths, every edge adds the values of its source node and turn.
+template <typename RandomIter>
+InternalRouteSummary::Leg summarizePackedPath(const DataFacade<Algorithm> &facade,
+                                              RandomIter packed_path_begin,
+                                              RandomIter packed_path_end)
+{
+    InternalRouteSummary::Leg summary{0, 0, 0};
+    util::for_each_pair(
+        packed_path_begin, packed_path_end, [&](const NodeID from, const NodeID to) {
+            const auto turn_id = facade.GetEdgeData(facade.FindEdge(from, to)).turn_id;
+            summary.weight +=
+                facade.GetNodeWeight(from) + facade.GetWeightPenaltyForEdgeID(turn_id);
+            summary.duration +=
+                facade.GetNodeDuration(from) + facade.GetDurationPenaltyForEdgeID(turn_id);
+            summary.distance += facade.GetNodeDistance(from);
+        });
+    return summary;
+}
+
 template <typename Algorithm>
 double getNetworkDistance(SearchEngineData<Algorithm> &engine_working_data,
                           const DataFacade<Algorithm> &facade,
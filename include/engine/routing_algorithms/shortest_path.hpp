@@ -19,6 +19,14 @@ InternalRouteResult shortestPathSearch(SearchEngineData<Algorithm> &engine_worki
                                        const std::vector<PhantomNodes> &phantom_nodes_vector,
                                        const boost::optional<bool> continue_straight_at_waypoint);
 
+// Same route as shortestPathSearch, but only computes weight, duration and distance of the legs
+template <typename Algorithm>
+InternalRouteSummary
+shortestPathSummary(SearchEngineData<Algorithm> &engine_working_data,
+                    const DataFacade<Algorithm> &facade,
+                    const std::vector<PhantomNodes> &phantom_nodes_vector,
+                    const boost::optional<bool> continue_straight_at_waypoint);
+
 } // namespace routing_algorithms
 } // namespace engine
 } // namespace osrm
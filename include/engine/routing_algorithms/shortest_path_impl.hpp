@@ -208,6 +208,71 @@ void unpackLegs(const DataFacade<Algorithm> &facade,
     }
 }
 
+template <typename Algorithm>
+void summarizeLegs(const DataFacade<Algorithm> &facade,
+                   const std::vector<PhantomNodes> &phantom_nodes_vector,
+                   const std::vector<NodeID> &total_packed_path,
+                   const std::vector<std::size_t> &packed_leg_begin,
+                   const EdgeWeight shortest_path_weight,
+                   InternalRouteSummary &summary)
+{
+    summary.shortest_path_weight = shortest_path_weight;
+
+    for (const auto current_leg : util::irange<std::size_t>(0UL, packed_leg_begin.size() - 1))
+    {
+        auto leg_begin = total_packed_path.begin() + packed_leg_begin[current_leg];
+        auto leg_end = total_packed_path.begin() + packed_leg_begin[current_leg + 1];
+        const auto &source_phantom = phantom_nodes_vector[current_leg].source_phantom;
+        const auto &target_phantom = phantom_nodes_vector[current_leg].target_phantom;
+
+        auto leg = summarizePackedPath(facade, leg_begin, leg_end);
+
+        // the search starts at the beginning of the source node and ends at the end of the target
+        // node, the phantom nodes give the parts before the source and after the target
+        if (*leg_begin == source_phantom.forward_segment_id.id)
+        {
+            leg.weight -= source_phantom.GetForwardWeightPlusOffset();
+            leg.duration -= source_phantom.GetForwardDuration();
+            leg.distance -= source_phantom.GetForwardDistance();
+        }
+        else
+        {
+            leg.weight -= source_phantom.GetReverseWeightPlusOffset();
+            leg.duration -= source_phantom.GetReverseDuration();
+            leg.distance -= source_phantom.GetReverseDistance();
+        }
+
+        if (*std::prev(leg_end) == target_phantom.forward_segment_id.id)
+        {
+            leg.weight += target_phantom.GetForwardWeightPlusOffset();
+            leg.duration += target_phantom.GetForwardDuration();
+            leg.distance += target_phantom.GetForwardDistance();
+        }
+        else
+        {
+            leg.weight += target_phantom.GetReverseWeightPlusOffset();
+            leg.duration += target_phantom.GetReverseDuration();
+            leg.distance += target_phantom.GetReverseDistance();
+        }
+
+        // use rectified linear unit function to avoid negative values
+        // due to flooring errors in phantom snapping
+        leg.duration = std::max<EdgeDuration>(0, leg.duration);
+        leg.distance = std::max<EdgeDistance>(0, leg.distance);
+
+        summary.legs.push_back(leg);
+    }
+}
+
+// Packed path of the shortest route through all phantom node pairs. The packed path of leg i
+// is [leg_begin[i], leg_begin[i + 1]), the last entry of leg_begin is a sentinel.
+struct PackedRoute
+{
+    std::vector<NodeID> path;
+    std::vector<std::size_t> leg_begin;
+    EdgeWeight weight = INVALID_EDGE_WEIGHT;
+};
+
 template <typename Algorithm>
 inline void initializeHeap(SearchEngineData<Algorithm> &engine_working_data,
                            const DataFacade<Algorithm> &facade)
@@ -226,16 +291,14 @@ inline void initializeHeap<mld::Algorithm>(SearchEngineData<mld::Algorithm> &eng
     const auto border_nodes_number = facade.GetMaxBorderNodeID() + 1;
     engine_working_data.InitializeOrClearFirstThreadLocalStorage(nodes_number, border_nodes_number);
 }
-}
 
+// Finds the shortest route through a list of vias, returns an invalid weight if there is none
 template <typename Algorithm>
-InternalRouteResult shortestPathSearch(SearchEngineData<Algorithm> &engine_working_data,
-                                       const DataFacade<Algorithm> &facade,
-                                       const std::vector<PhantomNodes> &phantom_nodes_vector,
-                                       const boost::optional<bool> continue_straight_at_waypoint)
+PackedRoute searchPackedRoute(SearchEngineData<Algorithm> &engine_working_data,
+                              const DataFacade<Algorithm> &facade,
+                              const std::vector<PhantomNodes> &phantom_nodes_vector,
+                              const boost::optional<bool> continue_straight_at_waypoint)
 {
-    InternalRouteResult raw_route_data;
-    raw_route_data.segment_end_coordinates = phantom_nodes_vector;
     const bool allow_uturn_at_waypoint =
         !(continue_straight_at_waypoint ? *continue_straight_at_waypoint
                                         : facade.GetContinueStraightDefault());
@@ -346,7 +409,7 @@ InternalRouteResult shortestPathSearch(SearchEngineData<Algorithm> &engine_worki
         if ((INVALID_EDGE_WEIGHT == new_total_weight_to_forward) &&
             (INVALID_EDGE_WEIGHT == new_total_weight_to_reverse))
         {
-            return raw_route_data;
+            return {};
         }
 
         // we need to figure out how the new legs connect to the previous ones
@@ -443,6 +506,7 @@ InternalRouteResult shortestPathSearch(SearchEngineData<Algorithm> &engine_worki
                  total_weight_to_reverse != INVALID_EDGE_WEIGHT);
 
     // We make sure the fastest route is always in packed_legs_to_forward
+    PackedRoute route;
     if (total_weight_to_forward < total_weight_to_reverse ||
         (total_weight_to_forward == total_weight_to_reverse &&
          total_packed_path_to_forward.size() < total_packed_path_to_reverse.size()))
@@ -451,12 +515,9 @@ InternalRouteResult shortestPathSearch(SearchEngineData<Algorithm> &engine_worki
         packed_leg_to_forward_begin.push_back(total_packed_path_to_forward.size());
         BOOST_ASSERT(packed_leg_to_forward_begin.size() == phantom_nodes_vector.size() + 1);
 
-        unpackLegs(facade,
-                   phantom_nodes_vector,
-                   total_packed_path_to_forward,
-                   packed_leg_to_forward_begin,
-                   total_weight_to_forward,
-                   raw_route_data);
+        route.path = std::move(total_packed_path_to_forward);
+        route.leg_begin = std::move(packed_leg_to_forward_begin);
+        route.weight = total_weight_to_forward;
     }
     else
     {
@@ -464,17 +525,60 @@ InternalRouteResult shortestPathSearch(SearchEngineData<Algorithm> &engine_worki
         packed_leg_to_reverse_begin.push_back(total_packed_path_to_reverse.size());
         BOOST_ASSERT(packed_leg_to_reverse_begin.size() == phantom_nodes_vector.size() + 1);
 
+        route.path = std::move(total_packed_path_to_reverse);
+        route.leg_begin = std::move(packed_leg_to_reverse_begin);
+        route.weight = total_weight_to_reverse;
+    }
+
+    return route;
+}
+}
+
+template <typename Algorithm>
+InternalRouteResult shortestPathSearch(SearchEngineData<Algorithm> &engine_working_data,
+                                       const DataFacade<Algorithm> &facade,
+                                       const std::vector<PhantomNodes> &phantom_nodes_vector,
+                                       const boost::optional<bool> continue_straight_at_waypoint)
+{
+    InternalRouteResult raw_route_data;
+    raw_route_data.segment_end_coordinates = phantom_nodes_vector;
+
+    const auto route = searchPackedRoute(
+        engine_working_data, facade, phantom_nodes_vector, continue_straight_at_waypoint);
+    if (route.weight != INVALID_EDGE_WEIGHT)
+    {
         unpackLegs(facade,
                    phantom_nodes_vector,
-                   total_packed_path_to_reverse,
-                   packed_leg_to_reverse_begin,
-                   total_weight_to_reverse,
+                   route.path,
+                   route.leg_begin,
+                   route.weight,
                    raw_route_data);
     }
 
     return raw_route_data;
 }
 
+template <typename Algorithm>
+InternalRouteSummary
+shortestPathSummary(SearchEngineData<Algorithm> &engine_working_data,
+                    const DataFacade<Algorithm> &facade,
+                    const std::vector<PhantomNodes> &phantom_nodes_vector,
+                    const boost::optional<bool> continue_straight_at_waypoint)
+{
+    InternalRouteSummary summary;
+    summary.segment_end_coordinates = phantom_nodes_vector;
+
+    const auto route = searchPackedRoute(
+        engine_working_data, facade, phantom_nodes_vector, continue_straight_at_waypoint);
+    if (route.weight != INVALID_EDGE_WEIGHT)
+    {
+        summarizeLegs(
+            facade, phantom_nodes_vector, route.path, route.leg_begin, route.weight, summary);
+    }
+
+    return summary;
+}
+
 } // namespace routing_algorithms
 } // namespace engine
 } // namespace osrm
@@ -0,0 +1,142 @@
+#ifndef TRIP_HELD_KARP_HPP
+#define TRIP_HELD_KARP_HPP
+
+#include "util/dist_table_wrapper.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace trip
+{
+
+namespace detail
+{
+// Larger than every valid tour, but small enough that two of them can be added without overflow.
+// Invalid table entries (e.g. introduced for fixed start and end) are mapped to this value.
+const constexpr EdgeWeight HELD_KARP_INFINITY = INVALID_EDGE_WEIGHT / 2;
+
+// Returns min over all k of (row[k] + column[k]). Both arrays are contiguous and the loop has no
+// branches, so the compiler can turn it into a vectorized min-reduction.
+inline EdgeWeight
+minimalSum(const EdgeWeight *row, const EdgeWeight *column, const std::size_t size)
+{
+    EdgeWeight minimum = HELD_KARP_INFINITY;
+    for (std::size_t k = 0; k < size; ++k)
+    {
+        minimum = std::min(minimum, row[k] + column[k]);
+    }
+    return std::min(minimum, HELD_KARP_INFINITY);
+}
+}
+
+// computes the optimal round trip with the dynamic programming algorithm of Held and Karp.
+// Needs O(2^n * n) memory and O(2^n * n^2) time, so it is only feasible for small trips.
+// Of all optimal trips the lexicographically smallest one that starts at 0 is returned, which
+// is the same trip BruteForceTrip finds.
+inline std::vector<NodeID> HeldKarpTrip(const std::size_t number_of_locations,
+                                        const util::DistTableWrapper<EdgeWeight> &dist_table)
+{
+    BOOST_ASSERT(number_of_locations > 0);
+    BOOST_ASSERT_MSG(number_of_locations * number_of_locations == dist_table.size(),
+                     "number_of_locations and dist_table size do not match");
+
+    std::vector<NodeID> route(1, 0);
+    if (number_of_locations < 3)
+    {
+        if (number_of_locations == 2)
+            route.push_back(1);
+        return route;
+    }
+
+    // Location 0 is the start and end of the round trip, all other locations are numbered from 0
+    // to width - 1 and form the subsets of the table.
+    const std::size_t width = number_of_locations - 1;
+    const std::size_t number_of_subsets = std::size_t{1} << width;
+
+    const auto weight = [&](const NodeID from, const NodeID to) {
+        const auto value = dist_table(from, to);
+        return value >= detail::HELD_KARP_INFINITY ? detail::HELD_KARP_INFINITY : value;
+    };
+
+    // outgoing[j * width + k] is the weight from j to k, outgoing from location 0 is stored last
+    std::vector<EdgeWeight> outgoing((width + 1) * width);
+    for (std::size_t k = 0; k < width; ++k)
+    {
+        for (std::size_t j = 0; j < width; ++j)
+        {
+            outgoing[j * width + k] = weight(j + 1, k + 1);
+        }
+        outgoing[width * width + k] = weight(0, k + 1);
+    }
+
+    // remaining[subset * width + j] is the weight of the shortest path that starts at j, visits
+    // all locations in subset and ends at location 0. Locations that are not in the subset have
+    // an infinite weight, which keeps the min-reduction free of branches.
+    std::vector<EdgeWeight> remaining(number_of_subsets * width, detail::HELD_KARP_INFINITY);
+    for (std::size_t j = 0; j < width; ++j)
+    {
+        remaining[(std::size_t{1} << j) * width + j] = weight(j + 1, 0);
+    }
+
+    // subsets are processed in increasing order, a subset without j is always smaller
+    for (std::size_t subset = 1; subset < number_of_subsets; ++subset)
+    {
+        if ((subset & (subset - 1)) == 0)
+            continue;
+
+        for (std::size_t j = 0; j < width; ++j)
+        {
+            const std::size_t bit = std::size_t{1} << j;
+            if ((subset & bit) == 0)
+                continue;
+
+            remaining[subset * width + j] = detail::minimalSum(
+                &remaining[(subset ^ bit) * width], &outgoing[j * width], width);
+        }
+    }
+
+    // walk the trip from location 0 and always take the smallest next location that still
+    // allows the optimal weight
+    std::size_t subset = number_of_subsets - 1;
+    const EdgeWeight *current_outgoing = &outgoing[width * width];
+    auto remaining_weight =
+        detail::minimalSum(&remaining[subset * width], current_outgoing, width);
+    while (subset != 0)
+    {
+        const auto *row = &remaining[subset * width];
+        std::size_t next = width;
+        for (std::size_t k = 0; k < width; ++k)
+        {
+            if ((subset & (std::size_t{1} << k)) != 0 &&
+                std::min(current_outgoing[k] + row[k], detail::HELD_KARP_INFINITY) ==
+                    remaining_weight)
+            {
+                next = k;
+                break;
+            }
+        }
+        BOOST_ASSERT(next < width);
+
+        route.push_back(next + 1);
+        remaining_weight = row[next];
+        current_outgoing = &outgoing[next * width];
+        subset ^= std::size_t{1} << next;
+    }
+
+    return route;
+}
+
+} // namespace trip
+} // namespace engine
+} // namespace osrm
+
+#endif // TRIP_HELD_KARP_HPP
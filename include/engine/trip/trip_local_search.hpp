@@ -0,0 +1,205 @@
+#ifndef TRIP_LOCAL_SEARCH_HPP
+#define TRIP_LOCAL_SEARCH_HPP
+
+#include "engine/trip/trip_farthest_insertion.hpp"
+#include "util/dist_table_wrapper.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/assert.hpp>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace trip
+{
+
+namespace detail
+{
+// Tour weights are summed up in 64 bit: invalid table entries then make every tour that uses them
+// heavier than any valid tour, so improving moves never introduce them.
+using TourWeight = std::int64_t;
+
+inline TourWeight TripWeight(const util::DistTableWrapper<EdgeWeight> &dist_table,
+                             const std::vector<NodeID> &route)
+{
+    TourWeight weight = 0;
+    for (std::size_t i = 0; i < route.size(); ++i)
+    {
+        weight += dist_table(route[i], route[(i + 1) % route.size()]);
+    }
+    return weight;
+}
+
+// Visits the nearest unvisited location next, starting at the given one
+inline std::vector<NodeID> GreedyTrip(const util::DistTableWrapper<EdgeWeight> &dist_table,
+                                      const NodeID start)
+{
+    const auto number_of_locations = dist_table.GetNumberOfNodes();
+
+    std::vector<NodeID> route;
+    route.reserve(number_of_locations);
+    route.push_back(start);
+
+    std::vector<bool> visited(number_of_locations, false);
+    visited[start] = true;
+    for (std::size_t added_nodes = 1; added_nodes < number_of_locations; ++added_nodes)
+    {
+        // invalid entries have the largest weight, so they are only used as a last resort
+        NodeID next = SPECIAL_NODEID;
+        for (NodeID id = 0; id < number_of_locations; ++id)
+        {
+            if (!visited[id] &&
+                (next == SPECIAL_NODEID ||
+                 dist_table(route.back(), id) < dist_table(route.back(), next)))
+            {
+                next = id;
+            }
+        }
+        BOOST_ASSERT(next != SPECIAL_NODEID);
+        visited[next] = true;
+        route.push_back(next);
+    }
+    return route;
+}
+
+// Improves the round trip in place with 2-opt and Or-opt moves until it is a local optimum or
+// the deadline is reached. The distance table does not have to be symmetric: the weights of
+// reversed segments are looked up in prefix sums of both directions of the tour.
+inline void ImproveTrip(const util::DistTableWrapper<EdgeWeight> &dist_table,
+                        std::vector<NodeID> &route,
+                        const std::chrono::steady_clock::time_point deadline)
+{
+    const auto size = route.size();
+    if (size < 4)
+        return;
+
+    const auto weight = [&](const NodeID from, const NodeID to) -> TourWeight {
+        return dist_table(from, to);
+    };
+
+    // forward[i] is the weight of route[0] -> ... -> route[i], backward[i] the weight of
+    // route[i] -> ... -> route[0]
+    std::vector<TourWeight> forward(size), backward(size);
+    const auto update_prefix_sums = [&] {
+        forward[0] = backward[0] = 0;
+        for (std::size_t i = 1; i < size; ++i)
+        {
+            forward[i] = forward[i - 1] + weight(route[i - 1], route[i]);
+            backward[i] = backward[i - 1] + weight(route[i], route[i - 1]);
+        }
+    };
+
+    // Reverses route[i + 1 .. j]
+    const auto try_two_opt = [&](const std::size_t i, const std::size_t j) {
+        const auto a = route[i], b = route[i + 1], c = route[j], d = route[(j + 1) % size];
+        const auto old_weight = weight(a, b) + (forward[j] - forward[i + 1]) + weight(c, d);
+        const auto new_weight = weight(a, c) + (backward[j] - backward[i + 1]) + weight(b, d);
+        if (new_weight >= old_weight)
+            return false;
+
+        std::reverse(route.begin() + i + 1, route.begin() + j + 1);
+        return true;
+    };
+
+    // Moves route[i .. i + length - 1] between route[j] and its successor
+    const auto try_or_opt = [&](
+        const std::size_t i, const std::size_t length, const std::size_t j) {
+        const auto prev = route[(i + size - 1) % size];
+        const auto first = route[i];
+        const auto last = route[(i + length - 1) % size];
+        const auto next = route[(i + length) % size];
+        const auto c = route[j], d = route[(j + 1) % size];
+
+        const auto removed = weight(prev, first) + weight(last, next) + weight(c, d);
+        const auto added = weight(prev, next) + weight(c, first) + weight(last, d);
+        if (added >= removed)
+            return false;
+
+        // rotate the tour so the segment starts at 0, then move it behind c
+        std::rotate(route.begin(), route.begin() + i, route.end());
+        const auto target = (j + size - i) % size;
+        std::rotate(route.begin(), route.begin() + length, route.begin() + target + 1);
+        return true;
+    };
+
+    bool improved = true;
+    while (improved && std::chrono::steady_clock::now() < deadline)
+    {
+        improved = false;
+        update_prefix_sums();
+
+        for (std::size_t i = 0; i + 2 < size && !improved; ++i)
+        {
+            for (std::size_t j = i + 2; j < size && !improved; ++j)
+            {
+                // same edge as (i, i + 1) for the last edge of the tour
+                if (i == 0 && j == size - 1)
+                    continue;
+                improved = try_two_opt(i, j);
+            }
+        }
+
+        for (std::size_t length = 1; length <= 3 && length + 2 < size && !improved; ++length)
+        {
+            for (std::size_t i = 0; i < size && !improved; ++i)
+            {
+                // insertion points are all edges that do not touch the segment
+                for (std::size_t offset = length; offset + 1 < size && !improved; ++offset)
+                {
+                    improved = try_or_opt(i, length, (i + offset) % size);
+                }
+            }
+        }
+    }
+}
+}
+
+// Computes a round trip with farthest insertion and nearest neighbour tours as start solutions
+// that are improved in parallel with 2-opt and Or-opt until the time budget is used up.
+// Returns the best local optimum that was found.
+inline std::vector<NodeID> LocalSearchTrip(const std::size_t number_of_locations,
+                                           const util::DistTableWrapper<EdgeWeight> &dist_table,
+                                           const std::chrono::milliseconds time_budget)
+{
+    const auto deadline = std::chrono::steady_clock::now() + time_budget;
+
+    std::vector<std::vector<NodeID>> routes;
+    routes.push_back(FarthestInsertionTrip(number_of_locations, dist_table));
+
+    // greedy tours from a few different start locations give the search some diversity
+    const constexpr std::size_t NUMBER_OF_GREEDY_STARTS = 7;
+    const auto step = std::max<std::size_t>(1, number_of_locations / NUMBER_OF_GREEDY_STARTS);
+    for (std::size_t start = 0; start < number_of_locations; start += step)
+    {
+        routes.push_back(detail::GreedyTrip(dist_table, start));
+    }
+
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, routes.size(), 1),
+                      [&](const tbb::blocked_range<std::size_t> &range) {
+                          for (auto index = range.begin(); index != range.end(); ++index)
+                          {
+                              detail::ImproveTrip(dist_table, routes[index], deadline);
+                          }
+                      });
+
+    return *std::min_element(
+        routes.begin(), routes.end(), [&](const auto &lhs, const auto &rhs) {
+            return detail::TripWeight(dist_table, lhs) < detail::TripWeight(dist_table, rhs);
+        });
+}
+
+} // namespace trip
+} // namespace engine
+} // namespace osrm
+
+#endif // TRIP_LOCAL_SEARCH_HPP
@@ -0,0 +1,169 @@
+#ifndef OSRM_ENGINE_UNPACKING_CACHE_HPP
+#define OSRM_ENGINE_UNPACKING_CACHE_HPP
+
+#include "util/typedefs.hpp"
+
+#include <boost/assert.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+
+// The original edges a CH shortcut consists of: edges[i] leads from nodes[i] to nodes[i + 1]
+struct UnpackedShortcut
+{
+    std::vector<NodeID> nodes;
+    std::vector<EdgeID> edges;
+};
+
+/**
+ * Bounded least recently used cache of unpacked CH shortcuts that is safe to share between
+ * threads.
+ *
+ * Shortcuts are keyed by their edge id and the direction they are traversed in. The keys are
+ * spread over independently locked shards, every shard evicts its least recently used shortcuts
+ * as soon as it holds more than its share of the capacity. The capacity is given in bytes and
+ * includes the bookkeeping of every entry, so it bounds the memory the cache uses.
+ */
+class UnpackingCache
+{
+  public:
+    using Key = std::uint64_t;
+
+    // Shortcuts with more original edges are rarely used by more than one route, they are not
+    // cached but the shortcuts they consist of are
+    static constexpr std::size_t MAX_CACHED_EDGES = 1024;
+
+    explicit UnpackingCache(const std::size_t capacity_in_bytes)
+        : shard_capacity(capacity_in_bytes / NUMBER_OF_SHARDS)
+    {
+    }
+
+    static Key MakeKey(const EdgeID edge, const bool reversed)
+    {
+        return (static_cast<Key>(edge) << 1) | static_cast<Key>(reversed);
+    }
+
+    // Approximate number of bytes a cached shortcut uses: its ids, the shortcut and its shared
+    // control block, the node in the LRU list and the node and bucket in the index
+    static std::size_t EntrySize(const UnpackedShortcut &shortcut)
+    {
+        const constexpr std::size_t ENTRY_OVERHEAD =
+            sizeof(UnpackedShortcut) + 2 * sizeof(long) + sizeof(Entry) + 2 * sizeof(void *) +
+            sizeof(std::pair<const Key, std::list<Entry>::iterator>) + 2 * sizeof(void *);
+        return ENTRY_OVERHEAD + shortcut.nodes.capacity() * sizeof(NodeID) +
+               shortcut.edges.capacity() * sizeof(EdgeID);
+    }
+
+    // Returns nullptr if the shortcut is not cached
+    std::shared_ptr<const UnpackedShortcut> Find(const Key key)
+    {
+        auto &shard = GetShard(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        const auto position = shard.index.find(key);
+        if (position == shard.index.end())
+        {
+            ++shard.misses;
+            return nullptr;
+        }
+
+        ++shard.hits;
+        shard.entries.splice(shard.entries.begin(), shard.entries, position->second);
+        return position->second->second;
+    }
+
+    // Returns the cached shortcut. Shortcuts that are larger than a shard are not kept.
+    std::shared_ptr<const UnpackedShortcut> Insert(const Key key, UnpackedShortcut unpacked)
+    {
+        BOOST_ASSERT(unpacked.nodes.size() == unpacked.edges.size() + 1);
+        auto shortcut = std::make_shared<const UnpackedShortcut>(std::move(unpacked));
+        const auto size = EntrySize(*shortcut);
+        if (size > shard_capacity)
+            return shortcut;
+
+        auto &shard = GetShard(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        // another thread could have unpacked the same shortcut in the meantime
+        const auto position = shard.index.find(key);
+        if (position != shard.index.end())
+            return position->second->second;
+
+        shard.entries.emplace_front(key, shortcut);
+        shard.index.emplace(key, shard.entries.begin());
+        shard.size += size;
+
+        while (shard.size > shard_capacity)
+        {
+            const auto &oldest = shard.entries.back();
+            shard.size -= EntrySize(*oldest.second);
+            shard.index.erase(oldest.first);
+            shard.entries.pop_back();
+        }
+
+        return shortcut;
+    }
+
+    std::uint64_t GetHits() const { return Sum(&Shard::hits); }
+    std::uint64_t GetMisses() const { return Sum(&Shard::misses); }
+
+    double GetHitRate() const
+    {
+        const auto lookups = GetHits() + GetMisses();
+        return lookups == 0 ? 0. : static_cast<double>(GetHits()) / lookups;
+    }
+
+  private:
+    static constexpr std::size_t NUMBER_OF_SHARDS = 64;
+
+    using Entry = std::pair<Key, std::shared_ptr<const UnpackedShortcut>>;
+
+    struct Shard
+    {
+        mutable std::mutex mutex;
+        // most recently used first
+        std::list<Entry> entries;
+        std::unordered_map<Key, std::list<Entry>::iterator> index;
+        // bytes used by the entries of this shard
+        std::size_t size = 0;
+        // lookups are counted per shard so that threads only share the lock of their shard
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+    };
+
+    Shard &GetShard(const Key key)
+    {
+        // consecutive edge ids are spread over all shards
+        return shards[(key >> 1) % NUMBER_OF_SHARDS];
+    }
+
+    std::uint64_t Sum(std::uint64_t Shard::*counter) const
+    {
+        std::uint64_t sum = 0;
+        for (const auto &shard : shards)
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            sum += shard.*counter;
+        }
+        return sum;
+    }
+
+    const std::size_t shard_capacity;
+    std::array<Shard, NUMBER_OF_SHARDS> shards;
+};
+}
+}
+
+#endif
@@ -3,6 +3,7 @@
 
 #include "extractor/segment_data_container.hpp"
 
+#include "util/coordinate.hpp"
 #include "util/typedefs.hpp"
 
 #include <unordered_map>
@@ -63,8 +64,10 @@ class CompressedEdgeContainer
     NodeID GetLastEdgeTargetID(const EdgeID edge_id) const;
     NodeID GetLastEdgeSourceID(const EdgeID edge_id) const;
 
-    // Invalidates the internal storage
-    std::unique_ptr<SegmentDataContainer> ToSegmentData();
+    // Invalidates the internal storage. The coordinates of the nodes are used to precompute the
+    // simplification levels of the geometries.
+    std::unique_ptr<SegmentDataContainer>
+    ToSegmentData(const std::vector<util::Coordinate> &coordinates);
 
   private:
     SegmentWeight ClipWeight(const SegmentWeight weight);
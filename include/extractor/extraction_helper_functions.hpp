@@ -8,6 +8,8 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cmath>
+#include <cstdint>
 #include <iterator>
 #include <limits>
 #include <string>
@@ -112,6 +114,29 @@ trimLaneString(std::string lane_string, std::int32_t count_left, std::int32_t co
     return guidance::trimLaneString(std::move(lane_string), count_left, count_right);
 }
 
+// Converts a number parsed from a tag, like a lane count, to an integer. Lua versions disagree on
+// how fractional numbers are passed to integer arguments, so the conversion is done explicitly:
+// the number is truncated and clamped to the range of the integer type, NaN becomes zero.
+template <typename T> inline T toCount(const double value)
+{
+    if (std::isnan(value))
+        return 0;
+    if (value <= static_cast<double>(std::numeric_limits<T>::lowest()))
+        return std::numeric_limits<T>::lowest();
+    if (value >= static_cast<double>(std::numeric_limits<T>::max()))
+        return std::numeric_limits<T>::max();
+    return static_cast<T>(value);
+}
+
+// Same as trimLaneString, with the counts converted by toCount
+inline std::string
+trimLaneStringByCount(std::string lane_string, const double count_left, const double count_right)
+{
+    return trimLaneString(std::move(lane_string),
+                          toCount<std::int32_t>(count_left),
+                          toCount<std::int32_t>(count_right));
+}
+
 inline std::string applyAccessTokens(const std::string &lane_string,
                                      const std::string &access_tokens)
 {
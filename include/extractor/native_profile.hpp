@@ -0,0 +1,112 @@
+#ifndef OSRM_EXTRACTOR_NATIVE_PROFILE_HPP
+#define OSRM_EXTRACTOR_NATIVE_PROFILE_HPP
+
+#include "extractor/extraction_node.hpp"
+#include "extractor/extraction_relation.hpp"
+#include "extractor/extraction_segment.hpp"
+#include "extractor/extraction_turn.hpp"
+#include "extractor/extraction_way.hpp"
+#include "extractor/location_dependent_data.hpp"
+#include "extractor/profile_properties.hpp"
+
+#include <osmium/osm.hpp>
+
+#include <string>
+#include <vector>
+
+namespace osrm
+{
+namespace extractor
+{
+
+/**
+ * Access to the location dependent data passed to osrm-extract, the native counterpart of
+ * `get_location_tag` in Lua profiles. Looking up a key returns a blank value if no data was
+ * loaded or no polygon at the location has the key.
+ */
+class LocationTags
+{
+  public:
+    virtual ~LocationTags() = default;
+
+    virtual LocationDependentData::property_t Get(const osmium::Location &location,
+                                                  const char *key) const = 0;
+
+    LocationDependentData::property_t Get(const osmium::Node &node, const char *key) const
+    {
+        return Get(node.location(), key);
+    }
+
+    // Same heuristic as for Lua profiles: the last node of the way localizes the way
+    LocationDependentData::property_t Get(const osmium::Way &way, const char *key) const
+    {
+        return Get(way.nodes().back().location(), key);
+    }
+};
+
+/**
+ * Interface of a compiled profile that is loaded from a shared object with `dlopen`.
+ *
+ * A native profile fills the same Extraction* structs a Lua profile does, but it is called
+ * directly from the extraction threads. All process functions may be called concurrently
+ * and therefore need to be thread-safe.
+ *
+ * The shared object has to be compiled against the same OSRM headers and with the same
+ * compiler as osrm-extract. It exports its profile with OSRM_NATIVE_PROFILE(ProfileClass).
+ */
+class NativeProfile
+{
+  public:
+    // Increment this whenever the layout of NativeProfile or the Extraction* structs changes
+    static const constexpr int API_VERSION = 2;
+
+    virtual ~NativeProfile() = default;
+
+    virtual ProfileProperties GetProfileProperties() const = 0;
+
+    virtual std::vector<std::vector<std::string>> GetExcludableClasses() const { return {}; }
+    virtual std::vector<std::string> GetClassNames() const { return {}; }
+    virtual std::vector<std::string> GetNameSuffixList() const { return {}; }
+    virtual std::vector<std::string> GetRestrictions() const { return {}; }
+    virtual std::vector<std::string> GetRelations() const { return {}; }
+
+    virtual void ProcessNode(const osmium::Node &node,
+                             ExtractionNode &result,
+                             const ExtractionRelationContainer &relations,
+                             const LocationTags &location_tags) const = 0;
+    virtual void ProcessWay(const osmium::Way &way,
+                            ExtractionWay &result,
+                            const ExtractionRelationContainer &relations,
+                            const LocationTags &location_tags) const = 0;
+    virtual void ProcessTurn(ExtractionTurn &turn) const = 0;
+    virtual void ProcessSegment(ExtractionSegment &) const {}
+};
+
+extern "C" {
+using NativeProfileAPIVersionFunction = int();
+using NativeProfileCreateFunction = NativeProfile *();
+using NativeProfileDestroyFunction = void(NativeProfile *);
+}
+
+#define OSRM_NATIVE_PROFILE_API_VERSION_SYMBOL "osrm_native_profile_api_version"
+#define OSRM_NATIVE_PROFILE_CREATE_SYMBOL "osrm_native_profile_create"
+#define OSRM_NATIVE_PROFILE_DESTROY_SYMBOL "osrm_native_profile_destroy"
+
+// Exports the entry points osrm-extract looks up in a native profile shared object
+#define OSRM_NATIVE_PROFILE(ProfileClass)                                                          \
+    extern "C" int osrm_native_profile_api_version()                                               \
+    {                                                                                              \
+        return ::osrm::extractor::NativeProfile::API_VERSION;                                      \
+    }                                                                                              \
+    extern "C" ::osrm::extractor::NativeProfile *osrm_native_profile_create()                      \
+    {                                                                                              \
+        return new ProfileClass();                                                                 \
+    }                                                                                              \
+    extern "C" void osrm_native_profile_destroy(::osrm::extractor::NativeProfile *profile)         \
+    {                                                                                              \
+        delete profile;                                                                            \
+    }
+}
+}
+
+#endif
@@ -11,6 +11,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include <sol2/sol.hpp>
 
@@ -34,6 +35,9 @@ struct LuaScriptingContext final
                     ExtractionWay &result,
                     const ExtractionRelationContainer &relations);
 
+    // True if the way has a non-empty value for one of the keys in relevant_way_keys
+    bool HasRelevantTags(const osmium::Way &way) const;
+
     ProfileProperties properties;
     RasterContainer raster_sources;
     sol::state state;
@@ -48,6 +52,10 @@ struct LuaScriptingContext final
     sol::function node_function;
     sol::function segment_function;
 
+    // Sorted list of tag keys the profile declared as relevant for process_way.
+    // If empty all ways are passed to the profile.
+    std::vector<std::string> relevant_way_keys;
+
     int api_version;
     sol::table profile_table;
 
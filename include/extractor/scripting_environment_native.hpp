@@ -0,0 +1,69 @@
+#ifndef SCRIPTING_ENVIRONMENT_NATIVE_HPP
+#define SCRIPTING_ENVIRONMENT_NATIVE_HPP
+
+#include "extractor/location_dependent_data.hpp"
+#include "extractor/native_profile.hpp"
+#include "extractor/scripting_environment.hpp"
+
+#include <boost/filesystem/path.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace osrm
+{
+namespace extractor
+{
+
+/**
+ * Runs a compiled profile (see NativeProfile) that is loaded from a shared object.
+ *
+ * Unlike the Lua environment there is no per-thread state: the profile object is shared
+ * between all extraction threads and called without any cross-language dispatch.
+ */
+class NativeScriptingEnvironment final : public ScriptingEnvironment
+{
+  public:
+    explicit NativeScriptingEnvironment(
+        const std::string &file_name,
+        const std::vector<boost::filesystem::path> &location_dependent_data_paths);
+    ~NativeScriptingEnvironment() override;
+
+    // Returns true if the profile path points to a shared object instead of a Lua script
+    static bool IsNativeProfile(const boost::filesystem::path &profile_path);
+
+    const ProfileProperties &GetProfileProperties() override;
+
+    std::vector<std::vector<std::string>> GetExcludableClasses() override;
+    std::vector<std::string> GetNameSuffixList() override;
+    std::vector<std::string> GetClassNames() override;
+    std::vector<std::string> GetRestrictions() override;
+    std::vector<std::string> GetRelations() override;
+    void ProcessTurn(ExtractionTurn &turn) override;
+    void ProcessSegment(ExtractionSegment &segment) override;
+
+    void
+    ProcessElements(const osmium::memory::Buffer &buffer,
+                    const RestrictionParser &restriction_parser,
+                    const ManeuverOverrideRelationParser &maneuver_override_parser,
+                    const ExtractionRelationContainer &relations,
+                    std::vector<std::pair<const osmium::Node &, ExtractionNode>> &resulting_nodes,
+                    std::vector<std::pair<const osmium::Way &, ExtractionWay>> &resulting_ways,
+                    std::vector<InputConditionalTurnRestriction> &resulting_restrictions,
+                    std::vector<InputManeuverOverride> &resulting_maneuver_overrides) override;
+
+    bool HasLocationDependentData() const override { return !location_dependent_data.empty(); }
+
+  private:
+    std::string file_name;
+    const LocationDependentData location_dependent_data;
+    void *library_handle;
+    NativeProfileDestroyFunction *destroy_profile;
+    NativeProfile *profile;
+    ProfileProperties properties;
+};
+}
+}
+
+#endif /* SCRIPTING_ENVIRONMENT_NATIVE_HPP */
@@ -14,6 +14,8 @@
 
 #include <unordered_map>
 
+#include <cstdint>
+#include <iterator>
 #include <string>
 #include <vector>
 
@@ -59,6 +61,7 @@ template <storage::Ownership Ownership> class SegmentDataContainerImpl
     using SegmentWeightVector = PackedVector<SegmentWeight, SEGMENT_WEIGHT_BITS>;
     using SegmentDurationVector = PackedVector<SegmentDuration, SEGMENT_DURATION_BITS>;
     using SegmentDatasourceVector = Vector<DatasourceID>;
+    using SegmentZoomLevelVector = Vector<std::uint8_t>;
 
     SegmentDataContainerImpl() = default;
 
@@ -69,11 +72,12 @@ template <storage::Ownership Ownership> class SegmentDataContainerImpl
                              SegmentDurationVector fwd_durations_,
                              SegmentDurationVector rev_durations_,
                              SegmentDatasourceVector fwd_datasources_,
-                             SegmentDatasourceVector rev_datasources_)
+                             SegmentDatasourceVector rev_datasources_,
+                             SegmentZoomLevelVector zoom_levels_)
         : index(std::move(index_)), nodes(std::move(nodes_)), fwd_weights(std::move(fwd_weights_)),
           rev_weights(std::move(rev_weights_)), fwd_durations(std::move(fwd_durations_)),
           rev_durations(std::move(rev_durations_)), fwd_datasources(std::move(fwd_datasources_)),
-          rev_datasources(std::move(rev_datasources_))
+          rev_datasources(std::move(rev_datasources_)), zoom_levels(std::move(zoom_levels_))
     {
     }
 
@@ -199,6 +203,50 @@ template <storage::Ownership Ownership> class SegmentDataContainerImpl
         return boost::adaptors::reverse(boost::make_iterator_range(begin, end));
     }
 
+    // Bulk versions of the packed range accessors above, they decode the whole range in one pass
+    void CopyForwardDurations(const DirectionalGeometryID id,
+                              std::vector<SegmentDuration> &durations) const
+    {
+        durations.resize(index[id + 1] - index[id] - 1);
+        fwd_durations.decode(index[id] + 1, index[id + 1], durations.begin());
+    }
+
+    void CopyReverseDurations(const DirectionalGeometryID id,
+                              std::vector<SegmentDuration> &durations) const
+    {
+        durations.resize(index[id + 1] - index[id] - 1);
+        rev_durations.decode(index[id], index[id + 1] - 1, durations.rbegin());
+    }
+
+    void CopyForwardWeights(const DirectionalGeometryID id,
+                            std::vector<SegmentWeight> &weights) const
+    {
+        weights.resize(index[id + 1] - index[id] - 1);
+        fwd_weights.decode(index[id] + 1, index[id + 1], weights.begin());
+    }
+
+    void CopyReverseWeights(const DirectionalGeometryID id,
+                            std::vector<SegmentWeight> &weights) const
+    {
+        weights.resize(index[id + 1] - index[id] - 1);
+        rev_weights.decode(index[id], index[id + 1] - 1, weights.rbegin());
+    }
+
+    // Smallest zoom level of the overview simplification that keeps a node of the geometry,
+    // see util::douglasPeuckerZoomLevels. The first and last node have level 0.
+    void CopyForwardZoomLevels(const DirectionalGeometryID id,
+                               std::vector<std::uint8_t> &levels) const
+    {
+        levels.assign(zoom_levels.begin() + index[id], zoom_levels.begin() + index[id + 1]);
+    }
+
+    void CopyReverseZoomLevels(const DirectionalGeometryID id,
+                               std::vector<std::uint8_t> &levels) const
+    {
+        levels.assign(std::make_reverse_iterator(zoom_levels.begin() + index[id + 1]),
+                      std::make_reverse_iterator(zoom_levels.begin() + index[id]));
+    }
+
     auto GetNumberOfGeometries() const { return index.size() - 1; }
     auto GetNumberOfSegments() const { return fwd_weights.size(); }
 
@@ -220,6 +268,7 @@ template <storage::Ownership Ownership> class SegmentDataContainerImpl
     SegmentDurationVector rev_durations;
     SegmentDatasourceVector fwd_datasources;
     SegmentDatasourceVector rev_datasources;
+    SegmentZoomLevelVector zoom_levels;
 };
 }
 
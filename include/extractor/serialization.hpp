@@ -92,6 +92,7 @@ inline void read(storage::tar::FileReader &reader,
         reader, name + "/forward_data_sources", segment_data.fwd_datasources);
     storage::serialization::read(
         reader, name + "/reverse_data_sources", segment_data.rev_datasources);
+    storage::serialization::read(reader, name + "/zoom_levels", segment_data.zoom_levels);
 }
 
 template <storage::Ownership Ownership>
@@ -109,6 +110,7 @@ inline void write(storage::tar::FileWriter &writer,
         writer, name + "/forward_data_sources", segment_data.fwd_datasources);
     storage::serialization::write(
         writer, name + "/reverse_data_sources", segment_data.rev_datasources);
+    storage::serialization::write(writer, name + "/zoom_levels", segment_data.zoom_levels);
 }
 
 template <storage::Ownership Ownership>
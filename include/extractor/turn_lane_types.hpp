@@ -83,19 +83,21 @@ inline TurnLanesIndexedArray transformTurnLaneMapIntoArrays(const LaneDescriptio
     //
     // turn lane offsets points into the locations of the turn_lane_masks array. We use a standard
     // adjacency array like structure to store the turn lane masks.
-    std::vector<std::uint32_t> turn_lane_offsets(turn_lane_map.data.size() + 1); // + sentinel
-    for (auto entry = turn_lane_map.data.begin(); entry != turn_lane_map.data.end(); ++entry)
-        turn_lane_offsets[entry->second + 1] = entry->first.size();
+    std::vector<std::uint32_t> turn_lane_offsets(turn_lane_map.Size() + 1); // + sentinel
+    turn_lane_map.ForEach([&](const TurnLaneDescription &description, const LaneDescriptionID id) {
+        turn_lane_offsets[id + 1] = description.size();
+    });
 
     // inplace prefix sum
     std::partial_sum(turn_lane_offsets.begin(), turn_lane_offsets.end(), turn_lane_offsets.begin());
 
     // allocate the current masks
     std::vector<TurnLaneType::Mask> turn_lane_masks(turn_lane_offsets.back());
-    for (auto entry = turn_lane_map.data.begin(); entry != turn_lane_map.data.end(); ++entry)
-        std::copy(entry->first.begin(),
-                  entry->first.end(),
-                  turn_lane_masks.begin() + turn_lane_offsets[entry->second]);
+    turn_lane_map.ForEach([&](const TurnLaneDescription &description, const LaneDescriptionID id) {
+        std::copy(description.begin(),
+                  description.end(),
+                  turn_lane_masks.begin() + turn_lane_offsets[id]);
+    });
 
     return std::make_tuple(std::move(turn_lane_offsets), std::move(turn_lane_masks));
 }
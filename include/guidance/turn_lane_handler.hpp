@@ -64,10 +64,6 @@ const constexpr char *scenario_names[] = {"Simple",
 
 class TurnLaneHandler
 {
-    using UpgradableMutex = boost::interprocess::interprocess_upgradable_mutex;
-    using ScopedReaderLock = boost::interprocess::sharable_lock<UpgradableMutex>;
-    using ScopedWriterLock = boost::interprocess::scoped_lock<UpgradableMutex>;
-
   public:
     typedef std::vector<TurnLaneData> LaneDataVector;
 
@@ -27,6 +27,7 @@ struct Engine final : public Nan::ObjectWrap
     static NAN_METHOD(tile);
     static NAN_METHOD(match);
     static NAN_METHOD(trip);
+    static NAN_METHOD(batch);
 
     Engine(osrm::EngineConfig &config);
 
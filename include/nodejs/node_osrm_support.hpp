@@ -51,14 +51,17 @@ struct PluginParameters
 
 using ObjectOrString = typename mapbox::util::variant<osrm::json::Object, std::string>;
 
-template <typename ResultT> inline v8::Local<v8::Value> render(const ResultT &result);
+inline void freeString(char * /*data*/, void *hint) { delete static_cast<std::string *>(hint); }
 
-template <> v8::Local<v8::Value> inline render(const std::string &result)
+// Hands the string over to a node Buffer without copying it, the Buffer frees it when it is
+// garbage collected
+inline v8::Local<v8::Value> render(std::string &&result)
 {
-    return Nan::CopyBuffer(result.data(), result.size()).ToLocalChecked();
+    auto *owned = new std::string(std::move(result));
+    return Nan::NewBuffer(&(*owned)[0], owned->size(), freeString, owned).ToLocalChecked();
 }
 
-template <> v8::Local<v8::Value> inline render(const ObjectOrString &result)
+inline v8::Local<v8::Value> render(ObjectOrString &&result)
 {
     if (result.is<osrm::json::Object>())
     {
@@ -70,17 +73,15 @@ template <> v8::Local<v8::Value> inline render(const ObjectOrString &result)
     else
     {
         // Return the string object as a node Buffer
-        return Nan::CopyBuffer(result.get<std::string>().data(), result.get<std::string>().size())
-            .ToLocalChecked();
+        return render(std::move(result.get<std::string>()));
     }
 }
 
 inline void ParseResult(const osrm::Status &result_status, osrm::json::Object &result)
 {
     const auto code_iter = result.values.find("code");
-    const auto end_iter = result.values.end();
 
-    BOOST_ASSERT(code_iter != end_iter);
+    BOOST_ASSERT(code_iter != result.values.end());
 
     if (result_status == osrm::Status::Error)
     {
@@ -89,7 +90,7 @@ inline void ParseResult(const osrm::Status &result_status, osrm::json::Object &r
 
     result.values.erase(code_iter);
     const auto message_iter = result.values.find("message");
-    if (message_iter != end_iter)
+    if (message_iter != result.values.end())
     {
         result.values.erase(message_iter);
     }
@@ -308,6 +309,42 @@ inline engine_config_ptr argumentsToEngineConfig(const Nan::FunctionCallbackInfo
         engine_config->max_radius_map_matching =
             static_cast<double>(max_radius_map_matching->NumberValue());
 
+    auto region = params->Get(Nan::New("region").ToLocalChecked());
+    if (!region->IsUndefined())
+    {
+        if (!region->IsArray() || v8::Local<v8::Array>::Cast(region)->Length() != 4)
+        {
+            Nan::ThrowError("region must be an array of [min_lon, min_lat, max_lon, max_lat]");
+            return engine_config_ptr();
+        }
+
+        auto region_array = v8::Local<v8::Array>::Cast(region);
+        double bounds[4];
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            auto bound = region_array->Get(i);
+            if (!bound->IsNumber())
+            {
+                Nan::ThrowError("region must be an array of [min_lon, min_lat, max_lon, max_lat]");
+                return engine_config_ptr();
+            }
+            bounds[i] = static_cast<double>(bound->NumberValue());
+        }
+
+        if (bounds[0] > bounds[2] || bounds[1] > bounds[3] || bounds[0] < -180 ||
+            bounds[2] > 180 || bounds[1] < -90 || bounds[3] > 90)
+        {
+            Nan::ThrowError("region must be a valid bounding box of [min_lon, min_lat, max_lon, "
+                            "max_lat]");
+            return engine_config_ptr();
+        }
+
+        engine_config->region = osrm::util::RectangleInt2D{osrm::util::FloatLongitude{bounds[0]},
+                                                           osrm::util::FloatLongitude{bounds[2]},
+                                                           osrm::util::FloatLatitude{bounds[1]},
+                                                           osrm::util::FloatLatitude{bounds[3]}};
+    }
+
     return engine_config;
 }
 
@@ -369,25 +406,19 @@ parseCoordinateArray(const v8::Local<v8::Array> &coordinates_array)
 
 // Parses all the non-service specific parameters
 template <typename ParamType>
-inline bool argumentsToParameter(const Nan::FunctionCallbackInfo<v8::Value> &args,
+inline bool argumentsToParameter(const v8::Local<v8::Value> &query,
                                  ParamType &params,
                                  bool requires_multiple_coordinates)
 {
     Nan::HandleScope scope;
 
-    if (args.Length() < 2)
-    {
-        Nan::ThrowTypeError("Two arguments required");
-        return false;
-    }
-
-    if (!args[0]->IsObject())
+    if (!query->IsObject())
     {
         Nan::ThrowTypeError("First arg must be an object");
         return false;
     }
 
-    v8::Local<v8::Object> obj = Nan::To<v8::Object>(args[0]).ToLocalChecked();
+    v8::Local<v8::Object> obj = Nan::To<v8::Object>(query).ToLocalChecked();
 
     v8::Local<v8::Value> coordinates = obj->Get(Nan::New("coordinates").ToLocalChecked());
     if (coordinates.IsEmpty())
@@ -894,15 +925,15 @@ argumentsToPluginParameters(const Nan::FunctionCallbackInfo<v8::Value> &args)
 }
 
 inline route_parameters_ptr
-argumentsToRouteParameter(const Nan::FunctionCallbackInfo<v8::Value> &args,
+argumentsToRouteParameter(const v8::Local<v8::Value> &query,
                           bool requires_multiple_coordinates)
 {
     route_parameters_ptr params = std::make_unique<osrm::RouteParameters>();
-    bool has_base_params = argumentsToParameter(args, params, requires_multiple_coordinates);
+    bool has_base_params = argumentsToParameter(query, params, requires_multiple_coordinates);
     if (!has_base_params)
         return route_parameters_ptr();
 
-    v8::Local<v8::Object> obj = Nan::To<v8::Object>(args[0]).ToLocalChecked();
+    v8::Local<v8::Object> obj = Nan::To<v8::Object>(query).ToLocalChecked();
 
     if (obj->Has(Nan::New("continue_straight").ToLocalChecked()))
     {
@@ -921,6 +952,20 @@ argumentsToRouteParameter(const Nan::FunctionCallbackInfo<v8::Value> &args,
         }
     }
 
+    if (obj->Has(Nan::New("eta_only").ToLocalChecked()))
+    {
+        auto value = obj->Get(Nan::New("eta_only").ToLocalChecked());
+        if (value.IsEmpty())
+            return route_parameters_ptr();
+
+        if (!value->IsBoolean())
+        {
+            Nan::ThrowError("'eta_only' param must be a boolean");
+            return route_parameters_ptr();
+        }
+        params->eta_only = value->BooleanValue();
+    }
+
     if (obj->Has(Nan::New("alternatives").ToLocalChecked()))
     {
         auto value = obj->Get(Nan::New("alternatives").ToLocalChecked());
@@ -1049,23 +1094,17 @@ argumentsToRouteParameter(const Nan::FunctionCallbackInfo<v8::Value> &args,
 }
 
 inline tile_parameters_ptr
-argumentsToTileParameters(const Nan::FunctionCallbackInfo<v8::Value> &args, bool /*unused*/)
+argumentsToTileParameters(const v8::Local<v8::Value> &query, bool /*unused*/)
 {
     tile_parameters_ptr params = std::make_unique<osrm::TileParameters>();
 
-    if (args.Length() < 2)
-    {
-        Nan::ThrowTypeError("Coordinate object and callback required");
-        return tile_parameters_ptr();
-    }
-
-    if (!args[0]->IsArray())
+    if (!query->IsArray())
     {
         Nan::ThrowTypeError("Parameter must be an array [x, y, z]");
         return tile_parameters_ptr();
     }
 
-    v8::Local<v8::Array> array = v8::Local<v8::Array>::Cast(args[0]);
+    v8::Local<v8::Array> array = v8::Local<v8::Array>::Cast(query);
 
     if (array->Length() != 3)
     {
@@ -1109,15 +1148,15 @@ argumentsToTileParameters(const Nan::FunctionCallbackInfo<v8::Value> &args, bool
 }
 
 inline nearest_parameters_ptr
-argumentsToNearestParameter(const Nan::FunctionCallbackInfo<v8::Value> &args,
+argumentsToNearestParameter(const v8::Local<v8::Value> &query,
                             bool requires_multiple_coordinates)
 {
     nearest_parameters_ptr params = std::make_unique<osrm::NearestParameters>();
-    bool has_base_params = argumentsToParameter(args, params, requires_multiple_coordinates);
+    bool has_base_params = argumentsToParameter(query, params, requires_multiple_coordinates);
     if (!has_base_params)
         return nearest_parameters_ptr();
 
-    v8::Local<v8::Object> obj = Nan::To<v8::Object>(args[0]).ToLocalChecked();
+    v8::Local<v8::Object> obj = Nan::To<v8::Object>(query).ToLocalChecked();
     if (obj.IsEmpty())
         return nearest_parameters_ptr();
 
@@ -1148,15 +1187,15 @@ argumentsToNearestParameter(const Nan::FunctionCallbackInfo<v8::Value> &args,
 }
 
 inline table_parameters_ptr
-argumentsToTableParameter(const Nan::FunctionCallbackInfo<v8::Value> &args,
+argumentsToTableParameter(const v8::Local<v8::Value> &query,
                           bool requires_multiple_coordinates)
 {
     table_parameters_ptr params = std::make_unique<osrm::TableParameters>();
-    bool has_base_params = argumentsToParameter(args, params, requires_multiple_coordinates);
+    bool has_base_params = argumentsToParameter(query, params, requires_multiple_coordinates);
     if (!has_base_params)
         return table_parameters_ptr();
 
-    v8::Local<v8::Object> obj = Nan::To<v8::Object>(args[0]).ToLocalChecked();
+    v8::Local<v8::Object> obj = Nan::To<v8::Object>(query).ToLocalChecked();
     if (obj.IsEmpty())
         return table_parameters_ptr();
 
@@ -1346,15 +1385,15 @@ argumentsToTableParameter(const Nan::FunctionCallbackInfo<v8::Value> &args,
 }
 
 inline trip_parameters_ptr
-argumentsToTripParameter(const Nan::FunctionCallbackInfo<v8::Value> &args,
+argumentsToTripParameter(const v8::Local<v8::Value> &query,
                          bool requires_multiple_coordinates)
 {
     trip_parameters_ptr params = std::make_unique<osrm::TripParameters>();
-    bool has_base_params = argumentsToParameter(args, params, requires_multiple_coordinates);
+    bool has_base_params = argumentsToParameter(query, params, requires_multiple_coordinates);
     if (!has_base_params)
         return trip_parameters_ptr();
 
-    v8::Local<v8::Object> obj = Nan::To<v8::Object>(args[0]).ToLocalChecked();
+    v8::Local<v8::Object> obj = Nan::To<v8::Object>(query).ToLocalChecked();
 
     bool parsedSuccessfully = parseCommonParameters(obj, params);
     if (!parsedSuccessfully)
@@ -1441,15 +1480,15 @@ argumentsToTripParameter(const Nan::FunctionCallbackInfo<v8::Value> &args,
 }
 
 inline match_parameters_ptr
-argumentsToMatchParameter(const Nan::FunctionCallbackInfo<v8::Value> &args,
+argumentsToMatchParameter(const v8::Local<v8::Value> &query,
                           bool requires_multiple_coordinates)
 {
     match_parameters_ptr params = std::make_unique<osrm::MatchParameters>();
-    bool has_base_params = argumentsToParameter(args, params, requires_multiple_coordinates);
+    bool has_base_params = argumentsToParameter(query, params, requires_multiple_coordinates);
     if (!has_base_params)
         return match_parameters_ptr();
 
-    v8::Local<v8::Object> obj = Nan::To<v8::Object>(args[0]).ToLocalChecked();
+    v8::Local<v8::Object> obj = Nan::To<v8::Object>(query).ToLocalChecked();
 
     if (obj->Has(Nan::New("timestamps").ToLocalChecked()))
     {
@@ -45,19 +45,29 @@ struct MatchParametersGrammar final : public RouteParametersGrammar<Iterator, Si
         gaps_type.add("split", engine::api::MatchParameters::GapsType::Split)(
             "ignore", engine::api::MatchParameters::GapsType::Ignore);
 
+        session_rule =
+            qi::lit("session=") >
+            qi::as_string[+qi::char_("-_a-zA-Z0-9")]
+                         [ph::bind(&engine::api::MatchParameters::session, qi::_r1) = qi::_1];
+
         root_rule =
             BaseGrammar::query_rule(qi::_r1) > BaseGrammar::format_rule(qi::_r1) >
             -('?' > (timestamps_rule(qi::_r1) | BaseGrammar::base_rule(qi::_r1) |
                      (qi::lit("gaps=") >
                       gaps_type[ph::bind(&engine::api::MatchParameters::gaps, qi::_r1) = qi::_1]) |
                      (qi::lit("tidy=") >
-                      qi::bool_[ph::bind(&engine::api::MatchParameters::tidy, qi::_r1) = qi::_1])) %
+                      qi::bool_[ph::bind(&engine::api::MatchParameters::tidy, qi::_r1) = qi::_1]) |
+                     session_rule(qi::_r1) |
+                     (qi::lit("end_session=") >
+                      qi::bool_[ph::bind(&engine::api::MatchParameters::end_session, qi::_r1) =
+                                    qi::_1])) %
                         '&');
     }
 
   private:
     qi::rule<Iterator, Signature> root_rule;
     qi::rule<Iterator, Signature> timestamps_rule;
+    qi::rule<Iterator, Signature> session_rule;
     qi::rule<Iterator, std::size_t()> size_t_;
 
     qi::symbols<char, engine::api::MatchParameters::GapsType> gaps_type;
@@ -40,7 +40,9 @@ struct RouteParametersGrammar : public BaseParametersGrammar<Iterator, Signature
             (qi::lit("continue_straight=") >
              (qi::lit("default") |
               qi::bool_[ph::bind(&engine::api::RouteParameters::continue_straight, qi::_r1) =
-                            qi::_1]));
+                            qi::_1])) |
+            (qi::lit("eta_only=") >
+             qi::bool_[ph::bind(&engine::api::RouteParameters::eta_only, qi::_r1) = qi::_1]);
 
         root_rule = query_rule(qi::_r1) > BaseGrammar::format_rule(qi::_r1) >
                     -('?' > (route_rule(qi::_r1) | base_rule(qi::_r1)) % '&');
@@ -56,6 +56,10 @@ struct TableParametersGrammar : public BaseParametersGrammar<Iterator, Signature
                                      engine::api::TableParameters::FallbackCoordinateType::Input)(
             "snapped", engine::api::TableParameters::FallbackCoordinateType::Snapped);
 
+        encoding_type.add("float", engine::api::TableParameters::EncodingType::Float)(
+            "int32", engine::api::TableParameters::EncodingType::Int32)(
+            "uint16", engine::api::TableParameters::EncodingType::UInt16);
+
         scale_factor_rule =
             qi::lit("scale_factor=") >
             (double_)[ph::bind(&engine::api::TableParameters::scale_factor, qi::_r1) = qi::_1];
@@ -68,7 +72,10 @@ struct TableParametersGrammar : public BaseParametersGrammar<Iterator, Signature
                              (qi::lit("fallback_coordinate=") >
                               fallback_coordinate_type
                                   [ph::bind(&engine::api::TableParameters::fallback_coordinate_type,
-                                            qi::_r1) = qi::_1])) %
+                                            qi::_r1) = qi::_1]) |
+                             (qi::lit("encoding=") >
+                              encoding_type[ph::bind(&engine::api::TableParameters::encoding,
+                                                     qi::_r1) = qi::_1])) %
                                 '&');
     }
 
@@ -104,6 +111,7 @@ struct TableParametersGrammar : public BaseParametersGrammar<Iterator, Signature
     qi::rule<Iterator, engine::api::TableParameters::AnnotationsType()> annotations_list;
     qi::symbols<char, engine::api::TableParameters::FallbackCoordinateType>
         fallback_coordinate_type;
+    qi::symbols<char, engine::api::TableParameters::EncodingType> encoding_type;
     qi::real_parser<double, json_policy> double_;
 };
 }
@@ -19,7 +19,9 @@
 #include <sys/shm.h>
 #endif
 
+#include <cerrno>
 #include <cstdint>
+#include <cstring>
 
 #include <algorithm>
 #include <exception>
@@ -55,7 +57,8 @@ class SharedMemory
     template <typename IdentifierT>
     SharedMemory(const boost::filesystem::path &lock_file,
                  const IdentifierT id,
-                 const uint64_t size = 0)
+                 const uint64_t size = 0,
+                 const bool use_hugepages = false)
         : key(lock_file.string().c_str(), id)
     {
         // open only
@@ -70,6 +73,41 @@ class SharedMemory
         // open or create
         else
         {
+#if defined(__linux__) && defined(SHM_HUGETLB)
+            // boost::interprocess drops all flags except the permissions, so the segment is
+            // created here and only opened by boost below. Readers attach it like any other.
+            // IPC_EXCL makes sure the segment is new: shmget would otherwise return an existing
+            // segment with whatever pages it was allocated with.
+            if (use_hugepages)
+            {
+                if (-1 ==
+                    ::shmget(key.get_key(), size, IPC_CREAT | IPC_EXCL | SHM_HUGETLB | 0644))
+                {
+                    const auto error = errno;
+                    if (EEXIST == error)
+                    {
+                        util::Log(logWARNING) << "shared memory of id " << id
+                                              << " already exists, it is reused without checking "
+                                                 "for huge pages";
+                    }
+                    else
+                    {
+                        util::Log(logWARNING)
+                            << "could not allocate shared memory with huge pages: "
+                            << std::strerror(error) << ", using normal pages";
+                    }
+                }
+                else
+                {
+                    util::Log() << "Allocated shared memory of id " << id << " with huge pages";
+                }
+            }
+#else
+            if (use_hugepages)
+            {
+                util::Log(logWARNING) << "huge pages are not supported on this platform";
+            }
+#endif
             shm = boost::interprocess::xsi_shared_memory(
                 boost::interprocess::open_or_create, key, size);
             util::Log(logDEBUG) << "opening/creating " << shm.get_shmid() << " from id " << id
@@ -203,8 +241,16 @@ class SharedMemory
     void *Ptr() const { return region.get_address(); }
     std::size_t Size() const { return region.get_size(); }
 
-    SharedMemory(const boost::filesystem::path &lock_file, const int id, const uint64_t size = 0)
+    SharedMemory(const boost::filesystem::path &lock_file,
+                 const int id,
+                 const uint64_t size = 0,
+                 const bool use_hugepages = false)
     {
+        if (use_hugepages)
+        {
+            util::Log(logWARNING) << "huge pages are not supported on this platform";
+        }
+
         sprintf(key, "%s.%d", "osrm.lock", id);
         if (0 == size)
         { // read_only
@@ -285,7 +331,8 @@ class SharedMemory
 #endif
 
 template <typename IdentifierT, typename LockFileT = OSRMLockFile>
-std::unique_ptr<SharedMemory> makeSharedMemory(const IdentifierT &id, const uint64_t size = 0)
+std::unique_ptr<SharedMemory>
+makeSharedMemory(const IdentifierT &id, const uint64_t size = 0, const bool use_hugepages = false)
 {
     static_assert(sizeof(id) == sizeof(std::uint16_t), "Key type is not 16 bits");
     try
@@ -302,7 +349,7 @@ std::unique_ptr<SharedMemory> makeSharedMemory(const IdentifierT &id, const uint
                 boost::filesystem::ofstream ofs(lock_file(id));
             }
         }
-        return std::make_unique<SharedMemory>(lock_file(id), id, size);
+        return std::make_unique<SharedMemory>(lock_file(id), id, size, use_hugepages);
     }
     catch (const boost::interprocess::interprocess_exception &e)
     {
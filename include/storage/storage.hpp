@@ -49,7 +49,7 @@ class Storage
   public:
     Storage(StorageConfig config);
 
-    int Run(int max_wait, const std::string &name, bool only_metric);
+    int Run(int max_wait, const std::string &name, bool only_metric, bool use_hugepages);
     void PopulateStaticData(const SharedDataIndex &index);
     void PopulateUpdatableData(const SharedDataIndex &index);
     void PopulateLayout(storage::BaseDataLayout &layout,
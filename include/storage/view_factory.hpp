@@ -160,6 +160,8 @@ inline auto make_segment_data_view(const SharedDataIndex &index, const std::stri
     auto rev_datasources_list =
         make_vector_view<DatasourceID>(index, name + "/reverse_data_sources");
 
+    auto zoom_levels_list = make_vector_view<std::uint8_t>(index, name + "/zoom_levels");
+
     return extractor::SegmentDataView{std::move(geometry_begin_indices),
                                       std::move(node_list),
                                       std::move(fwd_weight_list),
@@ -167,7 +169,8 @@ inline auto make_segment_data_view(const SharedDataIndex &index, const std::stri
                                       std::move(fwd_duration_list),
                                       std::move(rev_duration_list),
                                       std::move(fwd_datasources_list),
-                                      std::move(rev_datasources_list)};
+                                      std::move(rev_datasources_list),
+                                      std::move(zoom_levels_list)};
 }
 
 inline auto make_coordinates_view(const SharedDataIndex &index, const std::string &name)
@@ -243,12 +246,24 @@ inline auto make_entry_classes_view(const SharedDataIndex &index, const std::str
     return make_vector_view<util::guidance::EntryClass>(index, name);
 }
 
+inline auto make_contracted_durations_view(const SharedDataIndex &index, const std::string &name)
+{
+    return make_vector_view<EdgeDuration>(index, name + "/durations");
+}
+
+inline auto make_contracted_distances_view(const SharedDataIndex &index, const std::string &name)
+{
+    return make_vector_view<EdgeDistance>(index, name + "/distances");
+}
+
 inline auto make_contracted_metric_view(const SharedDataIndex &index, const std::string &name)
 {
     auto node_list = make_vector_view<contractor::QueryGraphView::NodeArrayEntry>(
         index, name + "/contracted_graph/node_array");
     auto edge_list = make_vector_view<contractor::QueryGraphView::EdgeArrayEntry>(
         index, name + "/contracted_graph/edge_array");
+    auto durations = make_contracted_durations_view(index, name);
+    auto distances = make_contracted_distances_view(index, name);
 
     std::vector<util::vector_view<bool>> edge_filter;
     index.List(name + "/exclude",
@@ -257,6 +272,8 @@ inline auto make_contracted_metric_view(const SharedDataIndex &index, const std:
                }));
 
     return contractor::ContractedMetricView{{std::move(node_list), std::move(edge_list)},
+                                            std::move(durations),
+                                            std::move(distances),
                                             std::move(edge_filter)};
 }
 
@@ -1,10 +1,15 @@
 #ifndef CONCURRENT_ID_MAP_HPP
 #define CONCURRENT_ID_MAP_HPP
 
-#include <boost/interprocess/sync/interprocess_upgradable_mutex.hpp>
-#include <boost/interprocess/sync/scoped_lock.hpp>
-#include <boost/interprocess/sync/sharable_lock.hpp>
+#include "util/integer_range.hpp"
 
+#include <tbb/enumerable_thread_specific.h>
+
+#include <boost/assert.hpp>
+
+#include <array>
+#include <atomic>
+#include <mutex>
 #include <unordered_map>
 
 namespace osrm
@@ -14,64 +19,94 @@ namespace util
 
 /**
  * This is a special purpose map for caching incrementing IDs
+ *
+ * Keys are spread over shards by their hash, each shard has its own lock. Every thread keeps
+ * the IDs it has seen in a local cache, so looking up a known key does not synchronize at all.
+ * IDs are dense and assigned in order of insertion.
  */
 template <typename KeyType, typename ValueType, typename HashType = std::hash<KeyType>>
 struct ConcurrentIDMap
 {
     static_assert(std::is_unsigned<ValueType>::value, "Only unsigned integer types are supported.");
 
-    using UpgradableMutex = boost::interprocess::interprocess_upgradable_mutex;
-    using ScopedReaderLock = boost::interprocess::sharable_lock<UpgradableMutex>;
-    using ScopedWriterLock = boost::interprocess::scoped_lock<UpgradableMutex>;
+    using key_type = KeyType;
+    using mapped_type = ValueType;
+    using Map = std::unordered_map<KeyType, ValueType, HashType>;
 
-    std::unordered_map<KeyType, ValueType, HashType> data;
-    mutable UpgradableMutex mutex;
+    static constexpr std::size_t NUMBER_OF_SHARDS = 64;
 
     ConcurrentIDMap() = default;
-    ConcurrentIDMap(ConcurrentIDMap &&other)
-    {
-        if (this != &other)
-        {
-            ScopedWriterLock other_lock{other.mutex};
-            ScopedWriterLock lock{mutex};
-
-            data = std::move(other.data);
-        }
-    }
+    ConcurrentIDMap(ConcurrentIDMap &&other) { *this = std::move(other); }
     ConcurrentIDMap &operator=(ConcurrentIDMap &&other)
     {
         if (this != &other)
         {
-            ScopedWriterLock other_lock{other.mutex};
-            ScopedWriterLock lock{mutex};
+            for (auto index : irange<std::size_t>(0, NUMBER_OF_SHARDS))
+            {
+                std::lock_guard<std::mutex> other_lock{other.shards[index].mutex};
+                std::lock_guard<std::mutex> lock{shards[index].mutex};
 
-            data = std::move(other.data);
+                shards[index].data = std::move(other.shards[index].data);
+            }
+            next_id = other.next_id.exchange(0);
+            // cached IDs belong to the previous content
+            cache.clear();
+            other.cache.clear();
         }
         return *this;
     }
 
     const ValueType ConcurrentFindOrAdd(const KeyType &key)
     {
+        auto &local_ids = cache.local();
+        const auto cached = local_ids.find(key);
+        if (cached != local_ids.end())
         {
-            ScopedReaderLock sentry{mutex};
-            const auto result = data.find(key);
-            if (result != data.end())
+            return cached->second;
+        }
+
+        auto &shard = shards[HashType{}(key) % NUMBER_OF_SHARDS];
+        const auto id = [&] {
+            std::lock_guard<std::mutex> lock{shard.mutex};
+            const auto result = shard.data.find(key);
+            if (result != shard.data.end())
             {
                 return result->second;
             }
-        }
+            const auto id = static_cast<ValueType>(next_id++);
+            shard.data.emplace(key, id);
+            return id;
+        }();
+
+        local_ids.emplace(key, id);
+        return id;
+    }
+
+    // Not safe to call while IDs are added
+    std::size_t Size() const { return next_id; }
+
+    // Calls callback(key, id) for all entries. Not safe to call while IDs are added.
+    template <typename Callback> void ForEach(Callback &&callback) const
+    {
+        for (const auto &shard : shards)
         {
-            ScopedWriterLock sentry{mutex};
-            const auto result = data.find(key);
-            if (result != data.end())
+            for (const auto &entry : shard.data)
             {
-                return result->second;
+                callback(entry.first, entry.second);
             }
-            const auto id = static_cast<ValueType>(data.size());
-            data[key] = id;
-            return id;
         }
     }
+
+  private:
+    struct Shard
+    {
+        std::mutex mutex;
+        Map data;
+    };
+
+    std::array<Shard, NUMBER_OF_SHARDS> shards;
+    std::atomic<std::size_t> next_id{0};
+    tbb::enumerable_thread_specific<Map> cache;
 };
 
 } // util
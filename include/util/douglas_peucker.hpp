@@ -3,12 +3,13 @@
 
 #include "util/coordinate.hpp"
 
+#include <cstdint>
 #include <iterator>
 #include <vector>
 
 namespace osrm
 {
-namespace engine
+namespace util
 {
 namespace detail
 {
@@ -65,16 +66,26 @@ const constexpr auto DOUGLAS_PEUCKER_THRESHOLDS_SIZE =
 // Input is vector of pairs. Each pair consists of the point information and a
 // bit indicating if the points is present in the generalization.
 // Note: points may also be pre-selected*/
-std::vector<util::Coordinate> douglasPeucker(std::vector<util::Coordinate>::const_iterator begin,
-                                             std::vector<util::Coordinate>::const_iterator end,
-                                             const unsigned zoom_level);
+std::vector<Coordinate> douglasPeucker(std::vector<Coordinate>::const_iterator begin,
+                                       std::vector<Coordinate>::const_iterator end,
+                                       const unsigned zoom_level);
 
 // Convenience range-based function
-inline std::vector<util::Coordinate> douglasPeucker(const std::vector<util::Coordinate> &geometry,
-                                                    const unsigned zoom_level)
+inline std::vector<Coordinate> douglasPeucker(const std::vector<Coordinate> &geometry,
+                                              const unsigned zoom_level)
 {
     return douglasPeucker(begin(geometry), end(geometry), zoom_level);
 }
+
+// Zoom level of points that are not needed at any zoom level
+const constexpr std::uint8_t DOUGLAS_PEUCKER_NEVER = detail::DOUGLAS_PEUCKER_THRESHOLDS_SIZE;
+
+// Computes the smallest zoom level for every point from which on the point is part of the
+// generalization. The farthest point of a range does not depend on the threshold, so the
+// simplification for a zoom level consists of exactly the points up to that level.
+// The end points get level 0, points that are never needed DOUGLAS_PEUCKER_NEVER.
+std::vector<std::uint8_t> douglasPeuckerZoomLevels(std::vector<Coordinate>::const_iterator begin,
+                                                   std::vector<Coordinate>::const_iterator end);
 }
 }
 
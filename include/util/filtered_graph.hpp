@@ -68,11 +68,15 @@ class FilteredGraphImpl<util::StaticGraph<EdgeDataT, Ownership>, Ownership>
     }
 
     // searches for a specific edge
+    // The filtered static graph is the contracted graph, its adjacency is sorted by target so
+    // only the edges to `to` need to be checked.
     EdgeIterator FindEdge(const NodeIterator from, const NodeIterator to) const
     {
-        for (const auto edge : GetAdjacentEdgeRange(from))
+        const auto end = graph.EndEdges(from);
+        for (auto edge = graph.LowerBoundEdge(from, to); edge != end && graph.GetTarget(edge) == to;
+             ++edge)
         {
-            if (to == GetTarget(edge))
+            if (edge_filter[edge])
             {
                 return edge;
             }
@@ -89,12 +93,15 @@ class FilteredGraphImpl<util::StaticGraph<EdgeDataT, Ownership>, Ownership>
 
         EdgeIterator smallest_edge = SPECIAL_EDGEID;
         EdgeWeight smallest_weight = INVALID_EDGE_WEIGHT;
-        for (auto edge : GetAdjacentEdgeRange(from))
+        const auto end = graph.EndEdges(from);
+        for (auto edge = graph.LowerBoundEdge(from, to); edge != end && graph.GetTarget(edge) == to;
+             ++edge)
         {
-            const NodeID target = GetTarget(edge);
+            if (!edge_filter[edge])
+                continue;
+
             const auto &data = GetEdgeData(edge);
-            if (target == to && data.weight < smallest_weight &&
-                std::forward<FilterFunction>(filter)(data))
+            if (data.weight < smallest_weight && std::forward<FilterFunction>(filter)(data))
             {
                 smallest_edge = edge;
                 smallest_weight = data.weight;
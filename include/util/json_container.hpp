@@ -33,8 +33,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <mapbox/variant.hpp>
 
+#include <boost/container/flat_map.hpp>
+
 #include <string>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -131,10 +132,17 @@ using Value = mapbox::util::variant<String,
  * Typed Object.
  *
  * Unwrap the key-value pairs holding type via its values member attribute.
+ *
+ * The key-value pairs are kept in a single vector sorted by key: responses are made of many
+ * small objects, which then need one allocation each instead of one per key. Keys are rendered
+ * in sorted order. Inserting or erasing a key invalidates references into the object.
+ *
+ * Members are allocated with the default allocator and not from a per-request arena: the
+ * objects are returned to library and node users and may outlive the request that built them.
  */
 struct Object
 {
-    std::unordered_map<std::string, Value> values;
+    boost::container::flat_map<std::string, Value> values;
 };
 
 /**
@@ -370,6 +370,37 @@ template <typename T, std::size_t Bits, storage::Ownership Ownership> class Pack
         return internal_reference{*this, get_internal_index(index)};
     }
 
+    // Decodes all elements in [first, last) to out. Elements are stored back to back, so this
+    // streams over the words once instead of doing the per-element table lookups of operator[].
+    template <typename OutputIter>
+    OutputIter decode(const std::size_t first, const std::size_t last, OutputIter out) const
+    {
+        BOOST_ASSERT(first <= last && last <= num_elements);
+        if (first == last)
+            return out;
+
+        const WordT mask = Bits == WORD_BITS ? ~WordT{0} : (WordT{1} << Bits) - 1;
+        std::size_t word_index = first * Bits / WORD_BITS;
+        std::size_t shift = first * Bits % WORD_BITS;
+        WordT word = vec[word_index];
+        for (auto remaining = last - first; remaining > 0; --remaining)
+        {
+            WordT value = word >> shift;
+            shift += Bits;
+            if (shift >= WORD_BITS)
+            {
+                shift -= WORD_BITS;
+                // the sentinel word makes this safe for the last element
+                word = vec[++word_index];
+                if (shift > 0)
+                    value |= word << (Bits - shift);
+            }
+            *out++ = get_lower_half_value<WordT, T>(value, mask, 0);
+        }
+
+        return out;
+    }
+
     auto at(std::size_t index) const
     {
         if (index < num_elements)
@@ -0,0 +1,58 @@
+#ifndef OSRM_UTIL_PARALLEL_REMOVE_IF_HPP
+#define OSRM_UTIL_PARALLEL_REMOVE_IF_HPP
+
+#include "util/static_assert.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
+namespace osrm
+{
+namespace util
+{
+
+// Same as std::remove_if but evaluates the predicate for all elements in parallel first,
+// so the predicate has to be safe to call concurrently. Keeps the order of the elements.
+//
+// Note: the loop runs isolated, the calling thread does not pick up unrelated tasks while it
+// waits for the loop to finish. Callers may therefore rely on their thread local state.
+template <typename RandIt, typename Predicate>
+RandIt parallel_remove_if(RandIt first, RandIt last, Predicate predicate, std::size_t grain = 8)
+{
+    static_assert_iter_category<RandIt, std::random_access_iterator_tag>();
+
+    const auto size = static_cast<std::size_t>(std::distance(first, last));
+    std::vector<std::uint8_t> remove(size);
+    tbb::this_task_arena::isolate([&] {
+        tbb::parallel_for(tbb::blocked_range<std::size_t>(0, size, grain),
+                          [&](const tbb::blocked_range<std::size_t> &range) {
+                              for (auto index = range.begin(); index != range.end(); ++index)
+                              {
+                                  remove[index] = predicate(*(first + index));
+                              }
+                          });
+    });
+
+    auto out = first;
+    for (std::size_t index = 0; index < size; ++index)
+    {
+        if (!remove[index])
+        {
+            if (out != first + index)
+                *out = std::move(*(first + index));
+            ++out;
+        }
+    }
+    return out;
+}
+} // namespace util
+} // namespace osrm
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef OSRM_STATIC_ASSERT_HPP
 #define OSRM_STATIC_ASSERT_HPP
 
+#include <iterator>
 #include <type_traits>
 
 namespace osrm
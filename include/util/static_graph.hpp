@@ -192,6 +192,31 @@ class StaticGraph
         return SPECIAL_EDGEID;
     }
 
+    /**
+     * Finds the first edge of `from` whose target is not smaller than `to` with a branch-free
+     * binary search.
+     *
+     * Only valid if the adjacency of `from` is sorted by target. This holds for graphs that were
+     * constructed from sorted edges, like the contracted graph, but not for renumbered graphs or
+     * the MultiLevelGraph.
+     * @return an edge in [BeginEdges(from), EndEdges(from)]
+     */
+    EdgeIterator LowerBoundEdge(const NodeIterator from, const NodeIterator to) const
+    {
+        EdgeIterator first = BeginEdges(from);
+        EdgeIterator length = EndEdges(from) - first;
+        if (length == 0)
+            return first;
+
+        while (length > 1)
+        {
+            const EdgeIterator half = length / 2;
+            first = edge_array[first + half].target < to ? first + half : first;
+            length -= half;
+        }
+        return first + (edge_array[first].target < to ? 1 : 0);
+    }
+
     /**
      * Finds the edge with the smallest `.weight` going from `from` to `to`
      * @param from the source node ID
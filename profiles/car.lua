@@ -119,6 +119,13 @@ function setup()
         'toll', 'motorway', 'ferry', 'restricted', 'tunnel'
     },
 
+    -- ways without any of these tags are dropped before process_way is called,
+    -- this has to match the initial tag check in process_way
+    relevant_way_keys = Sequence {
+      'highway',
+      'route'
+    },
+
     -- classes to support for exclude flags
     excludable = Sequence {
         Set {'toll'},
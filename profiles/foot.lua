@@ -63,6 +63,20 @@ function setup()
       'foot'
     },
 
+    -- ways without any of these tags are dropped before process_way is called,
+    -- this has to match the prefetched tags checked in process_way
+    relevant_way_keys = Sequence {
+      'highway',
+      'bridge',
+      'route',
+      'leisure',
+      'man_made',
+      'railway',
+      'platform',
+      'amenity',
+      'public_transport'
+    },
+
     -- list of suffixes to suppress in name change instructions
     suffix_list = Set {
       'N', 'NE', 'E', 'SE', 'S', 'SW', 'W', 'NW', 'North', 'South', 'West', 'East'
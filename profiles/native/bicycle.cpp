@@ -0,0 +1,721 @@
+// Native port of profiles/bicycle.lua and the parts of profiles/lib it uses
+//
+// Build as a shared object against the OSRM headers and pass it to osrm-extract:
+//   osrm-extract --profile bicycle.so map.osm.pbf
+//
+// The port follows the Lua code step by step, so both profiles extract the same data. The
+// cyclability weight of the Lua profile is commented out there, only the duration weight is ported.
+
+#include "extractor/extraction_helper_functions.hpp"
+#include "extractor/native_profile.hpp"
+#include "extractor/travel_mode.hpp"
+
+#include "profile_helpers.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace
+{
+using namespace osrm::extractor;
+using namespace osrm::profiles;
+
+const constexpr double DEFAULT_SPEED = 15;
+const constexpr double WALKING_SPEED = 4;
+const constexpr double TURN_PENALTY = 6;
+const constexpr double TURN_BIAS = 1.4;
+const constexpr double U_TURN_PENALTY = 20;
+const constexpr double TRAFFIC_LIGHT_PENALTY = 2;
+const constexpr double MODE_CHANGE_PENALTY = 30;
+
+// Intermediate values of the way handlers, the `data` table of the Lua profile
+struct WayData
+{
+    const char *highway = nullptr;
+    const char *route = nullptr;
+    const char *man_made = nullptr;
+    const char *railway = nullptr;
+    const char *amenity = nullptr;
+    const char *public_transport = nullptr;
+    const char *bridge = nullptr;
+    const char *access = nullptr;
+    const char *junction = nullptr;
+    double maxspeed = 0;
+    double maxspeed_forward = 0;
+    double maxspeed_backward = 0;
+    // the raw oneway tag, bicycle.lua never sets the oneway flags the tag helpers look at
+    const char *oneway = nullptr;
+    const bool is_forward_oneway = false;
+    const bool is_reverse_oneway = false;
+    const char *oneway_bicycle = nullptr;
+    const char *cycleway = nullptr;
+    const char *cycleway_left = nullptr;
+    const char *cycleway_right = nullptr;
+    const char *duration = nullptr;
+    const char *foot = nullptr;
+    const char *foot_forward = nullptr;
+    const char *foot_backward = nullptr;
+    const char *bicycle = nullptr;
+
+    bool way_type_allows_pushing = false;
+    bool has_cycleway_forward = false;
+    bool has_cycleway_backward = false;
+    bool reverse = false;
+    bool implied_oneway = false;
+};
+
+class BicycleProfile final : public NativeProfile
+{
+  public:
+    ProfileProperties GetProfileProperties() const override
+    {
+        ProfileProperties properties;
+        properties.SetUturnPenalty(U_TURN_PENALTY);
+        properties.SetWeightName("duration");
+        properties.SetMaxSpeedForMapMatching(110 / 3.6);
+        properties.use_turn_restrictions = false;
+        properties.continue_straight_at_waypoint = false;
+        // bicycle.lua sets `traffic_light_penalty`, `process_call_tagless_node` and
+        // `mode_change_penalty`, which are not profile properties, so the defaults of these are
+        // kept
+        return properties;
+    }
+
+    std::vector<std::vector<std::string>> GetExcludableClasses() const override { return {}; }
+
+    std::vector<std::string> GetClassNames() const override { return {"ferry", "tunnel"}; }
+
+    std::vector<std::string> GetNameSuffixList() const override { return {}; }
+
+    // not used as the profile does not use turn restrictions
+    std::vector<std::string> GetRestrictions() const override { return {"bicycle"}; }
+
+    std::vector<std::string> GetRelations() const override { return {}; }
+
+    void ProcessNode(const osmium::Node &node,
+                     ExtractionNode &result,
+                     const ExtractionRelationContainer &,
+                     const LocationTags &) const override
+    {
+        // parse access and barrier tags
+        const auto highway = getValue(node, "highway");
+        const auto is_crossing = equals(highway, "crossing");
+
+        const auto access = findAccessTag(node, access_tags_hierarchy);
+        if (access)
+        {
+            // access restrictions on crossing nodes are not relevant for the traffic on the road
+            if (access_tag_blacklist.Contains(access) && !is_crossing)
+            {
+                result.barrier = true;
+            }
+        }
+        else
+        {
+            if (barrier_blacklist.Contains(getValue(node, "barrier")))
+            {
+                result.barrier = true;
+            }
+        }
+
+        // check if node is a traffic light
+        if (equals(highway, "traffic_signals"))
+        {
+            result.traffic_lights = true;
+        }
+    }
+
+    void ProcessWay(const osmium::Way &way,
+                    ExtractionWay &result,
+                    const ExtractionRelationContainer &,
+                    const LocationTags &) const override
+    {
+        WayData data;
+        data.highway = getValue(way, "highway");
+
+        // Same order as the handlers in bicycle.lua, a handler returns false to abort
+        using Handler = bool (BicycleProfile::*)(const osmium::Way &, ExtractionWay &, WayData &)
+            const;
+        static const Handler handlers[] = {&BicycleProfile::DefaultMode,
+                                           &BicycleProfile::BlockedWays,
+                                           &BicycleProfile::HandleBicycleTags,
+                                           &BicycleProfile::Surface,
+                                           &BicycleProfile::Classification,
+                                           &BicycleProfile::Startpoint,
+                                           &BicycleProfile::Roundabouts,
+                                           &BicycleProfile::Names,
+                                           &BicycleProfile::Classes};
+        // WayHandlers.weights is not ported, it does nothing for the duration weight
+
+        for (const auto handler : handlers)
+        {
+            if (!(this->*handler)(way, result, data))
+            {
+                return;
+            }
+        }
+    }
+
+    void ProcessTurn(ExtractionTurn &turn) const override
+    {
+        // compute turn penalty as angle^2, with a left/right bias
+        const auto normalized_angle = turn.angle / 90.0;
+        if (normalized_angle >= 0.0)
+        {
+            turn.duration = normalized_angle * normalized_angle * TURN_PENALTY / TURN_BIAS;
+        }
+        else
+        {
+            turn.duration = normalized_angle * normalized_angle * TURN_PENALTY * TURN_BIAS;
+        }
+
+        if (turn.is_u_turn)
+        {
+            turn.duration = turn.duration + U_TURN_PENALTY;
+        }
+
+        if (turn.has_traffic_light)
+        {
+            turn.duration = turn.duration + TRAFFIC_LIGHT_PENALTY;
+        }
+
+        // the duration weight replaces the weight by the duration afterwards
+        if (turn.source_mode == TRAVEL_MODE_CYCLING && turn.target_mode != TRAVEL_MODE_CYCLING)
+        {
+            turn.weight = turn.weight + MODE_CHANGE_PENALTY;
+        }
+    }
+
+  private:
+    // lib/way_handlers.lua
+
+    bool DefaultMode(const osmium::Way &, ExtractionWay &result, WayData &) const
+    {
+        result.forward_travel_mode = TRAVEL_MODE_CYCLING;
+        result.backward_travel_mode = TRAVEL_MODE_CYCLING;
+        return true;
+    }
+
+    // impassable ways and constructions are the blocked ways the profile avoids
+    bool BlockedWays(const osmium::Way &way, ExtractionWay &, WayData &data) const
+    {
+        // construction
+        if (equals(data.highway, "construction") ||
+            equals(getValue(way, "railway"), "construction"))
+            return false;
+
+        const auto construction = getValue(way, "construction");
+        if (construction && !construction_whitelist.Contains(construction))
+            return false;
+
+        // impassables
+        if (equals(getValue(way, "impassable"), "yes"))
+            return false;
+        if (equals(getValue(way, "status"), "impassable"))
+            return false;
+
+        return true;
+    }
+
+    // bicycle.lua: handle_bicycle_tags, the main handler
+    bool HandleBicycleTags(const osmium::Way &way, ExtractionWay &result, WayData &data) const
+    {
+        // initial routability check, filters out buildings, boundaries, etc
+        data.route = getValue(way, "route");
+        data.man_made = getValue(way, "man_made");
+        data.railway = getValue(way, "railway");
+        data.amenity = getValue(way, "amenity");
+        data.public_transport = getValue(way, "public_transport");
+        data.bridge = getValue(way, "bridge");
+
+        if (!data.highway && !data.route && !data.railway && !data.amenity && !data.man_made &&
+            !data.public_transport && !data.bridge)
+        {
+            return false;
+        }
+
+        // access
+        data.access = findAccessTag(way, access_tags_hierarchy);
+        if (access_tag_blacklist.Contains(data.access))
+        {
+            return false;
+        }
+
+        // other tags
+        data.junction = getValue(way, "junction");
+        data.maxspeed = measure::getMaxSpeed(getValue(way, "maxspeed")).value_or(0);
+        data.maxspeed_forward =
+            measure::getMaxSpeed(getValue(way, "maxspeed:forward")).value_or(0);
+        data.maxspeed_backward =
+            measure::getMaxSpeed(getValue(way, "maxspeed:backward")).value_or(0);
+        data.oneway = getValue(way, "oneway");
+        data.oneway_bicycle = getValue(way, "oneway:bicycle");
+        data.cycleway = getValue(way, "cycleway");
+        data.cycleway_left = getValue(way, "cycleway:left");
+        data.cycleway_right = getValue(way, "cycleway:right");
+        data.duration = getValue(way, "duration");
+        data.foot = getValue(way, "foot");
+        data.foot_forward = getValue(way, "foot:forward");
+        data.foot_backward = getValue(way, "foot:backward");
+        data.bicycle = getValue(way, "bicycle");
+
+        HandleSpeed(result, data);
+        HandleOneway(result, data);
+        HandleCycleway(result, data);
+        HandleBikePush(result, data);
+
+        // maxspeed, lib/maxspeed.lua: MaxSpeed.limit
+        if (data.maxspeed_forward > 0)
+            result.forward_speed = std::min(result.forward_speed, data.maxspeed_forward);
+        else if (data.maxspeed > 0)
+            result.forward_speed = std::min(result.forward_speed, data.maxspeed);
+
+        if (data.maxspeed_backward > 0)
+            result.backward_speed = std::min(result.backward_speed, data.maxspeed_backward);
+        else if (data.maxspeed > 0)
+            result.backward_speed = std::min(result.backward_speed, data.maxspeed);
+
+        // not routable if no speed assigned, this avoid assertions in debug builds
+        if (result.forward_speed <= 0 && result.duration <= 0)
+            result.forward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+        if (result.backward_speed <= 0 && result.duration <= 0)
+            result.backward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+
+        // the safety handler only applies to the cyclability weight
+        return true;
+    }
+
+    void HandleSpeed(ExtractionWay &result, WayData &data) const
+    {
+        data.way_type_allows_pushing = false;
+
+        const auto set_speed = [&result](const double speed) {
+            result.forward_speed = speed;
+            result.backward_speed = speed;
+        };
+
+        const auto bridge_speed = bridge_speeds.Find(data.bridge);
+        const auto route_speed = route_speeds.Find(data.route);
+        const auto railway_platform_speed = platform_speeds.Find(data.railway);
+        const auto public_transport_speed = platform_speeds.Find(data.public_transport);
+        const auto railway_speed = railway_speeds.Find(data.railway);
+        const auto amenity_speed = amenity_speeds.Find(data.amenity);
+
+        if (bridge_speed && *bridge_speed > 0)
+        {
+            // the movable bridge takes the place of the highway in the handlers that follow
+            data.highway = data.bridge;
+            if (data.duration && durationIsValid(data.duration))
+            {
+                result.duration = std::max<double>(parseDuration(data.duration), 1);
+            }
+            set_speed(*bridge_speed);
+            data.way_type_allows_pushing = true;
+        }
+        else if (route_speed)
+        {
+            // ferries (doesn't cover routes tagged using relations)
+            result.forward_travel_mode = TRAVEL_MODE_FERRY;
+            result.backward_travel_mode = TRAVEL_MODE_FERRY;
+            if (data.duration && durationIsValid(data.duration))
+            {
+                result.duration = std::max<double>(1, parseDuration(data.duration));
+            }
+            else
+            {
+                set_speed(*route_speed);
+            }
+        }
+        // railway platforms (old tagging scheme)
+        else if (railway_platform_speed)
+        {
+            set_speed(*railway_platform_speed);
+            data.way_type_allows_pushing = true;
+        }
+        // public_transport platforms (new tagging platform)
+        else if (public_transport_speed)
+        {
+            set_speed(*public_transport_speed);
+            data.way_type_allows_pushing = true;
+        }
+        // railways
+        else if (railway_speed && access_tag_whitelist.Contains(data.access))
+        {
+            result.forward_travel_mode = TRAVEL_MODE_TRAIN;
+            result.backward_travel_mode = TRAVEL_MODE_TRAIN;
+            set_speed(*railway_speed);
+        }
+        // parking areas
+        else if (amenity_speed)
+        {
+            set_speed(*amenity_speed);
+            data.way_type_allows_pushing = true;
+        }
+        // regular ways
+        else if (const auto highway_speed = bicycle_speeds.Find(data.highway))
+        {
+            set_speed(*highway_speed);
+            data.way_type_allows_pushing = true;
+        }
+        // unknown way, but valid access tag
+        else if (access_tag_whitelist.Contains(data.access))
+        {
+            set_speed(DEFAULT_SPEED);
+            data.way_type_allows_pushing = true;
+        }
+    }
+
+    void HandleOneway(ExtractionWay &result, WayData &data) const
+    {
+        data.implied_oneway = equals(data.junction, "roundabout") ||
+                              equals(data.junction, "circular") ||
+                              equals(data.highway, "motorway");
+        data.reverse = false;
+
+        const auto is_yes = [](const char *value) {
+            return equals(value, "yes") || equals(value, "1") || equals(value, "true");
+        };
+        const auto is_no = [](const char *value) {
+            return equals(value, "no") || equals(value, "0") || equals(value, "false");
+        };
+
+        if (is_yes(data.oneway_bicycle))
+        {
+            result.backward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+        }
+        else if (is_no(data.oneway_bicycle))
+        {
+            // prevent other cases
+        }
+        else if (equals(data.oneway_bicycle, "-1"))
+        {
+            result.forward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+            data.reverse = true;
+        }
+        else if (is_yes(data.oneway))
+        {
+            result.backward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+        }
+        else if (is_no(data.oneway))
+        {
+            // prevent other cases
+        }
+        else if (equals(data.oneway, "-1"))
+        {
+            result.forward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+            data.reverse = true;
+        }
+        else if (data.implied_oneway)
+        {
+            result.backward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+        }
+    }
+
+    void HandleCycleway(ExtractionWay &result, WayData &data) const
+    {
+        data.has_cycleway_forward = false;
+        data.has_cycleway_backward = false;
+        const auto is_twoway = result.forward_travel_mode != TRAVEL_MODE_INACCESSIBLE &&
+                               result.backward_travel_mode != TRAVEL_MODE_INACCESSIBLE &&
+                               !data.implied_oneway;
+
+        // cycleways on normal roads
+        if (is_twoway)
+        {
+            if (cycleway_tags.Contains(data.cycleway))
+            {
+                data.has_cycleway_backward = true;
+                data.has_cycleway_forward = true;
+            }
+            if (cycleway_tags.Contains(data.cycleway_right) ||
+                opposite_cycleway_tags.Contains(data.cycleway_left))
+            {
+                data.has_cycleway_forward = true;
+            }
+            if (cycleway_tags.Contains(data.cycleway_left) ||
+                opposite_cycleway_tags.Contains(data.cycleway_right))
+            {
+                data.has_cycleway_backward = true;
+            }
+        }
+        else
+        {
+            const auto has_twoway_cycleway = opposite_cycleway_tags.Contains(data.cycleway) ||
+                                             opposite_cycleway_tags.Contains(data.cycleway_right) ||
+                                             opposite_cycleway_tags.Contains(data.cycleway_left);
+            const auto has_opposite_cycleway =
+                opposite_cycleway_tags.Contains(data.cycleway_left) ||
+                opposite_cycleway_tags.Contains(data.cycleway_right);
+            const auto has_oneway_cycleway = cycleway_tags.Contains(data.cycleway) ||
+                                             cycleway_tags.Contains(data.cycleway_right) ||
+                                             cycleway_tags.Contains(data.cycleway_left);
+
+            // set cycleway even though it is an one-way if opposite is tagged
+            if (has_twoway_cycleway)
+            {
+                data.has_cycleway_backward = true;
+                data.has_cycleway_forward = true;
+            }
+            else if (has_opposite_cycleway)
+            {
+                if (!data.reverse)
+                    data.has_cycleway_backward = true;
+                else
+                    data.has_cycleway_forward = true;
+            }
+            else if (has_oneway_cycleway)
+            {
+                if (!data.reverse)
+                    data.has_cycleway_forward = true;
+                else
+                    data.has_cycleway_backward = true;
+            }
+        }
+
+        const auto cycleway_speed = *bicycle_speeds.Find("cycleway");
+        if (data.has_cycleway_backward)
+        {
+            result.backward_travel_mode = TRAVEL_MODE_CYCLING;
+            result.backward_speed = cycleway_speed;
+        }
+        if (data.has_cycleway_forward)
+        {
+            result.forward_travel_mode = TRAVEL_MODE_CYCLING;
+            result.forward_speed = cycleway_speed;
+        }
+    }
+
+    void HandleBikePush(ExtractionWay &result, WayData &data) const
+    {
+        // pushing bikes - if no other mode found
+        if ((result.forward_travel_mode == TRAVEL_MODE_INACCESSIBLE ||
+             result.backward_travel_mode == TRAVEL_MODE_INACCESSIBLE ||
+             result.forward_speed == -1 || result.backward_speed == -1) &&
+            !equals(data.foot, "no"))
+        {
+            const double *push_forward_speed = nullptr;
+            const double *push_backward_speed = nullptr;
+
+            const auto pedestrian_speed = pedestrian_speeds.Find(data.highway);
+            const auto man_made_speed = man_made_speeds.Find(data.man_made);
+            if (pedestrian_speed)
+            {
+                push_forward_speed = pedestrian_speed;
+                push_backward_speed = pedestrian_speed;
+            }
+            else if (man_made_speed)
+            {
+                push_forward_speed = man_made_speed;
+                push_backward_speed = man_made_speed;
+            }
+            else if (equals(data.foot, "yes"))
+            {
+                push_forward_speed = &WALKING_SPEED;
+                if (!data.implied_oneway)
+                    push_backward_speed = &WALKING_SPEED;
+            }
+            else if (equals(data.foot_forward, "yes"))
+            {
+                push_forward_speed = &WALKING_SPEED;
+            }
+            else if (equals(data.foot_backward, "yes"))
+            {
+                push_backward_speed = &WALKING_SPEED;
+            }
+            else if (data.way_type_allows_pushing)
+            {
+                push_forward_speed = &WALKING_SPEED;
+                if (!data.implied_oneway)
+                    push_backward_speed = &WALKING_SPEED;
+            }
+
+            if (push_forward_speed && (result.forward_travel_mode == TRAVEL_MODE_INACCESSIBLE ||
+                                       result.forward_speed == -1))
+            {
+                result.forward_travel_mode = TRAVEL_MODE_PUSHING_BIKE;
+                result.forward_speed = *push_forward_speed;
+            }
+            if (push_backward_speed && (result.backward_travel_mode == TRAVEL_MODE_INACCESSIBLE ||
+                                        result.backward_speed == -1))
+            {
+                result.backward_travel_mode = TRAVEL_MODE_PUSHING_BIKE;
+                result.backward_speed = *push_backward_speed;
+            }
+        }
+
+        // dismount
+        if (equals(data.bicycle, "dismount"))
+        {
+            result.forward_travel_mode = TRAVEL_MODE_PUSHING_BIKE;
+            result.backward_travel_mode = TRAVEL_MODE_PUSHING_BIKE;
+            result.forward_speed = WALKING_SPEED;
+            result.backward_speed = WALKING_SPEED;
+        }
+    }
+
+    // reduce speed on bad surfaces
+    bool Surface(const osmium::Way &way, ExtractionWay &result, WayData &) const
+    {
+        const auto speed = surface_speeds.Find(getValue(way, "surface"));
+        if (speed)
+        {
+            result.forward_speed = std::min(*speed, result.forward_speed);
+            result.backward_speed = std::min(*speed, result.backward_speed);
+        }
+        return true;
+    }
+
+    // set the road classification based on guidance globals configuration
+    bool Classification(const osmium::Way &way, ExtractionWay &result, WayData &data) const
+    {
+        setClassification(data.highway, result, way);
+        return true;
+    }
+
+    // determine if this way can be used as a start/end point for routing
+    bool Startpoint(const osmium::Way &, ExtractionWay &result, WayData &) const
+    {
+        const auto is_start_mode = [](const TravelMode mode) {
+            return mode == TRAVEL_MODE_CYCLING || mode == TRAVEL_MODE_PUSHING_BIKE;
+        };
+        result.is_startpoint =
+            is_start_mode(result.forward_travel_mode) || is_start_mode(result.backward_travel_mode);
+        return true;
+    }
+
+    bool Roundabouts(const osmium::Way &way, ExtractionWay &result, WayData &) const
+    {
+        const auto junction = getValue(way, "junction");
+        if (equals(junction, "roundabout"))
+            result.roundabout = true;
+        // See Issue 3361: roundabout-shaped not following roundabout rules.
+        if (equals(junction, "circular"))
+            result.circular = true;
+        return true;
+    }
+
+    // handles name, including ref and pronunciation
+    bool Names(const osmium::Way &way, ExtractionWay &result, WayData &) const
+    {
+        const auto name = getValue(way, "name");
+        const auto pronunciation = getValue(way, "name:pronunciation");
+        const auto ref = getValue(way, "ref");
+        const auto exits = getValue(way, "junction:ref");
+
+        if (name)
+        {
+            result.SetName(name);
+        }
+        if (ref)
+        {
+            const auto canonical_ref = canonicalizeStringList(ref, ";");
+            result.SetForwardRef(canonical_ref.c_str());
+            result.SetBackwardRef(canonical_ref.c_str());
+        }
+        if (pronunciation)
+        {
+            result.SetPronunciation(pronunciation);
+        }
+        if (exits)
+        {
+            result.SetExits(canonicalizeStringList(exits, ";").c_str());
+        }
+        return true;
+    }
+
+    // add class information
+    bool Classes(const osmium::Way &way, ExtractionWay &result, WayData &data) const
+    {
+        const auto route = getForwardBackwardByKey(way, data, route_key);
+        const auto tunnel = getValue(way, "tunnel");
+
+        if (tunnel && !equals(tunnel, "no"))
+        {
+            result.forward_classes["tunnel"] = true;
+            result.backward_classes["tunnel"] = true;
+        }
+
+        if (equals(route.forward, "ferry"))
+            result.forward_classes["ferry"] = true;
+        if (equals(route.backward, "ferry"))
+            result.backward_classes["ferry"] = true;
+
+        return true;
+    }
+
+    const TagValueSet barrier_blacklist{"yes", "wall", "fence"};
+
+    const TagValueSet access_tag_whitelist{"yes", "permissive", "designated"};
+
+    // When a way is tagged with `use_sidepath` a parallel way suitable for cyclists is mapped and
+    // must be used instead (by law), so it is treated as 'no access for bicycles'.
+    const TagValueSet access_tag_blacklist{
+        "no", "private", "agricultural", "forestry", "delivery", "use_sidepath"};
+
+    const TagValueSet construction_whitelist{"no", "widening", "minor"};
+
+    const DirectionalKeys access_tags_hierarchy{"bicycle", "vehicle", "access"};
+
+    const TagValueSet cycleway_tags{
+        "track", "lane", "share_busway", "sharrow", "shared", "shared_lane"};
+
+    const TagValueSet opposite_cycleway_tags{"opposite", "opposite_lane", "opposite_track"};
+
+    const TagValueMap<double> bicycle_speeds{{"cycleway", DEFAULT_SPEED},
+                                             {"primary", DEFAULT_SPEED},
+                                             {"primary_link", DEFAULT_SPEED},
+                                             {"secondary", DEFAULT_SPEED},
+                                             {"secondary_link", DEFAULT_SPEED},
+                                             {"tertiary", DEFAULT_SPEED},
+                                             {"tertiary_link", DEFAULT_SPEED},
+                                             {"residential", DEFAULT_SPEED},
+                                             {"unclassified", DEFAULT_SPEED},
+                                             {"living_street", DEFAULT_SPEED},
+                                             {"road", DEFAULT_SPEED},
+                                             {"service", DEFAULT_SPEED},
+                                             {"track", 12},
+                                             {"path", 12}};
+
+    const TagValueMap<double> pedestrian_speeds{
+        {"footway", WALKING_SPEED}, {"pedestrian", WALKING_SPEED}, {"steps", 2}};
+
+    const TagValueMap<double> railway_speeds{{"train", 10},
+                                             {"railway", 10},
+                                             {"subway", 10},
+                                             {"light_rail", 10},
+                                             {"monorail", 10},
+                                             {"tram", 10}};
+
+    const TagValueMap<double> platform_speeds{{"platform", WALKING_SPEED}};
+
+    const TagValueMap<double> amenity_speeds{{"parking", 10}, {"parking_entrance", 10}};
+
+    const TagValueMap<double> man_made_speeds{{"pier", WALKING_SPEED}};
+
+    const TagValueMap<double> route_speeds{{"ferry", 5}};
+
+    const TagValueMap<double> bridge_speeds{{"movable", 5}};
+
+    const TagValueMap<double> surface_speeds{{"asphalt", DEFAULT_SPEED},
+                                             {"cobblestone:flattened", 10},
+                                             {"paving_stones", 10},
+                                             {"compacted", 10},
+                                             {"cobblestone", 6},
+                                             {"unpaved", 6},
+                                             {"fine_gravel", 6},
+                                             {"gravel", 6},
+                                             {"pebblestone", 6},
+                                             {"ground", 6},
+                                             {"dirt", 6},
+                                             {"earth", 6},
+                                             {"grass", 6},
+                                             {"mud", 3},
+                                             {"sand", 3},
+                                             {"sett", 10}};
+
+    const DirectionalKey route_key{"route"};
+};
+}
+
+OSRM_NATIVE_PROFILE(BicycleProfile)
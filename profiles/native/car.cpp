@@ -0,0 +1,1006 @@
+// Native port of profiles/car.lua and the parts of profiles/lib it uses
+//
+// Build as a shared object against the OSRM headers and pass it to osrm-extract:
+//   osrm-extract --profile car.so map.osm.pbf
+//
+// The port follows the Lua code step by step, so both profiles extract the same data, including
+// the values taken from location dependent data (--location-dependent-data).
+
+#include "extractor/extraction_helper_functions.hpp"
+#include "extractor/native_profile.hpp"
+#include "extractor/travel_mode.hpp"
+#include "util/typedefs.hpp"
+
+#include "profile_helpers.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace
+{
+using namespace osrm::extractor;
+using namespace osrm::profiles;
+
+const constexpr double DEFAULT_SPEED = 10;
+const constexpr double SIDE_ROAD_MULTIPLIER = 0.8;
+const constexpr double TURN_PENALTY = 7.5;
+const constexpr double SPEED_REDUCTION = 0.8;
+const constexpr double TURN_BIAS = 1.075;
+const constexpr double U_TURN_PENALTY = 20;
+const constexpr double TRAFFIC_LIGHT_PENALTY = 2;
+
+// Size of the vehicle, to be limited by physical restriction of the way
+const constexpr double VEHICLE_HEIGHT = 2.0;
+const constexpr double VEHICLE_WIDTH = 1.9;
+// Size of the vehicle, to be limited mostly by legal restriction of the way
+const constexpr double VEHICLE_LENGTH = 4.8;
+const constexpr double VEHICLE_WEIGHT = 2000;
+
+// Intermediate values of the way handlers, the `data` table of the Lua profile
+struct WayData
+{
+    explicit WayData(const LocationTags &location_tags) : location_tags(location_tags) {}
+
+    // the `get_location_tag` function of the way
+    const LocationTags &location_tags;
+
+    const char *highway = nullptr;
+    const char *bridge = nullptr;
+    const char *route = nullptr;
+    const char *forward_access = nullptr;
+    const char *backward_access = nullptr;
+    const char *oneway = nullptr;
+    bool is_forward_oneway = false;
+    bool is_reverse_oneway = false;
+};
+
+class CarProfile final : public NativeProfile
+{
+  public:
+    ProfileProperties GetProfileProperties() const override
+    {
+        ProfileProperties properties;
+        properties.SetMaxSpeedForMapMatching(180 / 3.6);
+        properties.SetWeightName("routability");
+        properties.SetUturnPenalty(U_TURN_PENALTY);
+        properties.continue_straight_at_waypoint = true;
+        properties.use_turn_restrictions = true;
+        properties.left_hand_driving = false;
+        // car.lua sets `process_call_tagless_node` and `traffic_light_penalty`, which are not
+        // profile properties, so the defaults of these are kept
+        return properties;
+    }
+
+    std::vector<std::vector<std::string>> GetExcludableClasses() const override
+    {
+        return {{"toll"}, {"motorway"}, {"ferry"}};
+    }
+
+    std::vector<std::string> GetClassNames() const override
+    {
+        return {"toll", "motorway", "ferry", "restricted", "tunnel"};
+    }
+
+    std::vector<std::string> GetNameSuffixList() const override
+    {
+        return {"N",
+                "NE",
+                "E",
+                "SE",
+                "S",
+                "SW",
+                "W",
+                "NW",
+                "North",
+                "South",
+                "West",
+                "East",
+                "Nor",
+                "Sou",
+                "We",
+                "Ea"};
+    }
+
+    std::vector<std::string> GetRestrictions() const override
+    {
+        return {"motorcar", "motor_vehicle", "vehicle"};
+    }
+
+    std::vector<std::string> GetRelations() const override { return {"route"}; }
+
+    void ProcessNode(const osmium::Node &node,
+                     ExtractionNode &result,
+                     const ExtractionRelationContainer &,
+                     const LocationTags &location_tags) const override
+    {
+        // parse access and barrier tags
+        const auto access = findAccessTag(node, access_tags_hierarchy);
+        if (access)
+        {
+            if (access_tag_blacklist.Contains(access) &&
+                !restricted_access_tag_list.Contains(access))
+            {
+                result.barrier = true;
+            }
+        }
+        else
+        {
+            const auto barrier = getValue(node, "barrier");
+            if (barrier)
+            {
+                // check height restriction barriers
+                bool restricted_by_height = false;
+                if (equals(barrier, "height_restrictor"))
+                {
+                    const auto maxheight =
+                        measure::getMaxHeight(getValue(node, "maxheight"), node, location_tags);
+                    restricted_by_height = maxheight && *maxheight < VEHICLE_HEIGHT;
+                }
+
+                // make an exception for rising bollard barriers
+                const auto rising_bollard = equals(getValue(node, "bollard"), "rising");
+
+                if ((!barrier_whitelist.Contains(barrier) && !rising_bollard) ||
+                    restricted_by_height)
+                {
+                    result.barrier = true;
+                }
+            }
+        }
+
+        // check if node is a traffic light
+        if (equals(getValue(node, "highway"), "traffic_signals"))
+        {
+            result.traffic_lights = true;
+        }
+    }
+
+    void ProcessWay(const osmium::Way &way,
+                    ExtractionWay &result,
+                    const ExtractionRelationContainer &,
+                    const LocationTags &location_tags) const override
+    {
+        WayData data(location_tags);
+        data.highway = getValue(way, "highway");
+        data.bridge = getValue(way, "bridge");
+        data.route = getValue(way, "route");
+
+        // perform an quick initial check and abort if the way is obviously not routable
+        if (!data.highway && !data.route)
+        {
+            return;
+        }
+
+        // Same order as the handlers in car.lua, a handler returns false to abort
+        using Handler = bool (CarProfile::*)(const osmium::Way &, ExtractionWay &, WayData &)
+            const;
+        static const Handler handlers[] = {&CarProfile::DefaultMode,
+                                           &CarProfile::BlockedWays,
+                                           &CarProfile::AvoidWays,
+                                           &CarProfile::HandleHeight,
+                                           &CarProfile::HandleWidth,
+                                           &CarProfile::HandleLength,
+                                           &CarProfile::HandleWeight,
+                                           &CarProfile::Access,
+                                           &CarProfile::Oneway,
+                                           &CarProfile::Destinations,
+                                           &CarProfile::Ferries,
+                                           &CarProfile::Movables,
+                                           &CarProfile::Service,
+                                           &CarProfile::Hov,
+                                           &CarProfile::Speed,
+                                           &CarProfile::Surface,
+                                           &CarProfile::Maxspeed,
+                                           &CarProfile::Penalties,
+                                           &CarProfile::Classes,
+                                           &CarProfile::TurnLanes,
+                                           &CarProfile::Classification,
+                                           &CarProfile::Roundabouts,
+                                           &CarProfile::Startpoint,
+                                           &CarProfile::DrivingSide,
+                                           &CarProfile::Names};
+        // WayHandlers.weights and WayHandlers.way_classification_for_turn are not ported, they
+        // do nothing for the routability weight and without turn classifications
+
+        for (const auto handler : handlers)
+        {
+            if (!(this->*handler)(way, result, data))
+            {
+                return;
+            }
+        }
+    }
+
+    void ProcessTurn(ExtractionTurn &turn) const override
+    {
+        // Use a sigmoid function to return a penalty that maxes out at turn_penalty over the
+        // space of 0-180 degrees. Values here were chosen by fitting the function to some turn
+        // penalty samples from real driving.
+        const auto turn_bias = turn.is_left_hand_driving ? 1. / TURN_BIAS : TURN_BIAS;
+
+        if (turn.has_traffic_light)
+        {
+            turn.duration = TRAFFIC_LIGHT_PENALTY;
+        }
+
+        if (turn.number_of_roads > 2 || turn.source_mode != turn.target_mode || turn.is_u_turn)
+        {
+            if (turn.angle >= 0)
+            {
+                turn.duration =
+                    turn.duration +
+                    TURN_PENALTY /
+                        (1 + std::exp(-((13 / turn_bias) * turn.angle / 180 - 6.5 * turn_bias)));
+            }
+            else
+            {
+                turn.duration =
+                    turn.duration +
+                    TURN_PENALTY /
+                        (1 + std::exp(-((13 * turn_bias) * -turn.angle / 180 - 6.5 / turn_bias)));
+            }
+
+            if (turn.is_u_turn)
+            {
+                turn.duration = turn.duration + U_TURN_PENALTY;
+            }
+        }
+
+        turn.weight = turn.duration;
+
+        // penalize turns from non-local access only segments onto local access only tags
+        if (!turn.source_restricted && turn.target_restricted)
+        {
+            turn.weight = std::numeric_limits<TurnPenalty>::max();
+        }
+    }
+
+  private:
+    // lib/way_handlers.lua
+
+    bool DefaultMode(const osmium::Way &, ExtractionWay &result, WayData &) const
+    {
+        result.forward_travel_mode = TRAVEL_MODE_DRIVING;
+        result.backward_travel_mode = TRAVEL_MODE_DRIVING;
+        return true;
+    }
+
+    bool BlockedWays(const osmium::Way &way, ExtractionWay &, WayData &data) const
+    {
+        // areas
+        if (equals(getValue(way, "area"), "yes"))
+            return false;
+
+        // don't route over steps
+        if (equals(data.highway, "steps"))
+            return false;
+
+        // construction
+        if (equals(data.highway, "construction") ||
+            equals(getValue(way, "railway"), "construction"))
+            return false;
+
+        const auto construction = getValue(way, "construction");
+        if (construction && !construction_whitelist.Contains(construction))
+            return false;
+
+        if (getValue(way, "proposed"))
+            return false;
+
+        // Reversible oneways change direction with low frequency (think twice a day): do not
+        // route over these at all at the moment because of time dependence.
+        if (equals(getValue(way, "oneway"), "reversible"))
+            return false;
+
+        // impassables
+        if (equals(getValue(way, "impassable"), "yes"))
+            return false;
+        if (equals(getValue(way, "status"), "impassable"))
+            return false;
+
+        return true;
+    }
+
+    bool AvoidWays(const osmium::Way &, ExtractionWay &, WayData &data) const
+    {
+        return !avoid.Contains(data.highway);
+    }
+
+    bool HandleHeight(const osmium::Way &way, ExtractionWay &result, WayData &data) const
+    {
+        const auto values = getForwardBackwardBySet(way, maxheight_keys);
+        const auto forward = measure::getMaxHeight(values.forward, way, data.location_tags);
+        const auto backward = measure::getMaxHeight(values.backward, way, data.location_tags);
+
+        if (forward && *forward < VEHICLE_HEIGHT)
+            result.forward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+        if (backward && *backward < VEHICLE_HEIGHT)
+            result.backward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+
+        return true;
+    }
+
+    bool HandleWidth(const osmium::Way &way, ExtractionWay &result, WayData &) const
+    {
+        const auto values = getForwardBackwardBySet(way, maxwidth_keys);
+        const auto narrow = getValue(way, "narrow");
+
+        const auto handle = [narrow](const char *value, TravelMode &mode) {
+            if ((equals(value, "narrow") || equals(narrow, "yes")) && VEHICLE_WIDTH > 2.2)
+            {
+                mode = TRAVEL_MODE_INACCESSIBLE;
+            }
+            else if (value)
+            {
+                const auto width = measure::getMaxWidth(value);
+                if (width && *width <= VEHICLE_WIDTH)
+                    mode = TRAVEL_MODE_INACCESSIBLE;
+            }
+        };
+
+        // travel modes are bit fields, they can not be bound to references
+        auto forward_mode = result.forward_travel_mode;
+        auto backward_mode = result.backward_travel_mode;
+        handle(values.forward, forward_mode);
+        handle(values.backward, backward_mode);
+        result.forward_travel_mode = forward_mode;
+        result.backward_travel_mode = backward_mode;
+
+        return true;
+    }
+
+    bool HandleLength(const osmium::Way &way, ExtractionWay &result, WayData &) const
+    {
+        const auto values = getForwardBackwardBySet(way, maxlength_keys);
+        const auto forward = measure::getMaxLength(values.forward);
+        const auto backward = measure::getMaxLength(values.backward);
+
+        if (forward && *forward < VEHICLE_LENGTH)
+            result.forward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+        if (backward && *backward < VEHICLE_LENGTH)
+            result.backward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+
+        return true;
+    }
+
+    bool HandleWeight(const osmium::Way &way, ExtractionWay &result, WayData &) const
+    {
+        const auto values = getForwardBackwardBySet(way, maxweight_keys);
+        const auto forward = measure::getMaxWeight(values.forward);
+        const auto backward = measure::getMaxWeight(values.backward);
+
+        if (forward && *forward < VEHICLE_WEIGHT)
+            result.forward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+        if (backward && *backward < VEHICLE_WEIGHT)
+            result.backward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+
+        return true;
+    }
+
+    // check accessibility by traversing our access tag hierarchy
+    bool Access(const osmium::Way &way, ExtractionWay &result, WayData &data) const
+    {
+        const auto access = getForwardBackwardBySet(way, access_tags_hierarchy);
+        data.forward_access = access.forward;
+        data.backward_access = access.backward;
+
+        // only allow a subset of roads to be treated as restricted
+        if (restricted_highway_whitelist.Contains(data.highway))
+        {
+            if (restricted_access_tag_list.Contains(data.forward_access))
+                result.forward_restricted = true;
+            if (restricted_access_tag_list.Contains(data.backward_access))
+                result.backward_restricted = true;
+        }
+
+        // blacklist access tags that aren't marked as restricted
+        if (access_tag_blacklist.Contains(data.forward_access) && !result.forward_restricted)
+            result.forward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+        if (access_tag_blacklist.Contains(data.backward_access) && !result.backward_restricted)
+            result.backward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+
+        return result.forward_travel_mode != TRAVEL_MODE_INACCESSIBLE ||
+               result.backward_travel_mode != TRAVEL_MODE_INACCESSIBLE;
+    }
+
+    bool Oneway(const osmium::Way &way, ExtractionWay &result, WayData &data) const
+    {
+        auto oneway = getValueByPrefixedSequence(way, oneway_keys);
+        if (!oneway)
+            oneway = getValue(way, "oneway");
+
+        data.oneway = oneway;
+
+        if (equals(oneway, "-1"))
+        {
+            data.is_reverse_oneway = true;
+            result.forward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+        }
+        else if (equals(oneway, "yes") || equals(oneway, "1") || equals(oneway, "true"))
+        {
+            data.is_forward_oneway = true;
+            result.backward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+        }
+        else
+        {
+            const auto junction = getValue(way, "junction");
+            if (equals(data.highway, "motorway") || equals(junction, "roundabout") ||
+                equals(junction, "circular"))
+            {
+                if (!equals(oneway, "no"))
+                {
+                    // implied oneway
+                    data.is_forward_oneway = true;
+                    result.backward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    // handle destination tags
+    bool Destinations(const osmium::Way &way, ExtractionWay &result, WayData &data) const
+    {
+        if (data.is_forward_oneway || data.is_reverse_oneway)
+        {
+            const auto destination = getDestination(way, data.is_forward_oneway);
+            result.SetDestinations(canonicalizeStringList(destination, ",").c_str());
+        }
+        return true;
+    }
+
+    // handling ferries and piers
+    bool Ferries(const osmium::Way &way, ExtractionWay &result, WayData &data) const
+    {
+        const auto route_speed = route_speeds.Find(data.route);
+        if (route_speed && *route_speed > 0)
+        {
+            const auto duration = getValue(way, "duration");
+            if (duration && durationIsValid(duration))
+            {
+                result.duration = std::max<double>(parseDuration(duration), 1);
+            }
+            result.forward_travel_mode = TRAVEL_MODE_FERRY;
+            result.backward_travel_mode = TRAVEL_MODE_FERRY;
+            result.forward_speed = *route_speed;
+            result.backward_speed = *route_speed;
+        }
+        return true;
+    }
+
+    // handling movable bridges
+    bool Movables(const osmium::Way &way, ExtractionWay &result, WayData &data) const
+    {
+        const auto bridge_speed = bridge_speeds.Find(data.bridge);
+        // the capacity:car check of the Lua handler compares a string with a number, it never
+        // excludes a bridge
+        if (bridge_speed && *bridge_speed > 0)
+        {
+            result.forward_travel_mode = TRAVEL_MODE_DRIVING;
+            result.backward_travel_mode = TRAVEL_MODE_DRIVING;
+            const auto duration = getValue(way, "duration");
+            if (duration && durationIsValid(duration))
+            {
+                result.duration = std::max<double>(parseDuration(duration), 1);
+            }
+            else
+            {
+                result.forward_speed = *bridge_speed;
+                result.backward_speed = *bridge_speed;
+            }
+        }
+        return true;
+    }
+
+    // service roads
+    bool Service(const osmium::Way &way, ExtractionWay &result, WayData &) const
+    {
+        if (service_tag_forbidden.Contains(getValue(way, "service")))
+        {
+            result.forward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+            result.backward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+            return false;
+        }
+        return true;
+    }
+
+    // all lanes restricted to hov vehicles?
+    static bool hasAllDesignatedHovLanes(const char *lanes)
+    {
+        if (!lanes)
+            return false;
+
+        for (const char *lane = lanes;; ++lane)
+        {
+            const auto end = std::strchr(lane, '|');
+            const auto length = end ? static_cast<std::size_t>(end - lane) : std::strlen(lane);
+            if (length != std::strlen("designated") || std::strncmp(lane, "designated", length))
+                return false;
+            if (!end)
+                return true;
+            lane = end;
+        }
+    }
+
+    // handle high occupancy vehicle tags
+    bool Hov(const osmium::Way &way, ExtractionWay &result, WayData &data) const
+    {
+        if (equals(getValue(way, "hov"), "designated"))
+        {
+            result.forward_restricted = true;
+            result.backward_restricted = true;
+        }
+
+        const auto hov_lanes = getForwardBackwardByKey(way, data, hov_lanes_key);
+
+        // with the routability weight turn penalties are used instead of filtering out
+        if (hasAllDesignatedHovLanes(hov_lanes.forward))
+            result.forward_restricted = true;
+        if (hasAllDesignatedHovLanes(hov_lanes.backward))
+            result.backward_restricted = true;
+
+        return true;
+    }
+
+    // handle speed (excluding maxspeed)
+    bool Speed(const osmium::Way &, ExtractionWay &result, WayData &data) const
+    {
+        if (result.forward_speed != -1)
+        {
+            // abort if already set, eg. by a route
+            return true;
+        }
+
+        const auto speed = highway_speeds.Find(data.highway);
+        if (speed)
+        {
+            // set speed by way type
+            result.forward_speed = *speed;
+            result.backward_speed = *speed;
+        }
+        else
+        {
+            // Set the avg speed on ways that are marked accessible
+            if (access_tag_whitelist.Contains(data.forward_access))
+                result.forward_speed = DEFAULT_SPEED;
+            else if (data.forward_access && !access_tag_blacklist.Contains(data.forward_access))
+                result.forward_speed = DEFAULT_SPEED;
+            else if (!data.forward_access && data.backward_access)
+                result.forward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+
+            if (access_tag_whitelist.Contains(data.backward_access))
+                result.backward_speed = DEFAULT_SPEED;
+            else if (data.backward_access && !access_tag_blacklist.Contains(data.backward_access))
+                result.backward_speed = DEFAULT_SPEED;
+            else if (!data.backward_access && data.forward_access)
+                result.backward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+        }
+
+        return !(result.forward_speed == -1 && result.backward_speed == -1 &&
+                 result.duration <= 0);
+    }
+
+    // reduce speed on bad surfaces
+    bool Surface(const osmium::Way &way, ExtractionWay &result, WayData &) const
+    {
+        const auto limit = [&result](const double *speed) {
+            if (speed)
+            {
+                result.forward_speed = std::min(*speed, result.forward_speed);
+                result.backward_speed = std::min(*speed, result.backward_speed);
+            }
+        };
+        limit(surface_speeds.Find(getValue(way, "surface")));
+        limit(tracktype_speeds.Find(getValue(way, "tracktype")));
+        limit(smoothness_speeds.Find(getValue(way, "smoothness")));
+        return true;
+    }
+
+    double ParseMaxspeed(const char *source) const
+    {
+        if (!source)
+            return 0;
+
+        const auto n = measure::getMaxSpeed(source);
+        if (n)
+            return *n;
+
+        // parse maxspeed like FR:urban
+        std::string lower = source;
+        std::transform(lower.begin(), lower.end(), lower.begin(), [](const unsigned char c) {
+            return std::tolower(c);
+        });
+        const auto speed = maxspeed_table.Find(lower.c_str());
+        if (speed)
+            return *speed;
+
+        // string.match(source, "%a%a:(%a+)")
+        const auto is_alpha = [](const char c) {
+            return std::isalpha(static_cast<unsigned char>(c)) != 0;
+        };
+        for (std::size_t index = 0; index + 2 < lower.size(); ++index)
+        {
+            if (is_alpha(lower[index]) && is_alpha(lower[index + 1]) && lower[index + 2] == ':' &&
+                index + 3 < lower.size() && is_alpha(lower[index + 3]))
+            {
+                auto end = index + 3;
+                while (end < lower.size() && is_alpha(lower[end]))
+                    ++end;
+                const auto highway_type = lower.substr(index + 3, end - index - 3);
+                const auto default_speed = maxspeed_table_default.Find(highway_type.c_str());
+                return default_speed ? *default_speed : 0;
+            }
+        }
+        return 0;
+    }
+
+    // maxspeed and advisory maxspeed
+    bool Maxspeed(const osmium::Way &way, ExtractionWay &result, WayData &) const
+    {
+        const auto values = getForwardBackwardBySet(way, maxspeed_keys);
+        const auto forward = ParseMaxspeed(values.forward);
+        const auto backward = ParseMaxspeed(values.backward);
+
+        if (forward > 0)
+            result.forward_speed = forward * SPEED_REDUCTION;
+        if (backward > 0)
+            result.backward_speed = backward * SPEED_REDUCTION;
+
+        return true;
+    }
+
+    // scale speeds to get better average driving times
+    bool Penalties(const osmium::Way &way, ExtractionWay &result, WayData &data) const
+    {
+        auto service_penalty = 1.0;
+        const auto service = service_penalties.Find(getValue(way, "service"));
+        if (service)
+            service_penalty = *service;
+
+        auto width_penalty = 1.0;
+        const auto unlimited = std::numeric_limits<double>::infinity();
+        const auto width = toLeadingNumber(getValue(way, "width")).value_or(unlimited);
+        const auto lanes = toLeadingNumber(getValue(way, "lanes")).value_or(unlimited);
+
+        const auto is_bidirectional = result.forward_travel_mode != TRAVEL_MODE_INACCESSIBLE &&
+                                      result.backward_travel_mode != TRAVEL_MODE_INACCESSIBLE;
+
+        if (width <= 3 || (lanes <= 1 && is_bidirectional))
+            width_penalty = 0.5;
+
+        // Handle high frequency reversible oneways (think traffic signal controlled, changing
+        // direction every 15 minutes). Scaling speed to take average waiting time into account
+        // plus some more for start / stop.
+        auto alternating_penalty = 1.0;
+        if (equals(data.oneway, "alternating"))
+            alternating_penalty = 0.4;
+
+        auto sideroad_penalty = 1.0;
+        const auto sideroad = getValue(way, "side_road");
+        if (equals(sideroad, "yes") || equals(sideroad, "rotary"))
+            sideroad_penalty = SIDE_ROAD_MULTIPLIER;
+
+        const auto forward_penalty =
+            std::min({service_penalty, width_penalty, alternating_penalty, sideroad_penalty});
+        const auto backward_penalty =
+            std::min({service_penalty, width_penalty, alternating_penalty, sideroad_penalty});
+
+        if (result.forward_speed > 0)
+            result.forward_rate = (result.forward_speed * forward_penalty) / 3.6;
+        if (result.backward_speed > 0)
+            result.backward_rate = (result.backward_speed * backward_penalty) / 3.6;
+        if (result.duration > 0)
+            result.weight = result.duration / forward_penalty;
+
+        return true;
+    }
+
+    // add class information
+    bool Classes(const osmium::Way &way, ExtractionWay &result, WayData &data) const
+    {
+        const auto toll = getForwardBackwardByKey(way, data, toll_key);
+        const auto route = getForwardBackwardByKey(way, data, route_key);
+        const auto tunnel = getValue(way, "tunnel");
+
+        if (tunnel && !equals(tunnel, "no"))
+        {
+            result.forward_classes["tunnel"] = true;
+            result.backward_classes["tunnel"] = true;
+        }
+
+        if (equals(toll.forward, "yes"))
+            result.forward_classes["toll"] = true;
+        if (equals(toll.backward, "yes"))
+            result.backward_classes["toll"] = true;
+
+        if (equals(route.forward, "ferry"))
+            result.forward_classes["ferry"] = true;
+        if (equals(route.backward, "ferry"))
+            result.backward_classes["ferry"] = true;
+
+        if (result.forward_restricted)
+            result.forward_classes["restricted"] = true;
+        if (result.backward_restricted)
+            result.backward_classes["restricted"] = true;
+
+        if (equals(data.highway, "motorway") || equals(data.highway, "motorway_link"))
+        {
+            result.forward_classes["motorway"] = true;
+            result.backward_classes["motorway"] = true;
+        }
+
+        return true;
+    }
+
+    // handle turn lanes
+    bool TurnLanes(const osmium::Way &way, ExtractionWay &result, WayData &data) const
+    {
+        setTurnLanes(way, data, result);
+        return true;
+    }
+
+    // set the road classification based on guidance globals configuration
+    bool Classification(const osmium::Way &way, ExtractionWay &result, WayData &data) const
+    {
+        setClassification(data.highway, result, way);
+        return true;
+    }
+
+    bool Roundabouts(const osmium::Way &way, ExtractionWay &result, WayData &) const
+    {
+        const auto junction = getValue(way, "junction");
+        if (equals(junction, "roundabout"))
+            result.roundabout = true;
+        // See Issue 3361: roundabout-shaped not following roundabout rules.
+        if (equals(junction, "circular"))
+            result.circular = true;
+        return true;
+    }
+
+    // determine if this way can be used as a start/end point for routing
+    bool Startpoint(const osmium::Way &, ExtractionWay &result, WayData &data) const
+    {
+        result.is_startpoint = result.forward_travel_mode == TRAVEL_MODE_DRIVING ||
+                               result.backward_travel_mode == TRAVEL_MODE_DRIVING;
+        // highway=service and access tags check
+        if (equals(data.highway, "service") &&
+            service_access_tag_blacklist.Contains(data.forward_access))
+        {
+            result.is_startpoint = false;
+        }
+        return true;
+    }
+
+    bool DrivingSide(const osmium::Way &way, ExtractionWay &result, WayData &data) const
+    {
+        // 'right' and unknown values keep the default of the profile, right hand driving
+        const auto driving_side = getValue(way, "driving_side");
+        if (driving_side)
+        {
+            result.is_left_hand_driving = equals(driving_side, "left");
+        }
+        else
+        {
+            const auto location_side = data.location_tags.Get(way, "driving_side");
+            const auto side = boost::get<std::string>(&location_side);
+            result.is_left_hand_driving = side && *side == "left";
+        }
+        return true;
+    }
+
+    // handles name, including ref and pronunciation
+    bool Names(const osmium::Way &way, ExtractionWay &result, WayData &) const
+    {
+        const auto name = getValue(way, "name");
+        const auto pronunciation = getValue(way, "name:pronunciation");
+        const auto ref = getValue(way, "ref");
+        const auto exits = getValue(way, "junction:ref");
+
+        if (name)
+        {
+            result.SetName(name);
+        }
+        if (ref)
+        {
+            const auto canonical_ref = canonicalizeStringList(ref, ";");
+            result.SetForwardRef(canonical_ref.c_str());
+            result.SetBackwardRef(canonical_ref.c_str());
+        }
+        if (pronunciation)
+        {
+            result.SetPronunciation(pronunciation);
+        }
+        if (exits)
+        {
+            result.SetExits(canonicalizeStringList(exits, ";").c_str());
+        }
+        return true;
+    }
+
+    const TagValueSet barrier_whitelist{"cattle_grid",
+                                        "border_control",
+                                        "toll_booth",
+                                        "sally_port",
+                                        "gate",
+                                        "lift_gate",
+                                        "no",
+                                        "entrance",
+                                        "height_restrictor",
+                                        "arch"};
+
+    const TagValueSet access_tag_whitelist{
+        "yes", "motorcar", "motor_vehicle", "vehicle", "permissive", "designated", "hov"};
+
+    const TagValueSet access_tag_blacklist{"no",
+                                           "agricultural",
+                                           "forestry",
+                                           "emergency",
+                                           "psv",
+                                           "customers",
+                                           "private",
+                                           "delivery",
+                                           "destination"};
+
+    // tags disallow access to in combination with highway=service
+    const TagValueSet service_access_tag_blacklist{"private"};
+
+    const TagValueSet restricted_access_tag_list{"private", "delivery", "destination", "customers"};
+
+    const DirectionalKeys access_tags_hierarchy{"motorcar", "motor_vehicle", "vehicle", "access"};
+
+    const TagValueSet service_tag_forbidden{"emergency_access"};
+
+    // oneway:<restriction> for all restrictions
+    const std::vector<std::string> oneway_keys{
+        "oneway:motorcar", "oneway:motor_vehicle", "oneway:vehicle"};
+
+    const TagValueSet avoid{"area",
+                            "reversible",
+                            "impassable",
+                            "hov_lanes",
+                            "steps",
+                            "construction",
+                            "proposed"};
+
+    const TagValueMap<double> highway_speeds{{"motorway", 90},
+                                             {"motorway_link", 45},
+                                             {"trunk", 85},
+                                             {"trunk_link", 40},
+                                             {"primary", 65},
+                                             {"primary_link", 30},
+                                             {"secondary", 55},
+                                             {"secondary_link", 25},
+                                             {"tertiary", 40},
+                                             {"tertiary_link", 20},
+                                             {"unclassified", 25},
+                                             {"residential", 25},
+                                             {"living_street", 10},
+                                             {"service", 15}};
+
+    const TagValueMap<double> service_penalties{{"alley", 0.5},
+                                                {"parking", 0.5},
+                                                {"parking_aisle", 0.5},
+                                                {"driveway", 0.5},
+                                                {"drive-through", 0.5},
+                                                {"drive-thru", 0.5}};
+
+    const TagValueSet restricted_highway_whitelist{"motorway",
+                                                   "motorway_link",
+                                                   "trunk",
+                                                   "trunk_link",
+                                                   "primary",
+                                                   "primary_link",
+                                                   "secondary",
+                                                   "secondary_link",
+                                                   "tertiary",
+                                                   "tertiary_link",
+                                                   "residential",
+                                                   "living_street",
+                                                   "unclassified",
+                                                   "service"};
+
+    const TagValueSet construction_whitelist{"no", "widening", "minor"};
+
+    const TagValueMap<double> route_speeds{{"ferry", 5}, {"shuttle_train", 10}};
+
+    const TagValueMap<double> bridge_speeds{{"movable", 5}};
+
+    // max speed for surfaces, surfaces that are not listed do not limit the speed
+    const TagValueMap<double> surface_speeds{{"cement", 80},
+                                             {"compacted", 80},
+                                             {"fine_gravel", 80},
+                                             {"paving_stones", 60},
+                                             {"metal", 60},
+                                             {"bricks", 60},
+                                             {"grass", 40},
+                                             {"wood", 40},
+                                             {"sett", 40},
+                                             {"grass_paver", 40},
+                                             {"gravel", 40},
+                                             {"unpaved", 40},
+                                             {"ground", 40},
+                                             {"dirt", 40},
+                                             {"pebblestone", 40},
+                                             {"tartan", 40},
+                                             {"cobblestone", 30},
+                                             {"clay", 30},
+                                             {"earth", 20},
+                                             {"stone", 20},
+                                             {"rocky", 20},
+                                             {"sand", 20},
+                                             {"mud", 10}};
+
+    // max speed for tracktypes
+    const TagValueMap<double> tracktype_speeds{
+        {"grade1", 60}, {"grade2", 40}, {"grade3", 30}, {"grade4", 25}, {"grade5", 20}};
+
+    // max speed for smoothnesses
+    const TagValueMap<double> smoothness_speeds{{"intermediate", 80},
+                                                {"bad", 40},
+                                                {"very_bad", 20},
+                                                {"horrible", 10},
+                                                {"very_horrible", 5},
+                                                {"impassable", 0}};
+
+    // http://wiki.openstreetmap.org/wiki/Speed_limits
+    const TagValueMap<double> maxspeed_table_default{
+        {"urban", 50}, {"rural", 90}, {"trunk", 110}, {"motorway", 130}};
+
+    // List only exceptions
+    const TagValueMap<double> maxspeed_table{{"at:rural", 100},
+                                             {"at:trunk", 100},
+                                             {"be:motorway", 120},
+                                             {"be-vlg:rural", 70},
+                                             {"by:urban", 60},
+                                             {"by:motorway", 110},
+                                             {"ch:rural", 80},
+                                             {"ch:trunk", 100},
+                                             {"ch:motorway", 120},
+                                             {"cz:trunk", 0},
+                                             {"cz:motorway", 0},
+                                             {"de:living_street", 7},
+                                             {"de:rural", 100},
+                                             {"de:motorway", 0},
+                                             {"dk:rural", 80},
+                                             {"fr:rural", 80},
+                                             {"gb:nsl_single", (60 * 1609) / 1000.},
+                                             {"gb:nsl_dual", (70 * 1609) / 1000.},
+                                             {"gb:motorway", (70 * 1609) / 1000.},
+                                             {"nl:rural", 80},
+                                             {"nl:trunk", 100},
+                                             {"no:rural", 80},
+                                             {"no:motorway", 110},
+                                             {"pl:rural", 100},
+                                             {"pl:trunk", 120},
+                                             {"pl:motorway", 140},
+                                             {"ro:trunk", 100},
+                                             {"ru:living_street", 20},
+                                             {"ru:urban", 60},
+                                             {"ru:motorway", 110},
+                                             {"uk:nsl_single", (60 * 1609) / 1000.},
+                                             {"uk:nsl_dual", (70 * 1609) / 1000.},
+                                             {"uk:motorway", (70 * 1609) / 1000.},
+                                             {"za:urban", 60},
+                                             {"za:rural", 100},
+                                             {"none", 140}};
+
+    const DirectionalKeys maxspeed_keys{
+        "maxspeed:advisory", "maxspeed", "source:maxspeed", "maxspeed:type"};
+    const DirectionalKeys maxheight_keys{"maxheight:physical", "maxheight"};
+    const DirectionalKeys maxwidth_keys{"maxwidth:physical", "maxwidth", "width", "est_width"};
+    const DirectionalKeys maxweight_keys{"maxweight"};
+    const DirectionalKeys maxlength_keys{"maxlength"};
+
+    const DirectionalKey hov_lanes_key{"hov:lanes"};
+    const DirectionalKey toll_key{"toll"};
+    const DirectionalKey route_key{"route"};
+};
+}
+
+OSRM_NATIVE_PROFILE(CarProfile)
@@ -0,0 +1,415 @@
+// Native port of profiles/foot.lua and the parts of profiles/lib it uses
+//
+// Build as a shared object against the OSRM headers and pass it to osrm-extract:
+//   osrm-extract --profile foot.so map.osm.pbf
+//
+// The port follows the Lua code step by step, so both profiles extract the same data.
+
+#include "extractor/extraction_helper_functions.hpp"
+#include "extractor/native_profile.hpp"
+#include "extractor/travel_mode.hpp"
+
+#include "profile_helpers.hpp"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using namespace osrm::extractor;
+using namespace osrm::profiles;
+
+const constexpr double WALKING_SPEED = 5;
+const constexpr double U_TURN_PENALTY = 2;
+const constexpr double TRAFFIC_LIGHT_PENALTY = 2;
+
+// Intermediate values of the way handlers, the `data` table of the Lua profile
+struct WayData
+{
+    const char *highway = nullptr;
+    const char *bridge = nullptr;
+    const char *route = nullptr;
+    const char *forward_access = nullptr;
+    const char *backward_access = nullptr;
+    const char *oneway = nullptr;
+    bool is_forward_oneway = false;
+    bool is_reverse_oneway = false;
+};
+
+class FootProfile final : public NativeProfile
+{
+  public:
+    ProfileProperties GetProfileProperties() const override
+    {
+        ProfileProperties properties;
+        properties.SetWeightName("duration");
+        properties.SetMaxSpeedForMapMatching(40 / 3.6);
+        properties.SetUturnPenalty(U_TURN_PENALTY);
+        properties.continue_straight_at_waypoint = false;
+        properties.use_turn_restrictions = false;
+        // foot.lua sets `call_tagless_node_function` and `traffic_light_penalty`, which are not
+        // read from the properties of a Lua profile, so the defaults of these are kept
+        return properties;
+    }
+
+    std::vector<std::vector<std::string>> GetExcludableClasses() const override { return {}; }
+
+    std::vector<std::string> GetClassNames() const override { return {}; }
+
+    // foot.lua lists its suffixes in a `Set`, the Lua scripting environment reads the values of
+    // that table, which are no names, so the profile has no suffixes
+    std::vector<std::string> GetNameSuffixList() const override { return {}; }
+
+    std::vector<std::string> GetRestrictions() const override { return {"foot"}; }
+
+    std::vector<std::string> GetRelations() const override { return {}; }
+
+    void ProcessNode(const osmium::Node &node,
+                     ExtractionNode &result,
+                     const ExtractionRelationContainer &,
+                     const LocationTags &) const override
+    {
+        // parse access and barrier tags
+        const auto access = findAccessTag(node, access_tags_hierarchy);
+        if (access)
+        {
+            if (access_tag_blacklist.Contains(access))
+            {
+                result.barrier = true;
+            }
+        }
+        else
+        {
+            const auto barrier = getValue(node, "barrier");
+            if (barrier)
+            {
+                // make an exception for rising bollard barriers
+                const auto rising_bollard = equals(getValue(node, "bollard"), "rising");
+
+                if (barrier_blacklist.Contains(barrier) && !rising_bollard)
+                {
+                    result.barrier = true;
+                }
+            }
+        }
+
+        // check if node is a traffic light
+        if (equals(getValue(node, "highway"), "traffic_signals"))
+        {
+            result.traffic_lights = true;
+        }
+    }
+
+    void ProcessWay(const osmium::Way &way,
+                    ExtractionWay &result,
+                    const ExtractionRelationContainer &,
+                    const LocationTags &) const override
+    {
+        WayData data;
+        data.highway = getValue(way, "highway");
+        data.bridge = getValue(way, "bridge");
+        data.route = getValue(way, "route");
+
+        // perform an quick initial check and abort if the way is obviously not routable, at
+        // least one of the prefetched tags has to be present
+        static const char *const prefetched_keys[] = {
+            "leisure", "man_made", "railway", "platform", "amenity", "public_transport"};
+        if (!data.highway && !data.bridge && !data.route &&
+            std::none_of(std::begin(prefetched_keys),
+                         std::end(prefetched_keys),
+                         [&way](const char *key) { return getValue(way, key) != nullptr; }))
+        {
+            return;
+        }
+
+        // Same order as the handlers in foot.lua, a handler returns false to abort
+        using Handler = bool (FootProfile::*)(const osmium::Way &, ExtractionWay &, WayData &)
+            const;
+        static const Handler handlers[] = {&FootProfile::DefaultMode,
+                                           &FootProfile::BlockedWays,
+                                           &FootProfile::Access,
+                                           &FootProfile::Oneway,
+                                           &FootProfile::Destinations,
+                                           &FootProfile::Ferries,
+                                           &FootProfile::Speed,
+                                           &FootProfile::Surface,
+                                           &FootProfile::Classification,
+                                           &FootProfile::Roundabouts,
+                                           &FootProfile::Startpoint,
+                                           &FootProfile::Names};
+        // WayHandlers.movables and WayHandlers.weights are not ported, the profile has no bridge
+        // speeds and they do nothing for the duration weight
+
+        for (const auto handler : handlers)
+        {
+            if (!(this->*handler)(way, result, data))
+            {
+                return;
+            }
+        }
+    }
+
+    void ProcessTurn(ExtractionTurn &turn) const override
+    {
+        turn.duration = 0.;
+
+        if (turn.is_u_turn)
+        {
+            turn.duration = turn.duration + U_TURN_PENALTY;
+        }
+
+        if (turn.has_traffic_light)
+        {
+            turn.duration = TRAFFIC_LIGHT_PENALTY;
+        }
+    }
+
+  private:
+    // lib/way_handlers.lua
+
+    bool DefaultMode(const osmium::Way &, ExtractionWay &result, WayData &) const
+    {
+        result.forward_travel_mode = TRAVEL_MODE_WALKING;
+        result.backward_travel_mode = TRAVEL_MODE_WALKING;
+        return true;
+    }
+
+    // impassables are the only blocked ways the profile avoids
+    bool BlockedWays(const osmium::Way &way, ExtractionWay &, WayData &) const
+    {
+        if (equals(getValue(way, "impassable"), "yes"))
+            return false;
+        if (equals(getValue(way, "status"), "impassable"))
+            return false;
+
+        return true;
+    }
+
+    // check accessibility by traversing our access tag hierarchy, no roads are restricted
+    bool Access(const osmium::Way &way, ExtractionWay &result, WayData &data) const
+    {
+        const auto access = getForwardBackwardBySet(way, access_tags_hierarchy);
+        data.forward_access = access.forward;
+        data.backward_access = access.backward;
+
+        if (access_tag_blacklist.Contains(data.forward_access))
+            result.forward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+        if (access_tag_blacklist.Contains(data.backward_access))
+            result.backward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+
+        return result.forward_travel_mode != TRAVEL_MODE_INACCESSIBLE ||
+               result.backward_travel_mode != TRAVEL_MODE_INACCESSIBLE;
+    }
+
+    // respect 'oneway:foot' but not 'oneway'
+    bool Oneway(const osmium::Way &way, ExtractionWay &result, WayData &data) const
+    {
+        const auto oneway = getValueByPrefixedSequence(way, oneway_keys);
+        data.oneway = oneway;
+
+        if (equals(oneway, "-1"))
+        {
+            data.is_reverse_oneway = true;
+            result.forward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+        }
+        else if (equals(oneway, "yes") || equals(oneway, "1") || equals(oneway, "true"))
+        {
+            data.is_forward_oneway = true;
+            result.backward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+        }
+
+        return true;
+    }
+
+    // handle destination tags
+    bool Destinations(const osmium::Way &way, ExtractionWay &result, WayData &data) const
+    {
+        if (data.is_forward_oneway || data.is_reverse_oneway)
+        {
+            const auto destination = getDestination(way, data.is_forward_oneway);
+            result.SetDestinations(canonicalizeStringList(destination, ",").c_str());
+        }
+        return true;
+    }
+
+    // handling ferries and piers
+    bool Ferries(const osmium::Way &way, ExtractionWay &result, WayData &data) const
+    {
+        const auto route_speed = route_speeds.Find(data.route);
+        if (route_speed && *route_speed > 0)
+        {
+            const auto duration = getValue(way, "duration");
+            if (duration && durationIsValid(duration))
+            {
+                result.duration = std::max<double>(parseDuration(duration), 1);
+            }
+            result.forward_travel_mode = TRAVEL_MODE_FERRY;
+            result.backward_travel_mode = TRAVEL_MODE_FERRY;
+            result.forward_speed = *route_speed;
+            result.backward_speed = *route_speed;
+        }
+        return true;
+    }
+
+    // handle speed (excluding maxspeed)
+    bool Speed(const osmium::Way &way, ExtractionWay &result, WayData &data) const
+    {
+        if (result.forward_speed != -1)
+        {
+            // abort if already set, eg. by a route
+            return true;
+        }
+
+        // Tags.get_constant_by_key_value visits the keys in table order, which does not matter
+        // here as all speeds are the same
+        const auto has_speed = std::any_of(
+            speeds.begin(), speeds.end(), [&way](const std::pair<const char *, TagValueSet> &key) {
+                return key.second.Contains(getValue(way, key.first));
+            });
+
+        if (has_speed)
+        {
+            // set speed by way type
+            result.forward_speed = WALKING_SPEED;
+            result.backward_speed = WALKING_SPEED;
+        }
+        else
+        {
+            // Set the avg speed on ways that are marked accessible
+            if (access_tag_whitelist.Contains(data.forward_access))
+                result.forward_speed = WALKING_SPEED;
+            else if (data.forward_access && !access_tag_blacklist.Contains(data.forward_access))
+                result.forward_speed = WALKING_SPEED;
+            else if (!data.forward_access && data.backward_access)
+                result.forward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+
+            if (access_tag_whitelist.Contains(data.backward_access))
+                result.backward_speed = WALKING_SPEED;
+            else if (data.backward_access && !access_tag_blacklist.Contains(data.backward_access))
+                result.backward_speed = WALKING_SPEED;
+            else if (!data.backward_access && data.forward_access)
+                result.backward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+        }
+
+        return !(result.forward_speed == -1 && result.backward_speed == -1 &&
+                 result.duration <= 0);
+    }
+
+    // reduce speed on bad surfaces
+    bool Surface(const osmium::Way &way, ExtractionWay &result, WayData &) const
+    {
+        const auto speed = surface_speeds.Find(getValue(way, "surface"));
+        if (speed)
+        {
+            result.forward_speed = std::min(*speed, result.forward_speed);
+            result.backward_speed = std::min(*speed, result.backward_speed);
+        }
+        return true;
+    }
+
+    // set the road classification based on guidance globals configuration
+    bool Classification(const osmium::Way &way, ExtractionWay &result, WayData &data) const
+    {
+        setClassification(data.highway, result, way);
+        return true;
+    }
+
+    bool Roundabouts(const osmium::Way &way, ExtractionWay &result, WayData &) const
+    {
+        const auto junction = getValue(way, "junction");
+        if (equals(junction, "roundabout"))
+            result.roundabout = true;
+        // See Issue 3361: roundabout-shaped not following roundabout rules.
+        if (equals(junction, "circular"))
+            result.circular = true;
+        return true;
+    }
+
+    // determine if this way can be used as a start/end point for routing
+    bool Startpoint(const osmium::Way &, ExtractionWay &result, WayData &) const
+    {
+        result.is_startpoint = result.forward_travel_mode == TRAVEL_MODE_WALKING ||
+                               result.backward_travel_mode == TRAVEL_MODE_WALKING;
+        return true;
+    }
+
+    // handles name, including ref and pronunciation
+    bool Names(const osmium::Way &way, ExtractionWay &result, WayData &) const
+    {
+        const auto name = getValue(way, "name");
+        const auto pronunciation = getValue(way, "name:pronunciation");
+        const auto ref = getValue(way, "ref");
+        const auto exits = getValue(way, "junction:ref");
+
+        if (name)
+        {
+            result.SetName(name);
+        }
+        if (ref)
+        {
+            const auto canonical_ref = canonicalizeStringList(ref, ";");
+            result.SetForwardRef(canonical_ref.c_str());
+            result.SetBackwardRef(canonical_ref.c_str());
+        }
+        if (pronunciation)
+        {
+            result.SetPronunciation(pronunciation);
+        }
+        if (exits)
+        {
+            result.SetExits(canonicalizeStringList(exits, ";").c_str());
+        }
+        return true;
+    }
+
+    const TagValueSet barrier_blacklist{"yes", "wall", "fence"};
+
+    const TagValueSet access_tag_whitelist{"yes", "foot", "permissive", "designated"};
+
+    const TagValueSet access_tag_blacklist{
+        "no", "agricultural", "forestry", "private", "delivery"};
+
+    const DirectionalKeys access_tags_hierarchy{"foot", "access"};
+
+    // oneway:<restriction> for all restrictions
+    const std::vector<std::string> oneway_keys{"oneway:foot"};
+
+    // ways with one of these tags get the walking speed
+    const std::vector<std::pair<const char *, TagValueSet>> speeds{
+        {"highway",
+         {"primary",
+          "primary_link",
+          "secondary",
+          "secondary_link",
+          "tertiary",
+          "tertiary_link",
+          "unclassified",
+          "residential",
+          "road",
+          "living_street",
+          "service",
+          "track",
+          "path",
+          "steps",
+          "pedestrian",
+          "footway",
+          "pier"}},
+        {"railway", {"platform"}},
+        {"amenity", {"parking", "parking_entrance"}},
+        {"man_made", {"pier"}},
+        {"leisure", {"track"}}};
+
+    const TagValueMap<double> route_speeds{{"ferry", 5}};
+
+    // max speed for surfaces, surfaces that are not listed do not limit the speed
+    const TagValueMap<double> surface_speeds{{"fine_gravel", WALKING_SPEED * 0.75},
+                                             {"gravel", WALKING_SPEED * 0.75},
+                                             {"pebblestone", WALKING_SPEED * 0.75},
+                                             {"mud", WALKING_SPEED * 0.5},
+                                             {"sand", WALKING_SPEED * 0.5}};
+};
+}
+
+OSRM_NATIVE_PROFILE(FootProfile)
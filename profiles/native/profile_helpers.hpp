@@ -0,0 +1,568 @@
+// Helpers for native profiles that behave like the Lua functions the Lua profiles use, so
+// native ports of profiles produce the same results as the originals.
+
+#ifndef OSRM_PROFILES_NATIVE_PROFILE_HELPERS_HPP
+#define OSRM_PROFILES_NATIVE_PROFILE_HELPERS_HPP
+
+#include "extractor/extraction_helper_functions.hpp"
+#include "extractor/extraction_way.hpp"
+#include "extractor/location_dependent_data.hpp"
+#include "extractor/native_profile.hpp"
+#include "extractor/road_classification.hpp"
+
+#include <osmium/osm.hpp>
+
+#include <boost/algorithm/string/replace.hpp>
+#include <boost/optional.hpp>
+#include <boost/variant.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace profiles
+{
+
+// Same as `object:get_value_by_key(key)` in a Lua profile: empty values are treated as missing
+template <typename T> const char *getValue(const T &object, const char *key)
+{
+    const auto value = object.get_value_by_key(key);
+    return value && *value ? value : nullptr;
+}
+
+template <typename T> const char *getValue(const T &object, const std::string &key)
+{
+    return getValue(object, key.c_str());
+}
+
+inline bool equals(const char *value, const char *expected)
+{
+    return value && std::strcmp(value, expected) == 0;
+}
+
+// Same as `string.match(value, substring)` for patterns without special characters
+inline bool contains(const char *value, const char *substring)
+{
+    return value && std::strstr(value, substring) != nullptr;
+}
+
+// Same as Lua's `tonumber`: the whole string, apart from surrounding spaces, has to be a number
+inline boost::optional<double> toNumber(const char *value)
+{
+    // Lua does not accept inf and nan, strtod does
+    if (!value || std::strpbrk(value, "nN"))
+        return boost::none;
+
+    char *end = nullptr;
+    const auto number = std::strtod(value, &end);
+    if (end == value)
+        return boost::none;
+
+    while (std::isspace(static_cast<unsigned char>(*end)))
+        ++end;
+    if (*end != '\0')
+        return boost::none;
+
+    return number;
+}
+
+inline boost::optional<double> toNumber(const std::string &value)
+{
+    return toNumber(value.c_str());
+}
+
+// Same as `tonumber(value:match("%d*"))`: the digits the value starts with
+inline boost::optional<double> toLeadingNumber(const char *value)
+{
+    if (!value)
+        return boost::none;
+
+    std::size_t length = 0;
+    while (std::isdigit(static_cast<unsigned char>(value[length])))
+        ++length;
+    if (length == 0)
+        return boost::none;
+
+    return toNumber(std::string(value, length));
+}
+
+// Lookup of a tag value in a fixed table, same as indexing a Lua table with the value.
+// Missing values (nullptr) are not found.
+template <typename T> class TagValueMap
+{
+  public:
+    TagValueMap(std::initializer_list<std::pair<const char *, T>> values)
+        : TagValueMap(std::vector<std::pair<const char *, T>>(values))
+    {
+    }
+
+    explicit TagValueMap(std::vector<std::pair<const char *, T>> values_)
+        : values(std::move(values_))
+    {
+        std::sort(this->values.begin(), this->values.end(), [](const auto &lhs, const auto &rhs) {
+            return std::strcmp(lhs.first, rhs.first) < 0;
+        });
+    }
+
+    const T *Find(const char *value) const
+    {
+        if (!value)
+            return nullptr;
+
+        const auto position = std::lower_bound(
+            values.begin(), values.end(), value, [](const auto &entry, const char *key) {
+                return std::strcmp(entry.first, key) < 0;
+            });
+        if (position == values.end() || std::strcmp(position->first, value) != 0)
+            return nullptr;
+
+        return &position->second;
+    }
+
+  private:
+    std::vector<std::pair<const char *, T>> values;
+};
+
+// Same as a Lua `Set`
+class TagValueSet
+{
+  public:
+    TagValueSet(std::initializer_list<const char *> values) : values(makeValues(values)) {}
+
+    bool Contains(const char *value) const { return values.Find(value) != nullptr; }
+
+  private:
+    static TagValueMap<bool> makeValues(std::initializer_list<const char *> values)
+    {
+        std::vector<std::pair<const char *, bool>> entries;
+        for (const auto value : values)
+            entries.emplace_back(value, true);
+        return TagValueMap<bool>(entries);
+    }
+
+    TagValueMap<bool> values;
+};
+
+// A tag key together with its directional variants
+struct DirectionalKey
+{
+    DirectionalKey(const char *key)
+        : key(key), forward(std::string(key) + ":forward"),
+          backward(std::string(key) + ":backward")
+    {
+    }
+
+    std::string key;
+    std::string forward;
+    std::string backward;
+};
+
+using DirectionalKeys = std::vector<DirectionalKey>;
+
+struct ForwardBackward
+{
+    const char *forward;
+    const char *backward;
+};
+
+// lib/tags.lua: Tags.get_forward_backward_by_key, only the oneway values of `data` are used
+template <typename Data>
+ForwardBackward
+getForwardBackwardByKey(const osmium::Way &way, const Data &data, const DirectionalKey &key)
+{
+    auto forward = getValue(way, key.forward);
+    auto backward = getValue(way, key.backward);
+
+    if (!forward || !backward)
+    {
+        const auto common = getValue(way, key.key);
+
+        if (data.oneway)
+        {
+            if (data.is_forward_oneway)
+                forward = forward ? forward : common;
+            if (data.is_reverse_oneway)
+                backward = backward ? backward : common;
+        }
+        else
+        {
+            forward = forward ? forward : common;
+            backward = backward ? backward : common;
+        }
+    }
+
+    return {forward, backward};
+}
+
+// lib/tags.lua: Tags.get_forward_backward_by_set
+inline ForwardBackward getForwardBackwardBySet(const osmium::Way &way, const DirectionalKeys &keys)
+{
+    const char *forward = nullptr;
+    const char *backward = nullptr;
+    for (const auto &key : keys)
+    {
+        if (!forward)
+            forward = getValue(way, key.forward);
+        if (!backward)
+            backward = getValue(way, key.backward);
+        if (!forward || !backward)
+        {
+            const auto common = getValue(way, key.key);
+            forward = forward ? forward : common;
+            backward = backward ? backward : common;
+        }
+        if (forward && backward)
+            break;
+    }
+
+    return {forward, backward};
+}
+
+// lib/tags.lua: Tags.get_value_by_prefixed_sequence
+inline const char *getValueByPrefixedSequence(const osmium::Way &way,
+                                              const std::vector<std::string> &prefixed_keys)
+{
+    for (const auto &key : prefixed_keys)
+    {
+        const auto value = getValue(way, key);
+        if (value)
+            return value;
+    }
+    return nullptr;
+}
+
+// lib/access.lua: Access.find_access_tag
+template <typename T> const char *findAccessTag(const T &object, const DirectionalKeys &hierarchy)
+{
+    for (const auto &key : hierarchy)
+    {
+        const auto access = getValue(object, key.key);
+        if (access)
+            return access;
+    }
+    return nullptr;
+}
+
+// lib/destination.lua: Destination.get_directional_tag
+inline boost::optional<std::string>
+getDirectionalTag(const osmium::Way &way, const bool is_forward, const DirectionalKey &key)
+{
+    auto value = getValue(way, is_forward ? key.forward : key.backward);
+    if (!value)
+        value = getValue(way, key.key);
+    if (!value)
+        return boost::none;
+
+    std::string result = value;
+    boost::replace_all(result, ";", ", ");
+    return result;
+}
+
+// lib/destination.lua: Destination.get_destination
+// Assembles destination as: "A59: Düsseldorf, Köln"
+inline std::string getDestination(const osmium::Way &way, const bool is_forward)
+{
+    static const DirectionalKey destination_ref_key{"destination:ref"};
+    static const DirectionalKey destination_key{"destination"};
+    static const DirectionalKey destination_street_key{"destination:street"};
+
+    const auto ref = getDirectionalTag(way, is_forward, destination_ref_key);
+    const auto destination = getDirectionalTag(way, is_forward, destination_key);
+    const auto street = getDirectionalTag(way, is_forward, destination_street_key);
+
+    if (ref && destination)
+        return *ref + ": " + *destination;
+    if (ref)
+        return *ref;
+    if (destination)
+        return *destination;
+    if (street)
+        return *street;
+    return "";
+}
+
+// lib/measure.lua
+namespace measure
+{
+const constexpr double INCH_TO_METERS = 0.0254;
+const constexpr double FEET_TO_INCHES = 12;
+const constexpr double POUND_TO_KILOGRAMS = 0.45359237;
+const constexpr double MILES_TO_KILOMETERS = 1.609;
+const constexpr double DEFAULT_MAXHEIGHT = 4.5;
+
+// Same as `tonumber(value:gsub(",", "."):match("%d+%.?%d*"))`
+inline boost::optional<double> parseDecimal(const char *value)
+{
+    while (*value && !std::isdigit(static_cast<unsigned char>(*value)))
+        ++value;
+    if (!*value)
+        return boost::none;
+
+    std::string number;
+    while (std::isdigit(static_cast<unsigned char>(*value)))
+        number += *value++;
+    if (*value == '.' || *value == ',')
+    {
+        number += '.';
+        ++value;
+        while (std::isdigit(static_cast<unsigned char>(*value)))
+            number += *value++;
+    }
+    return toNumber(number);
+}
+
+// Parse speed value as kilometers by hours.
+inline boost::optional<double> parseValueSpeed(const char *source)
+{
+    auto n = toLeadingNumber(source);
+    if (n && (contains(source, "mph") || contains(source, "mp/h")))
+    {
+        *n = *n * MILES_TO_KILOMETERS;
+    }
+    return n;
+}
+
+// Parse string as a height in meters.
+inline boost::optional<double> parseValueMeters(const char *value)
+{
+    auto n = parseDecimal(value);
+    if (n)
+    {
+        // Imperial unit to metric
+        const auto inches = std::strchr(value, '\'');
+        if (inches)
+        {
+            *n = *n * FEET_TO_INCHES;
+            // the first run of digits after the feet are the inches
+            const auto m = toLeadingNumber(std::strpbrk(inches, "0123456789"));
+            if (m)
+            {
+                *n = *n + *m;
+            }
+            *n = *n * INCH_TO_METERS;
+        }
+    }
+    return n;
+}
+
+// Parse weight value in kilograms.
+inline boost::optional<double> parseValueKilograms(const char *value)
+{
+    auto n = parseDecimal(value);
+    if (n)
+    {
+        if (contains(value, "lbs"))
+        {
+            *n = *n * POUND_TO_KILOGRAMS;
+        }
+        else if (contains(value, "kg"))
+        {
+        }
+        else
+        {
+            // Default, metric tons
+            *n = *n * 1000;
+        }
+    }
+    return n;
+}
+
+inline boost::optional<double> getMaxSpeed(const char *value)
+{
+    return value ? parseValueSpeed(value) : boost::none;
+}
+
+// Same as `element:get_location_tag('maxheight') or default_maxheight`
+inline double getLocationMaxHeight(const extractor::LocationDependentData::property_t &value)
+{
+    if (const auto height = boost::get<double>(&value))
+        return *height;
+
+    const auto flag = boost::get<bool>(&value);
+    if (boost::get<boost::blank>(&value) || (flag && !*flag))
+        return DEFAULT_MAXHEIGHT;
+
+    // the Lua profiles fail when they compare such a value with the vehicle height
+    throw std::runtime_error("Location dependent maxheight is not a number");
+}
+
+// Non numerical values take the height of the location dependent data or the default height
+template <typename T>
+boost::optional<double>
+getMaxHeight(const char *value, const T &element, const extractor::LocationTags &location_tags)
+{
+    static const TagValueSet non_numerical_values{"default", "none", "no-sign", "unsigned"};
+
+    if (!value)
+        return boost::none;
+
+    if (non_numerical_values.Contains(value))
+        return getLocationMaxHeight(location_tags.Get(element, "maxheight"));
+
+    return parseValueMeters(value);
+}
+
+inline boost::optional<double> getMaxWidth(const char *value)
+{
+    return value ? parseValueMeters(value) : boost::none;
+}
+
+inline boost::optional<double> getMaxLength(const char *value)
+{
+    return value ? parseValueMeters(value) : boost::none;
+}
+
+inline boost::optional<double> getMaxWeight(const char *value)
+{
+    return value ? parseValueKilograms(value) : boost::none;
+}
+}
+
+// lib/guidance.lua: Guidance.set_classification
+inline void
+setClassification(const char *highway, extractor::ExtractionWay &result, const osmium::Way &way)
+{
+    namespace RoadPriorityClass = extractor::RoadPriorityClass;
+
+    // default mapping from roads to types/priorities
+    static const TagValueMap<RoadPriorityClass::Enum> highway_classes{
+        {"motorway", RoadPriorityClass::MOTORWAY},
+        {"motorway_link", RoadPriorityClass::MOTORWAY_LINK},
+        {"trunk", RoadPriorityClass::TRUNK},
+        {"trunk_link", RoadPriorityClass::TRUNK_LINK},
+        {"primary", RoadPriorityClass::PRIMARY},
+        {"primary_link", RoadPriorityClass::PRIMARY_LINK},
+        {"secondary", RoadPriorityClass::SECONDARY},
+        {"secondary_link", RoadPriorityClass::SECONDARY_LINK},
+        {"tertiary", RoadPriorityClass::TERTIARY},
+        {"tertiary_link", RoadPriorityClass::TERTIARY_LINK},
+        {"unclassified", RoadPriorityClass::UNCLASSIFIED},
+        {"residential", RoadPriorityClass::MAIN_RESIDENTIAL},
+        {"service", RoadPriorityClass::ALLEY},
+        {"living_street", RoadPriorityClass::SIDE_RESIDENTIAL},
+        {"track", RoadPriorityClass::BIKE_PATH},
+        {"path", RoadPriorityClass::BIKE_PATH},
+        {"footway", RoadPriorityClass::FOOT_PATH},
+        {"pedestrian", RoadPriorityClass::FOOT_PATH},
+        {"steps", RoadPriorityClass::FOOT_PATH}};
+
+    static const TagValueSet motorway_types{"motorway", "motorway_link", "trunk", "trunk_link"};
+
+    // these road types are set with a car in mind, the Lua code uses them for all profiles
+    static const TagValueSet road_types{"motorway",
+                                        "motorway_link",
+                                        "trunk",
+                                        "trunk_link",
+                                        "primary",
+                                        "primary_link",
+                                        "secondary",
+                                        "secondary_link",
+                                        "tertiary",
+                                        "tertiary_link",
+                                        "unclassified",
+                                        "residential",
+                                        "living_street"};
+
+    static const TagValueSet link_types{
+        "motorway_link", "trunk_link", "primary_link", "secondary_link", "tertiary_link"};
+
+    auto &classification = result.road_classification;
+
+    if (motorway_types.Contains(highway))
+        classification.SetMotorwayFlag(true);
+    if (link_types.Contains(highway))
+        classification.SetLinkClass(true);
+
+    if (equals(highway, "service"))
+    {
+        // the Lua code checks the service type, but ends up with alley for all of them
+        classification.SetClass(RoadPriorityClass::ALLEY);
+    }
+    else
+    {
+        const auto priority_class = highway_classes.Find(highway);
+        classification.SetClass(priority_class ? *priority_class : RoadPriorityClass::CONNECTIVITY);
+    }
+    classification.SetLowPriorityFlag(!road_types.Contains(highway));
+
+    // same conversion as for `num_lanes` in Lua profiles
+    const auto set_lanes = [&classification](const double number_of_lanes) {
+        classification.SetNumberOfLanes(extractor::toCount<std::uint8_t>(number_of_lanes));
+    };
+
+    const auto lane_count = getValue(way, "lanes");
+    if (lane_count)
+    {
+        const auto lanes = toNumber(lane_count);
+        if (lanes)
+            set_lanes(*lanes);
+    }
+    else
+    {
+        double total_count = 0;
+        const auto forward_count = toNumber(getValue(way, "lanes:forward"));
+        if (forward_count)
+            total_count = *forward_count;
+        const auto backward_count = toNumber(getValue(way, "lanes:backward"));
+        if (backward_count)
+            total_count = total_count + *backward_count;
+        if (total_count != 0)
+            set_lanes(total_count);
+    }
+}
+
+// lib/guidance.lua: trims lane string with regard to supported lanes
+inline boost::optional<std::string> processLanes(const char *turn_lanes,
+                                                 const char *vehicle_lanes,
+                                                 const double first_count,
+                                                 const double second_count)
+{
+    if (!turn_lanes)
+        return boost::none;
+    if (vehicle_lanes)
+        return extractor::applyAccessTokens(turn_lanes, vehicle_lanes);
+    if (first_count != 0 || second_count != 0)
+        return extractor::trimLaneStringByCount(turn_lanes, first_count, second_count);
+    return std::string(turn_lanes);
+}
+
+// lib/guidance.lua: Guidance.get_turn_lanes together with WayHandlers.turn_lanes setting them
+template <typename Data>
+void setTurnLanes(const osmium::Way &way, const Data &data, extractor::ExtractionWay &result)
+{
+    static const DirectionalKey psv_lanes_key{"lanes:psv"};
+    static const DirectionalKey turn_lanes_key{"turn:lanes"};
+    static const DirectionalKey vehicle_lanes_key{"vehicle:lanes"};
+
+    const auto count = [](const char *value) { return toNumber(value).value_or(0); };
+    const auto psv = getForwardBackwardByKey(way, data, psv_lanes_key);
+    const auto psv_forward = count(psv.forward);
+    const auto psv_backward = count(psv.backward);
+
+    const auto turn_lanes = getForwardBackwardByKey(way, data, turn_lanes_key);
+    const auto vehicle_lanes = getForwardBackwardByKey(way, data, vehicle_lanes_key);
+
+    // note: backward lanes swap psv_backward and psv_forward
+    const auto forward =
+        processLanes(turn_lanes.forward, vehicle_lanes.forward, psv_backward, psv_forward);
+    const auto backward =
+        processLanes(turn_lanes.backward, vehicle_lanes.backward, psv_forward, psv_backward);
+
+    if (forward)
+        result.SetTurnLanesForward(forward->c_str());
+    if (backward)
+        result.SetTurnLanesBackward(backward->c_str());
+}
+}
+}
+
+#endif
@@ -0,0 +1,190 @@
+// Native port of profiles/testbot.lua
+//
+// Build as a shared object against the OSRM headers and pass it to osrm-extract:
+//   osrm-extract --profile testbot.so map.osm.pbf
+//
+// Moves at fixed, well-known speeds, practical for testing speed and travel times:
+// Primary road:  36km/h = 36000m/3600s = 100m/10s
+// Secondary road:  18km/h = 18000m/3600s = 100m/20s
+// Tertiary road:  12km/h = 12000m/3600s = 100m/30s
+
+#include "extractor/extraction_helper_functions.hpp"
+#include "extractor/native_profile.hpp"
+#include "extractor/travel_mode.hpp"
+
+#include "profile_helpers.hpp"
+
+#include <algorithm>
+#include <string>
+
+namespace
+{
+using namespace osrm::extractor;
+using namespace osrm::profiles;
+
+const constexpr double U_TURN_PENALTY = 20;
+const constexpr double TRAFFIC_LIGHT_PENALTY = 7; // seconds
+const constexpr double DEFAULT_SPEED = 24;
+
+class TestbotProfile final : public NativeProfile
+{
+  public:
+    ProfileProperties GetProfileProperties() const override
+    {
+        ProfileProperties properties;
+        properties.continue_straight_at_waypoint = true;
+        properties.SetMaxSpeedForMapMatching(30 / 3.6);
+        properties.SetWeightName("duration");
+        properties.call_tagless_node_function = false;
+        properties.SetUturnPenalty(U_TURN_PENALTY);
+        properties.SetTrafficSignalPenalty(TRAFFIC_LIGHT_PENALTY);
+        properties.use_turn_restrictions = true;
+        return properties;
+    }
+
+    std::vector<std::vector<std::string>> GetExcludableClasses() const override
+    {
+        return {{"motorway"}, {"toll"}, {"motorway", "toll"}};
+    }
+
+    std::vector<std::string> GetClassNames() const override
+    {
+        return {"motorway", "toll", "TooWords2"};
+    }
+
+    void ProcessNode(const osmium::Node &node,
+                     ExtractionNode &result,
+                     const ExtractionRelationContainer &,
+                     const LocationTags &) const override
+    {
+        if (equals(getValue(node, "highway"), "traffic_signals"))
+        {
+            result.traffic_lights = true;
+        }
+    }
+
+    void ProcessWay(const osmium::Way &way,
+                    ExtractionWay &result,
+                    const ExtractionRelationContainer &,
+                    const LocationTags &) const override
+    {
+        const auto highway = getValue(way, "highway");
+        const auto toll = getValue(way, "toll");
+        const auto name = getValue(way, "name");
+        const auto oneway = getValue(way, "oneway");
+        const auto duration = getValue(way, "duration");
+        const auto maxspeed = toNumber(getValue(way, "maxspeed"));
+        const auto maxspeed_forward = toNumber(getValue(way, "maxspeed:forward"));
+        const auto maxspeed_backward = toNumber(getValue(way, "maxspeed:backward"));
+        const auto junction = getValue(way, "junction");
+
+        if (name)
+        {
+            result.SetName(name);
+        }
+
+        result.forward_travel_mode = TRAVEL_MODE_DRIVING;
+        result.backward_travel_mode = TRAVEL_MODE_DRIVING;
+
+        if (duration && durationIsValid(duration))
+        {
+            result.duration = std::max(1u, parseDuration(duration));
+            result.forward_travel_mode = TRAVEL_MODE_ROUTE;
+            result.backward_travel_mode = TRAVEL_MODE_ROUTE;
+        }
+        else
+        {
+            auto speed_forward = DEFAULT_SPEED;
+            const auto speed = speeds.Find(highway);
+            if (speed)
+                speed_forward = *speed;
+            auto speed_backward = speed_forward;
+
+            if (equals(highway, "river"))
+            {
+                const auto temp_speed = speed_forward;
+                result.forward_travel_mode = TRAVEL_MODE_RIVER_DOWN;
+                result.backward_travel_mode = TRAVEL_MODE_RIVER_UP;
+                speed_forward = temp_speed * 1.5;
+                speed_backward = temp_speed / 1.5;
+            }
+            else if (equals(highway, "steps"))
+            {
+                result.forward_travel_mode = TRAVEL_MODE_STEPS_DOWN;
+                result.backward_travel_mode = TRAVEL_MODE_STEPS_UP;
+            }
+
+            if (maxspeed_forward && *maxspeed_forward > 0)
+            {
+                speed_forward = *maxspeed_forward;
+            }
+            else if (maxspeed && *maxspeed > 0 && speed_forward > *maxspeed)
+            {
+                speed_forward = *maxspeed;
+            }
+
+            if (maxspeed_backward && *maxspeed_backward > 0)
+            {
+                speed_backward = *maxspeed_backward;
+            }
+            else if (maxspeed && *maxspeed > 0 && speed_backward > *maxspeed)
+            {
+                speed_backward = *maxspeed;
+            }
+
+            result.forward_speed = speed_forward;
+            result.backward_speed = speed_backward;
+        }
+
+        if (equals(oneway, "no") || equals(oneway, "0") || equals(oneway, "false"))
+        {
+            // nothing to do
+        }
+        else if (equals(oneway, "-1"))
+        {
+            result.forward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+        }
+        else if (equals(oneway, "yes") || equals(oneway, "1") || equals(oneway, "true") ||
+                 equals(junction, "roundabout"))
+        {
+            result.backward_travel_mode = TRAVEL_MODE_INACCESSIBLE;
+        }
+
+        if (equals(highway, "motorway"))
+        {
+            result.forward_classes["motorway"] = true;
+            result.backward_classes["motorway"] = true;
+        }
+
+        if (equals(toll, "yes"))
+        {
+            result.forward_classes["toll"] = true;
+            result.backward_classes["toll"] = true;
+        }
+
+        if (equals(junction, "roundabout"))
+        {
+            result.roundabout = true;
+        }
+    }
+
+    void ProcessTurn(ExtractionTurn &turn) const override
+    {
+        if (turn.is_u_turn)
+        {
+            turn.duration = turn.duration + U_TURN_PENALTY;
+            turn.weight = turn.weight + U_TURN_PENALTY;
+        }
+        if (turn.has_traffic_light)
+        {
+            turn.duration = turn.duration + TRAFFIC_LIGHT_PENALTY;
+        }
+    }
+
+  private:
+    const TagValueMap<double> speeds{
+        {"primary", 36}, {"secondary", 18}, {"tertiary", 12}, {"steps", 6}};
+};
+}
+
+OSRM_NATIVE_PROFILE(TestbotProfile)
@@ -0,0 +1,92 @@
+#include "util/concurrent_id_map.hpp"
+#include "util/log.hpp"
+#include "util/timing_util.hpp"
+
+#include <boost/interprocess/sync/interprocess_upgradable_mutex.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/interprocess/sync/sharable_lock.hpp>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using namespace osrm;
+
+// The previous ConcurrentIDMap: one map behind a single upgradable lock
+struct LockedIDMap
+{
+    using UpgradableMutex = boost::interprocess::interprocess_upgradable_mutex;
+    using ScopedReaderLock = boost::interprocess::sharable_lock<UpgradableMutex>;
+    using ScopedWriterLock = boost::interprocess::scoped_lock<UpgradableMutex>;
+
+    std::unordered_map<std::uint64_t, std::uint32_t> data;
+    mutable UpgradableMutex mutex;
+
+    std::uint32_t ConcurrentFindOrAdd(const std::uint64_t key)
+    {
+        {
+            ScopedReaderLock sentry{mutex};
+            const auto result = data.find(key);
+            if (result != data.end())
+            {
+                return result->second;
+            }
+        }
+        ScopedWriterLock sentry{mutex};
+        const auto result = data.find(key);
+        if (result != data.end())
+        {
+            return result->second;
+        }
+        const auto id = static_cast<std::uint32_t>(data.size());
+        data[key] = id;
+        return id;
+    }
+};
+
+// Few distinct keys that are looked up very often, like lane descriptions or entry classes
+std::vector<std::uint64_t> makeKeys(const std::size_t num_lookups, const std::size_t num_keys)
+{
+    std::mt19937 generator(1337);
+    std::geometric_distribution<std::uint64_t> distribution(10. / num_keys);
+
+    std::vector<std::uint64_t> keys(num_lookups);
+    std::generate(keys.begin(), keys.end(), [&] { return distribution(generator); });
+    return keys;
+}
+
+template <typename MapT> double measure(const std::vector<std::uint64_t> &keys)
+{
+    MapT map;
+    std::vector<std::uint32_t> ids(keys.size());
+
+    TIMER_START(lookup);
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, keys.size()),
+                      [&](const tbb::blocked_range<std::size_t> &range) {
+                          for (auto index = range.begin(); index < range.end(); ++index)
+                          {
+                              ids[index] = map.ConcurrentFindOrAdd(keys[index]);
+                          }
+                      });
+    TIMER_STOP(lookup);
+
+    return TIMER_MSEC(lookup);
+}
+
+int main(int, char **)
+{
+    util::LogPolicy::GetInstance().Unmute();
+
+    const auto keys = makeKeys(20000000, 10000);
+
+    const auto locked_ms = measure<LockedIDMap>(keys);
+    const auto sharded_ms = measure<util::ConcurrentIDMap<std::uint64_t, std::uint32_t>>(keys);
+
+    util::Log() << "find or add: single lock " << locked_ms << " ms, util::ConcurrentIDMap "
+                << sharded_ms << " ms. " << locked_ms / sharded_ms;
+}
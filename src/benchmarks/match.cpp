@@ -22,7 +22,7 @@ int main(int argc, const char *argv[]) try
 {
     if (argc < 2)
     {
-        std::cerr << "Usage: " << argv[0] << " data.osrm\n";
+        std::cerr << "Usage: " << argv[0] << " data.osrm [CH|MLD] [radius]\n";
         return EXIT_FAILURE;
     }
 
@@ -32,6 +32,11 @@ int main(int argc, const char *argv[]) try
     EngineConfig config;
     config.storage_config = {argv[1]};
     config.use_shared_memory = false;
+    if (argc > 2)
+    {
+        config.algorithm = std::string{argv[2]} == "MLD" ? EngineConfig::Algorithm::MLD
+                                                          : EngineConfig::Algorithm::CH;
+    }
 
     // Routing machine with several services (such as Route, Table, Nearest, Trip, Match)
     OSRM osrm{config};
@@ -210,6 +215,12 @@ int main(int argc, const char *argv[]) try
     params.coordinates.push_back(
         FloatCoordinate{FloatLongitude{7.415342330932617}, FloatLatitude{43.733251335381205}});
 
+    // Larger radiuses give more candidates per coordinate, as in dense city centers
+    if (argc > 3)
+    {
+        params.radiuses.assign(params.coordinates.size(), std::stod(argv[3]));
+    }
+
     TIMER_START(routes);
     auto NUM = 100;
     for (int i = 0; i < NUM; ++i)
@@ -8,6 +8,7 @@
 #include <numeric>
 #include <random>
 #include <string>
+#include <utility>
 #include <vector>
 
 using namespace osrm;
@@ -62,6 +63,49 @@ auto measure_random_access()
     return Measurement{TIMER_MSEC(write), TIMER_MSEC(read)};
 }
 
+// Reads short consecutive ranges like the geometry accessors do, once element by element and
+// once with a single bulk decode per range
+template <std::size_t num_rounds, std::size_t num_entries, std::size_t range_length>
+auto measure_range_access()
+{
+    util::PackedVector<std::uint32_t, 22> vector(num_entries);
+    for (auto idx : util::irange<std::size_t>(0, num_entries))
+    {
+        vector[idx] = idx % (1 << 22);
+    }
+
+    std::vector<std::uint32_t> buffer(range_length);
+
+    TIMER_START(single);
+    for (auto round : util::irange<std::size_t>(0, num_rounds))
+    {
+        std::uint32_t sum = round;
+        for (std::size_t first = 0; first + range_length <= num_entries; first += range_length)
+        {
+            const auto begin = vector.begin() + first;
+            std::copy(begin, begin + range_length, buffer.begin());
+            sum += buffer.back();
+        }
+        dont_optimize_away(sum);
+    }
+    TIMER_STOP(single);
+
+    TIMER_START(bulk);
+    for (auto round : util::irange<std::size_t>(0, num_rounds))
+    {
+        std::uint32_t sum = round;
+        for (std::size_t first = 0; first + range_length <= num_entries; first += range_length)
+        {
+            vector.decode(first, first + range_length, buffer.begin());
+            sum += buffer.back();
+        }
+        dont_optimize_away(sum);
+    }
+    TIMER_STOP(bulk);
+
+    return std::make_pair(TIMER_MSEC(single), TIMER_MSEC(bulk));
+}
+
 int main(int, char **)
 {
     util::LogPolicy::GetInstance().Unmute();
@@ -78,4 +122,9 @@ int main(int, char **)
     util::Log() << "random read: std::vector " << result_plain.random_read_ms
                 << " ms, util::packed_vector " << result_packed.random_read_ms << " ms. "
                 << read_slowdown;
+
+    auto result_range = measure_range_access<1000, 1000000, 16>();
+    util::Log() << "range read: util::packed_vector single " << result_range.first
+                << " ms, bulk " << result_range.second << " ms. "
+                << result_range.first / result_range.second;
 }
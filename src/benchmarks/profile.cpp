@@ -0,0 +1,106 @@
+#include "extractor/extraction_node.hpp"
+#include "extractor/extraction_relation.hpp"
+#include "extractor/extraction_way.hpp"
+#include "extractor/maneuver_override_relation_parser.hpp"
+#include "extractor/restriction_parser.hpp"
+#include "extractor/scripting_environment.hpp"
+#include "extractor/scripting_environment_lua.hpp"
+#include "extractor/scripting_environment_native.hpp"
+
+#include "util/timing_util.hpp"
+
+#include <osmium/io/any_input.hpp>
+#include <osmium/memory/buffer.hpp>
+
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace osrm;
+using namespace osrm::extractor;
+
+namespace
+{
+// Runs the node and way functions of the profile for all elements on the calling thread
+void benchmark(ScriptingEnvironment &environment,
+               const std::vector<osmium::memory::Buffer> &buffers,
+               const std::string &name)
+{
+    auto restrictions = environment.GetRestrictions();
+    const RestrictionParser restriction_parser(
+        environment.GetProfileProperties().use_turn_restrictions, false, restrictions);
+    const ManeuverOverrideRelationParser maneuver_override_parser;
+    const ExtractionRelationContainer relations;
+
+    std::size_t number_of_nodes = 0;
+    std::size_t number_of_ways = 0;
+
+    TIMER_START(process);
+    for (const auto &buffer : buffers)
+    {
+        std::vector<std::pair<const osmium::Node &, ExtractionNode>> nodes;
+        std::vector<std::pair<const osmium::Way &, ExtractionWay>> ways;
+        std::vector<InputConditionalTurnRestriction> resulting_restrictions;
+        std::vector<InputManeuverOverride> resulting_maneuver_overrides;
+        environment.ProcessElements(buffer,
+                                    restriction_parser,
+                                    maneuver_override_parser,
+                                    relations,
+                                    nodes,
+                                    ways,
+                                    resulting_restrictions,
+                                    resulting_maneuver_overrides);
+        number_of_nodes += nodes.size();
+        number_of_ways += ways.size();
+    }
+    TIMER_STOP(process);
+
+    // The Lua environment does not call the way function for ways without relevant tags
+    std::cout << name << ": " << TIMER_MSEC(process) << "ms for " << number_of_nodes
+              << " nodes and " << number_of_ways << " processed ways" << std::endl;
+}
+}
+
+int main(int argc, const char *argv[]) try
+{
+    if (argc < 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " map.osm.pbf profile.lua [profile.so]\n";
+        return EXIT_FAILURE;
+    }
+
+    std::vector<osmium::memory::Buffer> buffers;
+    std::size_t number_of_bytes = 0;
+    {
+        osmium::io::Reader reader(argv[1], osmium::osm_entity_bits::nwr);
+        while (auto buffer = reader.read())
+        {
+            number_of_bytes += buffer.committed();
+            buffers.push_back(std::move(buffer));
+        }
+        reader.close();
+    }
+    std::cout << "Read " << buffers.size() << " buffers with " << number_of_bytes << " bytes"
+              << std::endl;
+
+    {
+        Sol2ScriptingEnvironment environment(argv[2], {});
+        benchmark(environment, buffers, argv[2]);
+    }
+
+    if (argc > 3)
+    {
+        NativeScriptingEnvironment environment(argv[3], {});
+        benchmark(environment, buffers, argv[3]);
+    }
+
+    return EXIT_SUCCESS;
+}
+catch (const std::exception &e)
+{
+    std::cerr << "Error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,149 @@
+#include "engine/datafacade_provider.hpp"
+#include "engine/plugins/viaroute.hpp"
+#include "engine/routing_algorithms.hpp"
+#include "engine/routing_algorithms/alternative_path.hpp"
+#include "engine/search_engine_data.hpp"
+#include "util/timing_util.hpp"
+
+#include "osrm/route_parameters.hpp"
+
+#include "osrm/coordinate.hpp"
+#include "osrm/engine_config.hpp"
+#include "osrm/json_container.hpp"
+
+#include "osrm/osrm.hpp"
+#include "osrm/status.hpp"
+
+#include <exception>
+#include <iostream>
+#include <string>
+#include <utility>
+
+#include <cstdlib>
+
+int main(int argc, const char *argv[]) try
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " data.osrm [CH|MLD]\n";
+        return EXIT_FAILURE;
+    }
+
+    using namespace osrm;
+
+    // Configure based on a .osrm base path, and no datasets in shared mem from osrm-datastore
+    EngineConfig config;
+    config.storage_config = {argv[1]};
+    config.use_shared_memory = false;
+    if (argc > 2)
+    {
+        config.algorithm = std::string{argv[2]} == "MLD" ? EngineConfig::Algorithm::MLD
+                                                          : EngineConfig::Algorithm::CH;
+    }
+
+    // Routing machine with several services (such as Route, Table, Nearest, Trip, Match)
+    OSRM osrm{config};
+
+    // Route across monaco with a few waypoints
+    RouteParameters params;
+    params.overview = RouteParameters::OverviewType::False;
+    params.steps = false;
+
+    using osrm::util::FloatCoordinate;
+    using osrm::util::FloatLatitude;
+    using osrm::util::FloatLongitude;
+
+    params.coordinates.push_back(
+        FloatCoordinate{FloatLongitude{7.437602352715216}, FloatLatitude{43.75030522209604}});
+    params.coordinates.push_back(
+        FloatCoordinate{FloatLongitude{7.421715259552002}, FloatLatitude{43.73744517900973}});
+    params.coordinates.push_back(
+        FloatCoordinate{FloatLongitude{7.419933319091797}, FloatLatitude{43.73050345355003}});
+    params.coordinates.push_back(
+        FloatCoordinate{FloatLongitude{7.415342330932617}, FloatLatitude{43.733251335381205}});
+
+    const auto run = [&](const char *name) {
+        TIMER_START(routes);
+        auto NUM = 1000;
+        for (int i = 0; i < NUM; ++i)
+        {
+            engine::api::ResultT result = json::Object();
+            const auto rc = osrm.Route(params, result);
+            auto &json_result = result.get<json::Object>();
+            const auto number_of_routes =
+                json_result.values.at("routes").get<json::Array>().values.size();
+            if (rc != Status::Ok || number_of_routes < 1 ||
+                (!params.alternatives && number_of_routes != 1))
+            {
+                return false;
+            }
+        }
+        TIMER_STOP(routes);
+        std::cout << name << ": " << (TIMER_USEC(routes) / NUM) << "us/req" << std::endl;
+        return true;
+    };
+
+    if (!run("full"))
+        return EXIT_FAILURE;
+
+    if (config.algorithm == EngineConfig::Algorithm::CH)
+    {
+        // The caches belong to the datasets, so the requests are repeated on a dataset that is
+        // loaded here and not inside of the OSRM object
+        using Algorithm = engine::routing_algorithms::ch::Algorithm;
+        const engine::ImmutableProvider<Algorithm> provider{config.storage_config};
+        engine::SearchEngineData<Algorithm> heaps;
+        const engine::plugins::ViaRoutePlugin plugin{
+            config.max_locations_viaroute, config.max_alternatives, {}, config.region};
+
+        const auto facade = provider.Get(params);
+        for (int i = 0; i < 1000; ++i)
+        {
+            engine::api::ResultT result = json::Object();
+            if (plugin.HandleRequest(engine::RoutingAlgorithms<Algorithm>{heaps, facade},
+                                     params,
+                                     result) != Status::Ok)
+            {
+                return EXIT_FAILURE;
+            }
+        }
+
+        const auto &cache = *facade->GetUnpackingCache();
+        std::cout << "unpacking cache: " << cache.GetHits() << " hits, " << cache.GetMisses()
+                  << " misses (" << 100 * cache.GetHitRate() << "%)" << std::endl;
+    }
+
+    params.eta_only = true;
+    if (!run("eta_only"))
+        return EXIT_FAILURE;
+
+    if (config.algorithm == EngineConfig::Algorithm::MLD)
+    {
+        params.eta_only = false;
+        params.alternatives = true;
+        params.number_of_alternatives = 3;
+        params.coordinates.resize(2);
+        if (!run("alternatives"))
+            return EXIT_FAILURE;
+
+        // Candidates rejected per filter stage of the alternatives search
+        const auto &counters = engine::routing_algorithms::getAlternativeFilterCounters();
+        std::cout << "alternatives: " << counters.searches << " searches, "
+                  << counters.candidates << " via candidates, rejected by unique node "
+                  << counters.by_unique_node << ", stretch " << counters.by_stretch
+                  << ", via on path " << counters.by_via_on_path << ", local optimality "
+                  << counters.by_local_optimality << ", cell sharing "
+                  << counters.by_cell_sharing << ", unpacking limit "
+                  << counters.by_unpacking_limit << ", time budget " << counters.by_time_budget
+                  << ", sharing " << counters.by_sharing << ", number of alternatives "
+                  << counters.by_number_of_alternatives << ", annotated stretch "
+                  << counters.by_annotated_stretch << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
+catch (const std::exception &e)
+{
+    std::cerr << "Error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
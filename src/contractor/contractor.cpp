@@ -99,19 +99,15 @@ int Contractor::Run()
             util::excludeFlagsToNodeFilter(number_of_edge_based_nodes, node_data, properties);
     }
 
-    QueryGraph query_graph;
-    std::vector<std::vector<bool>> edge_filters;
-    std::vector<std::vector<bool>> cores;
-    std::tie(query_graph, edge_filters) = contractExcludableGraph(
+    auto metric = contractExcludableGraph(
         toContractorGraph(number_of_edge_based_nodes, std::move(edge_based_edge_list)),
         std::move(node_weights),
         std::move(node_filters));
     TIMER_STOP(contraction);
-    util::Log() << "Contracted graph has " << query_graph.GetNumberOfEdges() << " edges.";
+    util::Log() << "Contracted graph has " << metric.graph.GetNumberOfEdges() << " edges.";
     util::Log() << "Contraction took " << TIMER_SEC(contraction) << " sec";
 
-    std::unordered_map<std::string, ContractedMetric> metrics = {
-        {metric_name, {std::move(query_graph), std::move(edge_filters)}}};
+    std::unordered_map<std::string, ContractedMetric> metrics = {{metric_name, std::move(metric)}};
 
     files::writeGraph(config.GetPath(".osrm.hsgr"), metrics, connectivity_checksum);
 
@@ -94,6 +94,7 @@ util::json::Array coordinateToLonLat(const util::Coordinate &coordinate)
 util::json::Object makeStepManeuver(const guidance::StepManeuver &maneuver)
 {
     util::json::Object step_maneuver;
+    step_maneuver.values.reserve(6);
 
     std::string maneuver_type;
 
@@ -123,6 +124,7 @@ util::json::Object makeStepManeuver(const guidance::StepManeuver &maneuver)
 util::json::Object makeIntersection(const guidance::IntermediateIntersection &intersection)
 {
     util::json::Object result;
+    result.values.reserve(7);
     util::json::Array bearings;
     util::json::Array entry;
 
@@ -172,6 +174,7 @@ util::json::Object makeIntersection(const guidance::IntermediateIntersection &in
 util::json::Object makeRouteStep(guidance::RouteStep step, util::json::Value geometry)
 {
     util::json::Object route_step;
+    route_step.values.reserve(15);
     route_step.values["distance"] = std::round(step.distance * 10) / 10.;
     route_step.values["duration"] = step.duration;
     route_step.values["weight"] = step.weight;
@@ -215,6 +218,7 @@ util::json::Object makeRoute(const guidance::Route &route,
                              const char *weight_name)
 {
     util::json::Object json_route;
+    json_route.values.reserve(6);
     json_route.values["distance"] = route.distance;
     json_route.values["duration"] = route.duration;
     json_route.values["weight"] = route.weight;
@@ -231,6 +235,8 @@ util::json::Object
 makeWaypoint(const util::Coordinate &location, const double &distance, std::string name)
 {
     util::json::Object waypoint;
+    // one more for the hint
+    waypoint.values.reserve(4);
     waypoint.values["location"] = detail::coordinateToLonLat(location);
     waypoint.values["name"] = std::move(name);
     waypoint.values["distance"] = distance;
@@ -250,6 +256,8 @@ util::json::Object makeWaypoint(const util::Coordinate &location,
 util::json::Object makeRouteLeg(guidance::RouteLeg leg, util::json::Array steps)
 {
     util::json::Object route_leg;
+    // one more for the annotation
+    route_leg.values.reserve(6);
     route_leg.values["distance"] = leg.distance;
     route_leg.values["duration"] = leg.duration;
     route_leg.values["weight"] = leg.weight;
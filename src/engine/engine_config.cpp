@@ -21,11 +21,14 @@ bool EngineConfig::IsValid() const
                               unlimited_or_more_than(max_locations_trip, 2) &&
                               unlimited_or_more_than(max_locations_viaroute, 2) &&
                               unlimited_or_more_than(max_results_nearest, 0) &&
-                              max_alternatives >= 0;
+                              max_alternatives >= 0 && alternatives_time_budget >= 0;
+
+    const bool region_valid = !region.IsValid() ||
+                              (region.min_lon <= region.max_lon && region.min_lat <= region.max_lat);
 
     return ((use_shared_memory && all_path_are_empty) || (use_mmap && storage_config.IsValid()) ||
             storage_config.IsValid()) &&
-           limits_valid;
+           limits_valid && region_valid;
 }
 }
 }
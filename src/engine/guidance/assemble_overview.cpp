@@ -1,5 +1,6 @@
-#include "engine/douglas_peucker.hpp"
 #include "engine/guidance/leg_geometry.hpp"
+#include "util/douglas_peucker.hpp"
+#include "util/integer_range.hpp"
 #include "util/viewport.hpp"
 
 #include <iterator>
@@ -72,10 +73,32 @@ std::vector<util::Coordinate> assembleOverview(const std::vector<LegGeometry> &l
     if (use_simplification)
     {
         const auto zoom_level = std::min(18u, calculateOverviewZoomLevel(leg_geometries));
+        std::vector<util::Coordinate> prefiltered;
         for (const auto &geometry : leg_geometries)
         {
-            const auto simplified =
-                douglasPeucker(geometry.locations.begin(), geometry.locations.end(), zoom_level);
+            const auto size = geometry.locations.size();
+            auto begin = geometry.locations.begin();
+            auto end = geometry.locations.end();
+
+            // Drop the nodes that are already removed by the precomputed simplification of their
+            // compressed geometry. Only the remaining nodes, mostly the intersections along the
+            // route, need to be simplified here.
+            if (geometry.zoom_levels.size() == size)
+            {
+                prefiltered.clear();
+                for (const auto index : util::irange<std::size_t>(0, size))
+                {
+                    if (geometry.zoom_levels[index] <= zoom_level || index == 0 ||
+                        index + 1 == size)
+                    {
+                        prefiltered.push_back(geometry.locations[index]);
+                    }
+                }
+                begin = prefiltered.cbegin();
+                end = prefiltered.cend();
+            }
+
+            const auto simplified = util::douglasPeucker(begin, end, zoom_level);
             insert_without_overlap(simplified.begin(), simplified.end());
         }
     }
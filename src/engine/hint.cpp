@@ -27,11 +27,13 @@ bool Hint::IsValid(const util::Coordinate new_input_coordinates,
 
 std::string Hint::ToBase64() const
 {
-    auto base64 = encodeBase64Bytewise(*this);
+    std::string base64(ENCODED_HINT_SIZE, '=');
 
     // Make safe for usage as GET parameter in URLs
-    std::replace(begin(base64), end(base64), '+', '-');
-    std::replace(begin(base64), end(base64), '/', '_');
+    detail::encodeBase64(reinterpret_cast<const unsigned char *>(this),
+                         sizeof(Hint),
+                         detail::BASE64_URL_ALPHABET,
+                         &base64[0]);
 
     return base64;
 }
@@ -40,14 +42,8 @@ Hint Hint::FromBase64(const std::string &base64Hint)
 {
     BOOST_ASSERT_MSG(base64Hint.size() == ENCODED_HINT_SIZE, "Hint has invalid size");
 
-    // We need mutability but don't want to change the API
-    auto encoded = base64Hint;
-
-    // Reverses above encoding we need for GET parameters in URL
-    std::replace(begin(encoded), end(encoded), '-', '+');
-    std::replace(begin(encoded), end(encoded), '_', '/');
-
-    return decodeBase64Bytewise<Hint>(encoded);
+    // The decoder accepts the URL safe alphabet used above
+    return decodeBase64Bytewise<Hint>(base64Hint);
 }
 
 bool operator==(const Hint &lhs, const Hint &rhs)
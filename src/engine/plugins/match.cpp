@@ -14,6 +14,7 @@
 #include <cstdlib>
 
 #include <algorithm>
+#include <chrono>
 #include <functional>
 #include <iterator>
 #include <memory>
@@ -110,6 +111,70 @@ void filterCandidates(const std::vector<util::Coordinate> &coordinates,
     }
 }
 
+// assuming radius is the standard deviation of a normal distribution
+// that models GPS noise (in this model), x3 should give us the correct
+// search radius with > 99% confidence
+std::vector<double> getSearchRadiuses(const api::MatchParameters &parameters)
+{
+    std::vector<double> search_radiuses;
+    if (parameters.radiuses.empty())
+    {
+        search_radiuses.resize(parameters.coordinates.size(),
+                               routing_algorithms::DEFAULT_GPS_PRECISION *
+                                   MatchPlugin::RADIUS_MULTIPLIER);
+    }
+    else
+    {
+        search_radiuses.resize(parameters.coordinates.size());
+        std::transform(parameters.radiuses.begin(),
+                       parameters.radiuses.end(),
+                       search_radiuses.begin(),
+                       [](const boost::optional<double> &maybe_radius) {
+                           if (maybe_radius)
+                           {
+                               return *maybe_radius * MatchPlugin::RADIUS_MULTIPLIER;
+                           }
+                           else
+                           {
+                               return routing_algorithms::DEFAULT_GPS_PRECISION *
+                                      MatchPlugin::RADIUS_MULTIPLIER;
+                           }
+
+                       });
+    }
+    return search_radiuses;
+}
+
+// Each sub_route will correspond to a MatchObject
+std::vector<InternalRouteResult> getSubRoutes(const RoutingAlgorithmsInterface &algorithms,
+                                              const MatchPlugin::SubMatchingList &sub_matchings)
+{
+    std::vector<InternalRouteResult> sub_routes(sub_matchings.size());
+    for (auto index : util::irange<std::size_t>(0UL, sub_matchings.size()))
+    {
+        BOOST_ASSERT(sub_matchings[index].nodes.size() > 1);
+
+        // FIXME we only run this to obtain the geometry
+        // The clean way would be to get this directly from the map matching plugin
+        PhantomNodes current_phantom_node_pair;
+        for (unsigned i = 0; i < sub_matchings[index].nodes.size() - 1; ++i)
+        {
+            current_phantom_node_pair.source_phantom = sub_matchings[index].nodes[i];
+            current_phantom_node_pair.target_phantom = sub_matchings[index].nodes[i + 1];
+            BOOST_ASSERT(current_phantom_node_pair.source_phantom.IsValid());
+            BOOST_ASSERT(current_phantom_node_pair.target_phantom.IsValid());
+            sub_routes[index].segment_end_coordinates.emplace_back(current_phantom_node_pair);
+        }
+        // force uturns to be on
+        // we split the phantom nodes anyway and only have bi-directional phantom nodes for
+        // possible uturns
+        sub_routes[index] =
+            algorithms.ShortestPathSearch(sub_routes[index].segment_end_coordinates, {false});
+        BOOST_ASSERT(sub_routes[index].shortest_path_weight != INVALID_EDGE_WEIGHT);
+    }
+    return sub_routes;
+}
+
 Status MatchPlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
                                   const api::MatchParameters &parameters,
                                   osrm::engine::api::ResultT &result) const
@@ -140,6 +205,11 @@ Status MatchPlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
         return Error("InvalidValue", "Invalid coordinate value.", result);
     }
 
+    if (!CheckRegion(parameters.coordinates))
+    {
+        return Error("InvalidValue", "Coordinates are outside of the served region.", result);
+    }
+
     if (max_radius_map_matching > 0 && std::any_of(parameters.radiuses.begin(),
                                                    parameters.radiuses.end(),
                                                    [&](const auto &radius) {
@@ -161,6 +231,11 @@ Status MatchPlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
         return Error("InvalidValue", "Timestamps need to be monotonically increasing.", result);
     }
 
+    if (!parameters.session.empty())
+    {
+        return HandleSessionRequest(algorithms, parameters, result);
+    }
+
     SubMatchingList sub_matchings;
     api::tidy::Result tidied;
     if (parameters.tidy)
@@ -183,34 +258,7 @@ Status MatchPlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
             "InvalidValue", "First and last coordinates must be specified as waypoints.", result);
     }
 
-    // assuming radius is the standard deviation of a normal distribution
-    // that models GPS noise (in this model), x3 should give us the correct
-    // search radius with > 99% confidence
-    std::vector<double> search_radiuses;
-    if (tidied.parameters.radiuses.empty())
-    {
-        search_radiuses.resize(tidied.parameters.coordinates.size(),
-                               routing_algorithms::DEFAULT_GPS_PRECISION * RADIUS_MULTIPLIER);
-    }
-    else
-    {
-        search_radiuses.resize(tidied.parameters.coordinates.size());
-        std::transform(tidied.parameters.radiuses.begin(),
-                       tidied.parameters.radiuses.end(),
-                       search_radiuses.begin(),
-                       [](const boost::optional<double> &maybe_radius) {
-                           if (maybe_radius)
-                           {
-                               return *maybe_radius * RADIUS_MULTIPLIER;
-                           }
-                           else
-                           {
-                               return routing_algorithms::DEFAULT_GPS_PRECISION * RADIUS_MULTIPLIER;
-                           }
-
-                       });
-    }
-
+    const auto search_radiuses = getSearchRadiuses(tidied.parameters);
     auto candidates_lists =
         GetPhantomNodesInRange(facade, tidied.parameters, search_radiuses, true);
 
@@ -265,29 +313,9 @@ Status MatchPlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
     BOOST_ASSERT(parameters.waypoints.empty() || sub_matchings.size() == 1);
     const auto collapse_legs = !parameters.waypoints.empty();
 
-    // each sub_route will correspond to a MatchObject
-    std::vector<InternalRouteResult> sub_routes(sub_matchings.size());
+    auto sub_routes = getSubRoutes(algorithms, sub_matchings);
     for (auto index : util::irange<std::size_t>(0UL, sub_matchings.size()))
     {
-        BOOST_ASSERT(sub_matchings[index].nodes.size() > 1);
-
-        // FIXME we only run this to obtain the geometry
-        // The clean way would be to get this directly from the map matching plugin
-        PhantomNodes current_phantom_node_pair;
-        for (unsigned i = 0; i < sub_matchings[index].nodes.size() - 1; ++i)
-        {
-            current_phantom_node_pair.source_phantom = sub_matchings[index].nodes[i];
-            current_phantom_node_pair.target_phantom = sub_matchings[index].nodes[i + 1];
-            BOOST_ASSERT(current_phantom_node_pair.source_phantom.IsValid());
-            BOOST_ASSERT(current_phantom_node_pair.target_phantom.IsValid());
-            sub_routes[index].segment_end_coordinates.emplace_back(current_phantom_node_pair);
-        }
-        // force uturns to be on
-        // we split the phantom nodes anyway and only have bi-directional phantom nodes for
-        // possible uturns
-        sub_routes[index] =
-            algorithms.ShortestPathSearch(sub_routes[index].segment_end_coordinates, {false});
-        BOOST_ASSERT(sub_routes[index].shortest_path_weight != INVALID_EDGE_WEIGHT);
         if (collapse_legs)
         {
             std::vector<bool> waypoint_legs;
@@ -314,6 +342,176 @@ Status MatchPlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
 
     return Status::Ok;
 }
+std::shared_ptr<MatchPlugin::Session> MatchPlugin::GetSession(const std::string &id) const
+{
+    const auto now = std::chrono::steady_clock::now();
+    const auto timeout = std::chrono::seconds(SESSION_TIMEOUT_SECONDS);
+
+    std::lock_guard<std::mutex> lock(sessions_mutex);
+
+    const auto position = session_index.find(id);
+    if (position != session_index.end())
+    {
+        sessions.splice(sessions.begin(), sessions, position->second);
+    }
+    else
+    {
+        sessions.push_front(SessionEntry{id, std::make_shared<Session>(), now});
+        session_index.emplace(id, sessions.begin());
+    }
+    sessions.front().last_access = now;
+
+    // sessions of devices that stopped sending samples are the least recently used ones
+    while (!sessions.empty() &&
+           (sessions.size() > MAX_SESSIONS || now - sessions.back().last_access > timeout))
+    {
+        session_index.erase(sessions.back().id);
+        sessions.pop_back();
+    }
+
+    return sessions.front().session;
+}
+
+void MatchPlugin::RemoveSession(const std::string &id) const
+{
+    std::lock_guard<std::mutex> lock(sessions_mutex);
+    const auto position = session_index.find(id);
+    if (position != session_index.end())
+    {
+        sessions.erase(position->second);
+        session_index.erase(position);
+    }
+}
+
+// Matches the samples of a request against the state of an online session. Only the parts of the
+// trace that can not change anymore are returned, their tracepoints are numbered from the start of
+// the session on.
+Status MatchPlugin::HandleSessionRequest(const RoutingAlgorithmsInterface &algorithms,
+                                         const api::MatchParameters &parameters,
+                                         osrm::engine::api::ResultT &result) const
+{
+    if (parameters.tidy)
+    {
+        return Error("InvalidValue", "Sessions can not be combined with tidy.", result);
+    }
+    if (!parameters.waypoints.empty())
+    {
+        return Error("InvalidValue", "Sessions can not be combined with waypoints.", result);
+    }
+    if (result.is<flatbuffers::FlatBufferBuilder>())
+    {
+        return Error("NotImplemented", "Sessions are only supported for JSON responses.", result);
+    }
+
+    const auto &facade = algorithms.GetFacade();
+
+    const auto session = GetSession(parameters.session);
+    std::lock_guard<std::mutex> lock(session->mutex);
+
+    const bool has_timestamps = !parameters.timestamps.empty();
+    // if the dataset was replaced the candidates of the kept samples are not valid anymore
+    if (!session->state || session->state->data_checksum != facade.GetCheckSum() ||
+        session->state->data_timestamp != facade.GetTimestamp())
+    {
+        session->state = std::make_unique<map_matching::MatchingSession>();
+        session->state->data_checksum = facade.GetCheckSum();
+        session->state->data_timestamp = facade.GetTimestamp();
+        session->state->use_timestamps = has_timestamps;
+    }
+    auto &state = *session->state;
+
+    if (state.use_timestamps != has_timestamps)
+    {
+        return Error("InvalidValue",
+                     "Timestamps need to be given for all or none of the requests of a session.",
+                     result);
+    }
+    if (has_timestamps && !state.trace_timestamps.empty() &&
+        parameters.timestamps.front() < state.trace_timestamps.back())
+    {
+        return Error("InvalidValue", "Timestamps need to be monotonically increasing.", result);
+    }
+
+    const auto search_radiuses = getSearchRadiuses(parameters);
+    auto candidates_lists = GetPhantomNodesInRange(facade, parameters, search_radiuses, true);
+
+    // the previous sample of the session is needed to detect a u-turn at the first new one
+    if (!state.trace_coordinates.empty())
+    {
+        std::vector<util::Coordinate> coordinates;
+        coordinates.reserve(parameters.coordinates.size() + 1);
+        coordinates.push_back(state.trace_coordinates.back());
+        coordinates.insert(
+            coordinates.end(), parameters.coordinates.begin(), parameters.coordinates.end());
+        candidates_lists.insert(candidates_lists.begin(), std::vector<PhantomNodeWithDistance>{});
+        filterCandidates(coordinates, candidates_lists);
+        candidates_lists.erase(candidates_lists.begin());
+    }
+    else
+    {
+        filterCandidates(parameters.coordinates, candidates_lists);
+    }
+
+    // a session can not grow without limit, the trace is cut if it did not converge until then
+    const bool finish = parameters.end_session ||
+                        (max_locations_map_matching > 0 &&
+                         static_cast<int>(state.NumberOfPendingSamples() +
+                                          parameters.coordinates.size()) >
+                             max_locations_map_matching);
+
+    auto sub_matchings =
+        algorithms.OnlineMapMatching(state,
+                                     candidates_lists,
+                                     parameters.coordinates,
+                                     parameters.timestamps,
+                                     parameters.radiuses,
+                                     parameters.gaps == api::MatchParameters::GapsType::Split,
+                                     finish);
+
+    // tracepoints of this response cover all samples from the first to the last matched one
+    std::size_t first_index = state.first_sample;
+    std::size_t end_index = state.first_sample;
+    if (!sub_matchings.empty())
+    {
+        first_index = sub_matchings.front().indices.front();
+        end_index = sub_matchings.back().indices.back() + 1;
+    }
+
+    api::MatchParameters response_parameters = parameters;
+    response_parameters.coordinates.assign(end_index - first_index, util::Coordinate{});
+    response_parameters.hints.clear();
+    response_parameters.bearings.clear();
+    response_parameters.radiuses.clear();
+    response_parameters.approaches.clear();
+    response_parameters.timestamps.clear();
+    for (auto &sub_matching : sub_matchings)
+    {
+        for (const auto i : util::irange<std::size_t>(0UL, sub_matching.indices.size()))
+        {
+            sub_matching.indices[i] -= first_index;
+            response_parameters.coordinates[sub_matching.indices[i]] =
+                sub_matching.nodes[i].input_location;
+        }
+    }
+
+    const auto sub_routes = getSubRoutes(algorithms, sub_matchings);
+    const auto tidied = api::tidy::keep_all(response_parameters);
+    api::MatchAPI match_api{facade, response_parameters, tidied};
+    match_api.MakeResponse(sub_matchings, sub_routes, result);
+
+    util::json::Object session_info;
+    session_info.values["id"] = parameters.session;
+    session_info.values["tracepoints_offset"] = static_cast<double>(first_index);
+    session_info.values["pending"] = static_cast<double>(state.NumberOfPendingSamples());
+    result.get<util::json::Object>().values["session"] = std::move(session_info);
+
+    if (parameters.end_session)
+    {
+        RemoveSession(parameters.session);
+    }
+
+    return Status::Ok;
+}
 }
 }
 }
@@ -17,7 +17,10 @@ namespace engine
 namespace plugins
 {
 
-NearestPlugin::NearestPlugin(const int max_results_) : max_results{max_results_} {}
+NearestPlugin::NearestPlugin(const int max_results_, const util::RectangleInt2D &region)
+    : BasePlugin(region), max_results{max_results_}
+{
+}
 
 Status NearestPlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
                                     const api::NearestParameters &params,
@@ -42,6 +45,9 @@ Status NearestPlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms
     if (!CheckAllCoordinates(params.coordinates))
         return Error("InvalidOptions", "Coordinates are invalid", result);
 
+    if (!CheckRegion(params.coordinates))
+        return Error("InvalidValue", "Coordinates are outside of the served region.", result);
+
     if (params.coordinates.size() != 1)
     {
         return Error("InvalidOptions", "Only one input coordinate is supported", result);
@@ -24,8 +24,9 @@ namespace engine
 namespace plugins
 {
 
-TablePlugin::TablePlugin(const int max_locations_distance_table)
-    : max_locations_distance_table(max_locations_distance_table)
+TablePlugin::TablePlugin(const int max_locations_distance_table,
+                         const util::RectangleInt2D &region)
+    : BasePlugin(region), max_locations_distance_table(max_locations_distance_table)
 {
 }
 
@@ -47,6 +48,11 @@ Status TablePlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
         return Error("InvalidOptions", "Coordinates are invalid", result);
     }
 
+    if (!CheckRegion(params.coordinates))
+    {
+        return Error("InvalidValue", "Coordinates are outside of the served region.", result);
+    }
+
     if (params.bearings.size() > 0 && params.coordinates.size() != params.bearings.size())
     {
         return Error(
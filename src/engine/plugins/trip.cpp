@@ -2,15 +2,15 @@
 
 #include "engine/api/trip_api.hpp"
 #include "engine/api/trip_parameters.hpp"
-#include "engine/trip/trip_brute_force.hpp"
-#include "engine/trip/trip_farthest_insertion.hpp"
-#include "engine/trip/trip_nearest_neighbour.hpp"
+#include "engine/trip/trip_held_karp.hpp"
+#include "engine/trip/trip_local_search.hpp"
 #include "util/dist_table_wrapper.hpp" // to access the dist table more easily
 #include "util/json_container.hpp"
 
 #include <boost/assert.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <iterator>
 #include <limits>
@@ -191,6 +191,11 @@ Status TripPlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
         return Error("InvalidValue", "Invalid coordinate value.", result);
     }
 
+    if (!CheckRegion(parameters.coordinates))
+    {
+        return Error("InvalidValue", "Coordinates are outside of the served region.", result);
+    }
+
     if (!CheckAlgorithms(parameters, algorithms, result))
         return Status::Error;
 
@@ -225,7 +230,9 @@ Status TripPlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
         return Status::Error;
     }
 
-    const constexpr std::size_t BF_MAX_FEASABLE = 10;
+    // Held-Karp needs ~7ms and 2MB for 16 locations, but grows by a factor of ~4 per location
+    const constexpr std::size_t HK_MAX_FEASABLE = 16;
+    const constexpr std::chrono::milliseconds LOCAL_SEARCH_TIME_BUDGET{100};
     BOOST_ASSERT_MSG(result_duration_table.size() == number_of_locations * number_of_locations,
                      "Distance Table has wrong size");
 
@@ -242,13 +249,14 @@ Status TripPlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
     std::vector<NodeID> duration_trip;
     duration_trip.reserve(number_of_locations);
     // get an optimized order in which the destinations should be visited
-    if (number_of_locations < BF_MAX_FEASABLE)
+    if (number_of_locations <= HK_MAX_FEASABLE)
     {
-        duration_trip = trip::BruteForceTrip(number_of_locations, result_duration_table);
+        duration_trip = trip::HeldKarpTrip(number_of_locations, result_duration_table);
     }
     else
     {
-        duration_trip = trip::FarthestInsertionTrip(number_of_locations, result_duration_table);
+        duration_trip = trip::LocalSearchTrip(
+            number_of_locations, result_duration_table, LOCAL_SEARCH_TIME_BUDGET);
     }
 
     // rotate result such that roundtrip starts at node with index 0
@@ -21,8 +21,12 @@ namespace engine
 namespace plugins
 {
 
-ViaRoutePlugin::ViaRoutePlugin(int max_locations_viaroute, int max_alternatives)
-    : max_locations_viaroute(max_locations_viaroute), max_alternatives(max_alternatives)
+ViaRoutePlugin::ViaRoutePlugin(int max_locations_viaroute,
+                               int max_alternatives,
+                               std::chrono::milliseconds alternatives_time_budget,
+                               const util::RectangleInt2D &region)
+    : BasePlugin(region), max_locations_viaroute(max_locations_viaroute),
+      max_alternatives(max_alternatives), alternatives_time_budget(alternatives_time_budget)
 {
 }
 
@@ -48,6 +52,13 @@ Status ViaRoutePlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithm
             result);
     }
 
+    if (route_parameters.eta_only && !algorithms.HasShortestPathSearch())
+    {
+        return Error("NotImplemented",
+                     "Routes without geometry are not implemented for the chosen search algorithm.",
+                     result);
+    }
+
     if (max_locations_viaroute > 0 &&
         (static_cast<int>(route_parameters.coordinates.size()) > max_locations_viaroute))
     {
@@ -73,6 +84,11 @@ Status ViaRoutePlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithm
         return Error("InvalidValue", "Invalid coordinate value.", result);
     }
 
+    if (!CheckRegion(route_parameters.coordinates))
+    {
+        return Error("InvalidValue", "Coordinates are outside of the served region.", result);
+    }
+
     // Error: first and last points should be waypoints
     if (!route_parameters.waypoints.empty() &&
         (route_parameters.waypoints[0] != 0 ||
@@ -107,6 +123,59 @@ Status ViaRoutePlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithm
 
     api::RouteAPI route_api{facade, route_parameters};
 
+    std::vector<bool> waypoint_legs;
+    if (!route_parameters.waypoints.empty())
+    {
+        waypoint_legs.resize(route_parameters.coordinates.size(), false);
+        std::for_each(route_parameters.waypoints.begin(),
+                      route_parameters.waypoints.end(),
+                      [&](const std::size_t waypoint_index) {
+                          BOOST_ASSERT(waypoint_index < waypoint_legs.size());
+                          waypoint_legs[waypoint_index] = true;
+                      });
+        // First and last coordinates should always be waypoints
+        // This gets validated earlier, but double-checking here, jic
+        BOOST_ASSERT(waypoint_legs.front());
+        BOOST_ASSERT(waypoint_legs.back());
+    }
+
+    const auto no_route = [&]() {
+        auto first_component_id = snapped_phantoms.front().component.id;
+        auto not_in_same_component = std::any_of(snapped_phantoms.begin(),
+                                                 snapped_phantoms.end(),
+                                                 [first_component_id](const PhantomNode &node) {
+                                                     return node.component.id != first_component_id;
+                                                 });
+
+        if (not_in_same_component)
+        {
+            return Error("NoRoute", "Impossible route between points", result);
+        }
+        else
+        {
+            return Error("NoRoute", "No route found between points", result);
+        }
+    };
+
+    // Only durations and distances are requested: the packed path of the route is summed up
+    // without unpacking it or looking up any geometry, names or turns.
+    if (route_parameters.eta_only)
+    {
+        auto summary =
+            algorithms.ShortestPathSummary(start_end_nodes, route_parameters.continue_straight);
+        if (!summary.is_valid())
+        {
+            return no_route();
+        }
+
+        if (!waypoint_legs.empty())
+        {
+            summary = CollapseInternalRouteSummary(summary, waypoint_legs);
+        }
+        route_api.MakeResponse(summary, start_end_nodes, result);
+        return Status::Ok;
+    }
+
     InternalManyRoutesResult routes;
 
     // TODO: in v6 we should remove the boolean and only keep the number parameter.
@@ -121,7 +190,8 @@ Status ViaRoutePlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithm
     // https://github.com/Project-OSRM/osrm-backend/issues/3905
     if (1 == start_end_nodes.size() && algorithms.HasAlternativePathSearch() && wants_alternatives)
     {
-        routes = algorithms.AlternativePathSearch(start_end_nodes.front(), number_of_alternatives);
+        routes = algorithms.AlternativePathSearch(
+            start_end_nodes.front(), number_of_alternatives, alternatives_time_budget);
     }
     else if (1 == start_end_nodes.size() && algorithms.HasDirectShortestPathSearch())
     {
@@ -141,20 +211,8 @@ Status ViaRoutePlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithm
 
     if (routes.routes[0].is_valid())
     {
-        auto collapse_legs = !route_parameters.waypoints.empty();
-        if (collapse_legs)
+        if (!waypoint_legs.empty())
         {
-            std::vector<bool> waypoint_legs(route_parameters.coordinates.size(), false);
-            std::for_each(route_parameters.waypoints.begin(),
-                          route_parameters.waypoints.end(),
-                          [&](const std::size_t waypoint_index) {
-                              BOOST_ASSERT(waypoint_index < waypoint_legs.size());
-                              waypoint_legs[waypoint_index] = true;
-                          });
-            // First and last coordinates should always be waypoints
-            // This gets validated earlier, but double-checking here, jic
-            BOOST_ASSERT(waypoint_legs.front());
-            BOOST_ASSERT(waypoint_legs.back());
             for (std::size_t i = 0; i < routes.routes.size(); i++)
             {
                 routes.routes[i] = CollapseInternalRouteResult(routes.routes[i], waypoint_legs);
@@ -165,21 +223,7 @@ Status ViaRoutePlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithm
     }
     else
     {
-        auto first_component_id = snapped_phantoms.front().component.id;
-        auto not_in_same_component = std::any_of(snapped_phantoms.begin(),
-                                                 snapped_phantoms.end(),
-                                                 [first_component_id](const PhantomNode &node) {
-                                                     return node.component.id != first_component_id;
-                                                 });
-
-        if (not_in_same_component)
-        {
-            return Error("NoRoute", "Impossible route between points", result);
-        }
-        else
-        {
-            return Error("NoRoute", "No route found between points", result);
-        }
+        return no_route();
     }
 
     return Status::Ok;
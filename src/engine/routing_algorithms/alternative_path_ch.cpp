@@ -563,7 +563,8 @@ bool viaNodeCandidatePassesTTest(SearchEngineData<Algorithm> &engine_working_dat
 InternalManyRoutesResult alternativePathSearch(SearchEngineData<Algorithm> &engine_working_data,
                                                const DataFacade<Algorithm> &facade,
                                                const PhantomNodes &phantom_node_pair,
-                                               unsigned /*number_of_alternatives*/)
+                                               unsigned /*number_of_alternatives*/,
+                                               std::chrono::milliseconds /*time_budget*/)
 {
     InternalRouteResult primary_route;
     InternalRouteResult secondary_route;
@@ -1,13 +1,19 @@
 #include "engine/routing_algorithms/alternative_path.hpp"
 #include "engine/routing_algorithms/routing_base_mld.hpp"
 
+#include "util/log.hpp"
+#include "util/parallel_remove_if.hpp"
 #include "util/static_assert.hpp"
 
 #include <boost/assert.hpp>
+#include <boost/optional.hpp>
 
 #include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <iterator>
 #include <memory>
+#include <sstream>
 #include <type_traits>
 #include <unordered_set>
 #include <utility>
@@ -15,6 +21,10 @@
 
 #include <boost/function_output_iterator.hpp>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
 namespace osrm
 {
 namespace engine
@@ -34,6 +44,8 @@ using Facade = DataFacade<Algorithm>;
 namespace
 {
 
+AlternativeFilterCounters filter_counters;
+
 struct Parameters
 {
     // Alternative paths candidate via nodes are taken from overlapping search spaces.
@@ -338,6 +350,7 @@ RandIt filterPackedPathsByCellSharing(RandIt first,
 
 // Filters packed paths based on local optimality. Mutates range in-place.
 // Returns an iterator to the filtered range's new end.
+// Note: the paths are checked in parallel, the heaps are only read.
 template <typename RandIt>
 RandIt filterPackedPathsByLocalOptimality(const WeightedViaNodePackedPath &path,
                                           const Heap &forward_heap,
@@ -446,7 +459,7 @@ RandIt filterPackedPathsByLocalOptimality(const WeightedViaNodePackedPath &path,
         return plateaux_length < parameters.kAtLeastOptimalAroundViaBy * detour_length;
     };
 
-    return std::remove_if(first, last, is_not_locally_optimal);
+    return util::parallel_remove_if(first, last, is_not_locally_optimal);
 }
 
 // Filters unpacked paths compared to all other paths. Mutates range in-place.
@@ -539,115 +552,155 @@ RandIt filterAnnotatedRoutesByStretch(RandIt first,
     return std::remove_if(first, last, over_duration_limit);
 }
 
-// Unpacks a range of WeightedViaNodePackedPaths into a range of WeightedViaNodeUnpackedPaths.
+// Unpacks a WeightedViaNodePackedPath into a WeightedViaNodeUnpackedPath.
 // Note: destroys search engine heaps for recursive unpacking. Extract heap data you need before.
-template <typename InputIt, typename OutIt>
-void unpackPackedPaths(InputIt first,
-                       InputIt last,
-                       OutIt out,
-                       SearchEngineData<Algorithm> &search_engine_data,
-                       const Facade &facade,
-                       const PhantomNodes &phantom_node_pair)
+WeightedViaNodeUnpackedPath unpackPackedPath(const WeightedViaNodePackedPath &weighted_packed_path,
+                                             SearchEngineData<Algorithm> &search_engine_data,
+                                             const Facade &facade,
+                                             const PhantomNodes &phantom_node_pair)
 {
-    util::static_assert_iter_category<InputIt, std::input_iterator_tag>();
-    util::static_assert_iter_category<OutIt, std::output_iterator_tag>();
-    util::static_assert_iter_value<InputIt, WeightedViaNodePackedPath>();
-
     const Partition &partition = facade.GetMultiLevelPartition();
 
     Heap &forward_heap = *search_engine_data.forward_heap_1;
     Heap &reverse_heap = *search_engine_data.reverse_heap_1;
 
-    for (auto it = first; it != last; ++it, ++out)
-    {
-        const auto packed_path_weight = it->via.weight;
-        const auto packed_path_via = it->via.node;
+    const auto packed_path_weight = weighted_packed_path.via.weight;
+    const auto packed_path_via = weighted_packed_path.via.node;
 
-        const auto &packed_path = it->path;
+    const auto &packed_path = weighted_packed_path.path;
 
-        //
-        // Todo: dup. code with mld::search except for level entry: we run a slight mld::search
-        //       adaption here and then dispatch to mld::search for recursively descending down.
-        //
+    //
+    // Todo: dup. code with mld::search except for level entry: we run a slight mld::search
+    //       adaption here and then dispatch to mld::search for recursively descending down.
+    //
 
-        std::vector<NodeID> unpacked_nodes;
-        std::vector<EdgeID> unpacked_edges;
-        unpacked_nodes.reserve(packed_path.size());
-        unpacked_edges.reserve(packed_path.size());
+    std::vector<NodeID> unpacked_nodes;
+    std::vector<EdgeID> unpacked_edges;
+    unpacked_nodes.reserve(packed_path.size());
+    unpacked_edges.reserve(packed_path.size());
 
-        // Beware the edge case when start, via, end are all the same.
-        // In this case we return a single node, no edges. We also don't unpack.
-        if (packed_path.empty())
-        {
-            const auto source_node = packed_path_via;
-            unpacked_nodes.push_back(source_node);
+    // Beware the edge case when start, via, end are all the same.
+    // In this case we return a single node, no edges. We also don't unpack.
+    if (packed_path.empty())
+    {
+        const auto source_node = packed_path_via;
+        unpacked_nodes.push_back(source_node);
+    }
+    else
+    {
+        const auto source_node = std::get<0>(packed_path.front());
+        unpacked_nodes.push_back(source_node);
+    }
+
+    for (auto const &packed_edge : packed_path)
+    {
+        NodeID source, target;
+        bool overlay_edge;
+        std::tie(source, target, overlay_edge) = packed_edge;
+        if (!overlay_edge)
+        { // a base graph edge
+            unpacked_nodes.push_back(target);
+            unpacked_edges.push_back(facade.FindEdge(source, target));
         }
         else
-        {
-            const auto source_node = std::get<0>(packed_path.front());
-            unpacked_nodes.push_back(source_node);
+        { // an overlay graph edge
+            LevelID level = getNodeQueryLevel(partition, source, phantom_node_pair); // XXX
+            CellID parent_cell_id = partition.GetCell(level, source);
+            BOOST_ASSERT(parent_cell_id == partition.GetCell(level, target));
+
+            LevelID sublevel = level - 1;
+
+            // Here heaps can be reused, let's go deeper!
+            forward_heap.Clear();
+            reverse_heap.Clear();
+            forward_heap.Insert(source, 0, {source});
+            reverse_heap.Insert(target, 0, {target});
+
+            BOOST_ASSERT(!facade.ExcludeNode(source));
+            BOOST_ASSERT(!facade.ExcludeNode(target));
+
+            // TODO: when structured bindings will be allowed change to
+            // auto [subpath_weight, subpath_source, subpath_target, subpath] = ...
+            EdgeWeight subpath_weight;
+            std::vector<NodeID> subpath_nodes;
+            std::vector<EdgeID> subpath_edges;
+            std::tie(subpath_weight, subpath_nodes, subpath_edges) = search(search_engine_data,
+                                                                            facade,
+                                                                            forward_heap,
+                                                                            reverse_heap,
+                                                                            DO_NOT_FORCE_LOOPS,
+                                                                            DO_NOT_FORCE_LOOPS,
+                                                                            INVALID_EDGE_WEIGHT,
+                                                                            sublevel,
+                                                                            parent_cell_id);
+            BOOST_ASSERT(!subpath_edges.empty());
+            BOOST_ASSERT(subpath_nodes.size() > 1);
+            BOOST_ASSERT(subpath_nodes.front() == source);
+            BOOST_ASSERT(subpath_nodes.back() == target);
+            unpacked_nodes.insert(
+                unpacked_nodes.end(), std::next(subpath_nodes.begin()), subpath_nodes.end());
+            unpacked_edges.insert(unpacked_edges.end(), subpath_edges.begin(), subpath_edges.end());
         }
+    }
 
-        for (auto const &packed_edge : packed_path)
-        {
-            NodeID source, target;
-            bool overlay_edge;
-            std::tie(source, target, overlay_edge) = packed_edge;
-            if (!overlay_edge)
-            { // a base graph edge
-                unpacked_nodes.push_back(target);
-                unpacked_edges.push_back(facade.FindEdge(source, target));
-            }
-            else
-            { // an overlay graph edge
-                LevelID level = getNodeQueryLevel(partition, source, phantom_node_pair); // XXX
-                CellID parent_cell_id = partition.GetCell(level, source);
-                BOOST_ASSERT(parent_cell_id == partition.GetCell(level, target));
-
-                LevelID sublevel = level - 1;
-
-                // Here heaps can be reused, let's go deeper!
-                forward_heap.Clear();
-                reverse_heap.Clear();
-                forward_heap.Insert(source, 0, {source});
-                reverse_heap.Insert(target, 0, {target});
-
-                BOOST_ASSERT(!facade.ExcludeNode(source));
-                BOOST_ASSERT(!facade.ExcludeNode(target));
-
-                // TODO: when structured bindings will be allowed change to
-                // auto [subpath_weight, subpath_source, subpath_target, subpath] = ...
-                EdgeWeight subpath_weight;
-                std::vector<NodeID> subpath_nodes;
-                std::vector<EdgeID> subpath_edges;
-                std::tie(subpath_weight, subpath_nodes, subpath_edges) = search(search_engine_data,
-                                                                                facade,
-                                                                                forward_heap,
-                                                                                reverse_heap,
-                                                                                DO_NOT_FORCE_LOOPS,
-                                                                                DO_NOT_FORCE_LOOPS,
-                                                                                INVALID_EDGE_WEIGHT,
-                                                                                sublevel,
-                                                                                parent_cell_id);
-                BOOST_ASSERT(!subpath_edges.empty());
-                BOOST_ASSERT(subpath_nodes.size() > 1);
-                BOOST_ASSERT(subpath_nodes.front() == source);
-                BOOST_ASSERT(subpath_nodes.back() == target);
-                unpacked_nodes.insert(
-                    unpacked_nodes.end(), std::next(subpath_nodes.begin()), subpath_nodes.end());
-                unpacked_edges.insert(
-                    unpacked_edges.end(), subpath_edges.begin(), subpath_edges.end());
-            }
-        }
+    return WeightedViaNodeUnpackedPath{0.0,
+                                       WeightedViaNode{packed_path_via, packed_path_weight},
+                                       std::move(unpacked_nodes),
+                                       std::move(unpacked_edges)};
+}
 
-        WeightedViaNodeUnpackedPath unpacked_path{
-            0.0,
-            WeightedViaNode{packed_path_via, packed_path_weight},
-            std::move(unpacked_nodes),
-            std::move(unpacked_edges)};
+// Unpacks a range of WeightedViaNodePackedPaths into WeightedViaNodeUnpackedPaths in parallel,
+// every thread uses its own search engine heaps. Paths that were not started before the deadline
+// (if any) are skipped, except for the first one. Keeps the order of the paths.
+// Note: destroys the search engine heaps of the calling thread as well.
+template <typename RandIt>
+std::vector<WeightedViaNodeUnpackedPath>
+unpackPackedPaths(RandIt first,
+                  RandIt last,
+                  const Facade &facade,
+                  const PhantomNodes &phantom_node_pair,
+                  const boost::optional<std::chrono::steady_clock::time_point> deadline)
+{
+    util::static_assert_iter_category<RandIt, std::random_access_iterator_tag>();
+    util::static_assert_iter_value<RandIt, WeightedViaNodePackedPath>();
 
-        out = std::move(unpacked_path);
+    const auto size = static_cast<std::size_t>(std::distance(first, last));
+    std::vector<WeightedViaNodeUnpackedPath> unpacked_paths(size);
+    std::vector<std::uint8_t> unpacked(size, false);
+
+    // Isolated: a waiting thread must not steal an unrelated query that clears its heaps.
+    tbb::this_task_arena::isolate([&] {
+        tbb::parallel_for(
+            tbb::blocked_range<std::size_t>(0, size, 1),
+            [&](const tbb::blocked_range<std::size_t> &range) {
+                SearchEngineData<Algorithm> search_engine_data;
+                for (auto index = range.begin(); index != range.end(); ++index)
+                {
+                    if (index > 0 && deadline && std::chrono::steady_clock::now() > *deadline)
+                        continue;
+
+                    search_engine_data.InitializeOrClearFirstThreadLocalStorage(
+                        facade.GetNumberOfNodes(), facade.GetMaxBorderNodeID() + 1);
+                    unpacked_paths[index] = unpackPackedPath(
+                        *(first + index), search_engine_data, facade, phantom_node_pair);
+                    unpacked[index] = true;
+                }
+            });
+    });
+
+    std::size_t number_of_unpacked_paths = 0;
+    for (std::size_t index = 0; index < size; ++index)
+    {
+        if (unpacked[index])
+        {
+            if (number_of_unpacked_paths != index)
+                unpacked_paths[number_of_unpacked_paths] = std::move(unpacked_paths[index]);
+            ++number_of_unpacked_paths;
+        }
     }
+    unpacked_paths.resize(number_of_unpacked_paths);
+
+    return unpacked_paths;
 }
 
 // Generates via candidate nodes from the overlap of the two search spaces from s and t.
@@ -773,7 +826,8 @@ makeCandidateVias(SearchEngineData<Algorithm> &search_engine_data,
 InternalManyRoutesResult alternativePathSearch(SearchEngineData<Algorithm> &search_engine_data,
                                                const Facade &facade,
                                                const PhantomNodes &phantom_node_pair,
-                                               unsigned number_of_alternatives)
+                                               unsigned number_of_alternatives,
+                                               std::chrono::milliseconds unpacking_time_budget)
 {
     Parameters parameters = parametersFromRequest(phantom_node_pair);
 
@@ -826,9 +880,27 @@ InternalManyRoutesResult alternativePathSearch(SearchEngineData<Algorithm> &sear
     // from the vector when we can mutate in-place and for filtering adjust iterators.
     auto it = end(candidate_vias);
 
-    it = filterViaCandidatesByUniqueNodeIds(begin(candidate_vias), it);
-    it = filterViaCandidatesByRoadImportance(begin(candidate_vias), it, facade);
-    it = filterViaCandidatesByStretch(begin(candidate_vias), it, shortest_path_weight, parameters);
+    // counts the candidates a filter stage rejected, in total and for this request
+    std::ostringstream rejected;
+    const auto count_rejected = [&](const char *stage,
+                                    std::atomic<std::uint64_t> &counter,
+                                    const std::uint64_t number) {
+        counter += number;
+        rejected << " " << stage << "=" << number;
+    };
+    const auto count = [&](const char *stage, auto &counter, auto before, auto after) {
+        count_rejected(stage, counter, std::distance(after, before));
+    };
+    ++filter_counters.searches;
+    filter_counters.candidates += candidate_vias.size();
+
+    auto filtered = filterViaCandidatesByUniqueNodeIds(begin(candidate_vias), it);
+    count("unique_node", filter_counters.by_unique_node, it, filtered);
+    it = filterViaCandidatesByRoadImportance(begin(candidate_vias), filtered, facade);
+    filtered =
+        filterViaCandidatesByStretch(begin(candidate_vias), it, shortest_path_weight, parameters);
+    count("stretch", filter_counters.by_stretch, it, filtered);
+    it = filtered;
 
     // Pre-rank by weight; sharing filtering below then discards by similarity.
     std::sort(begin(candidate_vias), it, [](const auto lhs, const auto rhs) {
@@ -859,6 +931,7 @@ InternalManyRoutesResult alternativePathSearch(SearchEngineData<Algorithm> &sear
 
     const auto last_filtered = filterViaCandidatesByViaNotOnPath(
         weighted_packed_paths[0], candidate_vias_first + 1, candidate_vias_last);
+    count("via_on_path", filter_counters.by_via_on_path, candidate_vias_last, last_filtered);
 
     // Store all alternative packed paths (if there are any).
     auto into = std::back_inserter(weighted_packed_paths);
@@ -868,14 +941,23 @@ InternalManyRoutesResult alternativePathSearch(SearchEngineData<Algorithm> &sear
 
     auto alternative_paths_last = end(weighted_packed_paths);
 
-    alternative_paths_last = filterPackedPathsByLocalOptimality(weighted_packed_paths[0],
-                                                                forward_heap, // paths for s, via
-                                                                reverse_heap, // paths for via, t
-                                                                begin(weighted_packed_paths) + 1,
-                                                                alternative_paths_last,
-                                                                parameters);
+    auto filtered_paths_last =
+        filterPackedPathsByLocalOptimality(weighted_packed_paths[0],
+                                           forward_heap, // paths for s, via
+                                           reverse_heap, // paths for via, t
+                                           begin(weighted_packed_paths) + 1,
+                                           alternative_paths_last,
+                                           parameters);
+    count("local_optimality",
+          filter_counters.by_local_optimality,
+          alternative_paths_last,
+          filtered_paths_last);
     alternative_paths_last = filterPackedPathsByCellSharing(
-        begin(weighted_packed_paths), alternative_paths_last, partition, parameters);
+        begin(weighted_packed_paths), filtered_paths_last, partition, parameters);
+    count("cell_sharing",
+          filter_counters.by_cell_sharing,
+          filtered_paths_last,
+          alternative_paths_last);
 
     BOOST_ASSERT(weighted_packed_paths.size() >= 1);
 
@@ -886,17 +968,23 @@ InternalManyRoutesResult alternativePathSearch(SearchEngineData<Algorithm> &sear
     const auto paths_first = begin(weighted_packed_paths);
     const auto paths_last = begin(weighted_packed_paths) + 1 + number_of_filtered_alternative_paths;
     const auto number_of_packed_paths = paths_last - paths_first;
+    count("unpacking_limit",
+          filter_counters.by_unpacking_limit,
+          alternative_paths_last,
+          paths_last);
 
-    std::vector<WeightedViaNodeUnpackedPath> unpacked_paths;
-    unpacked_paths.reserve(number_of_packed_paths);
+    // Candidates that are not unpacked when the budget runs out are dropped and the alternatives
+    // found so far are returned. The shortest path is always unpacked. Zero means unlimited.
+    boost::optional<std::chrono::steady_clock::time_point> deadline;
+    if (unpacking_time_budget.count() > 0)
+        deadline = std::chrono::steady_clock::now() + unpacking_time_budget;
 
     // Note: re-uses (read: destroys) heaps; we don't need them from here on anyway.
-    unpackPackedPaths(paths_first,
-                      paths_last,
-                      std::back_inserter(unpacked_paths),
-                      search_engine_data,
-                      facade,
-                      phantom_node_pair);
+    auto unpacked_paths =
+        unpackPackedPaths(paths_first, paths_last, facade, phantom_node_pair, deadline);
+    count_rejected("time_budget",
+                   filter_counters.by_time_budget,
+                   number_of_packed_paths - unpacked_paths.size());
 
     //
     // Filter and rank a second time. This time instead of being fast and doing
@@ -907,12 +995,17 @@ InternalManyRoutesResult alternativePathSearch(SearchEngineData<Algorithm> &sear
 
     unpacked_paths_last = filterUnpackedPathsBySharing(
         begin(unpacked_paths), end(unpacked_paths), facade, parameters);
+    count("sharing", filter_counters.by_sharing, end(unpacked_paths), unpacked_paths_last);
 
     const auto unpacked_paths_first = begin(unpacked_paths);
     const auto number_of_unpacked_paths =
         std::min(static_cast<std::size_t>(max_number_of_alternatives) + 1,
                  static_cast<std::size_t>(unpacked_paths_last - unpacked_paths_first));
     BOOST_ASSERT(number_of_unpacked_paths >= 1);
+    count("number_of_alternatives",
+          filter_counters.by_number_of_alternatives,
+          unpacked_paths_last,
+          unpacked_paths_first + number_of_unpacked_paths);
     unpacked_paths_last = unpacked_paths_first + number_of_unpacked_paths;
 
     //
@@ -943,13 +1036,20 @@ InternalManyRoutesResult alternativePathSearch(SearchEngineData<Algorithm> &sear
         parameters.kAtMostLongerBy = getLongerByFactorBasedOnDuration(routes_first->duration());
         routes_last = filterAnnotatedRoutesByStretch(
             routes_first + 1, routes_last, *routes_first, parameters);
+        count("annotated_stretch", filter_counters.by_annotated_stretch, end(routes), routes_last);
         routes.erase(routes_last, end(routes));
     }
 
     BOOST_ASSERT(routes.size() >= 1);
+    util::Log(logDEBUG) << "Alternatives: " << number_of_candidate_vias << " via candidates, "
+                        << number_of_packed_paths << " packed paths, " << unpacked_paths.size()
+                        << " unpacked paths, " << routes.size() << " routes, rejected:"
+                        << rejected.str();
     return InternalManyRoutesResult{std::move(routes)};
 }
 
+const AlternativeFilterCounters &getAlternativeFilterCounters() { return filter_counters; }
+
 } // namespace routing_algorithms
 } // namespace engine
 } // namespace osrm
@@ -66,8 +66,8 @@ void relaxOutgoingEdges(const DataFacade<Algorithm> &facade,
             const NodeID to = facade.GetTarget(edge);
             const auto edge_weight = data.weight;
 
-            const auto edge_duration = data.duration;
-            const auto edge_distance = data.distance;
+            const auto edge_duration = facade.GetEdgeDuration(edge);
+            const auto edge_distance = facade.GetEdgeDistance(edge);
 
             BOOST_ASSERT_MSG(edge_weight > 0, "edge_weight invalid");
             const auto to_weight = weight + edge_weight;
@@ -185,7 +185,8 @@ manyToManySearch(SearchEngineData<ch::Algorithm> &engine_working_data,
                  const std::vector<PhantomNode> &phantom_nodes,
                  const std::vector<std::size_t> &source_indices,
                  const std::vector<std::size_t> &target_indices,
-                 const bool calculate_distance)
+                 const bool calculate_distance,
+                 const EdgeWeight weight_upper_bound)
 {
     const auto number_of_sources = source_indices.size();
     const auto number_of_targets = target_indices.size();
@@ -199,6 +200,10 @@ manyToManySearch(SearchEngineData<ch::Algorithm> &engine_working_data,
 
     std::vector<NodeBucket> search_space_with_buckets;
 
+    // Backward searches start with non-negative weights, but a path can begin with a negative
+    // source offset that has to be taken into account when pruning them
+    const auto min_source_weight = getMinimalSourceWeight(phantom_nodes, source_indices);
+
     // Populate buckets with paths from all accessible nodes to destinations via backward searches
     for (std::uint32_t column_index = 0; column_index < target_indices.size(); ++column_index)
     {
@@ -211,7 +216,8 @@ manyToManySearch(SearchEngineData<ch::Algorithm> &engine_working_data,
         insertTargetInHeap(query_heap, phantom);
 
         // Explore search space
-        while (!query_heap.Empty())
+        while (!query_heap.Empty() &&
+               query_heap.MinKey() + min_source_weight <= weight_upper_bound)
         {
             backwardRoutingStep(
                 facade, column_index, query_heap, search_space_with_buckets, phantom);
@@ -234,7 +240,7 @@ manyToManySearch(SearchEngineData<ch::Algorithm> &engine_working_data,
         insertSourceInHeap(query_heap, source_phantom);
 
         // Explore search space
-        while (!query_heap.Empty())
+        while (!query_heap.Empty() && query_heap.MinKey() <= weight_upper_bound)
         {
             forwardRoutingStep(facade,
                                row_index,
@@ -249,6 +255,12 @@ manyToManySearch(SearchEngineData<ch::Algorithm> &engine_working_data,
         }
     }
 
+    if (weight_upper_bound != INVALID_EDGE_WEIGHT)
+    {
+        invalidateAboveUpperBound(
+            weights_table, durations_table, distances_table, weight_upper_bound);
+    }
+
     return std::make_pair(durations_table, distances_table);
 }
 
@@ -194,7 +194,8 @@ oneToManySearch(SearchEngineData<Algorithm> &engine_working_data,
                 const std::vector<PhantomNode> &phantom_nodes,
                 std::size_t phantom_index,
                 const std::vector<std::size_t> &phantom_indices,
-                const bool calculate_distance)
+                const bool calculate_distance,
+                const EdgeWeight weight_upper_bound)
 {
     std::vector<EdgeWeight> weights(phantom_indices.size(), INVALID_EDGE_WEIGHT);
     std::vector<EdgeDuration> durations(phantom_indices.size(), MAXIMAL_EDGE_DURATION);
@@ -372,7 +373,12 @@ oneToManySearch(SearchEngineData<Algorithm> &engine_working_data,
         }
     }
 
-    while (!query_heap.Empty() && !target_nodes_index.empty())
+    // Reverse searches start from the targets and reach sources with negative offsets
+    const auto min_target_weight =
+        DIRECTION == FORWARD_DIRECTION ? 0 : getMinimalSourceWeight(phantom_nodes, phantom_indices);
+
+    while (!query_heap.Empty() && !target_nodes_index.empty() &&
+           query_heap.MinKey() + min_target_weight <= weight_upper_bound)
     {
         // Extract node from the heap
         const auto node = query_heap.DeleteMin();
@@ -395,6 +401,11 @@ oneToManySearch(SearchEngineData<Algorithm> &engine_working_data,
                                       phantom_indices);
     }
 
+    if (weight_upper_bound != INVALID_EDGE_WEIGHT)
+    {
+        invalidateAboveUpperBound(weights, durations, distances_table, weight_upper_bound);
+    }
+
     return std::make_pair(durations, distances_table);
 }
 
@@ -538,7 +549,8 @@ manyToManySearch(SearchEngineData<Algorithm> &engine_working_data,
                  const std::vector<PhantomNode> &phantom_nodes,
                  const std::vector<std::size_t> &source_indices,
                  const std::vector<std::size_t> &target_indices,
-                 const bool calculate_distance)
+                 const bool calculate_distance,
+                 const EdgeWeight weight_upper_bound)
 {
     const auto number_of_sources = source_indices.size();
     const auto number_of_targets = target_indices.size();
@@ -552,6 +564,13 @@ manyToManySearch(SearchEngineData<Algorithm> &engine_working_data,
 
     std::vector<NodeBucket> search_space_with_buckets;
 
+    // Only searches from the targets can reach sources with negative offsets,
+    // for the reversed graph these are the searches that fill the buckets
+    const auto min_source_weight = getMinimalSourceWeight(
+        phantom_nodes, DIRECTION == FORWARD_DIRECTION ? source_indices : target_indices);
+    const auto min_backward_weight = DIRECTION == FORWARD_DIRECTION ? min_source_weight : 0;
+    const auto min_forward_weight = DIRECTION == FORWARD_DIRECTION ? 0 : min_source_weight;
+
     // Populate buckets with paths from all accessible nodes to destinations via backward searches
     for (std::uint32_t column_idx = 0; column_idx < target_indices.size(); ++column_idx)
     {
@@ -568,7 +587,8 @@ manyToManySearch(SearchEngineData<Algorithm> &engine_working_data,
             insertSourceInHeap(query_heap, target_phantom);
 
         // explore search space
-        while (!query_heap.Empty())
+        while (!query_heap.Empty() &&
+               query_heap.MinKey() + min_backward_weight <= weight_upper_bound)
         {
             backwardRoutingStep<DIRECTION>(
                 facade, column_idx, query_heap, search_space_with_buckets, target_phantom);
@@ -596,7 +616,8 @@ manyToManySearch(SearchEngineData<Algorithm> &engine_working_data,
             insertTargetInHeap(query_heap, source_phantom);
 
         // Explore search space
-        while (!query_heap.Empty())
+        while (!query_heap.Empty() &&
+               query_heap.MinKey() + min_forward_weight <= weight_upper_bound)
         {
             forwardRoutingStep<DIRECTION>(facade,
                                           row_idx,
@@ -612,6 +633,12 @@ manyToManySearch(SearchEngineData<Algorithm> &engine_working_data,
         }
     }
 
+    if (weight_upper_bound != INVALID_EDGE_WEIGHT)
+    {
+        invalidateAboveUpperBound(
+            weights_table, durations_table, distances_table, weight_upper_bound);
+    }
+
     return std::make_pair(durations_table, distances_table);
 }
 
@@ -636,7 +663,8 @@ manyToManySearch(SearchEngineData<mld::Algorithm> &engine_working_data,
                  const std::vector<PhantomNode> &phantom_nodes,
                  const std::vector<std::size_t> &source_indices,
                  const std::vector<std::size_t> &target_indices,
-                 const bool calculate_distance)
+                 const bool calculate_distance,
+                 const EdgeWeight weight_upper_bound)
 {
     if (source_indices.size() == 1)
     { // TODO: check if target_indices.size() == 1 and do a bi-directional search
@@ -645,7 +673,8 @@ manyToManySearch(SearchEngineData<mld::Algorithm> &engine_working_data,
                                                        phantom_nodes,
                                                        source_indices.front(),
                                                        target_indices,
-                                                       calculate_distance);
+                                                       calculate_distance,
+                                                       weight_upper_bound);
     }
 
     if (target_indices.size() == 1)
@@ -655,7 +684,8 @@ manyToManySearch(SearchEngineData<mld::Algorithm> &engine_working_data,
                                                        phantom_nodes,
                                                        target_indices.front(),
                                                        source_indices,
-                                                       calculate_distance);
+                                                       calculate_distance,
+                                                       weight_upper_bound);
     }
 
     if (target_indices.size() < source_indices.size())
@@ -665,7 +695,8 @@ manyToManySearch(SearchEngineData<mld::Algorithm> &engine_working_data,
                                                         phantom_nodes,
                                                         target_indices,
                                                         source_indices,
-                                                        calculate_distance);
+                                                        calculate_distance,
+                                                        weight_upper_bound);
     }
 
     return mld::manyToManySearch<FORWARD_DIRECTION>(engine_working_data,
@@ -673,7 +704,8 @@ manyToManySearch(SearchEngineData<mld::Algorithm> &engine_working_data,
                                                     phantom_nodes,
                                                     source_indices,
                                                     target_indices,
-                                                    calculate_distance);
+                                                    calculate_distance,
+                                                    weight_upper_bound);
 }
 
 } // namespace routing_algorithms
@@ -1,18 +1,23 @@
 #include "engine/routing_algorithms/map_matching.hpp"
+#include "engine/routing_algorithms/many_to_many.hpp"
 #include "engine/routing_algorithms/routing_base_ch.hpp"
 #include "engine/routing_algorithms/routing_base_mld.hpp"
 
 #include "engine/map_matching/hidden_markov_model.hpp"
 #include "engine/map_matching/matching_confidence.hpp"
+#include "engine/map_matching/matching_session.hpp"
 #include "engine/map_matching/sub_matching.hpp"
 
 #include "util/coordinate_calculation.hpp"
 #include "util/for_each_pair.hpp"
 
+#include <boost/thread/tss.hpp>
+
 #include <algorithm>
 #include <cstddef>
 #include <deque>
 #include <iomanip>
+#include <limits>
 #include <memory>
 #include <numeric>
 #include <utility>
@@ -31,6 +36,11 @@ using HMM = map_matching::HiddenMarkovModel<CandidateLists>;
 constexpr static const unsigned MAX_BROKEN_STATES = 10;
 constexpr static const double MATCHING_BETA = 10;
 constexpr static const double MAX_DISTANCE_DELTA = 2000.;
+// number of sample times an online session uses to estimate the median sample time
+constexpr static const std::size_t MAX_SESSION_SAMPLE_TIMES = 2 * MAX_BROKEN_STATES;
+
+// the states of a trace are kept in flat arrays that are reused by all requests of a thread
+boost::thread_specific_ptr<map_matching::HiddenMarkovModelStorage> model_storage;
 
 unsigned getMedianSampleTime(const std::vector<unsigned> &timestamps)
 {
@@ -47,23 +57,471 @@ unsigned getMedianSampleTime(const std::vector<unsigned> &timestamps)
     return *median;
 }
 
+std::vector<double>
+getEmissionLogProbabilities(const CandidateList &candidates,
+                            const map_matching::EmissionLogProbability &emission_log_probability)
+{
+    std::vector<double> emission_log_probabilities(candidates.size());
+    std::transform(candidates.begin(),
+                   candidates.end(),
+                   emission_log_probabilities.begin(),
+                   [&emission_log_probability](const PhantomNodeWithDistance &candidate) {
+                       return emission_log_probability(candidate.distance);
+                   });
+    return emission_log_probabilities;
+}
+
+// Phantom nodes of the transition searches, kept to reuse their memory between timestamps
+struct TransitionPhantomNodes
+{
+    std::vector<PhantomNode> phantom_nodes;
+    std::vector<std::size_t> sources;
+    std::vector<std::size_t> targets;
+};
+
+// Computes the transitions from the previous unbroken timestamp to timestamp t and maintains the
+// stack of unbroken timestamps. Returns true if there is a gap in the trace before t.
 template <typename Algorithm>
-inline void initializeHeap(SearchEngineData<Algorithm> &engine_working_data,
-                           const DataFacade<Algorithm> &facade)
+bool viterbiStep(SearchEngineData<Algorithm> &engine_working_data,
+                 const DataFacade<Algorithm> &facade,
+                 HMM &model,
+                 const CandidateLists &candidates_list,
+                 const std::vector<std::vector<double>> &emission_log_probabilities,
+                 const std::vector<util::Coordinate> &trace_coordinates,
+                 const std::vector<unsigned> &trace_timestamps,
+                 const bool use_timestamps,
+                 const bool allow_splitting,
+                 const unsigned max_broken_time,
+                 const std::size_t t,
+                 std::vector<std::size_t> &prev_unbroken_timestamps,
+                 std::size_t &breakage_begin,
+                 TransitionPhantomNodes &transition_phantom_nodes)
 {
+    const map_matching::TransitionLogProbability transition_log_probability(MATCHING_BETA);
+
+    const auto step_time = [&] {
+        if (use_timestamps)
+        {
+            return trace_timestamps[t] - trace_timestamps[prev_unbroken_timestamps.back()];
+        }
+        else
+        {
+            return 1u;
+        }
+    }();
+
+    const auto max_distance_delta = [&] {
+        if (use_timestamps)
+        {
+            return step_time * facade.GetMapMatchingMaxSpeed();
+        }
+        else
+        {
+            return MAX_DISTANCE_DELTA;
+        }
+    }();
+
+    const bool gap_in_trace = [&]() {
+        // use temporal information if available to determine a split
+        // but do not determine split by timestamps if wasn't asked about it
+        if (use_timestamps && allow_splitting)
+        {
+            return step_time > max_broken_time;
+        }
+        else
+        {
+            return t - prev_unbroken_timestamps.back() > MAX_BROKEN_STATES;
+        }
+    }();
+
+    if (gap_in_trace)
+    {
+        return true;
+    }
+
+    BOOST_ASSERT(!prev_unbroken_timestamps.empty());
+    const std::size_t prev_unbroken_timestamp = prev_unbroken_timestamps.back();
+
+    const auto prev_viterbi = model.viterbi[prev_unbroken_timestamp];
+    const auto prev_pruned = model.pruned[prev_unbroken_timestamp];
+    const auto &prev_unbroken_timestamps_list = candidates_list[prev_unbroken_timestamp];
+    const auto &prev_coordinate = trace_coordinates[prev_unbroken_timestamp];
+
+    auto current_viterbi = model.viterbi[t];
+    auto current_pruned = model.pruned[t];
+    auto current_parents = model.parents[t];
+    auto current_lengths = model.path_distances[t];
+    const auto &current_timestamps_list = candidates_list[t];
+    const auto &current_coordinate = trace_coordinates[t];
+
+    const auto haversine_distance =
+        util::coordinate_calculation::haversineDistance(prev_coordinate, current_coordinate);
+    // assumes minumum of 4 m/s
+    const EdgeWeight weight_upper_bound =
+        ((haversine_distance + max_distance_delta) / 4.) * facade.GetWeightMultiplier();
+
+    // Network distances from all unpruned candidates of the previous timestamp to all
+    // candidates of this one. A single bounded search per candidate settles all of its
+    // transitions instead of running a point-to-point query for every pair.
+    transition_phantom_nodes.phantom_nodes.clear();
+    transition_phantom_nodes.sources.clear();
+    transition_phantom_nodes.targets.clear();
+    for (const auto s : util::irange<std::size_t>(0UL, prev_viterbi.size()))
+    {
+        if (!prev_pruned[s])
+        {
+            transition_phantom_nodes.sources.push_back(
+                transition_phantom_nodes.phantom_nodes.size());
+            transition_phantom_nodes.phantom_nodes.push_back(
+                prev_unbroken_timestamps_list[s].phantom_node);
+        }
+    }
+    for (const auto &candidate : current_timestamps_list)
+    {
+        transition_phantom_nodes.targets.push_back(transition_phantom_nodes.phantom_nodes.size());
+        transition_phantom_nodes.phantom_nodes.push_back(candidate.phantom_node);
+    }
+
+    std::vector<EdgeDistance> network_distances;
+    if (!transition_phantom_nodes.sources.empty())
+    {
+        network_distances = manyToManySearch(engine_working_data,
+                                             facade,
+                                             transition_phantom_nodes.phantom_nodes,
+                                             transition_phantom_nodes.sources,
+                                             transition_phantom_nodes.targets,
+                                             true,
+                                             weight_upper_bound)
+                                .second;
+    }
+
+    // compute d_t for this timestamp and the next one
+    std::size_t row = 0;
+    for (const auto s : util::irange<std::size_t>(0UL, prev_viterbi.size()))
+    {
+        if (prev_pruned[s])
+        {
+            continue;
+        }
+        const auto row_offset = row++ * current_viterbi.size();
+
+        for (const auto s_prime : util::irange<std::size_t>(0UL, current_viterbi.size()))
+        {
+            const double emission_pr = emission_log_probabilities[t][s_prime];
+            double new_value = prev_viterbi[s] + emission_pr;
+            if (current_viterbi[s_prime] > new_value)
+            {
+                continue;
+            }
+
+            const auto path_distance = network_distances[row_offset + s_prime];
+            const double network_distance = path_distance == MAXIMAL_EDGE_DISTANCE
+                                                ? std::numeric_limits<double>::max()
+                                                : path_distance;
+
+            // get distance diff between loc1/2 and locs/s_prime
+            const auto d_t = std::abs(network_distance - haversine_distance);
+
+            // very low probability transition -> prune
+            if (d_t >= max_distance_delta)
+            {
+                continue;
+            }
+
+            const double transition_pr = transition_log_probability(d_t);
+            new_value += transition_pr;
+
+            if (new_value > current_viterbi[s_prime])
+            {
+                current_viterbi[s_prime] = new_value;
+                current_parents[s_prime] = std::make_pair(prev_unbroken_timestamp, s);
+                current_lengths[s_prime] = network_distance;
+                current_pruned[s_prime] = false;
+                model.breakage[t] = false;
+            }
+        }
+    }
+
+    if (model.breakage[t])
+    {
+        // save start of breakage -> we need this as split point
+        if (t < breakage_begin)
+        {
+            breakage_begin = t;
+        }
+
+        BOOST_ASSERT(prev_unbroken_timestamps.size() > 0);
+        // remove both ends of the breakage
+        prev_unbroken_timestamps.pop_back();
+    }
+    else
+    {
+        prev_unbroken_timestamps.push_back(t);
+    }
 
-    const auto nodes_number = facade.GetNumberOfNodes();
-    engine_working_data.InitializeOrClearFirstThreadLocalStorage(nodes_number);
+    return false;
 }
 
-template <>
-inline void initializeHeap<mld::Algorithm>(SearchEngineData<mld::Algorithm> &engine_working_data,
-                                           const DataFacade<mld::Algorithm> &facade)
+// Reconstructs the most likely path between sub_matching_begin and sub_matching_end. It ends in
+// the given state of the last unbroken timestamp or in the most likely one if none is given.
+// Returns false if the path consists of less than two samples.
+bool reconstructSubMatching(HMM &model,
+                            const CandidateLists &candidates_list,
+                            const std::vector<util::Coordinate> &trace_coordinates,
+                            std::size_t sub_matching_begin,
+                            const std::size_t sub_matching_end,
+                            const std::size_t last_state,
+                            const std::size_t index_offset,
+                            map_matching::SubMatching &matching)
 {
+    map_matching::MatchingConfidence confidence;
+
+    std::size_t parent_timestamp_index = sub_matching_end - 1;
+    while (parent_timestamp_index >= sub_matching_begin && model.breakage[parent_timestamp_index])
+    {
+        --parent_timestamp_index;
+    }
+    while (sub_matching_begin < sub_matching_end && model.breakage[sub_matching_begin])
+    {
+        ++sub_matching_begin;
+    }
+    const auto sub_matching_last_timestamp = parent_timestamp_index;
+
+    // matchings that only consist of one candidate are invalid
+    if (parent_timestamp_index - sub_matching_begin + 1 < 2)
+    {
+        return false;
+    }
+
+    std::size_t parent_candidate_index = last_state;
+    if (parent_candidate_index == map_matching::INVALID_STATE)
+    {
+        // loop through the columns, and only compare the last entry
+        const auto max_element_iter =
+            std::max_element(model.viterbi[parent_timestamp_index].begin(),
+                             model.viterbi[parent_timestamp_index].end());
+
+        parent_candidate_index =
+            std::distance(model.viterbi[parent_timestamp_index].begin(), max_element_iter);
+    }
+
+    std::deque<std::pair<std::size_t, std::size_t>> reconstructed_indices;
+    while (parent_timestamp_index > sub_matching_begin)
+    {
+        reconstructed_indices.emplace_front(parent_timestamp_index, parent_candidate_index);
+        model.viterbi_reachable[parent_timestamp_index][parent_candidate_index] = true;
+        const auto &next = model.parents[parent_timestamp_index][parent_candidate_index];
+        // make sure we can never get stuck in this loop
+        if (parent_timestamp_index == next.first)
+        {
+            break;
+        }
+        parent_timestamp_index = next.first;
+        parent_candidate_index = next.second;
+    }
+    reconstructed_indices.emplace_front(parent_timestamp_index, parent_candidate_index);
+    model.viterbi_reachable[parent_timestamp_index][parent_candidate_index] = true;
+    if (reconstructed_indices.size() < 2)
+    {
+        return false;
+    }
+
+    // fill viterbi reachability matrix
+    for (const auto s_last :
+         util::irange<std::size_t>(0UL, model.viterbi[sub_matching_last_timestamp].size()))
+    {
+        parent_timestamp_index = sub_matching_last_timestamp;
+        parent_candidate_index = s_last;
+        while (parent_timestamp_index > sub_matching_begin)
+        {
+            if (model.viterbi_reachable[parent_timestamp_index][parent_candidate_index] ||
+                model.pruned[parent_timestamp_index][parent_candidate_index])
+            {
+                break;
+            }
+            model.viterbi_reachable[parent_timestamp_index][parent_candidate_index] = true;
+            const auto &next = model.parents[parent_timestamp_index][parent_candidate_index];
+            parent_timestamp_index = next.first;
+            parent_candidate_index = next.second;
+        }
+        model.viterbi_reachable[parent_timestamp_index][parent_candidate_index] = true;
+    }
+
+    auto matching_distance = 0.0;
+    auto trace_distance = 0.0;
+    matching.nodes.reserve(reconstructed_indices.size());
+    matching.indices.reserve(reconstructed_indices.size());
+    for (const auto &idx : reconstructed_indices)
+    {
+        const auto timestamp_index = idx.first;
+        const auto location_index = idx.second;
+
+        matching.indices.push_back(timestamp_index + index_offset);
+        matching.nodes.push_back(candidates_list[timestamp_index][location_index].phantom_node);
+        auto const routes_count = std::accumulate(model.viterbi_reachable[timestamp_index].begin(),
+                                                  model.viterbi_reachable[timestamp_index].end(),
+                                                  0);
+        BOOST_ASSERT(routes_count > 0);
+        // we don't count the current route in the "alternatives_count" parameter
+        matching.alternatives_count.push_back(routes_count - 1);
+        matching_distance += model.path_distances[timestamp_index][location_index];
+    }
+    util::for_each_pair(
+        reconstructed_indices,
+        [&trace_distance, &trace_coordinates](const std::pair<std::size_t, std::size_t> &prev,
+                                              const std::pair<std::size_t, std::size_t> &curr) {
+            trace_distance += util::coordinate_calculation::haversineDistance(
+                trace_coordinates[prev.first], trace_coordinates[curr.first]);
+        });
+
+    matching.confidence = confidence(trace_distance, matching_distance);
+
+    return true;
+}
+
+// Finds the latest state that all unpruned states of the given timestamp descend from
+std::pair<std::size_t, std::size_t>
+findConvergedState(const HMM &model, const std::size_t timestamp, const std::size_t first_timestamp)
+{
+    std::vector<std::size_t> states;
+    for (const auto s : util::irange<std::size_t>(0UL, model.pruned[timestamp].size()))
+    {
+        if (!model.pruned[timestamp][s])
+        {
+            states.push_back(s);
+        }
+    }
+
+    auto current_timestamp = timestamp;
+    while (states.size() > 1)
+    {
+        // all transitions into a timestamp start at the same previous timestamp
+        const auto parent_timestamp = model.parents[current_timestamp][states.front()].first;
+        if (parent_timestamp == current_timestamp || parent_timestamp < first_timestamp)
+        {
+            return {map_matching::INVALID_STATE, map_matching::INVALID_STATE};
+        }
+
+        for (auto &state : states)
+        {
+            BOOST_ASSERT(model.parents[current_timestamp][state].first == parent_timestamp);
+            state = model.parents[current_timestamp][state].second;
+        }
+        std::sort(states.begin(), states.end());
+        states.erase(std::unique(states.begin(), states.end()), states.end());
+        current_timestamp = parent_timestamp;
+    }
+
+    if (states.empty())
+    {
+        return {map_matching::INVALID_STATE, map_matching::INVALID_STATE};
+    }
+
+    return {current_timestamp, states.front()};
+}
+
+// Drops all samples before the given one from the session
+void trimSession(map_matching::MatchingSession &session, const std::size_t number_of_samples)
+{
+    if (number_of_samples == 0)
+    {
+        return;
+    }
+
+    session.model.Trim(number_of_samples);
+
+    const auto trim_front = [number_of_samples](auto &values) {
+        values.erase(values.begin(),
+                     values.begin() + std::min(number_of_samples, values.size()));
+    };
+    trim_front(session.candidates_list);
+    trim_front(session.emission_log_probabilities);
+    trim_front(session.trace_coordinates);
+    trim_front(session.trace_timestamps);
+
+    const auto shift = [number_of_samples](const std::size_t index) {
+        return index >= number_of_samples ? index - number_of_samples : map_matching::INVALID_STATE;
+    };
+
+    session.first_sample += number_of_samples;
+    session.next_timestamp -= number_of_samples;
+    session.sub_matching_begin =
+        std::max(session.sub_matching_begin, number_of_samples) - number_of_samples;
+    if (session.breakage_begin != map_matching::INVALID_STATE)
+    {
+        session.breakage_begin = shift(session.breakage_begin);
+    }
+    if (session.finalized != map_matching::INVALID_STATE)
+    {
+        session.finalized = shift(session.finalized);
+    }
+    for (auto &timestamp : session.prev_unbroken_timestamps)
+    {
+        BOOST_ASSERT(timestamp >= number_of_samples);
+        timestamp -= number_of_samples;
+    }
+}
+
+// Commits to the given state: all states of later samples that do not descend from it are
+// pruned, so the path up to it stays the same whatever samples follow.
+void finalizeState(map_matching::MatchingSession &session,
+                   const std::size_t timestamp,
+                   const std::size_t state)
+{
+    auto &model = session.model;
+
+    for (const auto s : util::irange<std::size_t>(0UL, model.viterbi[timestamp].size()))
+    {
+        if (s != state)
+        {
+            model.viterbi[timestamp][s] = map_matching::IMPOSSIBLE_LOG_PROB;
+            model.pruned[timestamp][s] = true;
+        }
+    }
+
+    for (const auto t : util::irange<std::size_t>(timestamp + 1, session.next_timestamp))
+    {
+        if (model.breakage[t])
+        {
+            continue;
+        }
+
+        bool reachable = false;
+        for (const auto s : util::irange<std::size_t>(0UL, model.viterbi[t].size()))
+        {
+            if (model.pruned[t][s])
+            {
+                continue;
+            }
 
-    const auto nodes_number = facade.GetNumberOfNodes();
-    const auto border_nodes_number = facade.GetMaxBorderNodeID() + 1;
-    engine_working_data.InitializeOrClearFirstThreadLocalStorage(nodes_number, border_nodes_number);
+            const auto &parent = model.parents[t][s];
+            if (parent.first < timestamp || parent.first == t ||
+                model.pruned[parent.first][parent.second])
+            {
+                model.viterbi[t][s] = map_matching::IMPOSSIBLE_LOG_PROB;
+                model.pruned[t][s] = true;
+            }
+            else
+            {
+                reachable = true;
+            }
+        }
+        model.breakage[t] = !reachable;
+    }
+
+    auto &prev_unbroken_timestamps = session.prev_unbroken_timestamps;
+    prev_unbroken_timestamps.erase(std::remove_if(prev_unbroken_timestamps.begin(),
+                                                  prev_unbroken_timestamps.end(),
+                                                  [&](const std::size_t t) {
+                                                      return t < timestamp || model.breakage[t];
+                                                  }),
+                                   prev_unbroken_timestamps.end());
+
+    session.finalized = timestamp;
+    if (session.breakage_begin != map_matching::INVALID_STATE && session.breakage_begin < timestamp)
+    {
+        session.breakage_begin = map_matching::INVALID_STATE;
+    }
 }
 }
 
@@ -76,9 +534,7 @@ SubMatchingList mapMatching(SearchEngineData<Algorithm> &engine_working_data,
                             const std::vector<boost::optional<double>> &trace_gps_precision,
                             const bool allow_splitting)
 {
-    map_matching::MatchingConfidence confidence;
     map_matching::EmissionLogProbability default_emission_log_probability(DEFAULT_GPS_PRECISION);
-    map_matching::TransitionLogProbability transition_log_probability(MATCHING_BETA);
 
     SubMatchingList sub_matchings;
 
@@ -100,49 +556,25 @@ SubMatchingList mapMatching(SearchEngineData<Algorithm> &engine_working_data,
     const auto max_broken_time = median_sample_time * MAX_BROKEN_STATES;
 
     std::vector<std::vector<double>> emission_log_probabilities(trace_coordinates.size());
-    if (trace_gps_precision.empty())
+    for (auto t = 0UL; t < candidates_list.size(); ++t)
     {
-        for (auto t = 0UL; t < candidates_list.size(); ++t)
+        if (!trace_gps_precision.empty() && trace_gps_precision[t])
         {
-            emission_log_probabilities[t].resize(candidates_list[t].size());
-            std::transform(candidates_list[t].begin(),
-                           candidates_list[t].end(),
-                           emission_log_probabilities[t].begin(),
-                           [&](const PhantomNodeWithDistance &candidate) {
-                               return default_emission_log_probability(candidate.distance);
-                           });
+            emission_log_probabilities[t] = getEmissionLogProbabilities(
+                candidates_list[t], map_matching::EmissionLogProbability(*trace_gps_precision[t]));
         }
-    }
-    else
-    {
-        for (auto t = 0UL; t < candidates_list.size(); ++t)
+        else
         {
-            emission_log_probabilities[t].resize(candidates_list[t].size());
-            if (trace_gps_precision[t])
-            {
-                map_matching::EmissionLogProbability emission_log_probability(
-                    *trace_gps_precision[t]);
-                std::transform(
-                    candidates_list[t].begin(),
-                    candidates_list[t].end(),
-                    emission_log_probabilities[t].begin(),
-                    [&emission_log_probability](const PhantomNodeWithDistance &candidate) {
-                        return emission_log_probability(candidate.distance);
-                    });
-            }
-            else
-            {
-                std::transform(candidates_list[t].begin(),
-                               candidates_list[t].end(),
-                               emission_log_probabilities[t].begin(),
-                               [&](const PhantomNodeWithDistance &candidate) {
-                                   return default_emission_log_probability(candidate.distance);
-                               });
-            }
+            emission_log_probabilities[t] =
+                getEmissionLogProbabilities(candidates_list[t], default_emission_log_probability);
         }
     }
 
-    HMM model(candidates_list, emission_log_probabilities);
+    if (!model_storage.get())
+    {
+        model_storage.reset(new map_matching::HiddenMarkovModelStorage());
+    }
+    HMM model(candidates_list, emission_log_probabilities, *model_storage);
 
     std::size_t initial_timestamp = model.initialize(0);
     if (initial_timestamp == map_matching::INVALID_STATE)
@@ -150,9 +582,7 @@ SubMatchingList mapMatching(SearchEngineData<Algorithm> &engine_working_data,
         return sub_matchings;
     }
 
-    initializeHeap(engine_working_data, facade);
-    auto &forward_heap = *engine_working_data.forward_heap_1;
-    auto &reverse_heap = *engine_working_data.reverse_heap_1;
+    TransitionPhantomNodes transition_phantom_nodes;
 
     std::size_t breakage_begin = map_matching::INVALID_STATE;
     std::vector<std::size_t> split_points;
@@ -161,131 +591,20 @@ SubMatchingList mapMatching(SearchEngineData<Algorithm> &engine_working_data,
     prev_unbroken_timestamps.push_back(initial_timestamp);
     for (auto t = initial_timestamp + 1; t < candidates_list.size(); ++t)
     {
-
-        const auto step_time = [&] {
-            if (use_timestamps)
-            {
-                return trace_timestamps[t] - trace_timestamps[prev_unbroken_timestamps.back()];
-            }
-            else
-            {
-                return 1u;
-            }
-        }();
-
-        const auto max_distance_delta = [&] {
-            if (use_timestamps)
-            {
-                return step_time * facade.GetMapMatchingMaxSpeed();
-            }
-            else
-            {
-                return MAX_DISTANCE_DELTA;
-            }
-        }();
-
-        const bool gap_in_trace = [&]() {
-            // use temporal information if available to determine a split
-            // but do not determine split by timestamps if wasn't asked about it
-            if (use_timestamps && allow_splitting)
-            {
-                return step_time > max_broken_time;
-            }
-            else
-            {
-                return t - prev_unbroken_timestamps.back() > MAX_BROKEN_STATES;
-            }
-        }();
-
-        if (!gap_in_trace)
-        {
-            BOOST_ASSERT(!prev_unbroken_timestamps.empty());
-            const std::size_t prev_unbroken_timestamp = prev_unbroken_timestamps.back();
-
-            const auto &prev_viterbi = model.viterbi[prev_unbroken_timestamp];
-            const auto &prev_pruned = model.pruned[prev_unbroken_timestamp];
-            const auto &prev_unbroken_timestamps_list = candidates_list[prev_unbroken_timestamp];
-            const auto &prev_coordinate = trace_coordinates[prev_unbroken_timestamp];
-
-            auto &current_viterbi = model.viterbi[t];
-            auto &current_pruned = model.pruned[t];
-            auto &current_parents = model.parents[t];
-            auto &current_lengths = model.path_distances[t];
-            const auto &current_timestamps_list = candidates_list[t];
-            const auto &current_coordinate = trace_coordinates[t];
-
-            const auto haversine_distance = util::coordinate_calculation::haversineDistance(
-                prev_coordinate, current_coordinate);
-            // assumes minumum of 4 m/s
-            const EdgeWeight weight_upper_bound =
-                ((haversine_distance + max_distance_delta) / 4.) * facade.GetWeightMultiplier();
-
-            // compute d_t for this timestamp and the next one
-            for (const auto s : util::irange<std::size_t>(0UL, prev_viterbi.size()))
-            {
-                if (prev_pruned[s])
-                {
-                    continue;
-                }
-
-                for (const auto s_prime : util::irange<std::size_t>(0UL, current_viterbi.size()))
-                {
-                    const double emission_pr = emission_log_probabilities[t][s_prime];
-                    double new_value = prev_viterbi[s] + emission_pr;
-                    if (current_viterbi[s_prime] > new_value)
-                    {
-                        continue;
-                    }
-
-                    double network_distance =
-                        getNetworkDistance(engine_working_data,
-                                           facade,
-                                           forward_heap,
-                                           reverse_heap,
-                                           prev_unbroken_timestamps_list[s].phantom_node,
-                                           current_timestamps_list[s_prime].phantom_node,
-                                           weight_upper_bound);
-
-                    // get distance diff between loc1/2 and locs/s_prime
-                    const auto d_t = std::abs(network_distance - haversine_distance);
-
-                    // very low probability transition -> prune
-                    if (d_t >= max_distance_delta)
-                    {
-                        continue;
-                    }
-
-                    const double transition_pr = transition_log_probability(d_t);
-                    new_value += transition_pr;
-
-                    if (new_value > current_viterbi[s_prime])
-                    {
-                        current_viterbi[s_prime] = new_value;
-                        current_parents[s_prime] = std::make_pair(prev_unbroken_timestamp, s);
-                        current_lengths[s_prime] = network_distance;
-                        current_pruned[s_prime] = false;
-                        model.breakage[t] = false;
-                    }
-                }
-            }
-
-            if (model.breakage[t])
-            {
-                // save start of breakage -> we need this as split point
-                if (t < breakage_begin)
-                {
-                    breakage_begin = t;
-                }
-
-                BOOST_ASSERT(prev_unbroken_timestamps.size() > 0);
-                // remove both ends of the breakage
-                prev_unbroken_timestamps.pop_back();
-            }
-            else
-            {
-                prev_unbroken_timestamps.push_back(t);
-            }
-        }
+        const bool gap_in_trace = viterbiStep(engine_working_data,
+                                              facade,
+                                              model,
+                                              candidates_list,
+                                              emission_log_probabilities,
+                                              trace_coordinates,
+                                              trace_timestamps,
+                                              use_timestamps,
+                                              allow_splitting,
+                                              max_broken_time,
+                                              t,
+                                              prev_unbroken_timestamps,
+                                              breakage_begin,
+                                              transition_phantom_nodes);
 
         // breakage recover has removed all previous good points
         const bool trace_split = prev_unbroken_timestamps.empty();
@@ -329,109 +648,211 @@ SubMatchingList mapMatching(SearchEngineData<Algorithm> &engine_working_data,
     for (const auto sub_matching_end : split_points)
     {
         map_matching::SubMatching matching;
+        if (reconstructSubMatching(model,
+                                   candidates_list,
+                                   trace_coordinates,
+                                   sub_matching_begin,
+                                   sub_matching_end,
+                                   map_matching::INVALID_STATE,
+                                   0,
+                                   matching))
+        {
+            sub_matchings.push_back(std::move(matching));
+        }
+        sub_matching_begin = sub_matching_end;
+    }
 
-        std::size_t parent_timestamp_index = sub_matching_end - 1;
-        while (parent_timestamp_index >= sub_matching_begin &&
-               model.breakage[parent_timestamp_index])
+    return sub_matchings;
+}
+
+template <typename Algorithm>
+SubMatchingList onlineMapMatching(SearchEngineData<Algorithm> &engine_working_data,
+                                  const DataFacade<Algorithm> &facade,
+                                  map_matching::MatchingSession &session,
+                                  const CandidateLists &candidates_list,
+                                  const std::vector<util::Coordinate> &trace_coordinates,
+                                  const std::vector<unsigned> &trace_timestamps,
+                                  const std::vector<boost::optional<double>> &trace_gps_precision,
+                                  const bool allow_splitting,
+                                  const bool finish)
+{
+    map_matching::EmissionLogProbability default_emission_log_probability(DEFAULT_GPS_PRECISION);
+
+    SubMatchingList sub_matchings;
+
+    BOOST_ASSERT(candidates_list.size() == trace_coordinates.size());
+    BOOST_ASSERT(!session.use_timestamps || trace_timestamps.size() == candidates_list.size());
+
+    auto &model = session.model;
+    auto &prev_unbroken_timestamps = session.prev_unbroken_timestamps;
+
+    for (const auto index : util::irange<std::size_t>(0UL, candidates_list.size()))
+    {
+        if (session.use_timestamps)
+        {
+            if (!session.trace_timestamps.empty())
+            {
+                session.sample_times.push_back(trace_timestamps[index] -
+                                               session.trace_timestamps.back());
+                if (session.sample_times.size() > MAX_SESSION_SAMPLE_TIMES)
+                {
+                    session.sample_times.pop_front();
+                }
+            }
+            session.trace_timestamps.push_back(trace_timestamps[index]);
+        }
+
+        if (!trace_gps_precision.empty() && trace_gps_precision[index])
         {
-            --parent_timestamp_index;
+            session.emission_log_probabilities.push_back(getEmissionLogProbabilities(
+                candidates_list[index],
+                map_matching::EmissionLogProbability(*trace_gps_precision[index])));
         }
-        while (sub_matching_begin < sub_matching_end && model.breakage[sub_matching_begin])
+        else
         {
-            ++sub_matching_begin;
+            session.emission_log_probabilities.push_back(getEmissionLogProbabilities(
+                candidates_list[index], default_emission_log_probability));
         }
-        const auto sub_matching_last_timestamp = parent_timestamp_index;
+        session.candidates_list.push_back(candidates_list[index]);
+        session.trace_coordinates.push_back(trace_coordinates[index]);
+    }
+    model.Append();
 
-        // matchings that only consist of one candidate are invalid
-        if (parent_timestamp_index - sub_matching_begin + 1 < 2)
+    // the whole trace is not known, so only the latest sample times are used
+    const auto max_broken_time = [&] {
+        if (!session.use_timestamps || session.sample_times.empty())
         {
-            sub_matching_begin = sub_matching_end;
-            continue;
+            return MAX_BROKEN_STATES;
         }
+        std::vector<unsigned> sample_times(session.sample_times.begin(),
+                                           session.sample_times.end());
+        const auto median = sample_times.begin() + sample_times.size() / 2;
+        std::nth_element(sample_times.begin(), median, sample_times.end());
+        return std::max(1u, *median) * MAX_BROKEN_STATES;
+    }();
 
-        // loop through the columns, and only compare the last entry
-        const auto max_element_iter =
-            std::max_element(model.viterbi[parent_timestamp_index].begin(),
-                             model.viterbi[parent_timestamp_index].end());
+    TransitionPhantomNodes transition_phantom_nodes;
 
-        std::size_t parent_candidate_index =
-            std::distance(model.viterbi[parent_timestamp_index].begin(), max_element_iter);
+    const auto emit_sub_matching = [&](const std::size_t sub_matching_end,
+                                       const std::size_t last_state) {
+        const auto sub_matching_begin = session.finalized == map_matching::INVALID_STATE
+                                            ? session.sub_matching_begin
+                                            : session.finalized;
+        map_matching::SubMatching matching;
+        if (reconstructSubMatching(model,
+                                   session.candidates_list,
+                                   session.trace_coordinates,
+                                   sub_matching_begin,
+                                   sub_matching_end,
+                                   last_state,
+                                   session.first_sample,
+                                   matching))
+        {
+            sub_matchings.push_back(std::move(matching));
+        }
+    };
 
-        std::deque<std::pair<std::size_t, std::size_t>> reconstructed_indices;
-        while (parent_timestamp_index > sub_matching_begin)
+    while (session.next_timestamp < session.NumberOfSamples())
+    {
+        if (prev_unbroken_timestamps.empty())
         {
-            reconstructed_indices.emplace_front(parent_timestamp_index, parent_candidate_index);
-            model.viterbi_reachable[parent_timestamp_index][parent_candidate_index] = true;
-            const auto &next = model.parents[parent_timestamp_index][parent_candidate_index];
-            // make sure we can never get stuck in this loop
-            if (parent_timestamp_index == next.first)
+            const auto initial_timestamp = model.initialize(session.sub_matching_begin);
+            if (initial_timestamp == map_matching::INVALID_STATE)
             {
+                // none of the samples has candidates, start again with the next one
+                session.sub_matching_begin = session.NumberOfSamples();
+                session.next_timestamp = session.NumberOfSamples();
                 break;
             }
-            parent_timestamp_index = next.first;
-            parent_candidate_index = next.second;
-        }
-        reconstructed_indices.emplace_front(parent_timestamp_index, parent_candidate_index);
-        model.viterbi_reachable[parent_timestamp_index][parent_candidate_index] = true;
-        if (reconstructed_indices.size() < 2)
-        {
-            sub_matching_begin = sub_matching_end;
+
+            prev_unbroken_timestamps.push_back(initial_timestamp);
+            session.next_timestamp = initial_timestamp + 1;
             continue;
         }
 
-        // fill viterbi reachability matrix
-        for (const auto s_last :
-             util::irange<std::size_t>(0UL, model.viterbi[sub_matching_last_timestamp].size()))
+        const auto t = session.next_timestamp;
+        const bool gap_in_trace = viterbiStep(engine_working_data,
+                                              facade,
+                                              model,
+                                              session.candidates_list,
+                                              session.emission_log_probabilities,
+                                              session.trace_coordinates,
+                                              session.trace_timestamps,
+                                              session.use_timestamps,
+                                              allow_splitting,
+                                              max_broken_time,
+                                              t,
+                                              prev_unbroken_timestamps,
+                                              session.breakage_begin,
+                                              transition_phantom_nodes);
+
+        // breakage recover has removed all previous good points
+        const bool trace_split = prev_unbroken_timestamps.empty();
+
+        if (trace_split || gap_in_trace)
         {
-            parent_timestamp_index = sub_matching_last_timestamp;
-            parent_candidate_index = s_last;
-            while (parent_timestamp_index > sub_matching_begin)
+            std::size_t split_index = t;
+            if (session.breakage_begin != map_matching::INVALID_STATE)
             {
-                if (model.viterbi_reachable[parent_timestamp_index][parent_candidate_index] ||
-                    model.pruned[parent_timestamp_index][parent_candidate_index])
-                {
-                    break;
-                }
-                model.viterbi_reachable[parent_timestamp_index][parent_candidate_index] = true;
-                const auto &next = model.parents[parent_timestamp_index][parent_candidate_index];
-                parent_timestamp_index = next.first;
-                parent_candidate_index = next.second;
+                split_index = session.breakage_begin;
+                session.breakage_begin = map_matching::INVALID_STATE;
             }
-            model.viterbi_reachable[parent_timestamp_index][parent_candidate_index] = true;
+            // unlike the batch matching we never go back before the last finalized sample
+            if (session.finalized != map_matching::INVALID_STATE)
+            {
+                split_index = std::max(split_index, session.finalized + 1);
+            }
+
+            emit_sub_matching(split_index, map_matching::INVALID_STATE);
+
+            model.Clear(split_index);
+            prev_unbroken_timestamps.clear();
+            session.sub_matching_begin = split_index;
+            session.finalized = map_matching::INVALID_STATE;
+            session.next_timestamp = split_index;
         }
+        else
+        {
+            session.next_timestamp = t + 1;
+        }
+    }
 
-        auto matching_distance = 0.0;
-        auto trace_distance = 0.0;
-        matching.nodes.reserve(reconstructed_indices.size());
-        matching.indices.reserve(reconstructed_indices.size());
-        for (const auto &idx : reconstructed_indices)
-        {
-            const auto timestamp_index = idx.first;
-            const auto location_index = idx.second;
-
-            matching.indices.push_back(timestamp_index);
-            matching.nodes.push_back(candidates_list[timestamp_index][location_index].phantom_node);
-            auto const routes_count =
-                std::accumulate(model.viterbi_reachable[timestamp_index].begin(),
-                                model.viterbi_reachable[timestamp_index].end(),
-                                0);
-            BOOST_ASSERT(routes_count > 0);
-            // we don't count the current route in the "alternatives_count" parameter
-            matching.alternatives_count.push_back(routes_count - 1);
-            matching_distance += model.path_distances[timestamp_index][location_index];
-        }
-        util::for_each_pair(
-            reconstructed_indices,
-            [&trace_distance, &trace_coordinates](const std::pair<std::size_t, std::size_t> &prev,
-                                                  const std::pair<std::size_t, std::size_t> &curr) {
-                trace_distance += util::coordinate_calculation::haversineDistance(
-                    trace_coordinates[prev.first], trace_coordinates[curr.first]);
-            });
-
-        matching.confidence = confidence(trace_distance, matching_distance);
-
-        sub_matchings.push_back(matching);
-        sub_matching_begin = sub_matching_end;
+    if (finish)
+    {
+        if (!prev_unbroken_timestamps.empty())
+        {
+            emit_sub_matching(prev_unbroken_timestamps.back() + 1, map_matching::INVALID_STATE);
+        }
+
+        // all samples are matched now, the next ones start a new sub-matching
+        prev_unbroken_timestamps.clear();
+        session.finalized = map_matching::INVALID_STATE;
+        session.breakage_begin = map_matching::INVALID_STATE;
+        trimSession(session, session.NumberOfSamples());
+    }
+    else if (!prev_unbroken_timestamps.empty())
+    {
+        const auto first_timestamp = session.finalized == map_matching::INVALID_STATE
+                                         ? session.sub_matching_begin
+                                         : session.finalized;
+
+        std::size_t converged_timestamp, converged_state;
+        std::tie(converged_timestamp, converged_state) =
+            findConvergedState(model, prev_unbroken_timestamps.back(), first_timestamp);
+
+        if (converged_timestamp != map_matching::INVALID_STATE &&
+            (session.finalized == map_matching::INVALID_STATE ||
+             converged_timestamp > session.finalized))
+        {
+            emit_sub_matching(converged_timestamp + 1, converged_state);
+            finalizeState(session, converged_timestamp, converged_state);
+            // the finalized sample is kept as start of the next sub-matching. Dropping samples
+            // moves all kept ones, so this only happens once there are as many to drop as to keep.
+            if (2 * converged_timestamp >= session.NumberOfSamples())
+            {
+                trimSession(session, converged_timestamp);
+            }
+        }
     }
 
     return sub_matchings;
@@ -457,6 +878,30 @@ mapMatching(SearchEngineData<mld::Algorithm> &engine_working_data,
             const std::vector<boost::optional<double>> &trace_gps_precision,
             const bool allow_splitting);
 
+// CH
+template SubMatchingList
+onlineMapMatching(SearchEngineData<ch::Algorithm> &engine_working_data,
+                  const DataFacade<ch::Algorithm> &facade,
+                  map_matching::MatchingSession &session,
+                  const CandidateLists &candidates_list,
+                  const std::vector<util::Coordinate> &trace_coordinates,
+                  const std::vector<unsigned> &trace_timestamps,
+                  const std::vector<boost::optional<double>> &trace_gps_precision,
+                  const bool allow_splitting,
+                  const bool finish);
+
+// MLD
+template SubMatchingList
+onlineMapMatching(SearchEngineData<mld::Algorithm> &engine_working_data,
+                  const DataFacade<mld::Algorithm> &facade,
+                  map_matching::MatchingSession &session,
+                  const CandidateLists &candidates_list,
+                  const std::vector<util::Coordinate> &trace_coordinates,
+                  const std::vector<unsigned> &trace_timestamps,
+                  const std::vector<boost::optional<double>> &trace_gps_precision,
+                  const bool allow_splitting,
+                  const bool finish);
+
 } // namespace routing_algorithms
 } // namespace engine
 } // namespace osrm
@@ -21,6 +21,18 @@ shortestPathSearch(SearchEngineData<mld::Algorithm> &engine_working_data,
                    const std::vector<PhantomNodes> &phantom_nodes_vector,
                    const boost::optional<bool> continue_straight_at_waypoint);
 
+template InternalRouteSummary
+shortestPathSummary(SearchEngineData<ch::Algorithm> &engine_working_data,
+                    const DataFacade<ch::Algorithm> &facade,
+                    const std::vector<PhantomNodes> &phantom_nodes_vector,
+                    const boost::optional<bool> continue_straight_at_waypoint);
+
+template InternalRouteSummary
+shortestPathSummary(SearchEngineData<mld::Algorithm> &engine_working_data,
+                    const DataFacade<mld::Algorithm> &facade,
+                    const std::vector<PhantomNodes> &phantom_nodes_vector,
+                    const boost::optional<bool> continue_straight_at_waypoint);
+
 } // namespace routing_algorithms
 } // namespace engine
 } // namespace osrm
@@ -220,7 +220,7 @@ std::vector<TurnData> getTileTurns(const DataFacade<ch::Algorithm> &facade,
             // would offer a backward edge at `b` to `a` (due to the oneway from a to b)
             // but could also offer a shortcut (b-c-a) from `b` to `a` which is longer.
             EdgeID edge_id = facade.FindSmallestEdge(
-                approach_node, exit_node, [](const contractor::QueryEdge::EdgeData &data) {
+                approach_node, exit_node, [](const contractor::SearchEdgeData &data) {
                     return data.forward && !data.shortcut;
                 });
 
@@ -232,7 +232,7 @@ std::vector<TurnData> getTileTurns(const DataFacade<ch::Algorithm> &facade,
             if (SPECIAL_EDGEID == edge_id)
             {
                 edge_id = facade.FindSmallestEdge(
-                    exit_node, approach_node, [](const contractor::QueryEdge::EdgeData &data) {
+                    exit_node, approach_node, [](const contractor::SearchEdgeData &data) {
                         return data.backward && !data.shortcut;
                     });
             }
@@ -1,4 +1,5 @@
 #include "extractor/compressed_edge_container.hpp"
+#include "util/douglas_peucker.hpp"
 #include "util/log.hpp"
 
 #include <boost/assert.hpp>
@@ -6,6 +7,11 @@
 #include <boost/filesystem/fstream.hpp>
 #include <boost/numeric/conversion/cast.hpp>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <iterator>
 #include <limits>
 #include <string>
 
@@ -389,11 +395,38 @@ NodeID CompressedEdgeContainer::GetLastEdgeSourceID(const EdgeID edge_id) const
     return bucket[bucket.size() - 2].node_id;
 }
 
-std::unique_ptr<SegmentDataContainer> CompressedEdgeContainer::ToSegmentData()
+std::unique_ptr<SegmentDataContainer>
+CompressedEdgeContainer::ToSegmentData(const std::vector<util::Coordinate> &coordinates)
 {
     // Finalize the index
     segment_data->index.push_back(segment_data->nodes.size());
 
+    // Precompute the zoom levels at which the nodes of a geometry are kept by the overview
+    // simplification, so it does not need to simplify whole geometries per request
+    segment_data->zoom_levels.resize(segment_data->nodes.size());
+    tbb::parallel_for(
+        tbb::blocked_range<std::size_t>(0, segment_data->GetNumberOfGeometries()),
+        [&](const tbb::blocked_range<std::size_t> &range) {
+            std::vector<util::Coordinate> geometry;
+            for (auto id = range.begin(); id < range.end(); ++id)
+            {
+                const auto begin = segment_data->index[id];
+                const auto end = segment_data->index[id + 1];
+
+                geometry.clear();
+                std::transform(segment_data->nodes.begin() + begin,
+                               segment_data->nodes.begin() + end,
+                               std::back_inserter(geometry),
+                               [&coordinates](const NodeID node) { return coordinates[node]; });
+
+                const auto zoom_levels =
+                    util::douglasPeuckerZoomLevels(geometry.begin(), geometry.end());
+                std::copy(zoom_levels.begin(),
+                          zoom_levels.end(),
+                          segment_data->zoom_levels.begin() + begin);
+            }
+        });
+
     return std::move(segment_data);
 }
 }
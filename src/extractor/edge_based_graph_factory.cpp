@@ -32,10 +32,13 @@
 #include <sstream>
 #include <string>
 #include <tuple>
+#include <type_traits>
 #include <unordered_map>
 
 #include <tbb/blocked_range.h>
+#include <tbb/concurrent_queue.h>
 #include <tbb/parallel_for.h>
+#include <tbb/parallel_invoke.h>
 #include <tbb/pipeline.h>
 #include <tbb/task_scheduler_init.h>
 
@@ -56,6 +59,16 @@ template <> struct hash<std::pair<NodeID, NodeID>>
 // Buffer size of turn_indexes_write_buffer to reduce number of write(v) syscals
 const constexpr int TURN_INDEX_WRITE_BUFFER_SIZE = 1000;
 
+// Number of intersection batches that may be in flight in the edge expansion pipeline per thread.
+// This is the same token limit the pipeline has always used, it only bounds the number of
+// pipeline buffers, not the size of the accumulated results.
+const constexpr int EDGE_EXPANSION_BATCHES_PER_THREAD = 5;
+
+// Number of elements a recycled pipeline buffer may keep allocated per container. A batch of
+// 100 intersections usually produces a few hundred turns, buffers that grew much larger for a
+// dense batch are released instead of being kept around until the end of the pipeline.
+const constexpr std::size_t EDGE_EXPANSION_BUFFER_CAPACITY = 4096;
+
 namespace osrm
 {
 namespace extractor
@@ -527,6 +540,43 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
         };
         using EdgesPipelineBufferPtr = std::shared_ptr<EdgesPipelineBuffer>;
 
+        // The number of live tokens in the pipeline bounds the number of buffers we ever
+        // allocate. Buffers are handed back by the `output_stage` once their content has been
+        // transferred, so their capacity is reused instead of re-allocated for every batch.
+        // The capacity they keep is capped, so the pool holds at most
+        // max_batches_in_flight * EDGE_EXPANSION_BUFFER_CAPACITY elements per container.
+        // This only saves allocations: the results collected by the `output_stage`
+        // (m_edge_based_edge_list, turn_weight_penalties, turn_duration_penalties and
+        // conditionals) still grow with the size of the graph and are written in one go at the
+        // end, so the peak memory of this step is unchanged.
+        const auto max_batches_in_flight =
+            tbb::task_scheduler_init::default_num_threads() * EDGE_EXPANSION_BATCHES_PER_THREAD;
+        tbb::concurrent_queue<EdgesPipelineBufferPtr> buffer_pool;
+        const auto acquire_buffer = [&buffer_pool]() {
+            EdgesPipelineBufferPtr buffer;
+            if (!buffer_pool.try_pop(buffer))
+            {
+                buffer = std::make_shared<EdgesPipelineBuffer>();
+            }
+            return buffer;
+        };
+        const auto release_buffer = [&buffer_pool](EdgesPipelineBufferPtr buffer) {
+            const auto clear = [](auto &container, const std::size_t capacity) {
+                using Container = std::remove_reference_t<decltype(container)>;
+                if (capacity > EDGE_EXPANSION_BUFFER_CAPACITY)
+                    Container().swap(container);
+                else
+                    container.clear();
+            };
+            buffer->nodes_processed = 0;
+            clear(buffer->continuous_data, buffer->continuous_data.capacity());
+            clear(buffer->delayed_data, buffer->delayed_data.capacity());
+            clear(buffer->conditionals, buffer->conditionals.capacity());
+            clear(buffer->turn_to_ebn_map, buffer->turn_to_ebn_map.bucket_count());
+            buffer->checksum = util::ConnectivityChecksum{};
+            buffer_pool.push(std::move(buffer));
+        };
+
         m_connectivity_checksum = 0;
 
         std::unordered_map<NodeBasedTurn, std::pair<NodeID, NodeID>> global_turn_to_ebn_map;
@@ -702,7 +752,7 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
         tbb::filter_t<tbb::blocked_range<NodeID>, EdgesPipelineBufferPtr> processor_stage(
             tbb::filter::parallel, [&](const tbb::blocked_range<NodeID> &intersection_node_range) {
 
-                auto buffer = std::make_shared<EdgesPipelineBuffer>();
+                auto buffer = acquire_buffer();
                 buffer->nodes_processed = intersection_node_range.size();
 
                 for (auto intersection_node = intersection_node_range.begin(),
@@ -1073,15 +1123,18 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
                                   // TODO: log conflicts here
                                   global_turn_to_ebn_map.insert(p);
                               });
+
+                release_buffer(std::move(buffer));
             });
 
-        // Now, execute the pipeline.  The value of "5" here was chosen by experimentation
-        // on a 16-CPU machine and seemed to give the best performance.  This value needs
-        // to be balanced with the GRAINSIZE above - ideally, the pipeline puts as much work
-        // as possible in the `intersection_handler` step so that those parallel workers don't
-        // get blocked too much by the slower (io-performing) `buffer_storage`
-        tbb::parallel_pipeline(tbb::task_scheduler_init::default_num_threads() * 5,
+        // Now, execute the pipeline.  The value of EDGE_EXPANSION_BATCHES_PER_THREAD (5) was
+        // chosen by experimentation on a 16-CPU machine and seemed to give the best performance.
+        // This value needs to be balanced with the GRAINSIZE above - ideally, the pipeline puts as
+        // much work as possible in the `intersection_handler` step so that those parallel workers
+        // don't get blocked too much by the slower (io-performing) `buffer_storage`
+        tbb::parallel_pipeline(max_batches_in_flight,
                                generator_stage & processor_stage & output_stage);
+        buffer_pool.clear();
 
         // NOTE: buffer.delayed_data and buffer.delayed_turn_data have the same index
         std::for_each(delayed_data.begin(), delayed_data.end(), transfer_data);
@@ -1128,43 +1181,54 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
             turn_indexes_write_buffer.clear();
         }
     }
-    {
-        util::Log() << "Sorting and writing " << storage_maneuver_overrides.size()
-                    << " maneuver overrides...";
-
-        // Sort by `from_node`, so that later lookups can be done with a binary search.
-        std::sort(storage_maneuver_overrides.begin(),
-                  storage_maneuver_overrides.end(),
-                  [](const auto &a, const auto &b) { return a.start_node < b.start_node; });
+    // None of the remaining outputs depend on each other, so we write them concurrently. Only the
+    // conditional penalties need the final turn ids and are indexed after renumbering.
+    tbb::parallel_invoke(
+        [&] {
+            util::Log() << "Sorting and writing " << storage_maneuver_overrides.size()
+                        << " maneuver overrides...";
+
+            // Sort by `from_node`, so that later lookups can be done with a binary search.
+            std::sort(storage_maneuver_overrides.begin(),
+                      storage_maneuver_overrides.end(),
+                      [](const auto &a, const auto &b) { return a.start_node < b.start_node; });
+
+            files::writeManeuverOverrides(maneuver_overrides_filename,
+                                          storage_maneuver_overrides,
+                                          maneuver_override_sequences);
+        },
+        [&] {
+            // write weight penalties per turn
+            BOOST_ASSERT(turn_weight_penalties.size() == turn_duration_penalties.size());
+            files::writeTurnWeightPenalty(turn_weight_penalties_filename, turn_weight_penalties);
+        },
+        [&] {
+            files::writeTurnDurationPenalty(turn_duration_penalties_filename,
+                                            turn_duration_penalties);
+        },
+        [&] {
+            util::Log() << "Renumbering turns";
+            // Now, update the turn_id property on every EdgeBasedEdge - it will equal the position
+            // in the m_edge_based_edge_list array for each object.
+            tbb::parallel_for(tbb::blocked_range<NodeID>(0, m_edge_based_edge_list.size()),
+                              [this](const tbb::blocked_range<NodeID> &range) {
+                                  for (auto x = range.begin(), end = range.end(); x != end; ++x)
+                                  {
+                                      m_edge_based_edge_list[x].data.turn_id = x;
+                                  }
+                              });
 
-        files::writeManeuverOverrides(
-            maneuver_overrides_filename, storage_maneuver_overrides, maneuver_override_sequences);
-    }
+            // re-hash conditionals to connect to their respective edge-based edges. Due to the
+            // ordering, we do not really have a choice but to index the conditional penalties and
+            // walk over all edge-based-edges to find the ID of the edge
+            auto const indexed_conditionals = IndexConditionals(std::move(conditionals));
+            util::Log() << "Writing " << indexed_conditionals.size()
+                        << " conditional turn penalties...";
+            extractor::files::writeConditionalRestrictions(conditional_penalties_filename,
+                                                           indexed_conditionals);
+        });
 
     util::Log() << "done.";
-    util::Log() << "Renumbering turns";
-    // Now, update the turn_id property on every EdgeBasedEdge - it will equal the position in the
-    // m_edge_based_edge_list array for each object.
-    tbb::parallel_for(tbb::blocked_range<NodeID>(0, m_edge_based_edge_list.size()),
-                      [this](const tbb::blocked_range<NodeID> &range) {
-                          for (auto x = range.begin(), end = range.end(); x != end; ++x)
-                          {
-                              m_edge_based_edge_list[x].data.turn_id = x;
-                          }
-                      });
-
-    // re-hash conditionals to connect to their respective edge-based edges. Due to the ordering, we
-    // do not really have a choice but to index the conditional penalties and walk over all
-    // edge-based-edges to find the ID of the edge
-    auto const indexed_conditionals = IndexConditionals(std::move(conditionals));
-    util::Log() << "Writing " << indexed_conditionals.size() << " conditional turn penalties...";
-    extractor::files::writeConditionalRestrictions(conditional_penalties_filename,
-                                                   indexed_conditionals);
-
-    // write weight penalties per turn
-    BOOST_ASSERT(turn_weight_penalties.size() == turn_duration_penalties.size());
-    files::writeTurnWeightPenalty(turn_weight_penalties_filename, turn_weight_penalties);
-    files::writeTurnDurationPenalty(turn_duration_penalties_filename, turn_duration_penalties);
 
     util::Log() << "Generated " << m_edge_based_node_segments.size() << " edge based node segments";
     util::Log() << "Node-based graph contains " << node_based_edge_counter << " edges";
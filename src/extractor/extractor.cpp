@@ -341,8 +341,9 @@ int Extractor::run(ScriptingEnvironment &scripting_environment)
 
     // output the geometry of the node-based graph, needs to be done after the last usage, since it
     // destroys internal containers
-    files::writeSegmentData(config.GetPath(".osrm.geometry"),
-                            *node_based_graph_factory.GetCompressedEdges().ToSegmentData());
+    files::writeSegmentData(
+        config.GetPath(".osrm.geometry"),
+        *node_based_graph_factory.GetCompressedEdges().ToSegmentData(coordinates));
 
     util::Log() << "Saving edge-based node weights to file.";
     TIMER_START(timer_write_node_weights);
@@ -839,12 +840,11 @@ void Extractor::BuildRTree(std::vector<EdgeBasedNodeSegment> edge_based_node_seg
 
 template <typename Map> auto convertIDMapToVector(const Map &map)
 {
-    std::vector<typename Map::key_type> result(map.size());
-    for (const auto &pair : map)
-    {
-        BOOST_ASSERT(pair.second < map.size());
-        result[pair.second] = pair.first;
-    }
+    std::vector<typename Map::key_type> result(map.Size());
+    map.ForEach([&result](const auto &key, const auto id) {
+        BOOST_ASSERT(id < result.size());
+        result[id] = key;
+    });
     return result;
 }
 
@@ -909,8 +909,8 @@ void Extractor::ProcessGuidanceTurns(
     files::writeIntersections(
         config.GetPath(".osrm.icd").string(),
         IntersectionBearingsContainer{bearing_class_by_node_based_node,
-                                      convertIDMapToVector(bearing_class_hash.data)},
-        convertIDMapToVector(entry_class_hash.data));
+                                      convertIDMapToVector(bearing_class_hash)},
+        convertIDMapToVector(entry_class_hash));
     TIMER_STOP(write_intersections);
     util::Log() << "ok, after " << TIMER_SEC(write_intersections) << "s";
 
@@ -918,7 +918,7 @@ void Extractor::ProcessGuidanceTurns(
     TIMER_START(write_guidance_data);
 
     {
-        auto turn_lane_data = convertIDMapToVector(lane_data_map.data);
+        auto turn_lane_data = convertIDMapToVector(lane_data_map);
         files::writeTurnLaneData(config.GetPath(".osrm.tld"), turn_lane_data);
     }
 
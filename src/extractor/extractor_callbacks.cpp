@@ -40,7 +40,9 @@ ExtractorCallbacks::ExtractorCallbacks(ExtractionContainers &extraction_containe
 {
     // we reserved 0, 1, 2, 3, 4 for the empty case
     string_map[MapKey("", "", "", "", "")] = 0;
-    lane_description_map.data[TurnLaneDescription()] = 0;
+    const auto empty_lane_description = lane_description_map.ConcurrentFindOrAdd({});
+    BOOST_ASSERT(empty_lane_description == 0);
+    (void)empty_lane_description;
 }
 
 /**
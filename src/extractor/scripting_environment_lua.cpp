@@ -23,6 +23,8 @@
 
 #include <osmium/osm.hpp>
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <sstream>
 
@@ -46,6 +48,19 @@ namespace extractor
 
 namespace
 {
+// Compares tag keys without copying them into a std::string
+struct TagKeyLess
+{
+    bool operator()(const std::string &lhs, const char *rhs) const
+    {
+        return std::strcmp(lhs.c_str(), rhs) < 0;
+    }
+    bool operator()(const char *lhs, const std::string &rhs) const
+    {
+        return std::strcmp(lhs, rhs.c_str()) < 0;
+    }
+};
+
 template <class T>
 auto get_value_by_key(T const &object, const char *key) -> decltype(object.get_value_by_key(key))
 {
@@ -107,7 +122,7 @@ void Sol2ScriptingEnvironment::InitContext(LuaScriptingContext &context)
 
     context.state["durationIsValid"] = durationIsValid;
     context.state["parseDuration"] = parseDuration;
-    context.state["trimLaneString"] = trimLaneString;
+    context.state["trimLaneString"] = trimLaneStringByCount;
     context.state["applyAccessTokens"] = applyAccessTokens;
     context.state["canonicalizeStringList"] = canonicalizeStringList;
 
@@ -304,7 +319,10 @@ void Sol2ScriptingEnvironment::InitContext(LuaScriptingContext &context)
         sol::property(&RoadClassification::GetClass, &RoadClassification::SetClass),
         "num_lanes",
         sol::property(&RoadClassification::GetNumberOfLanes,
-                      &RoadClassification::SetNumberOfLanes));
+                      [](RoadClassification &classification, double number_of_lanes) {
+                          classification.SetNumberOfLanes(
+                              toCount<std::uint8_t>(number_of_lanes));
+                      }));
 
     context.state.new_usertype<ExtractionWay>(
         "ResultWay",
@@ -542,6 +560,20 @@ void Sol2ScriptingEnvironment::InitContext(LuaScriptingContext &context)
         context.has_way_function = context.way_function.valid();
         context.has_segment_function = context.segment_function.valid();
 
+        // read the optional list of tag keys a way needs to be passed to process_way
+        sol::table relevant_way_keys = context.profile_table["relevant_way_keys"];
+        if (relevant_way_keys.valid())
+        {
+            for (auto &&pair : relevant_way_keys)
+            {
+                context.relevant_way_keys.push_back(pair.second.as<std::string>());
+            }
+            std::sort(context.relevant_way_keys.begin(), context.relevant_way_keys.end());
+            context.relevant_way_keys.erase(
+                std::unique(context.relevant_way_keys.begin(), context.relevant_way_keys.end()),
+                context.relevant_way_keys.end());
+        }
+
         // read properties from 'profile.properties' table
         sol::table properties = context.profile_table["properties"];
         if (properties.valid())
@@ -897,6 +929,11 @@ void Sol2ScriptingEnvironment::ProcessElements(
         case osmium::item_type::way:
         {
             const osmium::Way &way = static_cast<const osmium::Way &>(*entity);
+            // Ways the profile would reject based on their keys alone never reach Lua
+            if (!local_context.HasRelevantTags(way))
+            {
+                break;
+            }
             result_way.clear();
             if (local_context.has_way_function)
             {
@@ -1152,6 +1189,23 @@ void Sol2ScriptingEnvironment::ProcessSegment(ExtractionSegment &segment)
     }
 }
 
+bool LuaScriptingContext::HasRelevantTags(const osmium::Way &way) const
+{
+    if (relevant_way_keys.empty())
+    {
+        return true;
+    }
+
+    const auto &tags = way.tags();
+    return std::any_of(tags.begin(), tags.end(), [this](const osmium::Tag &tag) {
+        // empty values are treated as missing, same as in get_value_by_key
+        return *tag.value() && std::binary_search(relevant_way_keys.begin(),
+                                                  relevant_way_keys.end(),
+                                                  tag.key(),
+                                                  TagKeyLess{});
+    });
+}
+
 void LuaScriptingContext::ProcessNode(const osmium::Node &node,
                                       ExtractionNode &result,
                                       const ExtractionRelationContainer &relations)
@@ -0,0 +1,250 @@
+#include "extractor/scripting_environment_native.hpp"
+
+#include "extractor/extraction_node.hpp"
+#include "extractor/extraction_relation.hpp"
+#include "extractor/extraction_segment.hpp"
+#include "extractor/extraction_turn.hpp"
+#include "extractor/extraction_way.hpp"
+#include "extractor/maneuver_override_relation_parser.hpp"
+#include "extractor/restriction_parser.hpp"
+
+#include "util/exception.hpp"
+#include "util/log.hpp"
+
+#include <osmium/osm.hpp>
+
+#include <boost/assert.hpp>
+#include <boost/geometry.hpp>
+
+#ifndef _WIN32
+#include <dlfcn.h>
+#endif
+
+#include <algorithm>
+
+namespace osrm
+{
+namespace extractor
+{
+
+namespace
+{
+#ifndef _WIN32
+template <typename FunctionT>
+FunctionT *lookupSymbol(void *handle, const std::string &file_name, const char *symbol)
+{
+    auto function = reinterpret_cast<FunctionT *>(dlsym(handle, symbol));
+    if (!function)
+    {
+        throw util::exception("Native profile " + file_name + " does not export " + symbol +
+                              ", did you use OSRM_NATIVE_PROFILE?");
+    }
+    return function;
+}
+#endif
+
+// Looks up location dependent data for one thread, the indexes of the last location are cached
+// like in the Lua scripting context
+class LocationDependentTags final : public LocationTags
+{
+  public:
+    explicit LocationDependentTags(const LocationDependentData &data) : data(data) {}
+
+    using LocationTags::Get;
+
+    LocationDependentData::property_t Get(const osmium::Location &location,
+                                          const char *key) const override
+    {
+        if (data.empty())
+            return {};
+
+        const LocationDependentData::point_t point{location.lon(), location.lat()};
+        if (!boost::geometry::equals(last_point, point))
+        {
+            last_point = point;
+            last_indexes = data.GetPropertyIndexes(point);
+        }
+
+        return data.FindByKey(last_indexes, key);
+    }
+
+  private:
+    const LocationDependentData &data;
+    // assume (0,180) is invalid coordinate
+    mutable LocationDependentData::point_t last_point{0., 180.};
+    mutable std::vector<std::size_t> last_indexes;
+};
+}
+
+NativeScriptingEnvironment::NativeScriptingEnvironment(
+    const std::string &file_name,
+    const std::vector<boost::filesystem::path> &location_dependent_data_paths)
+    : file_name(file_name), location_dependent_data(location_dependent_data_paths),
+      library_handle(nullptr), destroy_profile(nullptr), profile(nullptr)
+{
+#ifdef _WIN32
+    throw util::exception("Native profiles are not supported on this platform");
+#else
+    util::Log() << "Using native profile " << file_name;
+
+    library_handle = dlopen(file_name.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!library_handle)
+    {
+        throw util::exception("Failed to load native profile " + file_name + ": " + dlerror());
+    }
+
+    try
+    {
+        const auto api_version = lookupSymbol<NativeProfileAPIVersionFunction>(
+            library_handle, file_name, OSRM_NATIVE_PROFILE_API_VERSION_SYMBOL)();
+        if (api_version != NativeProfile::API_VERSION)
+        {
+            throw util::exception("Native profile " + file_name + " was built for API version " +
+                                  std::to_string(api_version) + " but this is version " +
+                                  std::to_string(NativeProfile::API_VERSION));
+        }
+
+        const auto create_profile = lookupSymbol<NativeProfileCreateFunction>(
+            library_handle, file_name, OSRM_NATIVE_PROFILE_CREATE_SYMBOL);
+        destroy_profile = lookupSymbol<NativeProfileDestroyFunction>(
+            library_handle, file_name, OSRM_NATIVE_PROFILE_DESTROY_SYMBOL);
+
+        profile = create_profile();
+        if (!profile)
+        {
+            throw util::exception("Native profile " + file_name + " failed to initialize");
+        }
+        properties = profile->GetProfileProperties();
+    }
+    catch (...)
+    {
+        if (profile)
+        {
+            destroy_profile(profile);
+        }
+        dlclose(library_handle);
+        throw;
+    }
+#endif
+}
+
+NativeScriptingEnvironment::~NativeScriptingEnvironment()
+{
+#ifndef _WIN32
+    if (profile)
+    {
+        destroy_profile(profile);
+    }
+    if (library_handle)
+    {
+        dlclose(library_handle);
+    }
+#endif
+}
+
+bool NativeScriptingEnvironment::IsNativeProfile(const boost::filesystem::path &profile_path)
+{
+    const auto extension = profile_path.extension().string();
+    return extension == ".so" || extension == ".dylib";
+}
+
+const ProfileProperties &NativeScriptingEnvironment::GetProfileProperties() { return properties; }
+
+std::vector<std::vector<std::string>> NativeScriptingEnvironment::GetExcludableClasses()
+{
+    return profile->GetExcludableClasses();
+}
+
+std::vector<std::string> NativeScriptingEnvironment::GetNameSuffixList()
+{
+    return profile->GetNameSuffixList();
+}
+
+std::vector<std::string> NativeScriptingEnvironment::GetClassNames()
+{
+    return profile->GetClassNames();
+}
+
+std::vector<std::string> NativeScriptingEnvironment::GetRestrictions()
+{
+    return profile->GetRestrictions();
+}
+
+std::vector<std::string> NativeScriptingEnvironment::GetRelations()
+{
+    return profile->GetRelations();
+}
+
+void NativeScriptingEnvironment::ProcessTurn(ExtractionTurn &turn)
+{
+    profile->ProcessTurn(turn);
+
+    // Same post-processing as for Lua profiles with api_version >= 2
+    if (properties.fallback_to_duration)
+        turn.weight = turn.duration;
+    else
+        turn.weight = std::min(turn.weight, properties.GetMaxTurnWeight());
+}
+
+void NativeScriptingEnvironment::ProcessSegment(ExtractionSegment &segment)
+{
+    profile->ProcessSegment(segment);
+}
+
+void NativeScriptingEnvironment::ProcessElements(
+    const osmium::memory::Buffer &buffer,
+    const RestrictionParser &restriction_parser,
+    const ManeuverOverrideRelationParser &maneuver_override_parser,
+    const ExtractionRelationContainer &relations,
+    std::vector<std::pair<const osmium::Node &, ExtractionNode>> &resulting_nodes,
+    std::vector<std::pair<const osmium::Way &, ExtractionWay>> &resulting_ways,
+    std::vector<InputConditionalTurnRestriction> &resulting_restrictions,
+    std::vector<InputManeuverOverride> &resulting_maneuver_overrides)
+{
+    ExtractionNode result_node;
+    ExtractionWay result_way;
+    const LocationDependentTags location_tags(location_dependent_data);
+
+    for (auto entity = buffer.cbegin(), end = buffer.cend(); entity != end; ++entity)
+    {
+        switch (entity->type())
+        {
+        case osmium::item_type::node:
+        {
+            const auto &node = static_cast<const osmium::Node &>(*entity);
+            result_node.clear();
+            if (!node.tags().empty() || properties.call_tagless_node_function)
+            {
+                profile->ProcessNode(node, result_node, relations, location_tags);
+            }
+            resulting_nodes.push_back({node, std::move(result_node)});
+        }
+        break;
+        case osmium::item_type::way:
+        {
+            const osmium::Way &way = static_cast<const osmium::Way &>(*entity);
+            result_way.clear();
+            profile->ProcessWay(way, result_way, relations, location_tags);
+            resulting_ways.push_back({way, std::move(result_way)});
+        }
+        break;
+        case osmium::item_type::relation:
+        {
+            const auto &relation = static_cast<const osmium::Relation &>(*entity);
+            if (auto result_res = restriction_parser.TryParse(relation))
+            {
+                resulting_restrictions.push_back(*result_res);
+            }
+            else if (auto result_res = maneuver_override_parser.TryParse(relation))
+            {
+                resulting_maneuver_overrides.push_back(*result_res);
+            }
+        }
+        break;
+        default:
+            break;
+        }
+    }
+}
+}
+}
@@ -337,8 +337,8 @@ void annotateTurns(const util::NodeBasedDynamicGraph &node_based_graph,
 
     util::Log() << "done.";
 
-    util::Log() << "Created " << entry_class_hash.data.size() << " entry classes and "
-                << bearing_class_hash.data.size() << " Bearing Classes";
+    util::Log() << "Created " << entry_class_hash.Size() << " entry classes and "
+                << bearing_class_hash.Size() << " Bearing Classes";
 }
 
 } // namespace guidance
@@ -8,10 +8,18 @@
 #include "osrm/tile_parameters.hpp"
 #include "osrm/trip_parameters.hpp"
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
+#include <cstdint>
 #include <exception>
+#include <functional>
 #include <sstream>
+#include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "nodejs/node_osrm.hpp"
 #include "nodejs/node_osrm_support.hpp"
@@ -43,6 +51,7 @@ NAN_MODULE_INIT(Engine::Init)
     SetPrototypeMethod(fnTp, "tile", tile);
     SetPrototypeMethod(fnTp, "match", match);
     SetPrototypeMethod(fnTp, "trip", trip);
+    SetPrototypeMethod(fnTp, "batch", batch);
 
     const auto fn = Nan::GetFunction(fnTp).ToLocalChecked();
 
@@ -83,6 +92,7 @@ NAN_MODULE_INIT(Engine::Init)
  * @param {Number} [options.max_radius_map_matching] Max. radius size supported in map matching query (default: 5).
  * @param {Number} [options.max_results_nearest] Max. results supported in nearest query (default: unlimited).
  * @param {Number} [options.max_alternatives] Max. number of alternatives supported in alternative routes query (default: 3).
+ * @param {Array} [options.region] Only answer requests with all coordinates in the bounding box `[min_lon, min_lat, max_lon, max_lat]` (default: unrestricted).
  *
  * @class OSRM
  *
@@ -115,13 +125,31 @@ NAN_METHOD(Engine::New)
     }
 }
 
+// Strips the status from the result and renders it as requested by the plugin parameters
+inline ObjectOrString finishResult(const osrm::Status status,
+                                   osrm::json::Object &json_result,
+                                   const PluginParameters &pluginParams)
+{
+    ParseResult(status, json_result);
+    if (pluginParams.renderJSONToBuffer)
+    {
+        std::ostringstream buf;
+        osrm::util::json::render(buf, json_result);
+        return buf.str();
+    }
+    return std::move(json_result);
+}
+
 template <typename ParameterParser, typename ServiceMemFn>
 inline void async(const Nan::FunctionCallbackInfo<v8::Value> &info,
                   ParameterParser argsToParams,
                   ServiceMemFn service,
                   bool requires_multiple_coordinates)
 {
-    auto params = argsToParams(info, requires_multiple_coordinates);
+    if (info.Length() < 2)
+        return Nan::ThrowTypeError("Two arguments required");
+
+    auto params = argsToParams(info[0], requires_multiple_coordinates);
     if (!params)
         return;
 
@@ -154,18 +182,7 @@ inline void async(const Nan::FunctionCallbackInfo<v8::Value> &info,
             osrm::engine::api::ResultT r;
             r = osrm::util::json::Object();
             const auto status = ((*osrm).*(service))(*params, r);
-            auto json_result = r.get<osrm::json::Object>();
-            ParseResult(status, json_result);
-            if (pluginParams.renderJSONToBuffer)
-            {
-                std::ostringstream buf;
-                osrm::util::json::render(buf, json_result);
-                result = buf.str();
-            }
-            else
-            {
-                result = json_result;
-            }
+            result = finishResult(status, r.get<osrm::json::Object>(), pluginParams);
         }
         catch (const std::exception &e)
         {
@@ -177,7 +194,7 @@ inline void async(const Nan::FunctionCallbackInfo<v8::Value> &info,
             Nan::HandleScope scope;
 
             const constexpr auto argc = 2u;
-            v8::Local<v8::Value> argv[argc] = {Nan::Null(), render(result)};
+            v8::Local<v8::Value> argv[argc] = {Nan::Null(), render(std::move(result))};
 
             callback->Call(argc, argv);
         }
@@ -202,7 +219,10 @@ inline void asyncForTiles(const Nan::FunctionCallbackInfo<v8::Value> &info,
                           ServiceMemFn service,
                           bool requires_multiple_coordinates)
 {
-    auto params = argsToParams(info, requires_multiple_coordinates);
+    if (info.Length() < 2)
+        return Nan::ThrowTypeError("Coordinate object and callback required");
+
+    auto params = argsToParams(info[0], requires_multiple_coordinates);
     if (!params)
         return;
 
@@ -234,8 +254,7 @@ inline void asyncForTiles(const Nan::FunctionCallbackInfo<v8::Value> &info,
         {
             result = std::string();
             const auto status = ((*osrm).*(service))(*params, result);
-            auto str_result = result.get<std::string>();
-            ParseResult(status, str_result);
+            ParseResult(status, result.get<std::string>());
         }
         catch (const std::exception &e)
         {
@@ -247,8 +266,8 @@ inline void asyncForTiles(const Nan::FunctionCallbackInfo<v8::Value> &info,
             Nan::HandleScope scope;
 
             const constexpr auto argc = 2u;
-            auto str_result = result.get<std::string>();
-            v8::Local<v8::Value> argv[argc] = {Nan::Null(), render(str_result)};
+            v8::Local<v8::Value> argv[argc] = {Nan::Null(),
+                                               render(std::move(result.get<std::string>()))};
 
             callback->Call(argc, argv);
         }
@@ -287,6 +306,7 @@ inline void asyncForTiles(const Nan::FunctionCallbackInfo<v8::Value> &info,
  * @param {String} [options.geometries=polyline] Returned route geometry format (influences overview and per step). Can also be `geojson`.
  * @param {String} [options.overview=simplified] Add overview geometry either `full`, `simplified` according to highest zoom level it could be display on, or not at all (`false`).
  * @param {Boolean} [options.continue_straight] Forces the route to keep going straight at waypoints and don't do a uturn even if it would be faster. Default value depends on the profile.
+ * @param {Boolean} [options.eta_only=false] Only return the duration, distance and weight of the route and its legs, without geometry. Can not be combined with `steps`, `annotations` or `alternatives`.
  * @param {Array} [options.approaches] Keep waypoints on curb side. Can be `null` (unrestricted, default) or `curb`.
  *                  `null`/`true`/`false`
  * @param {Function} callback
@@ -486,10 +506,10 @@ NAN_METHOD(Engine::match) //
 
 // clang-format off
 /**
- * The trip plugin solves the Traveling Salesman Problem using a greedy heuristic
- * (farthest-insertion algorithm) for 10 or * more waypoints and uses brute force for less than 10
- * waypoints. The returned path does not have to be the shortest path, * as TSP is NP-hard it is
- * only an approximation.
+ * The trip plugin solves the Traveling Salesman Problem exactly (Held-Karp algorithm) for up to 16
+ * waypoints. For more waypoints farthest insertion and greedy round trips are improved with 2-opt
+ * and Or-opt moves. In this case the returned path does not have to be the shortest path, as TSP
+ * is NP-hard it is only an approximation.
  *
  * Note that all input coordinates have to be connected for the trip service to work.
  * Currently, not all combinations of `roundtrip`, `source` and `destination` are supported.
@@ -554,6 +574,200 @@ NAN_METHOD(Engine::trip) //
     async(info, &argumentsToTripParameter, &osrm::OSRM::Trip, true);
 }
 
+// A single query of a batch: the parsed parameters bound to the service they are run with
+struct BatchQuery
+{
+    std::function<osrm::Status(const osrm::OSRM &, osrm::engine::api::ResultT &)> run;
+    ObjectOrString result;
+    std::string error;
+};
+
+template <typename ParameterParser, typename ServiceMemFn>
+inline bool makeBatchQuery(const v8::Local<v8::Value> &options,
+                           ParameterParser argsToParams,
+                           ServiceMemFn service,
+                           bool requires_multiple_coordinates,
+                           BatchQuery &query)
+{
+    auto params = argsToParams(options, requires_multiple_coordinates);
+    if (!params)
+        return false;
+
+    BOOST_ASSERT(params->IsValid());
+
+    std::shared_ptr<const typename decltype(params)::element_type> shared_params =
+        std::move(params);
+    query.run = [shared_params, service](const osrm::OSRM &osrm,
+                                         osrm::engine::api::ResultT &result) {
+        return (osrm.*(service))(*shared_params, result);
+    };
+    return true;
+}
+
+// clang-format off
+/**
+ * Runs several queries at once. All queries are computed in parallel by a single background job,
+ * which saves the overhead of scheduling every query on its own for many small requests.
+ *
+ * @name batch
+ * @memberof OSRM
+ * @param {Array} queries Array of objects with the `service` to query (`route`, `nearest`, `table`, `match` or `trip`)
+ *                        and the `options` for it, as they are passed to the service itself.
+ * @param {Object} [plugin_config] - Plugin configuration that applies to all results, see [Plugin behaviour](#plugin-behaviour).
+ * @param {Function} callback
+ *
+ * @returns {Array} The results in the order of the queries. A query that failed has an `Error` in its place.
+ *
+ * @example
+ * var osrm = new OSRM('network.osrm');
+ * var queries = [
+ *   {service: 'route', options: {coordinates: [[13.438640,52.519930], [13.415852,52.513191]]}},
+ *   {service: 'nearest', options: {coordinates: [[13.438640,52.519930]]}}
+ * ];
+ * osrm.batch(queries, function(err, results) {
+ *   if (err) throw err;
+ *   console.log(results[0].routes); // array of Route objects of the first query
+ *   console.log(results[1].waypoints); // array of Waypoint objects of the second query
+ * });
+ */
+// clang-format on
+NAN_METHOD(Engine::batch)
+{
+    if (info.Length() < 2)
+        return Nan::ThrowTypeError("Two arguments required");
+
+    if (!info[0]->IsArray())
+        return Nan::ThrowTypeError("First arg must be an array of queries");
+
+    const auto array = v8::Local<v8::Array>::Cast(info[0]);
+    std::vector<BatchQuery> queries(array->Length());
+    for (std::uint32_t index = 0; index < array->Length(); ++index)
+    {
+        const auto entry = array->Get(index);
+        if (entry.IsEmpty())
+            return;
+
+        if (!entry->IsObject())
+            return Nan::ThrowTypeError("Each query must be an object with service and options");
+
+        const auto object = Nan::To<v8::Object>(entry).ToLocalChecked();
+        const auto service = object->Get(Nan::New("service").ToLocalChecked());
+        const auto options = object->Get(Nan::New("options").ToLocalChecked());
+        if (service.IsEmpty() || options.IsEmpty())
+            return;
+
+        const auto invalid_service = "service must be a string: \"route\", \"nearest\", "
+                                     "\"table\", \"match\" or \"trip\"";
+        if (!service->IsString())
+            return Nan::ThrowError(invalid_service);
+
+        const Nan::Utf8String service_utf8str(service);
+        const std::string service_str{*service_utf8str,
+                                      *service_utf8str + service_utf8str.length()};
+
+        auto &query = queries[index];
+        bool parsed = false;
+        if (service_str == "route")
+            parsed = makeBatchQuery(
+                options, &argumentsToRouteParameter, &osrm::OSRM::Route, true, query);
+        else if (service_str == "nearest")
+            parsed = makeBatchQuery(
+                options, &argumentsToNearestParameter, &osrm::OSRM::Nearest, false, query);
+        else if (service_str == "table")
+            parsed = makeBatchQuery(
+                options, &argumentsToTableParameter, &osrm::OSRM::Table, true, query);
+        else if (service_str == "match")
+            parsed = makeBatchQuery(
+                options, &argumentsToMatchParameter, &osrm::OSRM::Match, true, query);
+        else if (service_str == "trip")
+            parsed = makeBatchQuery(
+                options, &argumentsToTripParameter, &osrm::OSRM::Trip, true, query);
+        else
+            return Nan::ThrowError(invalid_service);
+
+        if (!parsed)
+            return;
+    }
+
+    auto pluginParams = argumentsToPluginParameters(info);
+
+    if (!info[info.Length() - 1]->IsFunction())
+        return Nan::ThrowTypeError("last argument must be a callback function");
+
+    auto *const self = Nan::ObjectWrap::Unwrap<Engine>(info.Holder());
+
+    struct Worker final : Nan::AsyncWorker
+    {
+        using Base = Nan::AsyncWorker;
+
+        Worker(std::shared_ptr<osrm::OSRM> osrm_,
+               std::vector<BatchQuery> queries_,
+               Nan::Callback *callback,
+               PluginParameters pluginParams_)
+            : Base(callback), osrm{std::move(osrm_)}, queries{std::move(queries_)},
+              pluginParams{std::move(pluginParams_)}
+        {
+        }
+
+        void Execute() override
+        {
+            tbb::parallel_for(tbb::blocked_range<std::size_t>(0, queries.size(), 1),
+                              [&](const tbb::blocked_range<std::size_t> &range) {
+                                  for (auto index = range.begin(); index != range.end(); ++index)
+                                  {
+                                      // Queries keep state in thread local heaps and may run
+                                      // parallel loops themselves. Isolated, a thread waiting
+                                      // in such a loop does not steal another query of the
+                                      // batch that would clear its heaps.
+                                      tbb::this_task_arena::isolate(
+                                          [&] { run(queries[index]); });
+                                  }
+                              });
+        }
+
+        void run(BatchQuery &query) const try
+        {
+            osrm::engine::api::ResultT r;
+            r = osrm::util::json::Object();
+            const auto status = query.run(*osrm, r);
+            query.result = finishResult(status, r.get<osrm::json::Object>(), pluginParams);
+        }
+        catch (const std::exception &e)
+        {
+            query.error = e.what();
+        }
+
+        void HandleOKCallback() override
+        {
+            Nan::HandleScope scope;
+
+            auto results = Nan::New<v8::Array>(static_cast<int>(queries.size()));
+            for (std::uint32_t index = 0; index < queries.size(); ++index)
+            {
+                auto &query = queries[index];
+                if (query.error.empty())
+                    Nan::Set(results, index, render(std::move(query.result)));
+                else
+                    Nan::Set(results, index, Nan::Error(query.error.c_str()));
+            }
+
+            const constexpr auto argc = 2u;
+            v8::Local<v8::Value> argv[argc] = {Nan::Null(), results};
+
+            callback->Call(argc, argv);
+        }
+
+        // Keeps the OSRM object alive even after shutdown until we're done with callback
+        std::shared_ptr<osrm::OSRM> osrm;
+        std::vector<BatchQuery> queries;
+        const PluginParameters pluginParams;
+    };
+
+    auto *callback = new Nan::Callback{info[info.Length() - 1].As<v8::Function>()};
+    Nan::AsyncQueueWorker(
+        new Worker{self->this_, std::move(queries), callback, std::move(pluginParams)});
+}
+
 /**
  * Responses
  * @class Responses
@@ -2,6 +2,7 @@
 #include "extractor/extractor.hpp"
 #include "extractor/extractor_config.hpp"
 #include "extractor/scripting_environment_lua.hpp"
+#include "extractor/scripting_environment_native.hpp"
 
 namespace osrm
 {
@@ -10,6 +11,14 @@ namespace osrm
 
 void extract(const extractor::ExtractorConfig &config)
 {
+    if (extractor::NativeScriptingEnvironment::IsNativeProfile(config.profile_path))
+    {
+        extractor::NativeScriptingEnvironment scripting_environment(
+            config.profile_path.string(), config.location_dependent_data_paths);
+        extractor::Extractor(config).run(scripting_environment);
+        return;
+    }
+
     extractor::Sol2ScriptingEnvironment scripting_environment(config.profile_path.string(),
                                                               config.location_dependent_data_paths);
     extractor::Extractor(config).run(scripting_environment);
@@ -32,11 +32,16 @@ std::string getWrongOptionHelp(const engine::api::MatchParameters &parameters)
         constrainParamSize(
             PARAMETER_SIZE_MISMATCH_MSG, "timestamps", parameters.timestamps, coord_size, help);
 
-    if (!param_size_mismatch && parameters.coordinates.size() < 2)
+    if (!param_size_mismatch && parameters.coordinates.size() < 2 && parameters.session.empty())
     {
         help = "Number of coordinates needs to be at least two.";
     }
 
+    if (parameters.end_session && parameters.session.empty())
+    {
+        help = "end_session requires a session.";
+    }
+
     return help;
 }
 } // anon. ns
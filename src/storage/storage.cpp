@@ -17,6 +17,7 @@
 #include "util/exception_utils.hpp"
 #include "util/fingerprint.hpp"
 #include "util/log.hpp"
+#include "util/timing_util.hpp"
 
 #ifdef __linux__
 #include <sys/mman.h>
@@ -28,9 +29,12 @@
 #include <boost/interprocess/sync/file_lock.hpp>
 #include <boost/interprocess/sync/scoped_lock.hpp>
 
+#include <tbb/parallel_for.h>
+
 #include <cstdint>
 
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <iterator>
 #include <new>
@@ -52,7 +56,8 @@ struct RegionHandle
 };
 
 RegionHandle setupRegion(SharedRegionRegister &shared_register,
-                         const storage::BaseDataLayout &layout)
+                         const storage::BaseDataLayout &layout,
+                         const bool use_hugepages)
 {
     // This is safe because we have an exclusive lock for all osrm-datastore processes.
     auto shm_key = shared_register.ReserveKey();
@@ -76,7 +81,7 @@ RegionHandle setupRegion(SharedRegionRegister &shared_register,
     auto regions_size = encoded_static_layout.size() + layout.GetSizeOfLayout();
     util::Log() << "Data layout has a size of " << encoded_static_layout.size() << " bytes";
     util::Log() << "Allocating shared memory of " << regions_size << " bytes";
-    auto memory = makeSharedMemory(shm_key, regions_size);
+    auto memory = makeSharedMemory(shm_key, regions_size, use_hugepages);
 
     // Copy memory static_layout to shared memory and populate data
     char *shared_memory_ptr = static_cast<char *>(memory->Ptr());
@@ -165,6 +170,14 @@ bool swapData(Monitor &monitor,
 
     return true;
 }
+
+// Runs independent file loaders in parallel. Each loader reads one file into its own blocks.
+void runLoaders(const std::vector<std::function<void()>> &loaders)
+{
+    tbb::parallel_for(std::size_t{0}, loaders.size(), [&loaders](const std::size_t index) {
+        loaders[index]();
+    });
+}
 }
 
 void populateLayoutFromFile(const boost::filesystem::path &path, storage::BaseDataLayout &layout)
@@ -187,7 +200,10 @@ void populateLayoutFromFile(const boost::filesystem::path &path, storage::BaseDa
 
 Storage::Storage(StorageConfig config_) : config(std::move(config_)) {}
 
-int Storage::Run(int max_wait, const std::string &dataset_name, bool only_metric)
+int Storage::Run(int max_wait,
+                 const std::string &dataset_name,
+                 bool only_metric,
+                 bool use_hugepages)
 {
     BOOST_ASSERT_MSG(config.IsValid(), "Invalid storage config");
 
@@ -262,7 +278,7 @@ int Storage::Run(int max_wait, const std::string &dataset_name, bool only_metric
         Storage::PopulateLayoutWithRTree(*static_layout);
         std::vector<std::pair<bool, boost::filesystem::path>> files = Storage::GetStaticFiles();
         Storage::PopulateLayout(*static_layout, files);
-        auto static_handle = setupRegion(shared_register, *static_layout);
+        auto static_handle = setupRegion(shared_register, *static_layout, use_hugepages);
         regions.push_back({static_handle.data_ptr, std::move(static_layout)});
         handles[dataset_name + "/static"] = std::move(static_handle);
     }
@@ -271,7 +287,7 @@ int Storage::Run(int max_wait, const std::string &dataset_name, bool only_metric
         std::make_unique<storage::ContiguousDataLayout>();
     std::vector<std::pair<bool, boost::filesystem::path>> files = Storage::GetUpdatableFiles();
     Storage::PopulateLayout(*updatable_layout, files);
-    auto updatable_handle = setupRegion(shared_register, *updatable_layout);
+    auto updatable_handle = setupRegion(shared_register, *updatable_layout, use_hugepages);
     regions.push_back({updatable_handle.data_ptr, std::move(updatable_layout)});
     handles[dataset_name + "/updatable"] = std::move(updatable_handle);
 
@@ -380,9 +396,26 @@ void Storage::PopulateLayout(storage::BaseDataLayout &layout,
 void Storage::PopulateStaticData(const SharedDataIndex &index)
 {
     // read actual data into shared memory object //
+    TIMER_START(load_static);
 
-    // store the filename of the on-disk portion of the RTree
+    // FIXME we only need to get the weight name
+    std::string metric_name;
+    // load profile properties
     {
+        const auto profile_properties_ptr =
+            index.GetBlockPtr<extractor::ProfileProperties>("/common/properties");
+        extractor::files::readProfileProperties(config.GetPath(".osrm.properties"),
+                                                *profile_properties_ptr);
+
+        metric_name = profile_properties_ptr->GetWeightName();
+    }
+
+    // All files are written to disjoint blocks of the shared memory region, so they can
+    // be read (and their fingerprints verified) concurrently.
+    std::vector<std::function<void()>> loaders;
+
+    // store the filename of the on-disk portion of the RTree
+    loaders.push_back([&] {
         const auto file_index_path_ptr = index.GetBlockPtr<char>("/common/rtree/file_index_path");
         // make sure we have 0 ending
         std::fill(file_index_path_ptr,
@@ -394,16 +427,16 @@ void Storage::PopulateStaticData(const SharedDataIndex &index)
                          "/common/rtree/file_index_path")) >= absolute_file_index_path.size());
         std::copy(
             absolute_file_index_path.begin(), absolute_file_index_path.end(), file_index_path_ptr);
-    }
+    });
 
     // Name data
-    {
+    loaders.push_back([&] {
         auto name_table = make_name_table_view(index, "/common/names");
         extractor::files::readNames(config.GetPath(".osrm.names"), name_table);
-    }
+    });
 
     // Timestamp mark
-    {
+    loaders.push_back([&] {
         auto timestamp_ref = make_timestamp_view(index, "/common/timestamp");
         std::string ts;
         extractor::files::readTimestamp(config.GetPath(".osrm.timestamp"), ts);
@@ -411,29 +444,29 @@ void Storage::PopulateStaticData(const SharedDataIndex &index)
         {
             memcpy(const_cast<char *>(timestamp_ref.data()), ts.data(), ts.size());
         }
-    }
+    });
 
     // Turn lane data
-    {
+    loaders.push_back([&] {
         auto turn_lane_data = make_lane_data_view(index, "/common/turn_lanes");
         extractor::files::readTurnLaneData(config.GetPath(".osrm.tld"), turn_lane_data);
-    }
+    });
 
     // Turn lane descriptions
-    {
+    loaders.push_back([&] {
         auto views = make_turn_lane_description_views(index, "/common/turn_lanes");
         extractor::files::readTurnLaneDescriptions(
             config.GetPath(".osrm.tls"), std::get<0>(views), std::get<1>(views));
-    }
+    });
 
     // Load edge-based nodes data
-    {
+    loaders.push_back([&] {
         auto node_data = make_ebn_data_view(index, "/common/ebg_node_data");
         extractor::files::readNodeData(config.GetPath(".osrm.ebg_nodes"), node_data);
-    }
+    });
 
     // Load original edge data
-    {
+    loaders.push_back([&] {
         auto turn_data = make_turn_data_view(index, "/common/turn_data");
 
         auto connectivity_checksum_ptr =
@@ -441,160 +474,176 @@ void Storage::PopulateStaticData(const SharedDataIndex &index)
 
         guidance::files::readTurnData(
             config.GetPath(".osrm.edges"), turn_data, *connectivity_checksum_ptr);
-    }
+    });
 
     // Loading list of coordinates
-    {
+    loaders.push_back([&] {
         auto views = make_nbn_data_view(index, "/common/nbn_data");
         extractor::files::readNodes(
             config.GetPath(".osrm.nbg_nodes"), std::get<0>(views), std::get<1>(views));
-    }
+    });
 
     // store search tree portion of rtree
-    {
+    loaders.push_back([&] {
         auto rtree = make_search_tree_view(index, "/common/rtree");
         extractor::files::readRamIndex(config.GetPath(".osrm.ramIndex"), rtree);
-    }
-
-    // FIXME we only need to get the weight name
-    std::string metric_name;
-    // load profile properties
-    {
-        const auto profile_properties_ptr =
-            index.GetBlockPtr<extractor::ProfileProperties>("/common/properties");
-        extractor::files::readProfileProperties(config.GetPath(".osrm.properties"),
-                                                *profile_properties_ptr);
-
-        metric_name = profile_properties_ptr->GetWeightName();
-    }
+    });
 
     // Load intersection data
-    {
+    loaders.push_back([&] {
         auto intersection_bearings_view =
             make_intersection_bearings_view(index, "/common/intersection_bearings");
         auto entry_classes = make_entry_classes_view(index, "/common/entry_classes");
         extractor::files::readIntersections(
             config.GetPath(".osrm.icd"), intersection_bearings_view, entry_classes);
-    }
+    });
 
     if (boost::filesystem::exists(config.GetPath(".osrm.partition")))
     {
-        auto mlp = make_partition_view(index, "/mld/multilevelpartition");
-        partitioner::files::readPartition(config.GetPath(".osrm.partition"), mlp);
+        loaders.push_back([&] {
+            auto mlp = make_partition_view(index, "/mld/multilevelpartition");
+            partitioner::files::readPartition(config.GetPath(".osrm.partition"), mlp);
+        });
     }
 
     if (boost::filesystem::exists(config.GetPath(".osrm.cells")))
     {
-        auto storage = make_cell_storage_view(index, "/mld/cellstorage");
-        partitioner::files::readCells(config.GetPath(".osrm.cells"), storage);
+        loaders.push_back([&] {
+            auto storage = make_cell_storage_view(index, "/mld/cellstorage");
+            partitioner::files::readCells(config.GetPath(".osrm.cells"), storage);
+        });
     }
 
     if (boost::filesystem::exists(config.GetPath(".osrm.cell_metrics")))
     {
-        auto exclude_metrics = make_cell_metric_view(index, "/mld/metrics/" + metric_name);
-        std::unordered_map<std::string, std::vector<customizer::CellMetricView>> metrics = {
-            {metric_name, std::move(exclude_metrics)},
-        };
-        customizer::files::readCellMetrics(config.GetPath(".osrm.cell_metrics"), metrics);
+        loaders.push_back([&] {
+            auto exclude_metrics = make_cell_metric_view(index, "/mld/metrics/" + metric_name);
+            std::unordered_map<std::string, std::vector<customizer::CellMetricView>> metrics = {
+                {metric_name, std::move(exclude_metrics)},
+            };
+            customizer::files::readCellMetrics(config.GetPath(".osrm.cell_metrics"), metrics);
+        });
     }
 
     // load maneuver overrides
-    {
+    loaders.push_back([&] {
         auto views = make_maneuver_overrides_views(index, "/common/maneuver_overrides");
         extractor::files::readManeuverOverrides(
             config.GetPath(".osrm.maneuver_overrides"), std::get<0>(views), std::get<1>(views));
-    }
+    });
+
+    runLoaders(loaders);
+
+    TIMER_STOP(load_static);
+    util::Log() << "Loading static data took " << TIMER_MSEC(load_static) << "ms";
 }
 
 void Storage::PopulateUpdatableData(const SharedDataIndex &index)
 {
-    // load compressed geometry
+    TIMER_START(load_updatable);
+
+    // FIXME we only need to get the weight name
+    std::string metric_name;
+    // load profile properties
     {
+        extractor::ProfileProperties properties;
+        extractor::files::readProfileProperties(config.GetPath(".osrm.properties"), properties);
+
+        metric_name = properties.GetWeightName();
+    }
+
+    // Same as for the static data, every file populates its own blocks.
+    // The connectivity checksum of the static data is only read here.
+    std::vector<std::function<void()>> loaders;
+
+    // load compressed geometry
+    loaders.push_back([&] {
         auto segment_data = make_segment_data_view(index, "/common/segment_data");
         extractor::files::readSegmentData(config.GetPath(".osrm.geometry"), segment_data);
-    }
+    });
 
-    {
+    loaders.push_back([&] {
         const auto datasources_names_ptr =
             index.GetBlockPtr<extractor::Datasources>("/common/data_sources_names");
         extractor::files::readDatasources(config.GetPath(".osrm.datasource_names"),
                                           *datasources_names_ptr);
-    }
+    });
 
     // load turn weight penalties
-    {
+    loaders.push_back([&] {
         auto turn_duration_penalties = make_turn_weight_view(index, "/common/turn_penalty");
         extractor::files::readTurnWeightPenalty(config.GetPath(".osrm.turn_weight_penalties"),
                                                 turn_duration_penalties);
-    }
+    });
 
     // load turn duration penalties
-    {
+    loaders.push_back([&] {
         auto turn_duration_penalties = make_turn_duration_view(index, "/common/turn_penalty");
         extractor::files::readTurnDurationPenalty(config.GetPath(".osrm.turn_duration_penalties"),
                                                   turn_duration_penalties);
-    }
+    });
 
-    // FIXME we only need to get the weight name
-    std::string metric_name;
-    // load profile properties
+    if (boost::filesystem::exists(config.GetPath(".osrm.hsgr")))
     {
-        extractor::ProfileProperties properties;
-        extractor::files::readProfileProperties(config.GetPath(".osrm.properties"), properties);
+        loaders.push_back([&] {
+            const std::string metric_prefix = "/ch/metrics/" + metric_name;
+            auto contracted_metric = make_contracted_metric_view(index, metric_prefix);
+            std::unordered_map<std::string, contractor::ContractedMetricView> metrics = {
+                {metric_name, std::move(contracted_metric)}};
 
-        metric_name = properties.GetWeightName();
-    }
+            std::uint32_t graph_connectivity_checksum = 0;
+            contractor::files::readGraph(
+                config.GetPath(".osrm.hsgr"), metrics, graph_connectivity_checksum);
 
-    if (boost::filesystem::exists(config.GetPath(".osrm.hsgr")))
-    {
-        const std::string metric_prefix = "/ch/metrics/" + metric_name;
-        auto contracted_metric = make_contracted_metric_view(index, metric_prefix);
-        std::unordered_map<std::string, contractor::ContractedMetricView> metrics = {
-            {metric_name, std::move(contracted_metric)}};
-
-        std::uint32_t graph_connectivity_checksum = 0;
-        contractor::files::readGraph(
-            config.GetPath(".osrm.hsgr"), metrics, graph_connectivity_checksum);
-
-        auto turns_connectivity_checksum =
-            *index.GetBlockPtr<std::uint32_t>("/common/connectivity_checksum");
-        if (turns_connectivity_checksum != graph_connectivity_checksum)
-        {
-            throw util::exception(
-                "Connectivity checksum " + std::to_string(graph_connectivity_checksum) + " in " +
-                config.GetPath(".osrm.hsgr").string() + " does not equal to checksum " +
-                std::to_string(turns_connectivity_checksum) + " in " +
-                config.GetPath(".osrm.edges").string());
-        }
+            auto turns_connectivity_checksum =
+                *index.GetBlockPtr<std::uint32_t>("/common/connectivity_checksum");
+            if (turns_connectivity_checksum != graph_connectivity_checksum)
+            {
+                throw util::exception(
+                    "Connectivity checksum " + std::to_string(graph_connectivity_checksum) +
+                    " in " + config.GetPath(".osrm.hsgr").string() +
+                    " does not equal to checksum " + std::to_string(turns_connectivity_checksum) +
+                    " in " + config.GetPath(".osrm.edges").string());
+            }
+        });
     }
 
     if (boost::filesystem::exists(config.GetPath(".osrm.cell_metrics")))
     {
-        auto exclude_metrics = make_cell_metric_view(index, "/mld/metrics/" + metric_name);
-        std::unordered_map<std::string, std::vector<customizer::CellMetricView>> metrics = {
-            {metric_name, std::move(exclude_metrics)},
-        };
-        customizer::files::readCellMetrics(config.GetPath(".osrm.cell_metrics"), metrics);
+        loaders.push_back([&] {
+            auto exclude_metrics = make_cell_metric_view(index, "/mld/metrics/" + metric_name);
+            std::unordered_map<std::string, std::vector<customizer::CellMetricView>> metrics = {
+                {metric_name, std::move(exclude_metrics)},
+            };
+            customizer::files::readCellMetrics(config.GetPath(".osrm.cell_metrics"), metrics);
+        });
     }
 
     if (boost::filesystem::exists(config.GetPath(".osrm.mldgr")))
     {
-        auto graph_view = make_multi_level_graph_view(index, "/mld/multilevelgraph");
-        std::uint32_t graph_connectivity_checksum = 0;
-        customizer::files::readGraph(
-            config.GetPath(".osrm.mldgr"), graph_view, graph_connectivity_checksum);
-
-        auto turns_connectivity_checksum =
-            *index.GetBlockPtr<std::uint32_t>("/common/connectivity_checksum");
-        if (turns_connectivity_checksum != graph_connectivity_checksum)
-        {
-            throw util::exception(
-                "Connectivity checksum " + std::to_string(graph_connectivity_checksum) + " in " +
-                config.GetPath(".osrm.hsgr").string() + " does not equal to checksum " +
-                std::to_string(turns_connectivity_checksum) + " in " +
-                config.GetPath(".osrm.edges").string());
-        }
+        loaders.push_back([&] {
+            auto graph_view = make_multi_level_graph_view(index, "/mld/multilevelgraph");
+            std::uint32_t graph_connectivity_checksum = 0;
+            customizer::files::readGraph(
+                config.GetPath(".osrm.mldgr"), graph_view, graph_connectivity_checksum);
+
+            auto turns_connectivity_checksum =
+                *index.GetBlockPtr<std::uint32_t>("/common/connectivity_checksum");
+            if (turns_connectivity_checksum != graph_connectivity_checksum)
+            {
+                throw util::exception(
+                    "Connectivity checksum " + std::to_string(graph_connectivity_checksum) +
+                    " in " + config.GetPath(".osrm.hsgr").string() +
+                    " does not equal to checksum " + std::to_string(turns_connectivity_checksum) +
+                    " in " + config.GetPath(".osrm.edges").string());
+            }
+        });
     }
+
+    runLoaders(loaders);
+
+    TIMER_STOP(load_updatable);
+    util::Log() << "Loading updatable data took " << TIMER_MSEC(load_updatable) << "ms";
 }
 }
 }
@@ -42,7 +42,7 @@ return_code parseArguments(int argc,
         "profile,p",
         boost::program_options::value<boost::filesystem::path>(&extractor_config.profile_path)
             ->default_value("profiles/car.lua"),
-        "Path to LUA routing profile")(
+        "Path to LUA routing profile or to a compiled native profile (.so)")(
         "data_version,d",
         boost::program_options::value<std::string>(&extractor_config.data_version)
             ->default_value(""),
@@ -1,6 +1,7 @@
 #include "server/server.hpp"
 #include "util/exception_utils.hpp"
 #include "util/log.hpp"
+#include "util/rectangle.hpp"
 #include "util/meminfo.hpp"
 #include "util/version.hpp"
 
@@ -71,6 +72,29 @@ std::istream &operator>>(std::istream &in, EngineConfig::Algorithm &algorithm)
     return in;
 }
 } // namespace engine
+
+namespace util
+{
+// parses a bounding box given as min_lon,min_lat,max_lon,max_lat
+std::istream &operator>>(std::istream &in, RectangleInt2D &region)
+{
+    double min_lon, min_lat, max_lon, max_lat;
+    char sep1, sep2, sep3;
+    in >> min_lon >> sep1 >> min_lat >> sep2 >> max_lon >> sep3 >> max_lat;
+    if (in && sep1 == ',' && sep2 == ',' && sep3 == ',')
+    {
+        region = RectangleInt2D{FloatLongitude{min_lon},
+                                FloatLongitude{max_lon},
+                                FloatLatitude{min_lat},
+                                FloatLatitude{max_lat}};
+    }
+    else
+    {
+        in.setstate(std::ios::failbit);
+    }
+    return in;
+}
+} // namespace util
 } // namespace osrm
 
 // generate boost::program_options object for the routing part
@@ -148,9 +172,16 @@ inline unsigned generateServerProgramOptions(const int argc,
         ("max-alternatives",
          value<int>(&config.max_alternatives)->default_value(3),
          "Max. number of alternatives supported in the MLD route query") //
+        ("alternatives-time-budget",
+         value<int>(&config.alternatives_time_budget)->default_value(0),
+         "Max. milliseconds spent unpacking MLD alternatives. Default: unlimited.") //
         ("max-matching-radius",
          value<double>(&config.max_radius_map_matching)->default_value(-1.0),
-         "Max. radius size supported in map matching query. Default: unlimited.");
+         "Max. radius size supported in map matching query. Default: unlimited.") //
+        ("region",
+         value<util::RectangleInt2D>(&config.region),
+         "Reject requests with coordinates outside of the bounding box "
+         "min_lon,min_lat,max_lon,max_lat. The whole dataset is still loaded.");
 
     // hidden options, will be allowed on command line, but will not be shown to the user
     boost::program_options::options_description hidden_options("Hidden options");
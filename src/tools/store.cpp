@@ -100,7 +100,8 @@ bool generateDataStoreOptions(const int argc,
                               std::string &dataset_name,
                               bool &list_datasets,
                               bool &list_blocks,
-                              bool &only_metric)
+                              bool &only_metric,
+                              bool &use_hugepages)
 {
     // declare a group of options that will be allowed only on command line
     boost::program_options::options_description generic_options("Options");
@@ -141,7 +142,14 @@ bool generateDataStoreOptions(const int argc,
                 ->implicit_value(true),
             "Only reload the metric data without updating the full dataset. This is an "
             "optimization "
-            "for traffic updates.");
+            "for traffic updates.")(
+            "hugepages",
+            boost::program_options::value<bool>(&use_hugepages)
+                ->default_value(false)
+                ->implicit_value(true),
+            "Allocate the shared memory regions with huge pages (Linux only). Needs huge pages "
+            "reserved in vm.nr_hugepages and a user in vm.hugetlb_shm_group, falls back to "
+            "normal pages otherwise.");
 
     // hidden options, will be allowed on command line but will not be shown to the user
     boost::program_options::options_description hidden_options("Hidden options");
@@ -238,6 +246,7 @@ int main(const int argc, const char *argv[]) try
     bool list_datasets = false;
     bool list_blocks = false;
     bool only_metric = false;
+    bool use_hugepages = false;
     if (!generateDataStoreOptions(argc,
                                   argv,
                                   verbosity,
@@ -246,7 +255,8 @@ int main(const int argc, const char *argv[]) try
                                   dataset_name,
                                   list_datasets,
                                   list_blocks,
-                                  only_metric))
+                                  only_metric,
+                                  use_hugepages))
     {
         return EXIT_SUCCESS;
     }
@@ -267,7 +277,7 @@ int main(const int argc, const char *argv[]) try
     }
     storage::Storage storage(std::move(config));
 
-    return storage.Run(max_wait, dataset_name, only_metric);
+    return storage.Run(max_wait, dataset_name, only_metric, use_hugepages);
 }
 catch (const osrm::RuntimeError &e)
 {
@@ -0,0 +1,232 @@
+#include "util/douglas_peucker.hpp"
+#include "util/coordinate.hpp"
+#include "util/integer_range.hpp"
+#include "util/web_mercator.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace util
+{
+
+namespace
+{
+// Computes the squared distances of the points in (first, last) to the segment between the points
+// first and last. The coordinates are web mercator projected and scaled like fixed coordinates,
+// so the distances are normed to the thresholds table. The loop has no branches and works on
+// separate arrays of x and y coordinates so that it can be vectorized.
+void perpendicularDistances(const std::vector<double> &x,
+                            const std::vector<double> &y,
+                            const std::size_t first,
+                            const std::size_t last,
+                            std::vector<double> &distances)
+{
+    const double source_x = x[first];
+    const double source_y = y[first];
+    const double slope_x = x[last] - source_x;
+    const double slope_y = y[last] - source_y;
+    const double squared_length = slope_x * slope_x + slope_y * slope_y;
+    // degenerated segments are measured from their start
+    const double inverse_squared_length = squared_length > 0. ? 1. / squared_length : 0.;
+
+    const double *const __restrict x_data = x.data();
+    const double *const __restrict y_data = y.data();
+    double *const __restrict distance_data = distances.data();
+    for (auto idx = first + 1; idx < last; ++idx)
+    {
+        const double relative_x = x_data[idx] - source_x;
+        const double relative_y = y_data[idx] - source_y;
+        const double unnormed_ratio = slope_x * relative_x + slope_y * relative_y;
+        const double ratio = std::min(1., std::max(0., unnormed_ratio * inverse_squared_length));
+        const double delta_x = relative_x - ratio * slope_x;
+        const double delta_y = relative_y - ratio * slope_y;
+        distance_data[idx] = delta_x * delta_x + delta_y * delta_y;
+    }
+}
+
+// Projects the coordinates to web mercator in units of COORDINATE_PRECISION
+void projectCoordinates(std::vector<util::Coordinate>::const_iterator begin,
+                        const std::size_t size,
+                        std::vector<double> &x,
+                        std::vector<double> &y)
+{
+    x.resize(size);
+    y.resize(size);
+    for (auto idx : util::irange<std::size_t>(0UL, size))
+    {
+        const util::FloatCoordinate projected = util::web_mercator::fromWGS84(begin[idx]);
+        x[idx] = static_cast<double>(projected.lon) * COORDINATE_PRECISION;
+        y[idx] = static_cast<double>(projected.lat) * COORDINATE_PRECISION;
+    }
+}
+
+// Finds the point of (first, last) that is farthest from the segment between first and last
+std::pair<std::size_t, double> findFarthestPoint(const std::vector<double> &distances,
+                                                 const std::size_t first,
+                                                 const std::size_t last)
+{
+    double max_distance = 0.;
+    auto farthest_entry_index = last;
+    for (auto idx = first + 1; idx < last; ++idx)
+    {
+        if (distances[idx] > max_distance)
+        {
+            farthest_entry_index = idx;
+            max_distance = distances[idx];
+        }
+    }
+    return {farthest_entry_index, max_distance};
+}
+} // namespace
+
+std::vector<util::Coordinate> douglasPeucker(std::vector<util::Coordinate>::const_iterator begin,
+                                             std::vector<util::Coordinate>::const_iterator end,
+                                             const unsigned zoom_level)
+{
+    BOOST_ASSERT_MSG(zoom_level < detail::DOUGLAS_PEUCKER_THRESHOLDS_SIZE,
+                     "unsupported zoom level");
+
+    const std::size_t size = std::distance(begin, end);
+    if (size < 2)
+    {
+        return {};
+    }
+
+    std::vector<double> x, y;
+    projectCoordinates(begin, size, x, y);
+    std::vector<double> distances(size);
+
+    const auto threshold = static_cast<double>(detail::DOUGLAS_PEUCKER_THRESHOLDS[zoom_level]);
+
+    std::vector<bool> is_necessary(size, false);
+    BOOST_ASSERT(is_necessary.size() >= 2);
+    is_necessary.front() = true;
+    is_necessary.back() = true;
+    using GeometryRange = std::pair<std::size_t, std::size_t>;
+
+    std::vector<GeometryRange> recursion_stack;
+    recursion_stack.emplace_back(0UL, size - 1);
+
+    // mark locations as 'necessary' by divide-and-conquer
+    while (!recursion_stack.empty())
+    {
+        // pop next element
+        const GeometryRange pair = recursion_stack.back();
+        recursion_stack.pop_back();
+        // sanity checks
+        BOOST_ASSERT_MSG(is_necessary[pair.first], "left border must be necessary");
+        BOOST_ASSERT_MSG(is_necessary[pair.second], "right border must be necessary");
+        BOOST_ASSERT_MSG(pair.second < size, "right border outside of geometry");
+        BOOST_ASSERT_MSG(pair.first <= pair.second, "left border on the wrong side");
+
+        perpendicularDistances(x, y, pair.first, pair.second, distances);
+
+        std::size_t farthest_entry_index;
+        double max_distance;
+        std::tie(farthest_entry_index, max_distance) =
+            findFarthestPoint(distances, pair.first, pair.second);
+
+        // check if maximum violates a zoom level dependent threshold
+        if (max_distance > threshold)
+        {
+            //  mark idx as necessary
+            is_necessary[farthest_entry_index] = true;
+            if (pair.first + 1 < farthest_entry_index)
+            {
+                recursion_stack.emplace_back(pair.first, farthest_entry_index);
+            }
+            if (farthest_entry_index + 1 < pair.second)
+            {
+                recursion_stack.emplace_back(farthest_entry_index, pair.second);
+            }
+        }
+    }
+
+    auto simplified_size = std::count(is_necessary.begin(), is_necessary.end(), true);
+    std::vector<util::Coordinate> simplified_geometry;
+    simplified_geometry.reserve(simplified_size);
+    for (auto idx : util::irange<std::size_t>(0UL, size))
+    {
+        if (is_necessary[idx])
+        {
+            simplified_geometry.push_back(begin[idx]);
+        }
+    }
+
+    return simplified_geometry;
+}
+
+std::vector<std::uint8_t> douglasPeuckerZoomLevels(std::vector<Coordinate>::const_iterator begin,
+                                                   std::vector<Coordinate>::const_iterator end)
+{
+    const std::size_t size = std::distance(begin, end);
+    std::vector<std::uint8_t> zoom_levels(size, DOUGLAS_PEUCKER_NEVER);
+    if (size < 2)
+    {
+        std::fill(zoom_levels.begin(), zoom_levels.end(), 0);
+        return zoom_levels;
+    }
+
+    std::vector<double> x, y;
+    projectCoordinates(begin, size, x, y);
+    std::vector<double> distances(size);
+
+    zoom_levels.front() = 0;
+    zoom_levels.back() = 0;
+
+    // ranges of the recursion and the zoom level from which on they are split at all
+    struct GeometryRange
+    {
+        std::size_t first;
+        std::size_t last;
+        std::uint8_t zoom_level;
+    };
+    std::vector<GeometryRange> recursion_stack;
+    recursion_stack.push_back({0UL, size - 1, 0});
+
+    while (!recursion_stack.empty())
+    {
+        const GeometryRange range = recursion_stack.back();
+        recursion_stack.pop_back();
+
+        perpendicularDistances(x, y, range.first, range.last, distances);
+
+        std::size_t farthest_entry_index;
+        double max_distance;
+        std::tie(farthest_entry_index, max_distance) =
+            findFarthestPoint(distances, range.first, range.last);
+
+        // the thresholds are decreasing, find the first zoom level the maximum violates
+        auto zoom_level = range.zoom_level;
+        while (zoom_level < detail::DOUGLAS_PEUCKER_THRESHOLDS_SIZE &&
+               max_distance <= detail::DOUGLAS_PEUCKER_THRESHOLDS[zoom_level])
+        {
+            ++zoom_level;
+        }
+
+        if (zoom_level < detail::DOUGLAS_PEUCKER_THRESHOLDS_SIZE)
+        {
+            zoom_levels[farthest_entry_index] = zoom_level;
+            if (range.first + 1 < farthest_entry_index)
+            {
+                recursion_stack.push_back({range.first, farthest_entry_index, zoom_level});
+            }
+            if (farthest_entry_index + 1 < range.last)
+            {
+                recursion_stack.push_back({farthest_entry_index, range.last, zoom_level});
+            }
+        }
+    }
+
+    return zoom_levels;
+}
+} // ns util
+} // ns osrm
@@ -0,0 +1,107 @@
+var OSRM = require('../../');
+var test = require('tape');
+var data_path = require('./constants').data_path;
+var mld_data_path = require('./constants').mld_data_path;
+var three_test_coordinates = require('./constants').three_test_coordinates;
+var two_test_coordinates = require('./constants').two_test_coordinates;
+
+
+test('batch: runs queries of several services', function(assert) {
+    assert.plan(6);
+    var osrm = new OSRM(data_path);
+    osrm.batch([
+        {service: 'route', options: {coordinates: two_test_coordinates}},
+        {service: 'nearest', options: {coordinates: [three_test_coordinates[0]]}},
+        {service: 'table', options: {coordinates: three_test_coordinates}}
+    ], function(err, results) {
+        assert.ifError(err);
+        assert.equal(results.length, 3);
+        assert.ok(results[0].routes.length);
+        assert.equal(results[1].waypoints.length, 1);
+        assert.equal(results[2].durations.length, 3);
+        assert.notOk(results[0].hasOwnProperty('code'));
+    });
+});
+
+test('batch: returns JSON buffers', function(assert) {
+    assert.plan(4);
+    var osrm = new OSRM(data_path);
+    osrm.batch([
+        {service: 'route', options: {coordinates: two_test_coordinates}},
+        {service: 'trip', options: {coordinates: three_test_coordinates}}
+    ], { format: 'json_buffer' }, function(err, results) {
+        assert.ifError(err);
+        assert.ok(results[0] instanceof Buffer);
+        assert.ok(JSON.parse(results[0]).routes.length);
+        assert.ok(JSON.parse(results[1]).trips.length);
+    });
+});
+
+test('batch: failed queries do not fail the batch', function(assert) {
+    assert.plan(4);
+    var osrm = new OSRM(data_path);
+    osrm.batch([
+        {service: 'route', options: {coordinates: two_test_coordinates}},
+        {service: 'route', options: {coordinates: [[0, 0], [0.1, 0.1]], radiuses: [1, 1]}}
+    ], function(err, results) {
+        assert.ifError(err);
+        assert.ok(results[0].routes.length);
+        assert.ok(results[1] instanceof Error);
+        assert.equal(results[1].message, 'NoSegment');
+    });
+});
+
+test('batch: mixes alternatives and multi-waypoint routes on MLD', function(assert) {
+    var osrm = new OSRM({path: mld_data_path, algorithm: 'MLD'});
+    var queries = [];
+    for (var i = 0; i < 32; ++i) {
+        if (i % 2 === 0)
+            queries.push({service: 'route', options: {coordinates: two_test_coordinates, alternatives: true}});
+        else
+            queries.push({service: 'route', options: {coordinates: three_test_coordinates, steps: true}});
+    }
+    assert.plan(3 + 2 * queries.length);
+
+    // Every query of the batch has to find the same shortest route as when run on its own.
+    // Which alternatives are found depends on the time budget, so they are not compared.
+    osrm.route(queries[0].options, function(err, alternatives) {
+        assert.ifError(err);
+        osrm.route(queries[1].options, function(err, via) {
+            assert.ifError(err);
+            osrm.batch(queries, function(err, results) {
+                assert.ifError(err);
+                results.forEach(function(result, index) {
+                    var expected = index % 2 === 0 ? alternatives : via;
+                    assert.notOk(result instanceof Error);
+                    assert.deepEqual(result.routes[0], expected.routes[0]);
+                });
+            });
+        });
+    });
+});
+
+test('batch: runs an empty batch', function(assert) {
+    assert.plan(2);
+    var osrm = new OSRM(data_path);
+    osrm.batch([], function(err, results) {
+        assert.ifError(err);
+        assert.deepEqual(results, []);
+    });
+});
+
+test('batch: throws with too few or invalid args', function(assert) {
+    assert.plan(6);
+    var osrm = new OSRM(data_path);
+    assert.throws(function() { osrm.batch([]) },
+        /Two arguments required/);
+    assert.throws(function() { osrm.batch({}, function(err, results) {}) },
+        /First arg must be an array of queries/);
+    assert.throws(function() { osrm.batch([true], function(err, results) {}) },
+        /Each query must be an object with service and options/);
+    assert.throws(function() { osrm.batch([{service: 'tile', options: [0, 0, 0]}], function(err, results) {}) },
+        /service must be a string/);
+    assert.throws(function() { osrm.batch([{service: 'route', options: {}}], function(err, results) {}) },
+        /Must provide a coordinates property/);
+    assert.throws(function() { osrm.batch([], true) },
+        /last argument must be a callback function/);
+});
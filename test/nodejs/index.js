@@ -149,3 +149,4 @@ require('./match.js');
 require('./tile.js');
 require('./table.js');
 require('./nearest.js');
+require('./batch.js');
@@ -592,6 +592,27 @@ test('route:  in Monaco with custom limits on MLD', function(assert) {
     });
 });
 
+test('route: rejects coordinates outside of the region', function(assert) {
+    assert.plan(2);
+    var osrm = new OSRM({path: monaco_path, region: [7.41, 43.72, 7.416, 43.735]});
+    osrm.route({coordinates: two_test_coordinates}, function(err, route) {
+        assert.ifError(err);
+    });
+    osrm.route({coordinates: three_test_coordinates}, function(err, route) {
+        assert.equal(err.message, 'InvalidValue');
+    });
+});
+
+test('route: throws on invalid regions', function(assert) {
+    assert.plan(3);
+    assert.throws(function() { new OSRM({path: monaco_path, region: [7.41, 43.72, 7.416]}); },
+        /region must be an array/);
+    assert.throws(function() { new OSRM({path: monaco_path, region: [7.41, 43.72, 7.416, '43.735']}); },
+        /region must be an array/);
+    assert.throws(function() { new OSRM({path: monaco_path, region: [7.416, 43.72, 7.41, 43.735]}); },
+        /region must be a valid bounding box/);
+});
+
 test('route: route in Monaco without motorways', function(assert) {
     assert.plan(3);
     var osrm = new OSRM({path: monaco_mld_path, algorithm: 'MLD'});
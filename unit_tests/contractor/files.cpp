@@ -1,3 +1,4 @@
+#include "contractor/contracted_metric.hpp"
 #include "contractor/files.hpp"
 #include "contractor/graph_contractor_adaptors.hpp"
 
@@ -23,7 +24,6 @@ BOOST_AUTO_TEST_CASE(read_write_hsgr)
                                    TestEdge{3, 1, 1},
                                    TestEdge{4, 3, 1},
                                    TestEdge{5, 1, 1}};
-    auto reference_graph = QueryGraph{6, toEdges<QueryEdge>(makeGraph(edges))};
     std::vector<std::vector<bool>> reference_filters = {
         {false, false, true, true, false, false, true},
         {true, false, true, false, true, false, true},
@@ -32,7 +32,8 @@ BOOST_AUTO_TEST_CASE(read_write_hsgr)
     };
 
     std::unordered_map<std::string, ContractedMetric> reference_metrics = {
-        {"duration", {std::move(reference_graph), std::move(reference_filters)}}};
+        {"duration",
+         makeContractedMetric(6, toEdges<QueryEdge>(makeGraph(edges)), reference_filters)}};
 
     TemporaryFile tmp{TEST_DATA_DIR "/read_write_hsgr_test.osrm.hsgr"};
     contractor::files::writeGraph(tmp.path, reference_metrics, reference_connectivity_checksum);
@@ -43,6 +44,12 @@ BOOST_AUTO_TEST_CASE(read_write_hsgr)
     contractor::files::readGraph(tmp.path, metrics, connectivity_checksum);
 
     BOOST_CHECK_EQUAL(connectivity_checksum, reference_connectivity_checksum);
+    BOOST_CHECK_EQUAL(metrics["duration"].graph.GetNumberOfEdges(),
+                      reference_metrics["duration"].graph.GetNumberOfEdges());
+    CHECK_EQUAL_COLLECTIONS(metrics["duration"].durations,
+                            reference_metrics["duration"].durations);
+    CHECK_EQUAL_COLLECTIONS(metrics["duration"].distances,
+                            reference_metrics["duration"].distances);
     BOOST_CHECK_EQUAL(metrics["duration"].edge_filter.size(),
                       reference_metrics["duration"].edge_filter.size());
     CHECK_EQUAL_COLLECTIONS(metrics["duration"].edge_filter[0],
@@ -36,6 +36,15 @@ BOOST_AUTO_TEST_CASE(rfc4648_test_vectors_roundtrip)
     BOOST_CHECK_EQUAL(decodeBase64(encodeBase64("foobar")), "foobar");
 }
 
+BOOST_AUTO_TEST_CASE(url_safe_alphabet)
+{
+    using namespace osrm::engine;
+
+    // Section 5 replaces '+' and '/' by '-' and '_', both alphabets are decoded
+    BOOST_CHECK_EQUAL(decodeBase64("+/8="), "\xfb\xff");
+    BOOST_CHECK_EQUAL(decodeBase64("-_8="), "\xfb\xff");
+}
+
 BOOST_AUTO_TEST_CASE(hint_encoding_decoding_roundtrip)
 {
     using namespace osrm::engine;
@@ -7,9 +7,18 @@
 #include "engine/guidance/assemble_steps.hpp"
 #include "engine/guidance/post_processing.hpp"
 
+#include "util/douglas_peucker.hpp"
+#include "util/viewport.hpp"
+#include "util/web_mercator.hpp"
+
 #include <boost/test/test_case_template.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
 BOOST_AUTO_TEST_SUITE(guidance_assembly)
 
 BOOST_AUTO_TEST_CASE(trim_short_segments)
@@ -106,4 +115,124 @@ BOOST_AUTO_TEST_CASE(trim_short_segments)
     BOOST_CHECK_EQUAL(geometry.osm_node_ids.size(), 2);
 }
 
+namespace
+{
+using osrm::util::Coordinate;
+
+// Squared distance of the point to the segment, measured in the projection and units of the
+// Douglas-Peucker thresholds
+double squaredDistance(const Coordinate point, const Coordinate source, const Coordinate target)
+{
+    const auto project = [](const Coordinate coordinate) {
+        const auto projected = osrm::util::web_mercator::fromWGS84(coordinate);
+        return std::make_pair(static_cast<double>(projected.lon) * osrm::COORDINATE_PRECISION,
+                              static_cast<double>(projected.lat) * osrm::COORDINATE_PRECISION);
+    };
+    const auto projected_point = project(point);
+    const auto projected_source = project(source);
+    const auto projected_target = project(target);
+
+    const double slope_x = projected_target.first - projected_source.first;
+    const double slope_y = projected_target.second - projected_source.second;
+    const double relative_x = projected_point.first - projected_source.first;
+    const double relative_y = projected_point.second - projected_source.second;
+    const double squared_length = slope_x * slope_x + slope_y * slope_y;
+    const double ratio =
+        squared_length > 0.
+            ? std::min(1., std::max(0., (slope_x * relative_x + slope_y * relative_y) /
+                                            squared_length))
+            : 0.;
+    const double delta_x = relative_x - ratio * slope_x;
+    const double delta_y = relative_y - ratio * slope_y;
+    return delta_x * delta_x + delta_y * delta_y;
+}
+
+// Largest squared distance of the geometry to the simplification, which has to consist of points
+// of the geometry in the same order
+double maxSquaredDeviation(const std::vector<Coordinate> &geometry,
+                           const std::vector<Coordinate> &simplified)
+{
+    BOOST_REQUIRE_GE(simplified.size(), 2);
+    BOOST_REQUIRE(simplified.front() == geometry.front());
+    BOOST_REQUIRE(simplified.back() == geometry.back());
+
+    double max_deviation = 0.;
+    std::size_t segment = 0;
+    for (const auto &point : geometry)
+    {
+        max_deviation = std::max(
+            max_deviation, squaredDistance(point, simplified[segment], simplified[segment + 1]));
+        if (point == simplified[segment + 1] && segment + 2 < simplified.size())
+            ++segment;
+    }
+    BOOST_CHECK_EQUAL(segment + 2, simplified.size());
+    return max_deviation;
+}
+}
+
+BOOST_AUTO_TEST_CASE(overview_with_zoom_levels_is_close_to_full_simplification)
+{
+    using namespace osrm::engine::guidance;
+    using namespace osrm::util;
+
+    // A winding leg through 20 compressed geometries of 200 nodes each
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> step(-0.0001, 0.0001);
+    const std::size_t number_of_geometries = 20;
+    const std::size_t geometry_size = 200;
+
+    LegGeometry leg;
+    double lon = 7.42, lat = 43.73;
+    leg.locations.push_back({FloatLongitude{lon}, FloatLatitude{lat}});
+    for (std::size_t geometry = 0; geometry < number_of_geometries; ++geometry)
+    {
+        const auto first = leg.locations.size() - 1;
+        for (std::size_t node = 1; node < geometry_size; ++node)
+        {
+            lon += 0.00005 + step(generator);
+            lat += step(generator);
+            leg.locations.push_back({FloatLongitude{lon}, FloatLatitude{lat}});
+        }
+
+        // the levels are precomputed per compressed geometry, which share their end nodes
+        const auto levels =
+            douglasPeuckerZoomLevels(leg.locations.begin() + first, leg.locations.end());
+        if (!leg.zoom_levels.empty())
+            leg.zoom_levels.pop_back();
+        leg.zoom_levels.insert(leg.zoom_levels.end(), levels.begin(), levels.end());
+    }
+    BOOST_REQUIRE_EQUAL(leg.zoom_levels.size(), leg.locations.size());
+
+    Coordinate south_west = leg.locations.front();
+    Coordinate north_east = leg.locations.front();
+    for (const auto &coordinate : leg.locations)
+    {
+        south_west.lon = std::min(south_west.lon, coordinate.lon);
+        south_west.lat = std::min(south_west.lat, coordinate.lat);
+        north_east.lon = std::max(north_east.lon, coordinate.lon);
+        north_east.lat = std::max(north_east.lat, coordinate.lat);
+    }
+    const auto zoom_level = std::min(18u, viewport::getFittedZoom(south_west, north_east));
+    const auto threshold =
+        static_cast<double>(osrm::util::detail::DOUGLAS_PEUCKER_THRESHOLDS[zoom_level]);
+
+    const auto reference = douglasPeucker(leg.locations, zoom_level);
+    const auto overview = assembleOverview({leg}, true);
+    BOOST_TEST_MESSAGE("z" << zoom_level << ": " << leg.locations.size() << " nodes, "
+                           << reference.size() << " after Douglas-Peucker, " << overview.size()
+                           << " in the overview");
+
+    // Every dropped node is within the threshold of the simplification of its compressed
+    // geometry, and the nodes of that simplification are within the threshold of the overview.
+    // So the overview deviates at most twice as much as the simplification of the whole leg may.
+    BOOST_CHECK_LE(maxSquaredDeviation(leg.locations, reference), threshold);
+    BOOST_CHECK_LE(maxSquaredDeviation(leg.locations, overview), 4 * threshold);
+    BOOST_CHECK_LT(overview.size(), leg.locations.size() / 4);
+
+    // without precomputed levels the whole leg is simplified
+    leg.zoom_levels.clear();
+    const auto full_overview = assembleOverview({leg}, true);
+    BOOST_CHECK(full_overview == reference);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,103 @@
+#include "engine/map_matching/hidden_markov_model.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(hidden_markov_model)
+
+using namespace osrm;
+using namespace osrm::engine::map_matching;
+
+using CandidateLists = std::vector<std::vector<int>>;
+using Model = HiddenMarkovModel<CandidateLists>;
+
+BOOST_AUTO_TEST_CASE(flat_rows)
+{
+    const CandidateLists candidates = {{1, 2}, {}, {3, 4, 5}};
+    const std::vector<std::vector<double>> emissions = {{-1., -2.}, {}, {-3., -4., -5.}};
+    HiddenMarkovModelStorage storage;
+    Model model(candidates, emissions, storage);
+
+    BOOST_CHECK_EQUAL(model.viterbi.size(), 3);
+    BOOST_CHECK_EQUAL(model.viterbi[0].size(), 2);
+    BOOST_CHECK_EQUAL(model.viterbi[1].size(), 0);
+    BOOST_CHECK_EQUAL(model.viterbi[2].size(), 3);
+    BOOST_CHECK_EQUAL(storage.viterbi.size(), 5);
+
+    BOOST_CHECK_EQUAL(model.initialize(0), 0);
+    BOOST_CHECK_EQUAL(model.viterbi[0][1], -2.);
+    BOOST_CHECK(model.parents[0][1] == std::make_pair(0u, 1u));
+    BOOST_CHECK(!model.pruned[0][0]);
+    BOOST_CHECK(!model.breakage[0]);
+    // states of other timestamps are not touched
+    BOOST_CHECK_EQUAL(model.viterbi[2][0], IMPOSSIBLE_LOG_PROB);
+    BOOST_CHECK(model.pruned[2][0]);
+
+    model.viterbi[2][2] = -6.;
+    model.Clear(1);
+    BOOST_CHECK_EQUAL(model.viterbi[0][1], -2.);
+    BOOST_CHECK_EQUAL(model.viterbi[2][2], IMPOSSIBLE_LOG_PROB);
+}
+
+BOOST_AUTO_TEST_CASE(append_and_trim)
+{
+    CandidateLists candidates = {{1, 2}, {3}};
+    std::vector<std::vector<double>> emissions = {{-1., -2.}, {-3.}};
+    HiddenMarkovModelStorage storage;
+    Model model(candidates, emissions, storage);
+
+    model.initialize(0);
+    model.viterbi[1][0] = -4.;
+    model.parents[1][0] = std::make_pair(0u, 1u);
+    model.pruned[1][0] = false;
+    model.breakage[1] = false;
+
+    candidates.push_back({4, 5});
+    emissions.push_back({-5., -6.});
+    model.Append();
+    BOOST_CHECK_EQUAL(model.viterbi.size(), 3);
+    BOOST_CHECK_EQUAL(model.viterbi[2].size(), 2);
+    BOOST_CHECK_EQUAL(model.viterbi[2][1], IMPOSSIBLE_LOG_PROB);
+    BOOST_CHECK(model.breakage[2]);
+    // existing states are kept
+    BOOST_CHECK_EQUAL(model.viterbi[1][0], -4.);
+
+    model.viterbi[2][1] = -7.;
+    model.parents[2][1] = std::make_pair(1u, 0u);
+
+    candidates.erase(candidates.begin());
+    emissions.erase(emissions.begin());
+    model.Trim(1);
+    BOOST_CHECK_EQUAL(model.viterbi.size(), 2);
+    BOOST_CHECK_EQUAL(model.viterbi[0][0], -4.);
+    BOOST_CHECK_EQUAL(model.viterbi[1][1], -7.);
+    BOOST_CHECK(!model.breakage[0]);
+    // parents are shifted and parents that were dropped turn the state into an initial one
+    BOOST_CHECK(model.parents[1][1] == std::make_pair(0u, 0u));
+    BOOST_CHECK(model.parents[0][0] == std::make_pair(0u, 0u));
+}
+
+BOOST_AUTO_TEST_CASE(storage_reuse)
+{
+    HiddenMarkovModelStorage storage;
+    {
+        const CandidateLists candidates = {{1, 2, 3}, {4, 5, 6}};
+        const std::vector<std::vector<double>> emissions = {{-1., -1., -1.}, {-1., -1., -1.}};
+        Model model(candidates, emissions, storage);
+        model.initialize(0);
+        model.viterbi[1][2] = -2.;
+    }
+
+    const auto capacity = storage.viterbi.capacity();
+    const CandidateLists candidates = {{1}, {2, 3}};
+    const std::vector<std::vector<double>> emissions = {{-1.}, {-2., -3.}};
+    Model model(candidates, emissions, storage);
+
+    BOOST_CHECK_EQUAL(storage.viterbi.capacity(), capacity);
+    BOOST_CHECK_EQUAL(model.viterbi[1].size(), 2);
+    BOOST_CHECK_EQUAL(model.viterbi[1][1], IMPOSSIBLE_LOG_PROB);
+    BOOST_CHECK(model.breakage[0] && model.breakage[1]);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
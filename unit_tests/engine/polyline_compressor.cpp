@@ -46,4 +46,26 @@ BOOST_AUTO_TEST_CASE(polyline6_test_case)
         decodePolyline<1000000>(encodePolyline<1000000>(coords.begin(), coords.end())).begin()));
 }
 
+BOOST_AUTO_TEST_CASE(polyline_buffer_test_case)
+{
+    using namespace osrm::engine;
+    using namespace osrm::util;
+
+    const std::vector<Coordinate> coords({{FixedLongitude{-73990171}, FixedLatitude{40714701}},
+                                          {FixedLongitude{-73991801}, FixedLatitude{40717571}},
+                                          {FixedLongitude{-73985751}, FixedLatitude{40715651}}});
+
+    const auto size = encodedPolylineSize(coords.begin(), coords.end());
+    BOOST_CHECK_EQUAL(size, 19);
+
+    std::vector<char> buffer(size + 1, '#');
+    const auto end = encodePolyline(coords.begin(), coords.end(), buffer.data());
+    BOOST_CHECK_EQUAL(end - buffer.data(), size);
+    BOOST_CHECK_EQUAL(std::string(buffer.data(), size), "{aowFperbM}PdI~Jyd@");
+    BOOST_CHECK_EQUAL(buffer.back(), '#');
+
+    BOOST_CHECK_EQUAL(encodedPolylineSize(coords.begin(), coords.begin()), 0);
+    BOOST_CHECK_EQUAL(encodePolyline(coords.begin(), coords.begin()), "");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,132 @@
+#include "engine/trip/trip_brute_force.hpp"
+#include "engine/trip/trip_farthest_insertion.hpp"
+#include "engine/trip/trip_held_karp.hpp"
+#include "engine/trip/trip_local_search.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <random>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(trip_solvers)
+
+using namespace osrm;
+using namespace osrm::engine;
+
+namespace
+{
+util::DistTableWrapper<EdgeWeight>
+makeTable(std::mt19937 &generator, const std::size_t number_of_locations, const int max_weight)
+{
+    std::uniform_int_distribution<EdgeWeight> weights(1, max_weight);
+    std::vector<EdgeWeight> table(number_of_locations * number_of_locations, 0);
+    for (std::size_t from = 0; from < number_of_locations; ++from)
+    {
+        for (std::size_t to = 0; to < number_of_locations; ++to)
+        {
+            if (from != to)
+                table[from * number_of_locations + to] = weights(generator);
+        }
+    }
+    return util::DistTableWrapper<EdgeWeight>(std::move(table), number_of_locations);
+}
+
+// same changes the trip plugin makes for a fixed start and end
+void fixStartAndEnd(const NodeID source,
+                    const NodeID destination,
+                    util::DistTableWrapper<EdgeWeight> &table)
+{
+    for (NodeID i = 0; i < table.GetNumberOfNodes(); ++i)
+    {
+        if (i != source)
+            table.SetValue(i, source, INVALID_EDGE_WEIGHT);
+        if (i != destination)
+            table.SetValue(destination, i, INVALID_EDGE_WEIGHT);
+    }
+    table.SetValue(destination, source, 0);
+    table.SetValue(source, destination, INVALID_EDGE_WEIGHT);
+}
+
+bool isPermutation(std::vector<NodeID> route, const std::size_t number_of_locations)
+{
+    std::vector<NodeID> identity(number_of_locations);
+    std::iota(identity.begin(), identity.end(), 0);
+    std::sort(route.begin(), route.end());
+    return route == identity;
+}
+}
+
+BOOST_AUTO_TEST_CASE(held_karp_matches_brute_force)
+{
+    std::mt19937 generator(42);
+    for (std::size_t number_of_locations = 1; number_of_locations < 9; ++number_of_locations)
+    {
+        for (int repetition = 0; repetition < 20; ++repetition)
+        {
+            // small weights to get many ties, both have to pick the same trip
+            const auto table = makeTable(generator, number_of_locations, 5);
+            const auto brute_force = trip::BruteForceTrip(number_of_locations, table);
+            const auto held_karp = trip::HeldKarpTrip(number_of_locations, table);
+            BOOST_CHECK_EQUAL_COLLECTIONS(
+                held_karp.begin(), held_karp.end(), brute_force.begin(), brute_force.end());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(held_karp_fixed_start_and_end)
+{
+    std::mt19937 generator(7);
+    for (std::size_t number_of_locations = 3; number_of_locations < 9; ++number_of_locations)
+    {
+        auto table = makeTable(generator, number_of_locations, 100);
+        fixStartAndEnd(0, number_of_locations - 1, table);
+
+        const auto brute_force = trip::BruteForceTrip(number_of_locations, table);
+        const auto held_karp = trip::HeldKarpTrip(number_of_locations, table);
+        BOOST_CHECK_EQUAL_COLLECTIONS(
+            held_karp.begin(), held_karp.end(), brute_force.begin(), brute_force.end());
+        BOOST_CHECK_EQUAL(held_karp.back(), number_of_locations - 1);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(local_search_improves_farthest_insertion)
+{
+    std::mt19937 generator(1);
+    for (std::size_t number_of_locations = 4; number_of_locations < 12; ++number_of_locations)
+    {
+        const auto table = makeTable(generator, number_of_locations, 1000);
+        const auto optimum = trip::detail::TripWeight(
+            table, trip::HeldKarpTrip(number_of_locations, table));
+        const auto farthest_insertion = trip::detail::TripWeight(
+            table, trip::FarthestInsertionTrip(number_of_locations, table));
+
+        const auto route =
+            trip::LocalSearchTrip(number_of_locations, table, std::chrono::milliseconds(1000));
+        BOOST_CHECK(isPermutation(route, number_of_locations));
+        const auto weight = trip::detail::TripWeight(table, route);
+        BOOST_CHECK_GE(weight, optimum);
+        BOOST_CHECK_LE(weight, farthest_insertion);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(local_search_fixed_start_and_end)
+{
+    std::mt19937 generator(3);
+    const std::size_t number_of_locations = 30;
+    auto table = makeTable(generator, number_of_locations, 1000);
+    fixStartAndEnd(0, number_of_locations - 1, table);
+
+    auto route =
+        trip::LocalSearchTrip(number_of_locations, table, std::chrono::milliseconds(1000));
+    BOOST_CHECK(isPermutation(route, number_of_locations));
+
+    // the trip must not use any of the invalid entries
+    std::rotate(route.begin(), std::find(route.begin(), route.end(), 0), route.end());
+    BOOST_CHECK_EQUAL(route.back(), number_of_locations - 1);
+    BOOST_CHECK_LT(trip::detail::TripWeight(table, route), INVALID_EDGE_WEIGHT);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
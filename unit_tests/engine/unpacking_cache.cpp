@@ -0,0 +1,90 @@
+#include "engine/unpacking_cache.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(unpacking_cache)
+
+using namespace osrm;
+using namespace osrm::engine;
+
+namespace
+{
+UnpackedShortcut makeShortcut(const std::size_t number_of_edges)
+{
+    UnpackedShortcut shortcut;
+    shortcut.nodes.push_back(0);
+    for (std::size_t index = 0; index < number_of_edges; ++index)
+    {
+        shortcut.nodes.push_back(index + 1);
+        shortcut.edges.push_back(index);
+    }
+    return shortcut;
+}
+}
+
+BOOST_AUTO_TEST_CASE(find_and_insert)
+{
+    UnpackingCache cache(1 << 20);
+
+    const auto forward = UnpackingCache::MakeKey(5, false);
+    const auto reverse = UnpackingCache::MakeKey(5, true);
+    BOOST_CHECK(forward != reverse);
+
+    BOOST_CHECK(!cache.Find(forward));
+    cache.Insert(forward, makeShortcut(3));
+
+    const auto unpacked = cache.Find(forward);
+    BOOST_REQUIRE(unpacked);
+    BOOST_CHECK_EQUAL(unpacked->edges.size(), 3);
+    BOOST_CHECK_EQUAL(unpacked->nodes.back(), 3);
+    BOOST_CHECK(!cache.Find(reverse));
+
+    BOOST_CHECK_EQUAL(cache.GetHits(), 1);
+    BOOST_CHECK_EQUAL(cache.GetMisses(), 2);
+    BOOST_CHECK_CLOSE(cache.GetHitRate(), 1. / 3., 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(evicts_least_recently_used)
+{
+    // 64 shards with room for two shortcuts each, the keys below all map to the first shard
+    const auto entry_size = UnpackingCache::EntrySize(makeShortcut(2));
+    UnpackingCache cache(64 * 2 * entry_size);
+    const auto first = UnpackingCache::MakeKey(0, false);
+    const auto second = UnpackingCache::MakeKey(64, false);
+    const auto third = UnpackingCache::MakeKey(128, false);
+
+    cache.Insert(first, makeShortcut(2));
+    cache.Insert(second, makeShortcut(2));
+    // makes the second shortcut the least recently used one
+    BOOST_CHECK(cache.Find(first));
+
+    cache.Insert(third, makeShortcut(2));
+    BOOST_CHECK(cache.Find(first));
+    BOOST_CHECK(!cache.Find(second));
+    BOOST_CHECK(cache.Find(third));
+
+    // too large to be cached at all, but still returned
+    const auto large = cache.Insert(UnpackingCache::MakeKey(192, false), makeShortcut(100));
+    BOOST_CHECK_EQUAL(large->edges.size(), 100);
+    BOOST_CHECK(!cache.Find(UnpackingCache::MakeKey(192, false)));
+    BOOST_CHECK(cache.Find(first));
+}
+
+BOOST_AUTO_TEST_CASE(capacity_in_bytes)
+{
+    const auto shortcut = makeShortcut(10);
+    const auto entry_size = UnpackingCache::EntrySize(shortcut);
+    // the ids alone are not all that is stored per entry
+    BOOST_CHECK_GT(entry_size, 21 * sizeof(NodeID));
+
+    UnpackingCache cache(64 * 3 * entry_size);
+    for (EdgeID edge = 0; edge < 64 * 10; ++edge)
+        cache.Insert(UnpackingCache::MakeKey(edge, false), makeShortcut(10));
+
+    std::size_t cached = 0;
+    for (EdgeID edge = 0; edge < 64 * 10; ++edge)
+        cached += cache.Find(UnpackingCache::MakeKey(edge, false)) != nullptr;
+    BOOST_CHECK_EQUAL(cached, 64 * 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,9 +1,14 @@
 #include "extractor/compressed_edge_container.hpp"
+#include "util/coordinate.hpp"
 #include "util/typedefs.hpp"
 
 #include <boost/test/test_case_template.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
 BOOST_AUTO_TEST_SUITE(compressed_edge_container)
 
 using namespace osrm;
@@ -87,4 +92,43 @@ BOOST_AUTO_TEST_CASE(t_crossing)
     BOOST_CHECK_EQUAL(container.GetLastEdgeSourceID(2), 3);
 }
 
+BOOST_AUTO_TEST_CASE(zoom_levels)
+{
+    /*
+            2
+          /   \
+     0--1      3
+    */
+    CompressedEdgeContainer container;
+
+    // forward edges 0---1---2---3, reverse edges 3---2---1---0
+    container.CompressEdge(0, 1, 1, 2, 1, 1, 11, 11);
+    container.CompressEdge(0, 2, 2, 3, 2, 1, 22, 11);
+    container.CompressEdge(3, 4, 2, 1, 1, 1, 11, 11);
+    container.CompressEdge(3, 5, 1, 0, 2, 1, 22, 11);
+    container.ZipEdges(0, 3);
+
+    const std::vector<util::Coordinate> coordinates = {
+        {util::FloatLongitude{0}, util::FloatLatitude{0}},
+        {util::FloatLongitude{1}, util::FloatLatitude{0.5}},
+        {util::FloatLongitude{2}, util::FloatLatitude{1}},
+        {util::FloatLongitude{3}, util::FloatLatitude{0}}};
+    const auto segment_data = container.ToSegmentData(coordinates);
+
+    std::vector<std::uint8_t> forward_levels, reverse_levels;
+    segment_data->CopyForwardZoomLevels(0, forward_levels);
+    segment_data->CopyReverseZoomLevels(0, reverse_levels);
+
+    BOOST_REQUIRE_EQUAL(forward_levels.size(), 4);
+    // the end points are always kept, node 2 from zoom level 3 on and node 1 much later
+    BOOST_CHECK_EQUAL(forward_levels[0], 0);
+    BOOST_CHECK_EQUAL(forward_levels[2], 3);
+    BOOST_CHECK_GT(forward_levels[1], 3);
+    BOOST_CHECK_EQUAL(forward_levels[3], 0);
+    BOOST_CHECK(std::equal(forward_levels.begin(),
+                           forward_levels.end(),
+                           reverse_levels.rbegin(),
+                           reverse_levels.rend()));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
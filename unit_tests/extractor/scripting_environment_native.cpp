@@ -0,0 +1,652 @@
+#include "extractor/scripting_environment_native.hpp"
+#include "extractor/extraction_node.hpp"
+#include "extractor/extraction_relation.hpp"
+#include "extractor/extraction_turn.hpp"
+#include "extractor/extraction_helper_functions.hpp"
+#include "extractor/extraction_way.hpp"
+#include "extractor/maneuver_override_relation_parser.hpp"
+#include "extractor/restriction_parser.hpp"
+
+#include "util/exception.hpp"
+
+#include <osmium/builder/attr.hpp>
+#include <osmium/memory/buffer.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/test_case_template.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(scripting_environment_native)
+
+using namespace osrm;
+using namespace osrm::extractor;
+using namespace osmium::builder;
+using namespace osmium::builder::attr;
+
+BOOST_AUTO_TEST_CASE(is_native_profile)
+{
+    BOOST_CHECK(NativeScriptingEnvironment::IsNativeProfile("profiles/car.so"));
+    BOOST_CHECK(NativeScriptingEnvironment::IsNativeProfile("/tmp/car.dylib"));
+    BOOST_CHECK(!NativeScriptingEnvironment::IsNativeProfile("profiles/car.lua"));
+    BOOST_CHECK(!NativeScriptingEnvironment::IsNativeProfile("profiles/so"));
+}
+
+// Lua and native profiles convert lane counts parsed from tags the same way
+BOOST_AUTO_TEST_CASE(lane_count_conversion)
+{
+    BOOST_CHECK_EQUAL(toCount<std::uint8_t>(2), 2);
+    BOOST_CHECK_EQUAL(toCount<std::uint8_t>(2.9), 2);
+    BOOST_CHECK_EQUAL(toCount<std::uint8_t>(-1), 0);
+    BOOST_CHECK_EQUAL(toCount<std::uint8_t>(1000), 255);
+    BOOST_CHECK_EQUAL(toCount<std::uint8_t>(std::numeric_limits<double>::quiet_NaN()), 0);
+    BOOST_CHECK_EQUAL(toCount<std::int32_t>(-2.5), -2);
+    BOOST_CHECK_EQUAL(toCount<std::int32_t>(1e20), std::numeric_limits<std::int32_t>::max());
+
+    BOOST_CHECK_EQUAL(trimLaneStringByCount("|through|right|", 1.5, 1.9), "through|right");
+}
+
+// The profiles are only built where native profiles are supported
+#ifdef OSRM_TESTBOT_PROFILE
+namespace
+{
+struct ProcessedElements
+{
+    std::vector<std::pair<const osmium::Node &, ExtractionNode>> nodes;
+    std::vector<std::pair<const osmium::Way &, ExtractionWay>> ways;
+};
+
+// The processed elements reference the objects in the buffer, it has to outlive them
+ProcessedElements process(NativeScriptingEnvironment &environment,
+                          const osmium::memory::Buffer &buffer)
+{
+    auto restrictions = environment.GetRestrictions();
+    const RestrictionParser restriction_parser(
+        environment.GetProfileProperties().use_turn_restrictions, false, restrictions);
+    const ManeuverOverrideRelationParser maneuver_override_parser;
+    const ExtractionRelationContainer relations;
+
+    ProcessedElements result;
+    std::vector<InputConditionalTurnRestriction> resulting_restrictions;
+    std::vector<InputManeuverOverride> resulting_maneuver_overrides;
+    environment.ProcessElements(buffer,
+                                restriction_parser,
+                                maneuver_override_parser,
+                                relations,
+                                result.nodes,
+                                result.ways,
+                                resulting_restrictions,
+                                resulting_maneuver_overrides);
+    return result;
+}
+
+ExtractionTurn makeTurn(const double angle,
+                        const bool is_u_turn,
+                        const bool has_traffic_light,
+                        const bool source_restricted = false,
+                        const bool target_restricted = false,
+                        const TravelMode source_mode = TRAVEL_MODE_DRIVING,
+                        const TravelMode target_mode = TRAVEL_MODE_DRIVING)
+{
+    return ExtractionTurn(angle,
+                          3,
+                          is_u_turn,
+                          has_traffic_light,
+                          false,
+                          source_restricted,
+                          source_mode,
+                          false,
+                          false,
+                          1,
+                          0,
+                          0,
+                          50,
+                          RoadPriorityClass::PRIMARY,
+                          target_restricted,
+                          target_mode,
+                          false,
+                          false,
+                          1,
+                          0,
+                          0,
+                          50,
+                          RoadPriorityClass::PRIMARY,
+                          {},
+                          {});
+}
+
+// Location dependent data in a temporary GeoJSON file
+struct LocationDataFixture
+{
+    LocationDataFixture(const std::string &json) : temporary_file(boost::filesystem::unique_path())
+    {
+        std::ofstream file(temporary_file.string());
+        file << json;
+    }
+    ~LocationDataFixture() { remove(temporary_file); }
+
+    boost::filesystem::path temporary_file;
+};
+
+void checkThrows(const std::string &file_name,
+                 const std::vector<boost::filesystem::path> &location_dependent_data_paths,
+                 const std::string &expected_message)
+{
+    try
+    {
+        NativeScriptingEnvironment environment(file_name, location_dependent_data_paths);
+        BOOST_ERROR("expected an exception for " << file_name);
+    }
+    catch (const util::exception &error)
+    {
+        const std::string message = error.what();
+        BOOST_CHECK_MESSAGE(message.find(expected_message) != std::string::npos,
+                            "unexpected message: " << message);
+    }
+}
+}
+
+BOOST_AUTO_TEST_CASE(testbot_setup)
+{
+    NativeScriptingEnvironment environment(OSRM_TESTBOT_PROFILE, {});
+
+    const auto &properties = environment.GetProfileProperties();
+    BOOST_CHECK_EQUAL(properties.GetWeightName(), "duration");
+    BOOST_CHECK(properties.fallback_to_duration);
+    BOOST_CHECK(!properties.call_tagless_node_function);
+    BOOST_CHECK(properties.continue_straight_at_waypoint);
+    BOOST_CHECK(properties.use_turn_restrictions);
+    BOOST_CHECK_EQUAL(properties.GetUturnPenalty(), 20);
+    BOOST_CHECK_EQUAL(properties.GetTrafficSignalPenalty(), 7);
+
+    const std::vector<std::string> class_names = {"motorway", "toll", "TooWords2"};
+    const auto names = environment.GetClassNames();
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        names.begin(), names.end(), class_names.begin(), class_names.end());
+
+    const std::vector<std::vector<std::string>> excludable = {
+        {"motorway"}, {"toll"}, {"motorway", "toll"}};
+    BOOST_CHECK(environment.GetExcludableClasses() == excludable);
+    BOOST_CHECK(environment.GetRestrictions().empty());
+}
+
+BOOST_AUTO_TEST_CASE(testbot_process_elements)
+{
+    NativeScriptingEnvironment environment(OSRM_TESTBOT_PROFILE, {});
+
+    osmium::memory::Buffer buffer{1024};
+    add_node(buffer, _id(1), _tag("highway", "traffic_signals"));
+    add_node(buffer, _id(2));
+    add_way(buffer,
+            _id(10),
+            _nodes({1, 2}),
+            _tag("highway", "primary"),
+            _tag("name", "Main Street"),
+            _tag("toll", "yes"));
+    add_way(buffer, _id(11), _nodes({1, 2}), _tag("highway", "secondary"), _tag("oneway", "-1"));
+
+    const auto result = process(environment, buffer);
+
+    BOOST_REQUIRE_EQUAL(result.nodes.size(), 2);
+    BOOST_CHECK(result.nodes[0].second.traffic_lights);
+    BOOST_CHECK(!result.nodes[0].second.barrier);
+    BOOST_CHECK(!result.nodes[1].second.traffic_lights);
+
+    BOOST_REQUIRE_EQUAL(result.ways.size(), 2);
+    const auto &primary = result.ways[0].second;
+    BOOST_CHECK_EQUAL(primary.forward_speed, 36);
+    BOOST_CHECK_EQUAL(primary.backward_speed, 36);
+    BOOST_CHECK_EQUAL(primary.GetName(), std::string("Main Street"));
+    BOOST_CHECK(primary.forward_classes.at("toll"));
+    BOOST_CHECK(primary.backward_classes.at("toll"));
+
+    const auto &secondary = result.ways[1].second;
+    BOOST_CHECK_EQUAL(secondary.forward_speed, 18);
+    BOOST_CHECK_EQUAL(secondary.forward_travel_mode, TRAVEL_MODE_INACCESSIBLE);
+    BOOST_CHECK_EQUAL(secondary.backward_travel_mode, TRAVEL_MODE_DRIVING);
+}
+
+BOOST_AUTO_TEST_CASE(testbot_process_turn)
+{
+    NativeScriptingEnvironment environment(OSRM_TESTBOT_PROFILE, {});
+
+    auto u_turn = makeTurn(0, true, false);
+    environment.ProcessTurn(u_turn);
+    BOOST_CHECK_EQUAL(u_turn.duration, 20);
+    BOOST_CHECK_EQUAL(u_turn.weight, 20);
+
+    // the profile only sets the duration, the weight falls back to it
+    auto traffic_light = makeTurn(180, false, true);
+    environment.ProcessTurn(traffic_light);
+    BOOST_CHECK_EQUAL(traffic_light.duration, 7);
+    BOOST_CHECK_EQUAL(traffic_light.weight, 7);
+}
+
+BOOST_AUTO_TEST_CASE(car_setup)
+{
+    NativeScriptingEnvironment environment(OSRM_CAR_PROFILE, {});
+
+    const auto &properties = environment.GetProfileProperties();
+    BOOST_CHECK_EQUAL(properties.GetWeightName(), "routability");
+    BOOST_CHECK(!properties.fallback_to_duration);
+    BOOST_CHECK_EQUAL(properties.GetUturnPenalty(), 20);
+
+    const std::vector<std::string> restrictions = {"motorcar", "motor_vehicle", "vehicle"};
+    const auto result = environment.GetRestrictions();
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        result.begin(), result.end(), restrictions.begin(), restrictions.end());
+    BOOST_CHECK_EQUAL(environment.GetClassNames().size(), 5);
+    BOOST_CHECK_EQUAL(environment.GetExcludableClasses().size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(car_process_elements)
+{
+    NativeScriptingEnvironment environment(OSRM_CAR_PROFILE, {});
+
+    osmium::memory::Buffer buffer{4096};
+    add_node(buffer, _id(1), _tag("barrier", "gate"));
+    add_node(buffer, _id(2), _tag("barrier", "bollard"));
+    add_node(buffer, _id(3), _tag("barrier", "bollard"), _tag("bollard", "rising"));
+    add_node(buffer, _id(4), _tag("barrier", "height_restrictor"), _tag("maxheight", "1.8"));
+    add_node(buffer, _id(5), _tag("access", "private"));
+    add_node(buffer, _id(6), _tag("access", "no"));
+    add_way(buffer,
+            _id(10),
+            _nodes({1, 2}),
+            _tag("highway", "primary"),
+            _tag("oneway", "yes"),
+            _tag("maxspeed", "50"),
+            _tag("ref", "A1;A2"),
+            _tag("destination", "Berlin;Hamburg"));
+    add_way(buffer, _id(11), _nodes({1, 2}), _tag("highway", "residential"), _tag("access", "no"));
+    add_way(buffer,
+            _id(12),
+            _nodes({1, 2}),
+            _tag("highway", "service"),
+            _tag("service", "parking_aisle"),
+            _tag("surface", "gravel"));
+    add_way(buffer, _id(13), _nodes({1, 2}), _tag("highway", "track"));
+    add_way(buffer,
+            _id(14),
+            _nodes({1, 2}),
+            _tag("highway", "residential"),
+            _tag("maxheight", "6'"));
+    add_way(buffer, _id(15), _nodes({1, 2}), _tag("route", "ferry"), _tag("duration", "00:10"));
+    add_way(buffer, _id(16), _nodes({1, 2}), _tag("building", "yes"));
+
+    const auto result = process(environment, buffer);
+
+    BOOST_REQUIRE_EQUAL(result.nodes.size(), 6);
+    BOOST_CHECK(!result.nodes[0].second.barrier);
+    BOOST_CHECK(result.nodes[1].second.barrier);
+    BOOST_CHECK(!result.nodes[2].second.barrier);
+    BOOST_CHECK(result.nodes[3].second.barrier);
+    BOOST_CHECK(!result.nodes[4].second.barrier);
+    BOOST_CHECK(result.nodes[5].second.barrier);
+
+    BOOST_REQUIRE_EQUAL(result.ways.size(), 7);
+
+    // maxspeed is reduced, a oneway has destinations
+    const auto &primary = result.ways[0].second;
+    BOOST_CHECK_EQUAL(primary.forward_travel_mode, TRAVEL_MODE_DRIVING);
+    BOOST_CHECK_EQUAL(primary.backward_travel_mode, TRAVEL_MODE_INACCESSIBLE);
+    BOOST_CHECK_CLOSE(primary.forward_speed, 40, 1e-6);
+    BOOST_CHECK_CLOSE(primary.forward_rate, 40 / 3.6, 1e-6);
+    BOOST_CHECK_EQUAL(primary.GetForwardRef(), std::string("A1; A2"));
+    BOOST_CHECK_EQUAL(primary.GetDestinations(), std::string("Berlin, Hamburg"));
+    BOOST_CHECK_EQUAL(primary.road_classification.GetClass(), RoadPriorityClass::PRIMARY);
+
+    const auto &no_access = result.ways[1].second;
+    BOOST_CHECK_EQUAL(no_access.forward_travel_mode, TRAVEL_MODE_INACCESSIBLE);
+    BOOST_CHECK_EQUAL(no_access.backward_travel_mode, TRAVEL_MODE_INACCESSIBLE);
+
+    // limited by the surface and penalized as parking aisle
+    const auto &service = result.ways[2].second;
+    BOOST_CHECK_EQUAL(service.forward_speed, 15);
+    BOOST_CHECK_CLOSE(service.forward_rate, 15 * 0.5 / 3.6, 1e-6);
+    BOOST_CHECK_EQUAL(service.road_classification.GetClass(), RoadPriorityClass::ALLEY);
+    BOOST_CHECK(service.road_classification.IsLowPriorityRoadClass());
+
+    // tracks have no speed in the car profile
+    const auto &track = result.ways[3].second;
+    BOOST_CHECK_EQUAL(track.forward_speed, -1);
+    BOOST_CHECK_EQUAL(track.backward_speed, -1);
+
+    // six feet are less than the height of the vehicle
+    const auto &low = result.ways[4].second;
+    BOOST_CHECK_EQUAL(low.forward_travel_mode, TRAVEL_MODE_INACCESSIBLE);
+    BOOST_CHECK_EQUAL(low.backward_travel_mode, TRAVEL_MODE_INACCESSIBLE);
+
+    const auto &ferry = result.ways[5].second;
+    BOOST_CHECK_EQUAL(ferry.forward_travel_mode, TRAVEL_MODE_FERRY);
+    BOOST_CHECK_EQUAL(ferry.duration, 600);
+    BOOST_CHECK_EQUAL(ferry.weight, 600);
+    BOOST_CHECK(ferry.forward_classes.at("ferry"));
+
+    // not a road, the profile does not touch the result
+    const auto &building = result.ways[6].second;
+    BOOST_CHECK_EQUAL(building.forward_travel_mode, TRAVEL_MODE_INACCESSIBLE);
+    BOOST_CHECK_EQUAL(building.backward_travel_mode, TRAVEL_MODE_INACCESSIBLE);
+}
+
+BOOST_AUTO_TEST_CASE(car_process_turn)
+{
+    NativeScriptingEnvironment environment(OSRM_CAR_PROFILE, {});
+
+    // a straight turn is cheap, a u-turn gets the full turn and u-turn penalties
+    auto straight = makeTurn(180, false, false);
+    environment.ProcessTurn(straight);
+    BOOST_CHECK_LT(straight.duration, 0.1);
+    BOOST_CHECK_EQUAL(straight.weight, straight.duration);
+
+    auto u_turn = makeTurn(0, true, false);
+    environment.ProcessTurn(u_turn);
+    BOOST_CHECK_GT(u_turn.duration, 20 + 7);
+    BOOST_CHECK_LT(u_turn.duration, 20 + 7.5);
+
+    // entering a restricted road is penalized with the maximal turn weight
+    auto restricted = makeTurn(180, false, true, false, true);
+    environment.ProcessTurn(restricted);
+    BOOST_CHECK_GT(restricted.duration, 2);
+    BOOST_CHECK_LT(restricted.duration, 2.1);
+    BOOST_CHECK_EQUAL(restricted.weight, environment.GetProfileProperties().GetMaxTurnWeight());
+}
+
+BOOST_AUTO_TEST_CASE(car_location_dependent_data)
+{
+    LocationDataFixture fixture(R"json({
+"type": "FeatureCollection",
+"features": [
+{
+    "type": "Feature",
+    "properties": { "driving_side": "left", "maxheight": 1.5 },
+    "geometry": { "type": "Polygon", "coordinates": [ [ [0, 0], [1, 0], [1, 1], [0, 1], [0, 0] ] ] }
+}
+]})json");
+
+    NativeScriptingEnvironment environment(OSRM_CAR_PROFILE, {fixture.temporary_file});
+    BOOST_CHECK(environment.HasLocationDependentData());
+
+    // a default height takes the height of the region or the default height of the profile
+    const osmium::Location inside{0.5, 0.5};
+    const osmium::Location outside{2.5, 0.5};
+
+    osmium::memory::Buffer buffer{4096};
+    add_node(buffer,
+             _id(1),
+             _location(inside),
+             _tag("barrier", "height_restrictor"),
+             _tag("maxheight", "default"));
+    add_node(buffer,
+             _id(2),
+             _location(outside),
+             _tag("barrier", "height_restrictor"),
+             _tag("maxheight", "default"));
+    add_way(buffer,
+            _id(10),
+            _nodes({osmium::NodeRef(1, inside), osmium::NodeRef(2, inside)}),
+            _tag("highway", "primary"));
+    add_way(buffer,
+            _id(11),
+            _nodes({osmium::NodeRef(1, outside), osmium::NodeRef(2, outside)}),
+            _tag("highway", "primary"));
+    add_way(buffer,
+            _id(12),
+            _nodes({osmium::NodeRef(1, inside), osmium::NodeRef(2, inside)}),
+            _tag("highway", "primary"),
+            _tag("maxheight", "default"));
+    add_way(buffer,
+            _id(13),
+            _nodes({osmium::NodeRef(1, outside), osmium::NodeRef(2, outside)}),
+            _tag("highway", "primary"),
+            _tag("maxheight", "default"));
+    // the tag of the way takes precedence over the region
+    add_way(buffer,
+            _id(14),
+            _nodes({osmium::NodeRef(1, inside), osmium::NodeRef(2, inside)}),
+            _tag("highway", "primary"),
+            _tag("driving_side", "right"));
+
+    const auto result = process(environment, buffer);
+
+    BOOST_REQUIRE_EQUAL(result.nodes.size(), 2);
+    BOOST_CHECK(result.nodes[0].second.barrier);
+    BOOST_CHECK(!result.nodes[1].second.barrier);
+
+    BOOST_REQUIRE_EQUAL(result.ways.size(), 5);
+    BOOST_CHECK(result.ways[0].second.is_left_hand_driving);
+    BOOST_CHECK(!result.ways[1].second.is_left_hand_driving);
+    BOOST_CHECK_EQUAL(result.ways[2].second.forward_travel_mode, TRAVEL_MODE_INACCESSIBLE);
+    BOOST_CHECK_EQUAL(result.ways[2].second.backward_travel_mode, TRAVEL_MODE_INACCESSIBLE);
+    BOOST_CHECK_EQUAL(result.ways[3].second.forward_travel_mode, TRAVEL_MODE_DRIVING);
+    BOOST_CHECK_EQUAL(result.ways[3].second.backward_travel_mode, TRAVEL_MODE_DRIVING);
+    BOOST_CHECK(!result.ways[4].second.is_left_hand_driving);
+}
+
+BOOST_AUTO_TEST_CASE(foot_setup)
+{
+    NativeScriptingEnvironment environment(OSRM_FOOT_PROFILE, {});
+
+    const auto &properties = environment.GetProfileProperties();
+    BOOST_CHECK_EQUAL(properties.GetWeightName(), "duration");
+    BOOST_CHECK(properties.fallback_to_duration);
+    BOOST_CHECK(!properties.continue_straight_at_waypoint);
+    BOOST_CHECK(!properties.use_turn_restrictions);
+
+    const std::vector<std::string> restrictions = {"foot"};
+    const auto result = environment.GetRestrictions();
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        result.begin(), result.end(), restrictions.begin(), restrictions.end());
+    BOOST_CHECK(environment.GetClassNames().empty());
+}
+
+BOOST_AUTO_TEST_CASE(foot_process_elements)
+{
+    NativeScriptingEnvironment environment(OSRM_FOOT_PROFILE, {});
+
+    osmium::memory::Buffer buffer{4096};
+    add_node(buffer, _id(1), _tag("barrier", "gate"));
+    add_node(buffer, _id(2), _tag("barrier", "wall"));
+    add_node(buffer, _id(3), _tag("highway", "traffic_signals"));
+    add_node(buffer, _id(4), _tag("access", "no"));
+    add_way(buffer, _id(10), _nodes({1, 2}), _tag("highway", "footway"), _tag("name", "Path"));
+    add_way(buffer,
+            _id(11),
+            _nodes({1, 2}),
+            _tag("highway", "primary"),
+            _tag("oneway:foot", "yes"),
+            _tag("surface", "gravel"));
+    add_way(buffer, _id(12), _nodes({1, 2}), _tag("highway", "motorway"));
+    add_way(buffer, _id(13), _nodes({1, 2}), _tag("highway", "residential"), _tag("foot", "no"));
+    add_way(buffer, _id(14), _nodes({1, 2}), _tag("route", "ferry"), _tag("duration", "00:10"));
+
+    const auto result = process(environment, buffer);
+
+    BOOST_REQUIRE_EQUAL(result.nodes.size(), 4);
+    BOOST_CHECK(!result.nodes[0].second.barrier);
+    BOOST_CHECK(result.nodes[1].second.barrier);
+    BOOST_CHECK(result.nodes[2].second.traffic_lights);
+    BOOST_CHECK(result.nodes[3].second.barrier);
+
+    BOOST_REQUIRE_EQUAL(result.ways.size(), 5);
+
+    const auto &footway = result.ways[0].second;
+    BOOST_CHECK_EQUAL(footway.forward_travel_mode, TRAVEL_MODE_WALKING);
+    BOOST_CHECK_EQUAL(footway.backward_travel_mode, TRAVEL_MODE_WALKING);
+    BOOST_CHECK_EQUAL(footway.forward_speed, 5);
+    BOOST_CHECK_EQUAL(footway.GetName(), std::string("Path"));
+    BOOST_CHECK(footway.road_classification.IsLowPriorityRoadClass());
+
+    // a walking oneway, slowed down by the surface
+    const auto &primary = result.ways[1].second;
+    BOOST_CHECK_EQUAL(primary.forward_travel_mode, TRAVEL_MODE_WALKING);
+    BOOST_CHECK_EQUAL(primary.backward_travel_mode, TRAVEL_MODE_INACCESSIBLE);
+    BOOST_CHECK_CLOSE(primary.forward_speed, 3.75, 1e-6);
+
+    // motorways have no walking speed
+    const auto &motorway = result.ways[2].second;
+    BOOST_CHECK_EQUAL(motorway.forward_speed, -1);
+    BOOST_CHECK_EQUAL(motorway.backward_speed, -1);
+
+    const auto &no_access = result.ways[3].second;
+    BOOST_CHECK_EQUAL(no_access.forward_travel_mode, TRAVEL_MODE_INACCESSIBLE);
+    BOOST_CHECK_EQUAL(no_access.backward_travel_mode, TRAVEL_MODE_INACCESSIBLE);
+
+    const auto &ferry = result.ways[4].second;
+    BOOST_CHECK_EQUAL(ferry.forward_travel_mode, TRAVEL_MODE_FERRY);
+    BOOST_CHECK_EQUAL(ferry.duration, 600);
+}
+
+BOOST_AUTO_TEST_CASE(foot_process_turn)
+{
+    NativeScriptingEnvironment environment(OSRM_FOOT_PROFILE, {});
+
+    auto straight =
+        makeTurn(90, false, false, false, false, TRAVEL_MODE_WALKING, TRAVEL_MODE_WALKING);
+    environment.ProcessTurn(straight);
+    BOOST_CHECK_EQUAL(straight.duration, 0);
+    BOOST_CHECK_EQUAL(straight.weight, 0);
+
+    auto u_turn = makeTurn(0, true, false, false, false, TRAVEL_MODE_WALKING, TRAVEL_MODE_WALKING);
+    environment.ProcessTurn(u_turn);
+    BOOST_CHECK_EQUAL(u_turn.duration, 2);
+    BOOST_CHECK_EQUAL(u_turn.weight, 2);
+
+    auto traffic_light =
+        makeTurn(90, false, true, false, false, TRAVEL_MODE_WALKING, TRAVEL_MODE_WALKING);
+    environment.ProcessTurn(traffic_light);
+    BOOST_CHECK_EQUAL(traffic_light.duration, 2);
+    BOOST_CHECK_EQUAL(traffic_light.weight, 2);
+}
+
+BOOST_AUTO_TEST_CASE(bicycle_setup)
+{
+    NativeScriptingEnvironment environment(OSRM_BICYCLE_PROFILE, {});
+
+    const auto &properties = environment.GetProfileProperties();
+    BOOST_CHECK_EQUAL(properties.GetWeightName(), "duration");
+    BOOST_CHECK(properties.fallback_to_duration);
+    BOOST_CHECK(!properties.use_turn_restrictions);
+    BOOST_CHECK_EQUAL(properties.GetUturnPenalty(), 20);
+
+    const std::vector<std::string> class_names = {"ferry", "tunnel"};
+    const auto names = environment.GetClassNames();
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        names.begin(), names.end(), class_names.begin(), class_names.end());
+
+    const std::vector<std::string> restrictions = {"bicycle"};
+    const auto result = environment.GetRestrictions();
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        result.begin(), result.end(), restrictions.begin(), restrictions.end());
+}
+
+BOOST_AUTO_TEST_CASE(bicycle_process_elements)
+{
+    NativeScriptingEnvironment environment(OSRM_BICYCLE_PROFILE, {});
+
+    osmium::memory::Buffer buffer{4096};
+    add_node(buffer, _id(1), _tag("barrier", "bollard"));
+    add_node(buffer, _id(2), _tag("barrier", "wall"));
+    add_node(buffer, _id(3), _tag("access", "no"), _tag("crossing", "yes"));
+    add_way(buffer,
+            _id(10),
+            _nodes({1, 2}),
+            _tag("highway", "cycleway"),
+            _tag("name", "Bike Path"));
+    add_way(buffer, _id(11), _nodes({1, 2}), _tag("highway", "primary"), _tag("oneway", "yes"));
+    add_way(buffer, _id(12), _nodes({1, 2}), _tag("highway", "footway"));
+    add_way(buffer, _id(13), _nodes({1, 2}), _tag("highway", "motorway"));
+    add_way(buffer,
+            _id(14),
+            _nodes({1, 2}),
+            _tag("highway", "residential"),
+            _tag("surface", "gravel"));
+    add_way(buffer, _id(15), _nodes({1, 2}), _tag("highway", "primary"), _tag("tunnel", "yes"));
+
+    const auto result = process(environment, buffer);
+
+    BOOST_REQUIRE_EQUAL(result.nodes.size(), 3);
+    BOOST_CHECK(!result.nodes[0].second.barrier);
+    BOOST_CHECK(result.nodes[1].second.barrier);
+    BOOST_CHECK(result.nodes[2].second.barrier);
+
+    BOOST_REQUIRE_EQUAL(result.ways.size(), 6);
+
+    const auto &cycleway = result.ways[0].second;
+    BOOST_CHECK_EQUAL(cycleway.forward_travel_mode, TRAVEL_MODE_CYCLING);
+    BOOST_CHECK_EQUAL(cycleway.backward_travel_mode, TRAVEL_MODE_CYCLING);
+    BOOST_CHECK_EQUAL(cycleway.forward_speed, 15);
+    BOOST_CHECK_EQUAL(cycleway.GetName(), std::string("Bike Path"));
+
+    // the bike can be pushed against the direction of a oneway
+    const auto &oneway = result.ways[1].second;
+    BOOST_CHECK_EQUAL(oneway.forward_travel_mode, TRAVEL_MODE_CYCLING);
+    BOOST_CHECK_EQUAL(oneway.backward_travel_mode, TRAVEL_MODE_PUSHING_BIKE);
+    BOOST_CHECK_EQUAL(oneway.forward_speed, 15);
+    BOOST_CHECK_EQUAL(oneway.backward_speed, 4);
+
+    const auto &footway = result.ways[2].second;
+    BOOST_CHECK_EQUAL(footway.forward_travel_mode, TRAVEL_MODE_PUSHING_BIKE);
+    BOOST_CHECK_EQUAL(footway.backward_travel_mode, TRAVEL_MODE_PUSHING_BIKE);
+    BOOST_CHECK_EQUAL(footway.forward_speed, 4);
+
+    const auto &motorway = result.ways[3].second;
+    BOOST_CHECK_EQUAL(motorway.forward_travel_mode, TRAVEL_MODE_INACCESSIBLE);
+    BOOST_CHECK_EQUAL(motorway.backward_travel_mode, TRAVEL_MODE_INACCESSIBLE);
+
+    const auto &gravel = result.ways[4].second;
+    BOOST_CHECK_EQUAL(gravel.forward_speed, 6);
+    BOOST_CHECK_EQUAL(gravel.backward_speed, 6);
+
+    const auto &tunnel = result.ways[5].second;
+    BOOST_CHECK(tunnel.forward_classes.at("tunnel"));
+    BOOST_CHECK(tunnel.backward_classes.at("tunnel"));
+}
+
+BOOST_AUTO_TEST_CASE(bicycle_process_turn)
+{
+    NativeScriptingEnvironment environment(OSRM_BICYCLE_PROFILE, {});
+
+    auto straight =
+        makeTurn(180, false, false, false, false, TRAVEL_MODE_CYCLING, TRAVEL_MODE_CYCLING);
+    environment.ProcessTurn(straight);
+    BOOST_CHECK_EQUAL(straight.duration, 0);
+
+    auto right = makeTurn(90, false, false, false, false, TRAVEL_MODE_CYCLING, TRAVEL_MODE_CYCLING);
+    environment.ProcessTurn(right);
+    BOOST_CHECK_CLOSE(right.duration, 6 / 1.4, 1e-6);
+
+    // the u-turn and traffic light penalties add to the penalty of the sharpest turn
+    auto u_turn = makeTurn(0, true, false, false, false, TRAVEL_MODE_CYCLING, TRAVEL_MODE_CYCLING);
+    environment.ProcessTurn(u_turn);
+    BOOST_CHECK_CLOSE(u_turn.duration, 20 + 24 / 1.4, 1e-6);
+    BOOST_CHECK_EQUAL(u_turn.weight, u_turn.duration);
+
+    auto traffic_light =
+        makeTurn(0, false, true, false, false, TRAVEL_MODE_CYCLING, TRAVEL_MODE_CYCLING);
+    environment.ProcessTurn(traffic_light);
+    BOOST_CHECK_CLOSE(traffic_light.duration, 2 + 24 / 1.4, 1e-6);
+
+    // the mode change penalty only applies to the weight, which is the duration in this profile
+    auto mode_change =
+        makeTurn(180, false, false, false, false, TRAVEL_MODE_CYCLING, TRAVEL_MODE_PUSHING_BIKE);
+    environment.ProcessTurn(mode_change);
+    BOOST_CHECK_EQUAL(mode_change.duration, 0);
+    BOOST_CHECK_EQUAL(mode_change.weight, 0);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_profiles)
+{
+    checkThrows("does-not-exist.so", {}, "Failed to load native profile");
+    checkThrows(OSRM_WRONG_VERSION_PROFILE, {}, "was built for API version");
+    checkThrows(OSRM_MISSING_SYMBOL_PROFILE, {}, "osrm_native_profile_destroy");
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,9 @@
+// Native profile that does not export all entry points
+
+#include "extractor/native_profile.hpp"
+
+extern "C" int osrm_native_profile_api_version()
+{
+    return ::osrm::extractor::NativeProfile::API_VERSION;
+}
+extern "C" ::osrm::extractor::NativeProfile *osrm_native_profile_create() { return nullptr; }
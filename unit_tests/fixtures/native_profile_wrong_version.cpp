@@ -0,0 +1,10 @@
+// Native profile that was built for a different API version
+
+#include "extractor/native_profile.hpp"
+
+extern "C" int osrm_native_profile_api_version()
+{
+    return ::osrm::extractor::NativeProfile::API_VERSION + 1;
+}
+extern "C" ::osrm::extractor::NativeProfile *osrm_native_profile_create() { return nullptr; }
+extern "C" void osrm_native_profile_destroy(::osrm::extractor::NativeProfile *) {}
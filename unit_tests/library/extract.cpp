@@ -1,11 +1,22 @@
 #include <boost/test/test_case_template.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include "extractor/files.hpp"
+#include "extractor/profile_properties.hpp"
+
 #include "osrm/extractor.hpp"
 #include "osrm/extractor_config.hpp"
 
+#include <boost/filesystem.hpp>
+
 #include <tbb/task_scheduler_init.h> // default_num_threads
 
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
 BOOST_AUTO_TEST_SUITE(library_extract)
 
 BOOST_AUTO_TEST_CASE(test_extract_with_invalid_config)
@@ -25,4 +36,144 @@ BOOST_AUTO_TEST_CASE(test_extract_with_valid_config)
     BOOST_CHECK_NO_THROW(osrm::extract(config));
 }
 
+#ifdef OSRM_CAR_PROFILE
+namespace
+{
+// Extracts a copy of monaco.osm.pbf with the profile into a new directory
+boost::filesystem::path
+extractMonaco(const boost::filesystem::path &profile_path,
+              const std::vector<boost::filesystem::path> &location_dependent_data_paths)
+{
+    const auto directory =
+        boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    boost::filesystem::create_directories(directory);
+    const auto input_path = directory / "monaco.osm.pbf";
+    boost::filesystem::copy_file(OSRM_TEST_DATA_DIR "/monaco.osm.pbf", input_path);
+
+    osrm::ExtractorConfig config;
+    config.input_path = input_path;
+    config.profile_path = profile_path;
+    config.location_dependent_data_paths = location_dependent_data_paths;
+    config.UseDefaultOutputNames(input_path);
+    // a single thread makes the order of equal elements in the output deterministic
+    config.requested_num_threads = 1;
+    config.small_component_size = 1000;
+    config.generate_edge_lookup = false;
+    config.use_metadata = false;
+    osrm::extract(config);
+
+    return directory;
+}
+
+std::vector<char> readFile(const boost::filesystem::path &path)
+{
+    std::ifstream stream(path.string(), std::ios::binary);
+    return {std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+}
+
+// A native port of a Lua profile has to produce exactly the same data as the Lua profile
+void checkNativeEqualsLua(
+    const std::string &lua_profile,
+    const boost::filesystem::path &native_profile,
+    const std::vector<boost::filesystem::path> &location_dependent_data_paths = {})
+{
+    const auto lua_directory =
+        extractMonaco(OSRM_PROJECT_DIR "/profiles/" + lua_profile, location_dependent_data_paths);
+    const auto native_directory = extractMonaco(native_profile, location_dependent_data_paths);
+
+    std::vector<std::string> file_names;
+    for (const auto &entry : boost::filesystem::directory_iterator(lua_directory))
+    {
+        file_names.push_back(entry.path().filename().string());
+    }
+    std::sort(file_names.begin(), file_names.end());
+    BOOST_CHECK_GT(file_names.size(), 1);
+
+    for (const auto &file_name : file_names)
+    {
+        const auto native_path = native_directory / file_name;
+        BOOST_REQUIRE_MESSAGE(boost::filesystem::exists(native_path), file_name << " is missing");
+
+        // written as raw struct that includes padding, compare the values instead
+        if (file_name == "monaco.osrm.properties")
+        {
+            osrm::extractor::ProfileProperties lua_properties, native_properties;
+            osrm::extractor::files::readProfileProperties(lua_directory / file_name,
+                                                          lua_properties);
+            osrm::extractor::files::readProfileProperties(native_path, native_properties);
+            BOOST_CHECK_EQUAL(lua_properties.GetWeightName(), native_properties.GetWeightName());
+            BOOST_CHECK_EQUAL(lua_properties.GetUturnPenalty(),
+                              native_properties.GetUturnPenalty());
+            BOOST_CHECK_EQUAL(lua_properties.GetTrafficSignalPenalty(),
+                              native_properties.GetTrafficSignalPenalty());
+            BOOST_CHECK_EQUAL(lua_properties.GetMaxSpeedForMapMatching(),
+                              native_properties.GetMaxSpeedForMapMatching());
+            BOOST_CHECK_EQUAL(lua_properties.continue_straight_at_waypoint,
+                              native_properties.continue_straight_at_waypoint);
+            BOOST_CHECK_EQUAL(lua_properties.use_turn_restrictions,
+                              native_properties.use_turn_restrictions);
+            BOOST_CHECK_EQUAL(lua_properties.left_hand_driving,
+                              native_properties.left_hand_driving);
+            BOOST_CHECK_EQUAL(lua_properties.fallback_to_duration,
+                              native_properties.fallback_to_duration);
+            for (std::size_t index = 0; index <= osrm::extractor::MAX_CLASS_INDEX; ++index)
+            {
+                BOOST_CHECK_EQUAL(lua_properties.GetClassName(index),
+                                  native_properties.GetClassName(index));
+            }
+            BOOST_CHECK(lua_properties.excludable_classes == native_properties.excludable_classes);
+            continue;
+        }
+
+        const auto lua_data = readFile(lua_directory / file_name);
+        const auto native_data = readFile(native_path);
+        BOOST_CHECK_MESSAGE(lua_data == native_data, file_name << " differs");
+    }
+
+    boost::filesystem::remove_all(lua_directory);
+    boost::filesystem::remove_all(native_directory);
+}
+}
+
+BOOST_AUTO_TEST_CASE(test_extract_native_car_equals_lua)
+{
+    checkNativeEqualsLua("car.lua", OSRM_CAR_PROFILE);
+}
+
+// Pretends that Monaco drives on the left and defaults to a maxheight of two meters
+BOOST_AUTO_TEST_CASE(test_extract_native_car_with_location_dependent_data_equals_lua)
+{
+    const auto regions_path =
+        boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    {
+        std::ofstream regions(regions_path.string());
+        regions << R"json({
+"type": "FeatureCollection",
+"features": [
+{
+    "type": "Feature",
+    "properties": { "driving_side": "left", "maxheight": 2 },
+    "geometry": { "type": "Polygon", "coordinates": [
+        [ [7.40, 43.72], [7.44, 43.72], [7.44, 43.76], [7.40, 43.76], [7.40, 43.72] ]
+    ] }
+}
+]})json";
+    }
+
+    checkNativeEqualsLua("car.lua", OSRM_CAR_PROFILE, {regions_path});
+
+    boost::filesystem::remove(regions_path);
+}
+
+BOOST_AUTO_TEST_CASE(test_extract_native_foot_equals_lua)
+{
+    checkNativeEqualsLua("foot.lua", OSRM_FOOT_PROFILE);
+}
+
+BOOST_AUTO_TEST_CASE(test_extract_native_bicycle_equals_lua)
+{
+    checkNativeEqualsLua("bicycle.lua", OSRM_BICYCLE_PROFILE);
+}
+#endif
+
 BOOST_AUTO_TEST_SUITE_END()
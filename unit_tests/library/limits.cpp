@@ -195,4 +195,35 @@ BOOST_AUTO_TEST_CASE(test_nearest_limits)
     BOOST_CHECK(code == "TooBig"); // per the New-Server API spec
 }
 
+BOOST_AUTO_TEST_CASE(test_route_region)
+{
+    using namespace osrm;
+
+    EngineConfig config;
+    config.storage_config = {OSRM_TEST_DATA_DIR "/ch/monaco.osrm"};
+    config.use_shared_memory = false;
+    config.region = util::RectangleInt2D{util::FloatLongitude{7.40},
+                                         util::FloatLongitude{7.44},
+                                         util::FloatLatitude{43.72},
+                                         util::FloatLatitude{43.76}};
+
+    OSRM osrm{config};
+
+    RouteParameters params;
+    params.coordinates.emplace_back(util::FloatLongitude{7.419758}, util::FloatLatitude{43.731142});
+    params.coordinates.emplace_back(getZeroCoordinate());
+
+    engine::api::ResultT result = json::Object();
+
+    const auto rc = osrm.Route(params, result);
+
+    BOOST_CHECK(rc == Status::Error);
+
+    auto &json_result = result.get<json::Object>();
+    const auto code = json_result.values["code"].get<json::String>().value;
+    BOOST_CHECK(code == "InvalidValue");
+    const auto message = json_result.values["message"].get<json::String>().value;
+    BOOST_CHECK(message == "Coordinates are outside of the served region.");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -13,6 +13,23 @@
 #include "osrm/osrm.hpp"
 #include "osrm/status.hpp"
 
+#include "engine/datafacade_provider.hpp"
+#include "engine/routing_algorithms/many_to_many.hpp"
+#include "engine/routing_algorithms/routing_base_ch.hpp"
+#include "engine/routing_algorithms/routing_base_mld.hpp"
+#include "engine/search_engine_data.hpp"
+
+#include "util/integer_range.hpp"
+
+#include <boost/optional.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
 BOOST_AUTO_TEST_SUITE(match)
 
 BOOST_AUTO_TEST_CASE(test_match)
@@ -208,4 +225,260 @@ BOOST_AUTO_TEST_CASE(test_match_fb_serialization_skip_waypoints)
     BOOST_CHECK(fb->waypoints() == nullptr);
 }
 
+namespace
+{
+double lon(const Location &location)
+{
+    return static_cast<double>(osrm::util::toFloating(location.lon));
+}
+
+double lat(const Location &location)
+{
+    return static_cast<double>(osrm::util::toFloating(location.lat));
+}
+
+Location interpolate(const Location &from, const Location &to, const double factor)
+{
+    return {Longitude{lon(from) + factor * (lon(to) - lon(from))},
+            Latitude{lat(from) + factor * (lat(to) - lat(from))}};
+}
+
+// A dense trace through the locations of the big component
+Locations get_session_trace_locations()
+{
+    const auto locations = get_locations_in_big_component();
+    Locations trace;
+    for (std::size_t index = 0; index + 1 < locations.size(); ++index)
+    {
+        for (const auto factor : {0., 0.25, 0.5, 0.75})
+            trace.push_back(interpolate(locations[index], locations[index + 1], factor));
+    }
+    trace.push_back(locations.back());
+    return trace;
+}
+
+using CH = osrm::engine::routing_algorithms::ch::Algorithm;
+using MLD = osrm::engine::routing_algorithms::mld::Algorithm;
+
+double network_distance(osrm::engine::SearchEngineData<CH> &heaps,
+                        const osrm::engine::DataFacade<CH> &facade,
+                        const osrm::engine::PhantomNode &source,
+                        const osrm::engine::PhantomNode &target)
+{
+    heaps.InitializeOrClearFirstThreadLocalStorage(facade.GetNumberOfNodes());
+    return osrm::engine::routing_algorithms::ch::getNetworkDistance(
+        heaps, facade, *heaps.forward_heap_1, *heaps.reverse_heap_1, source, target);
+}
+
+double network_distance(osrm::engine::SearchEngineData<MLD> &heaps,
+                        const osrm::engine::DataFacade<MLD> &facade,
+                        const osrm::engine::PhantomNode &source,
+                        const osrm::engine::PhantomNode &target)
+{
+    heaps.InitializeOrClearFirstThreadLocalStorage(facade.GetNumberOfNodes(),
+                                                   facade.GetMaxBorderNodeID() + 1);
+    return osrm::engine::routing_algorithms::mld::getNetworkDistance(
+        heaps, facade, *heaps.forward_heap_1, *heaps.reverse_heap_1, source, target);
+}
+
+// The matcher computes the transitions between the candidates of consecutive samples with one
+// many-to-many search. Its distances have to match the point-to-point network distances that
+// were used before, up to the rounding of the pre-computed segment distances.
+template <typename Algorithm> void check_transition_distances(const std::string &base_path)
+{
+    using namespace osrm;
+
+    const engine::ImmutableProvider<Algorithm> provider{storage::StorageConfig{base_path}};
+    const auto facade = provider.Get(engine::api::BaseParameters{});
+    engine::SearchEngineData<Algorithm> heaps;
+
+    const auto trace = get_session_trace_locations();
+    std::size_t number_of_transitions = 0;
+    for (const auto index : util::irange<std::size_t>(1UL, trace.size()))
+    {
+        std::vector<engine::PhantomNode> phantom_nodes;
+        std::vector<std::size_t> sources;
+        std::vector<std::size_t> targets;
+        for (const auto &candidate : facade->NearestPhantomNodesInRange(
+                 trace[index - 1], 50., engine::Approach::UNRESTRICTED, false))
+        {
+            sources.push_back(phantom_nodes.size());
+            phantom_nodes.push_back(candidate.phantom_node);
+        }
+        for (const auto &candidate : facade->NearestPhantomNodesInRange(
+                 trace[index], 50., engine::Approach::UNRESTRICTED, false))
+        {
+            targets.push_back(phantom_nodes.size());
+            phantom_nodes.push_back(candidate.phantom_node);
+        }
+        BOOST_REQUIRE(!sources.empty());
+        BOOST_REQUIRE(!targets.empty());
+
+        const auto distances = engine::routing_algorithms::manyToManySearch(
+                                   heaps, *facade, phantom_nodes, sources, targets, true)
+                                   .second;
+        BOOST_REQUIRE_EQUAL(distances.size(), sources.size() * targets.size());
+
+        for (const auto row : util::irange<std::size_t>(0UL, sources.size()))
+        {
+            for (const auto column : util::irange<std::size_t>(0UL, targets.size()))
+            {
+                const auto reference = network_distance(
+                    heaps, *facade, phantom_nodes[sources[row]], phantom_nodes[targets[column]]);
+                const auto distance = distances[row * targets.size() + column];
+
+                if (reference == std::numeric_limits<double>::max())
+                {
+                    BOOST_CHECK_EQUAL(distance, MAXIMAL_EDGE_DISTANCE);
+                    continue;
+                }
+                BOOST_REQUIRE_NE(distance, MAXIMAL_EDGE_DISTANCE);
+                BOOST_CHECK_LE(std::abs(distance - reference), 1 + 0.01 * reference);
+                ++number_of_transitions;
+            }
+        }
+    }
+    BOOST_CHECK_GT(number_of_transitions, 0);
+}
+
+using MatchedLocations = std::vector<boost::optional<std::pair<double, double>>>;
+
+std::pair<double, double> get_location(const osrm::json::Value &tracepoint)
+{
+    const auto &location =
+        tracepoint.get<osrm::json::Object>().values.at("location").get<osrm::json::Array>().values;
+    return {location[0].get<osrm::json::Number>().value,
+            location[1].get<osrm::json::Number>().value};
+}
+
+// Sends the trace in chunks of the given size and collects the matched location of every sample
+MatchedLocations match_in_session(osrm::OSRM &osrm,
+                                  const std::string &session,
+                                  const Locations &trace,
+                                  const std::size_t chunk_size)
+{
+    using namespace osrm;
+
+    MatchedLocations matched(trace.size());
+    for (std::size_t begin = 0; begin < trace.size(); begin += chunk_size)
+    {
+        const auto end = std::min(trace.size(), begin + chunk_size);
+
+        MatchParameters params;
+        params.session = session;
+        params.end_session = end == trace.size();
+        params.coordinates.assign(trace.begin() + begin, trace.begin() + end);
+        params.radiuses.assign(end - begin, boost::make_optional(50.));
+
+        engine::api::ResultT result = json::Object();
+        const auto rc = osrm.Match(params, result);
+        BOOST_CHECK(rc == Status::Ok);
+
+        auto &json_result = result.get<json::Object>();
+        BOOST_CHECK_EQUAL(json_result.values.at("code").get<json::String>().value, "Ok");
+
+        const auto &session_info = json_result.values.at("session").get<json::Object>().values;
+        BOOST_CHECK_EQUAL(session_info.at("id").get<json::String>().value, session);
+        const auto offset = static_cast<std::size_t>(
+            session_info.at("tracepoints_offset").get<json::Number>().value);
+        const auto pending = session_info.at("pending").get<json::Number>().value;
+        if (params.end_session)
+        {
+            BOOST_CHECK_EQUAL(pending, 0);
+        }
+
+        const auto &tracepoints = json_result.values.at("tracepoints").get<json::Array>().values;
+        BOOST_CHECK_LE(offset + tracepoints.size(), end);
+        for (const auto index : util::irange<std::size_t>(0UL, tracepoints.size()))
+        {
+            if (tracepoints[index].is<json::Null>())
+                continue;
+
+            // consecutive responses share the sample they connect at
+            const auto location = get_location(tracepoints[index]);
+            auto &sample = matched[offset + index];
+            if (sample)
+                BOOST_CHECK(*sample == location);
+            sample = location;
+        }
+    }
+    return matched;
+}
+}
+
+BOOST_AUTO_TEST_CASE(test_match_session_equals_batch)
+{
+    using namespace osrm;
+
+    auto osrm = getOSRM(OSRM_TEST_DATA_DIR "/ch/monaco.osrm");
+
+    const auto trace = get_session_trace_locations();
+
+    MatchParameters params;
+    params.coordinates = trace;
+    params.radiuses.assign(trace.size(), boost::make_optional(50.));
+
+    engine::api::ResultT result = json::Object();
+    const auto rc = osrm.Match(params, result);
+    BOOST_CHECK(rc == Status::Ok);
+
+    const auto &tracepoints =
+        result.get<json::Object>().values.at("tracepoints").get<json::Array>().values;
+    BOOST_REQUIRE_EQUAL(tracepoints.size(), trace.size());
+
+    MatchedLocations batch(trace.size());
+    for (const auto index : util::irange<std::size_t>(0UL, tracepoints.size()))
+    {
+        if (!tracepoints[index].is<json::Null>())
+            batch[index] = get_location(tracepoints[index]);
+    }
+    BOOST_CHECK(std::any_of(batch.begin(), batch.end(), [](const auto &location) {
+        return static_cast<bool>(location);
+    }));
+
+    // sample by sample and several samples per request
+    for (const std::size_t chunk_size : {1, 3})
+    {
+        const auto session =
+            match_in_session(osrm, "session-" + std::to_string(chunk_size), trace, chunk_size);
+        BOOST_CHECK(session == batch);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_match_end_session)
+{
+    using namespace osrm;
+
+    auto osrm = getOSRM(OSRM_TEST_DATA_DIR "/ch/monaco.osrm");
+
+    const auto trace = get_session_trace_locations();
+    match_in_session(osrm, "ended", trace, trace.size());
+
+    // the session was removed, the same id starts a new one
+    MatchParameters params;
+    params.session = "ended";
+    params.coordinates.push_back(trace.front());
+    params.radiuses.push_back(boost::make_optional(50.));
+
+    engine::api::ResultT result = json::Object();
+    const auto rc = osrm.Match(params, result);
+    BOOST_CHECK(rc == Status::Ok);
+
+    const auto &json_result = result.get<json::Object>();
+    BOOST_CHECK(json_result.values.at("tracepoints").get<json::Array>().values.empty());
+    const auto &session_info = json_result.values.at("session").get<json::Object>().values;
+    BOOST_CHECK_EQUAL(session_info.at("tracepoints_offset").get<json::Number>().value, 0);
+    BOOST_CHECK_EQUAL(session_info.at("pending").get<json::Number>().value, 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_match_transition_distances_ch)
+{
+    check_transition_distances<CH>(OSRM_TEST_DATA_DIR "/ch/monaco.osrm");
+}
+
+BOOST_AUTO_TEST_CASE(test_match_transition_distances_mld)
+{
+    check_transition_distances<MLD>(OSRM_TEST_DATA_DIR "/mld/monaco.osrm");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -661,4 +661,92 @@ BOOST_AUTO_TEST_CASE(test_route_serialize_fb_skip_waypoints)
     }
 }
 
+namespace
+{
+// Distances of eta_only routes are summed from the edges and not from the geometry
+void checkETAOnlyMatchesFullRoute(osrm::OSRM &osrm, osrm::RouteParameters params)
+{
+    using namespace osrm;
+
+    engine::api::ResultT full_result = json::Object();
+    BOOST_REQUIRE(osrm.Route(params, full_result) == Status::Ok);
+
+    params.eta_only = true;
+    engine::api::ResultT eta_result = json::Object();
+    BOOST_REQUIRE(osrm.Route(params, eta_result) == Status::Ok);
+
+    auto &full_json = full_result.get<json::Object>();
+    auto &eta_json = eta_result.get<json::Object>();
+    BOOST_CHECK_EQUAL(eta_json.values.at("code").get<json::String>().value, "Ok");
+    CHECK_EQUAL_JSON(full_json.values.at("waypoints"), eta_json.values.at("waypoints"));
+
+    const auto &full_routes = full_json.values.at("routes").get<json::Array>().values;
+    const auto &eta_routes = eta_json.values.at("routes").get<json::Array>().values;
+    BOOST_REQUIRE_EQUAL(full_routes.size(), 1);
+    BOOST_REQUIRE_EQUAL(eta_routes.size(), 1);
+
+    const auto check_summary = [](const json::Object &full, const json::Object &eta) {
+        BOOST_CHECK_EQUAL(full.values.at("duration").get<json::Number>().value,
+                          eta.values.at("duration").get<json::Number>().value);
+        BOOST_CHECK_EQUAL(full.values.at("weight").get<json::Number>().value,
+                          eta.values.at("weight").get<json::Number>().value);
+
+        const auto full_distance = full.values.at("distance").get<json::Number>().value;
+        const auto eta_distance = eta.values.at("distance").get<json::Number>().value;
+        BOOST_CHECK_SMALL(full_distance - eta_distance, 1. + 0.01 * full_distance);
+    };
+
+    const auto &full_route = full_routes.front().get<json::Object>();
+    const auto &eta_route = eta_routes.front().get<json::Object>();
+    check_summary(full_route, eta_route);
+    BOOST_CHECK_EQUAL(eta_route.values.count("geometry"), 0);
+
+    const auto &full_legs = full_route.values.at("legs").get<json::Array>().values;
+    const auto &eta_legs = eta_route.values.at("legs").get<json::Array>().values;
+    const auto number_of_legs =
+        params.waypoints.empty() ? params.coordinates.size() - 1 : params.waypoints.size() - 1;
+    BOOST_REQUIRE_EQUAL(full_legs.size(), number_of_legs);
+    BOOST_REQUIRE_EQUAL(eta_legs.size(), number_of_legs);
+
+    for (std::size_t leg = 0; leg < number_of_legs; ++leg)
+    {
+        const auto &eta_leg = eta_legs[leg].get<json::Object>();
+        check_summary(full_legs[leg].get<json::Object>(), eta_leg);
+        BOOST_CHECK_EQUAL(eta_leg.values.at("steps").get<json::Array>().values.size(), 0);
+    }
+}
+
+osrm::RouteParameters getETAOnlyParameters()
+{
+    osrm::RouteParameters params;
+    for (const auto &location : get_locations_in_big_component())
+        params.coordinates.push_back(location);
+    for (const auto &location : get_split_trace_locations())
+        params.coordinates.push_back(location);
+    return params;
+}
+}
+
+BOOST_AUTO_TEST_CASE(test_route_eta_only_matches_full_route_ch)
+{
+    auto osrm = getOSRM(OSRM_TEST_DATA_DIR "/ch/monaco.osrm");
+
+    checkETAOnlyMatchesFullRoute(osrm, getETAOnlyParameters());
+
+    auto params = getETAOnlyParameters();
+    params.waypoints = {0, 3, params.coordinates.size() - 1};
+    checkETAOnlyMatchesFullRoute(osrm, params);
+}
+
+BOOST_AUTO_TEST_CASE(test_route_eta_only_matches_full_route_mld)
+{
+    auto osrm = getOSRM(OSRM_TEST_DATA_DIR "/mld/monaco.osrm", osrm::EngineConfig::Algorithm::MLD);
+
+    checkETAOnlyMatchesFullRoute(osrm, getETAOnlyParameters());
+
+    auto params = getETAOnlyParameters();
+    params.waypoints = {0, 3, params.coordinates.size() - 1};
+    checkETAOnlyMatchesFullRoute(osrm, params);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -5,6 +5,7 @@
 #include "fixture.hpp"
 #include "waypoint_check.hpp"
 
+#include "engine/api/table_api.hpp"
 #include "osrm/table_parameters.hpp"
 
 #include "osrm/coordinate.hpp"
@@ -13,6 +14,9 @@
 #include "osrm/osrm.hpp"
 #include "osrm/status.hpp"
 
+#include <cmath>
+#include <cstdint>
+
 BOOST_AUTO_TEST_SUITE(table)
 
 BOOST_AUTO_TEST_CASE(test_table_three_coords_one_source_one_dest_matrix)
@@ -340,4 +344,109 @@ BOOST_AUTO_TEST_CASE(test_table_serialiaze_fb_no_waypoints)
     BOOST_CHECK(fb->waypoints() == nullptr);
 }
 
+BOOST_AUTO_TEST_CASE(test_table_serialiaze_fb_int32)
+{
+    using namespace osrm;
+
+    auto osrm = getOSRM(OSRM_TEST_DATA_DIR "/ch/monaco.osrm");
+
+    TableParameters params;
+    params.coordinates.push_back(get_dummy_location());
+    params.coordinates.push_back(get_dummy_location());
+    params.coordinates.push_back(get_dummy_location());
+    params.annotations = TableParameters::AnnotationsType::All;
+
+    engine::api::ResultT float_result = flatbuffers::FlatBufferBuilder();
+    BOOST_CHECK(osrm.Table(params, float_result) == Status::Ok);
+
+    params.encoding = TableParameters::EncodingType::Int32;
+    engine::api::ResultT int_result = flatbuffers::FlatBufferBuilder();
+    BOOST_CHECK(osrm.Table(params, int_result) == Status::Ok);
+
+    auto float_table = engine::api::fbresult::GetFBResult(
+                           float_result.get<flatbuffers::FlatBufferBuilder>().GetBufferPointer())
+                           ->table();
+    auto int_table = engine::api::fbresult::GetFBResult(
+                         int_result.get<flatbuffers::FlatBufferBuilder>().GetBufferPointer())
+                         ->table();
+
+    // integer tables replace the float tables
+    BOOST_CHECK(int_table->durations() == nullptr);
+    BOOST_CHECK(int_table->distances() == nullptr);
+    BOOST_REQUIRE(int_table->durations_ds() != nullptr);
+    BOOST_REQUIRE(int_table->distances_m() != nullptr);
+    BOOST_CHECK(float_table->durations_ds() == nullptr);
+    BOOST_CHECK(float_table->distances_m() == nullptr);
+
+    const auto durations = float_table->durations();
+    const auto distances = float_table->distances();
+    const auto durations_ds = int_table->durations_ds();
+    const auto distances_m = int_table->distances_m();
+    BOOST_REQUIRE_EQUAL(durations_ds->size(), durations->size());
+    BOOST_REQUIRE_EQUAL(distances_m->size(), distances->size());
+    for (flatbuffers::uoffset_t index = 0; index < durations->size(); ++index)
+    {
+        BOOST_CHECK_EQUAL(durations_ds->Get(index), std::lround(durations->Get(index) * 10));
+        BOOST_CHECK_LE(std::abs(distances_m->Get(index) - distances->Get(index)), 0.55);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_table_serialiaze_fb_uint16)
+{
+    using namespace osrm;
+
+    auto osrm = getOSRM(OSRM_TEST_DATA_DIR "/ch/monaco.osrm");
+
+    TableParameters params;
+    for (const auto &location : get_locations_in_big_component())
+        params.coordinates.push_back(location);
+    // not reachable from the big component
+    params.coordinates.push_back(get_locations_in_small_component().front());
+    params.annotations = TableParameters::AnnotationsType::All;
+
+    engine::api::ResultT float_result = flatbuffers::FlatBufferBuilder();
+    BOOST_CHECK(osrm.Table(params, float_result) == Status::Ok);
+
+    params.encoding = TableParameters::EncodingType::UInt16;
+    engine::api::ResultT short_result = flatbuffers::FlatBufferBuilder();
+    BOOST_CHECK(osrm.Table(params, short_result) == Status::Ok);
+
+    auto float_table = engine::api::fbresult::GetFBResult(
+                           float_result.get<flatbuffers::FlatBufferBuilder>().GetBufferPointer())
+                           ->table();
+    auto short_table = engine::api::fbresult::GetFBResult(
+                           short_result.get<flatbuffers::FlatBufferBuilder>().GetBufferPointer())
+                           ->table();
+
+    BOOST_CHECK(short_table->durations() == nullptr);
+    BOOST_CHECK(short_table->distances() == nullptr);
+    BOOST_CHECK(short_table->durations_ds() == nullptr);
+    BOOST_CHECK(short_table->distances_m() == nullptr);
+    BOOST_REQUIRE(short_table->durations_s() != nullptr);
+    BOOST_REQUIRE(short_table->distances_dam() != nullptr);
+
+    const auto unreachable = engine::api::TableAPI::UnreachableCell<std::uint16_t>();
+    const auto durations = float_table->durations();
+    const auto distances = float_table->distances();
+    const auto durations_s = short_table->durations_s();
+    const auto distances_dam = short_table->distances_dam();
+    BOOST_REQUIRE_EQUAL(durations_s->size(), durations->size());
+    BOOST_REQUIRE_EQUAL(distances_dam->size(), distances->size());
+    for (flatbuffers::uoffset_t index = 0; index < durations->size(); ++index)
+    {
+        const auto row = index / params.coordinates.size();
+        const auto column = index % params.coordinates.size();
+        const auto is_small_component = row + 1 == params.coordinates.size();
+        if (is_small_component != (column + 1 == params.coordinates.size()))
+        {
+            BOOST_CHECK_EQUAL(durations_s->Get(index), unreachable);
+            BOOST_CHECK_EQUAL(distances_dam->Get(index), unreachable);
+            continue;
+        }
+
+        BOOST_CHECK_LE(std::abs(durations_s->Get(index) - durations->Get(index)), 0.55);
+        BOOST_CHECK_LE(std::abs(distances_dam->Get(index) * 10 - distances->Get(index)), 5.5);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -295,6 +295,8 @@ class MockAlgorithmDataFacade<engine::datafacade::CH>
     unsigned GetOutDegree(const NodeID /* n */) const override { return 0; }
     NodeID GetTarget(const EdgeID /* e */) const override { return SPECIAL_NODEID; }
     const EdgeData &GetEdgeData(const EdgeID /* e */) const override { return foo; }
+    EdgeDuration GetEdgeDuration(const EdgeID /* e */) const override { return 0; }
+    EdgeDistance GetEdgeDistance(const EdgeID /* e */) const override { return 0; }
     EdgeRange GetAdjacentEdgeRange(const NodeID /* node */) const override
     {
         return EdgeRange(static_cast<EdgeID>(0), static_cast<EdgeID>(0), {});
@@ -321,6 +323,8 @@ class MockAlgorithmDataFacade<engine::datafacade::CH>
     {
         return SPECIAL_EDGEID;
     }
+
+    engine::UnpackingCache *GetUnpackingCache() const override { return nullptr; }
 };
 
 template <typename AlgorithmT>
@@ -92,6 +92,7 @@ BOOST_AUTO_TEST_CASE(invalid_table_urls)
     BOOST_CHECK_EQUAL(testInvalidOptions<TableParameters>("1,2;3,4?fallback_coordinate=asdf"),
                       28UL);
     BOOST_CHECK_EQUAL(testInvalidOptions<TableParameters>("1,2;3,4?fallback_coordinate=10"), 28UL);
+    BOOST_CHECK_EQUAL(testInvalidOptions<TableParameters>("1,2;3,4?encoding=int16"), 17UL);
     BOOST_CHECK_EQUAL(
         testInvalidOptions<TableParameters>("1,2;3,4?annotations=durations&scale_factor=-1"), 28UL);
     BOOST_CHECK_EQUAL(
@@ -620,6 +621,18 @@ BOOST_AUTO_TEST_CASE(valid_table_urls)
     CHECK_EQUAL_RANGE(reference_1.radiuses, result_11->radiuses);
     CHECK_EQUAL_RANGE(reference_1.approaches, result_11->approaches);
     CHECK_EQUAL_RANGE(reference_1.coordinates, result_11->coordinates);
+
+    auto result_12 = parseParameters<TableParameters>("1,2;3,4?encoding=int32");
+    BOOST_CHECK(result_12);
+    BOOST_CHECK(result_12->encoding == TableParameters::EncodingType::Int32);
+
+    auto result_13 = parseParameters<TableParameters>("1,2;3,4?encoding=float");
+    BOOST_CHECK(result_13);
+    BOOST_CHECK(result_13->encoding == TableParameters::EncodingType::Float);
+
+    auto result_14 = parseParameters<TableParameters>("1,2;3,4?encoding=uint16");
+    BOOST_CHECK(result_14);
+    BOOST_CHECK(result_14->encoding == TableParameters::EncodingType::UInt16);
 }
 
 BOOST_AUTO_TEST_CASE(valid_match_urls)
@@ -663,6 +676,21 @@ BOOST_AUTO_TEST_CASE(valid_match_urls)
     CHECK_EQUAL_RANGE(reference_3.radiuses, result_3->radiuses);
     CHECK_EQUAL_RANGE(reference_3.approaches, result_3->approaches);
     CHECK_EQUAL_RANGE(reference_3.coordinates, result_3->coordinates);
+
+    // sessions can be continued with a single coordinate
+    std::vector<util::Coordinate> coords_3 = {{util::FloatLongitude{1}, util::FloatLatitude{2}}};
+
+    MatchParameters reference_4{};
+    reference_4.coordinates = coords_3;
+    reference_4.timestamps = {5};
+    auto result_4 =
+        parseParameters<MatchParameters>("1,2?timestamps=5&session=truck-42_a&end_session=true");
+    BOOST_CHECK(result_4);
+    BOOST_CHECK(result_4->IsValid());
+    BOOST_CHECK_EQUAL(result_4->session, "truck-42_a");
+    BOOST_CHECK(result_4->end_session);
+    CHECK_EQUAL_RANGE(reference_4.timestamps, result_4->timestamps);
+    CHECK_EQUAL_RANGE(reference_4.coordinates, result_4->coordinates);
 }
 
 BOOST_AUTO_TEST_CASE(invalid_match_urls)
@@ -688,6 +716,11 @@ BOOST_AUTO_TEST_CASE(invalid_match_urls)
     BOOST_CHECK_EQUAL(testInvalidOptions<MatchParameters>("1,2;3,4?waypoints=0,4"), 19UL);
     BOOST_CHECK_EQUAL(testInvalidOptions<MatchParameters>("1,2;3,4?waypoints=x;4"), 18UL);
     BOOST_CHECK_EQUAL(testInvalidOptions<MatchParameters>("1,2;3,4?waypoints=0;3.5"), 21UL);
+    BOOST_CHECK_EQUAL(testInvalidOptions<MatchParameters>("1,2;3,4?session=a.b"), 17UL);
+
+    // a single coordinate is only valid for sessions
+    auto result_3 = parseParameters<MatchParameters>("1,2");
+    BOOST_CHECK(!result_3 || !result_3->IsValid());
 }
 
 BOOST_AUTO_TEST_CASE(valid_nearest_urls)
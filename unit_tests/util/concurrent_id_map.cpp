@@ -0,0 +1,58 @@
+#include "util/concurrent_id_map.hpp"
+
+#include <boost/test/test_case_template.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(concurrent_id_map_test)
+
+using namespace osrm;
+using namespace osrm::util;
+
+BOOST_AUTO_TEST_CASE(find_or_add_test)
+{
+    ConcurrentIDMap<std::uint64_t, std::uint32_t> map;
+
+    BOOST_CHECK_EQUAL(map.ConcurrentFindOrAdd(42), 0);
+    BOOST_CHECK_EQUAL(map.ConcurrentFindOrAdd(7), 1);
+    BOOST_CHECK_EQUAL(map.ConcurrentFindOrAdd(42), 0);
+    BOOST_CHECK_EQUAL(map.Size(), 2);
+
+    auto moved = std::move(map);
+    BOOST_CHECK_EQUAL(moved.ConcurrentFindOrAdd(7), 1);
+    BOOST_CHECK_EQUAL(moved.ConcurrentFindOrAdd(8), 2);
+}
+
+BOOST_AUTO_TEST_CASE(dense_ids_test)
+{
+    const std::uint64_t num_keys = 1000;
+    ConcurrentIDMap<std::uint64_t, std::uint32_t> map;
+
+    // every key is added by many threads concurrently
+    std::vector<std::uint32_t> ids(num_keys * 16);
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, ids.size()),
+                      [&](const tbb::blocked_range<std::size_t> &range) {
+                          for (auto index = range.begin(); index < range.end(); ++index)
+                              ids[index] = map.ConcurrentFindOrAdd(index % num_keys);
+                      });
+
+    BOOST_CHECK_EQUAL(map.Size(), num_keys);
+
+    std::vector<std::uint64_t> keys(num_keys, num_keys);
+    map.ForEach([&](const std::uint64_t key, const std::uint32_t id) {
+        BOOST_REQUIRE_LT(id, num_keys);
+        keys[id] = key;
+    });
+    BOOST_CHECK(std::find(keys.begin(), keys.end(), num_keys) == keys.end());
+
+    for (auto index = 0u; index < ids.size(); ++index)
+        BOOST_CHECK_EQUAL(keys[ids[index]], index % num_keys);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,4 +1,4 @@
-#include "engine/douglas_peucker.hpp"
+#include "util/douglas_peucker.hpp"
 #include "util/coordinate_calculation.hpp"
 #include "util/debug.hpp"
 
@@ -7,12 +7,14 @@
 
 #include <osrm/coordinate.hpp>
 
+#include <algorithm>
+#include <random>
 #include <vector>
 
 BOOST_AUTO_TEST_SUITE(douglas_peucker_simplification)
 
 using namespace osrm;
-using namespace osrm::engine;
+using namespace osrm::util;
 
 BOOST_AUTO_TEST_CASE(calibrate_thresholds)
 {
@@ -115,4 +117,41 @@ BOOST_AUTO_TEST_CASE(remove_second_node_test)
     }
 }
 
+BOOST_AUTO_TEST_CASE(zoom_levels_test)
+{
+    // a random walk with a lot of points that are close to the thresholds
+    std::mt19937 generator(42);
+    std::normal_distribution<double> distribution(0, 30);
+    std::vector<util::Coordinate> coordinates;
+    std::int32_t lon = 13400000, lat = 52500000;
+    double delta_lon = 20, delta_lat = 10;
+    for (auto index = 0; index < 5000; ++index)
+    {
+        delta_lon = std::max(-60., std::min(60., delta_lon + distribution(generator)));
+        delta_lat = std::max(-60., std::min(60., delta_lat + distribution(generator)));
+        lon += delta_lon;
+        lat += delta_lat;
+        coordinates.push_back(
+            util::Coordinate{util::FixedLongitude{lon}, util::FixedLatitude{lat}});
+    }
+
+    const auto zoom_levels = douglasPeuckerZoomLevels(coordinates.begin(), coordinates.end());
+    BOOST_REQUIRE_EQUAL(zoom_levels.size(), coordinates.size());
+    BOOST_CHECK_EQUAL(zoom_levels.front(), 0);
+    BOOST_CHECK_EQUAL(zoom_levels.back(), 0);
+
+    for (unsigned z = 0; z < detail::DOUGLAS_PEUCKER_THRESHOLDS_SIZE; z++)
+    {
+        std::vector<util::Coordinate> filtered;
+        for (auto index = 0u; index < coordinates.size(); ++index)
+        {
+            if (zoom_levels[index] <= z)
+                filtered.push_back(coordinates[index]);
+        }
+        const auto simplified = douglasPeucker(coordinates, z);
+        BOOST_CHECK_EQUAL(filtered.size(), simplified.size());
+        BOOST_CHECK(filtered == simplified);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
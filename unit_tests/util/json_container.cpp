@@ -0,0 +1,53 @@
+#include "util/json_container.hpp"
+#include "util/json_renderer.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <sstream>
+#include <string>
+
+BOOST_AUTO_TEST_SUITE(json_container_test)
+
+using namespace osrm;
+using namespace osrm::util;
+
+BOOST_AUTO_TEST_CASE(object_access)
+{
+    json::Object object;
+    object.values["zeta"] = json::Number(1);
+    object.values["alpha"] = "a";
+    object.values.emplace("beta", json::True());
+
+    BOOST_CHECK_EQUAL(object.values.size(), 3);
+    BOOST_CHECK_EQUAL(object.values.at("alpha").get<json::String>().value, "a");
+    BOOST_CHECK(object.values.find("gamma") == object.values.end());
+
+    object.values["zeta"] = json::Number(2);
+    BOOST_CHECK_EQUAL(object.values.size(), 3);
+    BOOST_CHECK_EQUAL(object.values.at("zeta").get<json::Number>().value, 2);
+
+    object.values.erase(object.values.find("beta"));
+    BOOST_CHECK_EQUAL(object.values.count("beta"), 0);
+    BOOST_CHECK_EQUAL(object.values.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(render_sorted_keys)
+{
+    json::Object inner;
+    inner.values["b"] = json::Null();
+    inner.values["a"] = json::False();
+
+    json::Array array;
+    array.values.push_back(json::True());
+    array.values.push_back(inner);
+
+    json::Object object;
+    object.values["second"] = array;
+    object.values["first"] = "value";
+
+    std::ostringstream out;
+    json::render(out, object);
+    BOOST_CHECK_EQUAL(out.str(), "{\"first\":\"value\",\"second\":[true,{\"a\":false,\"b\":null}]}");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
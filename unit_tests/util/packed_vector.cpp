@@ -255,4 +255,39 @@ BOOST_AUTO_TEST_CASE(packed_weights_view_with_type_erasure)
     CHECK_EQUAL_RANGE(reverse_any, 3, 2, 1);
 }
 
+template <std::size_t Bits> void check_decode()
+{
+    PackedVector<std::uint64_t, Bits> vector;
+
+    std::mt19937 rng(1337);
+    std::uniform_int_distribution<std::uint64_t> dist(0, (1ULL << Bits) - 1);
+    for (std::size_t i = 0; i < 300; ++i)
+        vector.push_back(dist(rng));
+
+    for (std::size_t first = 0; first < vector.size(); first += 7)
+    {
+        for (std::size_t last = first; last <= vector.size(); last += 13)
+        {
+            std::vector<std::uint64_t> decoded(last - first);
+            const auto end = vector.decode(first, last, decoded.begin());
+            BOOST_CHECK(end == decoded.end());
+            BOOST_CHECK(std::equal(decoded.begin(), decoded.end(), vector.begin() + first));
+        }
+    }
+
+    // the last element ends on a word boundary for every 64th element
+    std::vector<std::uint64_t> decoded(vector.size());
+    vector.decode(0, vector.size(), decoded.rbegin());
+    BOOST_CHECK(std::equal(decoded.rbegin(), decoded.rend(), vector.begin()));
+}
+
+BOOST_AUTO_TEST_CASE(packed_vector_decode_range)
+{
+    check_decode<1>();
+    check_decode<22>();
+    check_decode<32>();
+    check_decode<33>();
+    check_decode<63>();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,60 @@
+#include "util/parallel_remove_if.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(parallel_remove_if_test)
+
+using namespace osrm;
+using namespace osrm::util;
+
+BOOST_AUTO_TEST_CASE(matches_serial_remove_if)
+{
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> values(0, 100);
+
+    for (const std::size_t size : {0, 1, 7, 8, 9, 100, 10000})
+    {
+        std::vector<int> input(size);
+        std::generate(input.begin(), input.end(), [&] { return values(generator); });
+
+        for (const int threshold : {-1, 10, 50, 90, 101})
+        {
+            const auto predicate = [threshold](const int value) { return value < threshold; };
+
+            auto serial = input;
+            serial.erase(std::remove_if(serial.begin(), serial.end(), predicate), serial.end());
+
+            auto parallel = input;
+            parallel.erase(parallel_remove_if(parallel.begin(), parallel.end(), predicate),
+                           parallel.end());
+
+            BOOST_CHECK_EQUAL_COLLECTIONS(
+                serial.begin(), serial.end(), parallel.begin(), parallel.end());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(moves_elements)
+{
+    std::vector<std::string> input;
+    for (int index = 0; index < 1000; ++index)
+        input.push_back(std::string(32, 'a' + index % 26) + std::to_string(index));
+
+    const auto predicate = [](const std::string &value) { return value.back() % 3 == 0; };
+
+    auto serial = input;
+    serial.erase(std::remove_if(serial.begin(), serial.end(), predicate), serial.end());
+
+    auto parallel = input;
+    parallel.erase(parallel_remove_if(parallel.begin(), parallel.end(), predicate, 1),
+                   parallel.end());
+
+    BOOST_CHECK_EQUAL_COLLECTIONS(serial.begin(), serial.end(), parallel.begin(), parallel.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
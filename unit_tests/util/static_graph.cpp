@@ -206,4 +206,31 @@ BOOST_AUTO_TEST_CASE(renumber_test)
     BOOST_CHECK_EQUAL(simple_graph.GetEdgeData(eit).id, 2);
 }
 
+BOOST_AUTO_TEST_CASE(lower_bound_edge_test)
+{
+    std::mt19937 g(RANDOM_SEED);
+    std::uniform_int_distribution<NodeID> node_udist(0, TEST_NUM_NODES - 1);
+
+    // a few nodes with a high degree and parallel edges, like the contracted graph has
+    std::vector<TestInputEdge> input_edges;
+    for (unsigned i = 0; i < TEST_NUM_EDGES; i++)
+    {
+        input_edges.push_back(TestInputEdge{node_udist(g) % 10, node_udist(g), EdgeID{i}});
+    }
+    std::stable_sort(input_edges.begin(), input_edges.end());
+    TestStaticGraph graph(TEST_NUM_NODES, input_edges);
+
+    for (NodeID from = 0; from < TEST_NUM_NODES; from++)
+    {
+        for (NodeID to = 0; to <= TEST_NUM_NODES; to++)
+        {
+            const auto range = graph.GetAdjacentEdgeRange(from);
+            const auto expected = std::find_if(range.begin(), range.end(), [&](const auto edge) {
+                return graph.GetTarget(edge) >= to;
+            });
+            BOOST_CHECK_EQUAL(graph.LowerBoundEdge(from, to), *expected);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()